@@ -50,6 +50,9 @@ int main(int argc, char** argv)
   JetScapeLogger::Instance()->SetVerboseLevel(0);
   
   auto reader=make_shared<JetScapeReaderAscii>(argv[1]);
+  // only the hadrons are used
+  reader->SetFastParsing(true);
+  reader->SetReadShowers(false);
   std::ofstream dist_output (argv[2]); //Format is SN, PID, E, Px, Py, Pz, Eta, Phi
   vector<shared_ptr<Hadron>> hadrons;
   int SN=0;
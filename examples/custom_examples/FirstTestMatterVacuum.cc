@@ -157,7 +157,7 @@ int main(int argc, char** argv)
   // pythiaGun->stat();
 
   // // Demonstrate how to work with pythia statistics
-  Pythia8::Info& info = pythiaGun->info;
+  const Pythia8::Info &info = pythiaGun->GetGeneratorInfo();
   // cout << " nTried    = " << info.nTried() << endl;
   // cout << " nSelected = " << info.nSelected()  << endl;
   // cout << " nAccepted = " << info.nAccepted()  << endl;
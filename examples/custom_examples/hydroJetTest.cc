@@ -172,7 +172,7 @@ int main(int argc, char** argv)
 // Some information is only known after the full run,
   // Therefore store information at the end of the file, in a footer
   writer->WriteComment ( "EVENT GENERATION INFORMATION" );
-  Pythia8::Info& info = pythiaGun->info;
+  const Pythia8::Info &info = pythiaGun->GetGeneratorInfo();
   std::ostringstream oss;
   oss.str(""); oss << "nTried    = " << info.nTried();
   writer->WriteComment ( oss.str() );
@@ -224,3 +224,28 @@ TEST(LiquefierBaseTest, TEST_add_hydro_source) {
     //pOut.clear();
     //lqf.Clear();
 }
+
+
+// check that droplets can be collected aside and handed over later
+TEST(LiquefierBaseTest, TEST_staged_droplets) {
+    LiquefierBase lqf;
+
+    // charm quarks do not need the medium information in filter_partons
+    FourVector p_in(3.0, 0.0, 0.0, 3.5);
+    FourVector p_out(2.0, 0.0, 0.0, 2.5);
+    FourVector x_test(0.0, 0.0, 0.0, 1.0);
+    std::vector<Parton> pIn = {Parton(0, 4, 0, p_in, x_test)};
+    std::vector<Parton> pOut = {Parton(0, 4, 0, p_out, x_test)};
+
+    std::vector<Droplet> staged;
+    lqf.add_hydro_sources(pIn, pOut, staged);
+    EXPECT_EQ(0, lqf.get_dropletlist_size());
+    EXPECT_EQ(1, staged.size());
+
+    Droplet first_drop;
+    lqf.add_a_droplet(first_drop);
+    lqf.add_droplets(staged);
+    EXPECT_EQ(2, lqf.get_dropletlist_size());
+    EXPECT_DOUBLE_EQ(p_in.t() - p_out.t(),
+                     (lqf.get_a_droplet(1).get_pmu())[0]);
+}
@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "JetScapeWriterStream.h"
+#include "JetScapeReader.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <random>
+
+using namespace Jetscape;
+
+// write a few events like the framework does, the files start at event 0
+static void write_events(std::vector<shared_ptr<JetScapeWriter>> writers) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> u(0., 1.);
+    for (int ev = 0; ev < 4; ev++) {
+        std::vector<shared_ptr<PartonShower>> showers;
+        for (int s = 0; s < 2; s++) {
+            auto shower = make_shared<PartonShower>();
+            node v0 = shower->new_vertex(Vertex());
+            node v1 = shower->new_vertex(Vertex(0, 0, 0, u(rng)));
+            shower->new_parton(v0, v1, Parton(0, 21, 0, 100 * u(rng), u(rng),
+                                              u(rng), 200.));
+            for (int i = 0; i < 20 + 10 * s; i++) {
+                node v = shower->new_vertex(Vertex(u(rng), -u(rng), 0, 1e-7 * u(rng)));
+                shower->new_parton(v1, v, Parton(i + 1, 1, 0, 10 * u(rng),
+                                                 u(rng) - 0.5, 6 * u(rng),
+                                                 20 + u(rng)));
+            }
+            showers.push_back(shower);
+        }
+        std::vector<shared_ptr<Hadron>> hadrons;
+        for (int i = 0; i < 50 * (ev + 1); i++) {
+            hadrons.push_back(make_shared<Hadron>(i, 211, 0, 5 * u(rng),
+                                                  4 * u(rng) - 2, 6 * u(rng),
+                                                  10 + u(rng), nullptr));
+        }
+
+        for (auto &writer : writers) {
+            writer->GetHeader().SetEventPlaneAngle(0.1 * ev);
+            writer->WriteHeaderToFile();
+            for (auto &shower : showers) {
+                writer->WriteComment("Energy loss Shower Initating Parton: Matter");
+                writer->Write(shower->GetPartonAt(0));
+                writer->Write(shower);
+            }
+            writer->WriteComment("Final State Hadrons");
+            for (unsigned int i = 0; i < hadrons.size(); i++) {
+                writer->WriteWhiteSpace("[" + std::to_string(i) + "] H");
+                writer->Write(hadrons[i]);
+            }
+            writer->WriteEvent();
+        }
+        JetScapeModuleBase::IncrementCurrentEvent();
+    }
+}
+
+// the fast parsing gives exactly the events of the line by line parsing
+template <class R> static void compare_readers(const std::string &file_name) {
+    R slow(file_name);
+    R fast(file_name);
+    fast.SetFastParsing(true);
+    R hadrons_only(file_name);
+    hadrons_only.SetFastParsing(true);
+    hadrons_only.SetReadShowers(false);
+
+    int n_events = 0;
+    while (!slow.Finished()) {
+        slow.Next();
+        ASSERT_FALSE(fast.Finished());
+        fast.Next();
+        hadrons_only.Next();
+        EXPECT_EQ(slow.GetCurrentEvent(), fast.GetCurrentEvent());
+        EXPECT_EQ(slow.GetEventPlaneAngle(), fast.GetEventPlaneAngle());
+        EXPECT_EQ(slow.GetEventPlaneAngle(), hadrons_only.GetEventPlaneAngle());
+
+        auto slow_showers = slow.GetPartonShowers();
+        auto fast_showers = fast.GetPartonShowers();
+        ASSERT_EQ(slow_showers.size(), fast_showers.size());
+        EXPECT_EQ(0u, hadrons_only.GetPartonShowers().size());
+        for (unsigned int s = 0; s < slow_showers.size(); s++) {
+            auto &a = slow_showers[s];
+            auto &b = fast_showers[s];
+            ASSERT_EQ(a->GetNumberOfPartons(), b->GetNumberOfPartons());
+            ASSERT_EQ(a->GetNumberOfVertices(), b->GetNumberOfVertices());
+            for (int i = 0; i < a->GetNumberOfPartons(); i++) {
+                EXPECT_EQ(a->GetPartonSource(i), b->GetPartonSource(i));
+                EXPECT_EQ(a->GetPartonTarget(i), b->GetPartonTarget(i));
+                EXPECT_EQ(a->GetPartonAt(i)->plabel(), b->GetPartonAt(i)->plabel());
+                EXPECT_EQ(a->GetPartonAt(i)->px(), b->GetPartonAt(i)->px());
+                EXPECT_EQ(a->GetPartonAt(i)->e(), b->GetPartonAt(i)->e());
+            }
+            for (int i = 0; i < a->GetNumberOfVertices(); i++) {
+                EXPECT_EQ(a->GetVertexAt(i)->x_in().x(), b->GetVertexAt(i)->x_in().x());
+                EXPECT_EQ(a->GetVertexAt(i)->x_in().t(), b->GetVertexAt(i)->x_in().t());
+            }
+        }
+
+        auto slow_hadrons = slow.GetHadrons();
+        ASSERT_GT(slow_hadrons.size(), 0u);
+        for (auto *reader : {&fast, &hadrons_only}) {
+            auto hadrons = reader->GetHadrons();
+            ASSERT_EQ(slow_hadrons.size(), hadrons.size());
+            for (unsigned int i = 0; i < hadrons.size(); i++) {
+                EXPECT_EQ(slow_hadrons[i]->pid(), hadrons[i]->pid());
+                EXPECT_EQ(slow_hadrons[i]->px(), hadrons[i]->px());
+                EXPECT_EQ(slow_hadrons[i]->pz(), hadrons[i]->pz());
+                EXPECT_EQ(slow_hadrons[i]->e(), hadrons[i]->e());
+            }
+        }
+        n_events++;
+    }
+    EXPECT_EQ(4, n_events);
+    EXPECT_TRUE(fast.Finished());
+    EXPECT_TRUE(hadrons_only.Finished());
+}
+
+TEST(JetScapeReaderTest, TEST_FAST_PARSING){
+    std::string file_name = "ascii_reader_test.dat";
+    std::string gz_file_name = "ascii_reader_test.dat.gz";
+    auto writer = make_shared<JetScapeWriterAscii>(file_name);
+    auto gz_writer = make_shared<JetScapeWriterAsciiGZ>(gz_file_name);
+    writer->Init();
+    gz_writer->Init();
+    write_events({writer, gz_writer});
+    writer->Close();
+    gz_writer->Close();
+
+    compare_readers<JetScapeReaderAscii>(file_name);
+    compare_readers<JetScapeReaderAsciiGZ>(gz_file_name);
+    std::remove(file_name.c_str());
+    std::remove(gz_file_name.c_str());
+}
@@ -0,0 +1,124 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "JetScapeWriterBinary.h"
+#include "JetScapeBinaryReader.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+
+using namespace Jetscape;
+
+// one parton from vertex 0 to vertex 1, which splits into n_partons partons
+static shared_ptr<PartonShower> make_shower(int n_partons) {
+    auto shower = make_shared<PartonShower>();
+    node v0 = shower->new_vertex(Vertex(0, 0, 0, 0));
+    node v1 = shower->new_vertex(Vertex(0.1, 0.2, 0.3, 0.5));
+    shower->new_parton(v0, v1, Parton(0, 21, 0, 50., 0.5, 1.0, 60.));
+    for (int i = 0; i < n_partons; i++) {
+        node v = shower->new_vertex(Vertex(0.1 * i, 0, 0, 1.0 + i));
+        shower->new_parton(v1, v, Parton(i + 1, 1, 0, 10. + i, -0.2, 2.0, 12. + i));
+    }
+    return shower;
+}
+
+static void write_and_read(int compression_level) {
+    std::string file_name = "binary_writer_test.jsbin";
+    auto writer = make_shared<JetScapeWriterBinary>(file_name);
+    writer->SetCompressionLevel(compression_level);
+    writer->Open();
+
+    std::vector<shared_ptr<PartonShower>> showers = {make_shower(3),
+                                                     make_shower(40)};
+    double x[4] = {1., 2., 3., 4.};
+    auto hadron = make_shared<Hadron>(7, 211, 0, 3., 0.4, -1.2, 3.5, x);
+    for (int ev = 0; ev < 3; ev++) {
+        writer->GetHeader().SetEventPlaneAngle(0.25 * ev);
+        writer->WriteHeaderToFile();
+        writer->WriteComment("event " + std::to_string(ev));
+        for (auto &shower : showers) {
+            writer->Write(shower);
+        }
+        for (int i = 0; i < 100; i++) {
+            writer->Write(hadron);
+        }
+        writer->WriteEvent();
+    }
+    writer->Close();
+
+    JetScapeBinaryReader reader(file_name);
+    int n_events = 0;
+    while (!reader.Finished()) {
+        reader.Next();
+        const JetScapeBinaryEvent &event = reader.GetEvent();
+        EXPECT_DOUBLE_EQ(0.25 * n_events, reader.GetEventPlaneAngle());
+        ASSERT_EQ(1u, event.lines.size());
+        EXPECT_EQ("# event " + std::to_string(n_events), event.lines[0]);
+
+        auto read_showers = reader.GetPartonShowers();
+        ASSERT_EQ(showers.size(), read_showers.size());
+        for (unsigned int s = 0; s < showers.size(); s++) {
+            auto &in = showers[s];
+            auto &out = read_showers[s];
+            ASSERT_EQ(in->GetNumberOfPartons(), out->GetNumberOfPartons());
+            ASSERT_EQ(in->GetNumberOfVertices(), out->GetNumberOfVertices());
+            for (int i = 0; i < in->GetNumberOfPartons(); i++) {
+                EXPECT_EQ(in->GetPartonSource(i), out->GetPartonSource(i));
+                EXPECT_EQ(in->GetPartonTarget(i), out->GetPartonTarget(i));
+                EXPECT_EQ(in->GetPartonAt(i)->plabel(), out->GetPartonAt(i)->plabel());
+                EXPECT_EQ(in->GetPartonAt(i)->pid(), out->GetPartonAt(i)->pid());
+                EXPECT_NEAR(in->GetPartonAt(i)->e(), out->GetPartonAt(i)->e(), 1e-5);
+                EXPECT_NEAR(in->GetPartonAt(i)->pt(), out->GetPartonAt(i)->pt(), 1e-5);
+            }
+            for (int i = 0; i < in->GetNumberOfVertices(); i++) {
+                EXPECT_NEAR(in->GetVertexAt(i)->x_in().t(),
+                            out->GetVertexAt(i)->x_in().t(), 1e-6);
+            }
+        }
+
+        auto hadrons = reader.GetHadrons();
+        ASSERT_EQ(100u, hadrons.size());
+        EXPECT_EQ(211, hadrons[0]->pid());
+        EXPECT_NEAR(hadron->px(), hadrons[0]->px(), 1e-5);
+        EXPECT_NEAR(hadron->x_in().t(), hadrons[0]->x_in().t(), 1e-6);
+        EXPECT_NEAR(hadron->x_in().z(), hadrons[0]->x_in().z(), 1e-6);
+        EXPECT_EQ(100u, reader.GetHadronsForFastJet().size());
+        n_events++;
+    }
+    EXPECT_EQ(3, n_events);
+    std::remove(file_name.c_str());
+}
+
+TEST(JetScapeBinaryTest, TEST_UNCOMPRESSED){
+    write_and_read(0);
+}
+
+TEST(JetScapeBinaryTest, TEST_COMPRESSED){
+    write_and_read(1);
+}
+
+// an event cut short is refused
+TEST(JetScapeBinaryTest, TEST_TRUNCATED){
+    JetScapeBinaryEvent event;
+    event.AddShower(*make_shower(5));
+    std::string payload;
+    event.Encode(payload);
+
+    JetScapeBinaryEvent decoded;
+    EXPECT_TRUE(decoded.Decode(payload));
+    EXPECT_EQ(6u, decoded.shower_parton_columns.size());
+    payload.resize(payload.size() - 4);
+    EXPECT_FALSE(decoded.Decode(payload));
+}
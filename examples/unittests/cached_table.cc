@@ -0,0 +1,110 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "CachedTable.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace Jetscape;
+
+// reads all the numbers and counts the calls
+static int n_parsed = 0;
+static bool parse_all(std::istream &in, std::vector<double> &values) {
+    n_parsed++;
+    double value;
+    while (in >> value)
+        values.push_back(value);
+    return (!values.empty());
+}
+
+static void write_source(const std::string &file_name, int n) {
+    std::ofstream out(file_name.c_str());
+    for (int i = 0; i < n; i++)
+        out << 0.5 * i << "\n";
+}
+
+// check that the cache is built once, mapped and rebuilt when the source changes
+TEST(CachedTableTest, TEST_CACHE){
+    std::string source = "cached_table_test.dat";
+    std::remove(CachedTable::CacheFileName(source).c_str());
+    write_source(source, 100);
+    n_parsed = 0;
+
+    auto built = CachedTable::Load(source, parse_all);
+    ASSERT_TRUE(built != nullptr);
+    EXPECT_EQ(1, n_parsed);
+    EXPECT_TRUE(built->IsMapped());
+    ASSERT_EQ(100u, built->size());
+    EXPECT_DOUBLE_EQ(49.5, (*built)[99]);
+
+    auto mapped = CachedTable::Load(source, parse_all);
+    ASSERT_TRUE(mapped != nullptr);
+    EXPECT_EQ(1, n_parsed);
+    EXPECT_TRUE(mapped->IsMapped());
+    for (std::size_t i = 0; i < mapped->size(); i++)
+        EXPECT_EQ(built->at(i), mapped->at(i));
+
+    write_source(source, 50);
+    auto rebuilt = CachedTable::Load(source, parse_all);
+    ASSERT_TRUE(rebuilt != nullptr);
+    EXPECT_EQ(2, n_parsed);
+    EXPECT_EQ(50u, rebuilt->size());
+    // the old mapping stays valid
+    EXPECT_DOUBLE_EQ(49.5, mapped->at(99));
+
+    std::remove(source.c_str());
+    std::remove(CachedTable::CacheFileName(source).c_str());
+}
+
+// check that the caches go to the cache directory, not next to the source
+TEST(CachedTableTest, TEST_CACHE_DIRECTORY){
+    std::string directory = "cached_table_test_caches";
+    CachedTable::SetCacheDirectory(directory);
+    EXPECT_EQ(directory, CachedTable::GetCacheDirectory());
+    std::string source = "cached_table_directory.dat";
+    write_source(source, 10);
+
+    std::string cache_file = CachedTable::CacheFileName(source);
+    EXPECT_EQ(0u, cache_file.find(directory + "/cached_table_directory.dat."));
+    auto table = CachedTable::Load(source, parse_all);
+    ASSERT_TRUE(table != nullptr);
+    EXPECT_TRUE(table->IsMapped());
+    EXPECT_TRUE(std::ifstream(cache_file.c_str()).good());
+    EXPECT_FALSE(std::ifstream((source + ".cache").c_str()).good());
+
+    std::remove(source.c_str());
+    std::remove(cache_file.c_str());
+    std::remove(directory.c_str());
+    CachedTable::SetCacheDirectory("");
+}
+
+// check the errors
+TEST(CachedTableTest, TEST_ERRORS){
+    EXPECT_TRUE(CachedTable::Load("no_such_table.dat", parse_all) == nullptr);
+
+    std::string source = "cached_table_empty.dat";
+    { std::ofstream out(source.c_str()); }
+    EXPECT_TRUE(CachedTable::Load(source, parse_all) == nullptr);
+    std::remove(source.c_str());
+
+    auto table = CachedTable::FromValues({1., 2., 3.});
+    EXPECT_FALSE(table->IsMapped());
+    EXPECT_DOUBLE_EQ(3., table->at(2));
+    EXPECT_THROW(table->at(3), std::out_of_range);
+}
@@ -17,6 +17,7 @@
 #include "LiquefierBase.h"
 #include "gtest/gtest.h"
 #include <iostream>
+#include <random>
 
 using namespace Jetscape;
 
@@ -220,3 +221,73 @@ TEST(CausalLiquifierTest, TEST_GRID_TAU_ETA_CONSERVATION){
         }
     }
 }
+
+// check the tabulated kernel against the Bessel functions
+TEST(CausalLiquifierTest, TEST_TABULATED_KERNEL){
+
+    CausalLiquefier lqf(0.3,0.3,0.3,0.3);
+    double c = lqf.c_diff;
+    double g = lqf.gamma_relax;
+
+    for(double t=0.1; t < 15.0; t+=0.37){
+        for(double r=0.01; r < c*t; r+=0.0731){
+            double u = sqrt(c*c*t*t - r*r);
+            double x = g*u/c;
+            double f = g*g/c*lqf.dumping(t);
+            double rho = f*(gsl_sf_bessel_I1(x)/(c*u) + gsl_sf_bessel_In(2,x)*t/u/u)
+                + lqf.dumping(t)*lqf.rho_delta(t,r);
+            double j = f*gsl_sf_bessel_In(2,x)*r/u/u
+                + lqf.dumping(t)*lqf.j_delta(t,r);
+            EXPECT_NEAR(rho, lqf.kernel_rho(t,r), 1e-6*std::abs(rho));
+            EXPECT_NEAR(j, lqf.kernel_j(t,r), 1e-6*std::abs(j));
+        }
+    }
+}
+
+// the droplet index gives the same source as going through all droplets
+TEST(CausalLiquifierTest, TEST_SOURCE_INDEX){
+
+    CausalLiquefier lqf(0.1,0.1,0.1,0.1);
+    lqf.set_t_delay(0.5);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> u(0., 1.);
+    for(int i=0; i<2000; i++){
+        std::array<Jetscape::real, 4> x_in = {
+            Jetscape::real(0.5 + 2.0*u(rng)), Jetscape::real(6.0*u(rng) - 3.0),
+            Jetscape::real(6.0*u(rng) - 3.0), Jetscape::real(2.0*u(rng) - 1.0)};
+        std::array<Jetscape::real, 4> p_in = {
+            Jetscape::real(2.0), Jetscape::real(u(rng)),
+            Jetscape::real(u(rng)), Jetscape::real(u(rng))};
+        lqf.add_a_droplet(Droplet(x_in, p_in));
+    }
+
+    int n_nonzero = 0;
+    for(int i=0; i<400; i++){
+        Jetscape::real tau = 1.0 + 2.5*u(rng);
+        Jetscape::real x = 6.0*u(rng) - 3.0;
+        Jetscape::real y = 6.0*u(rng) - 3.0;
+        Jetscape::real eta = 2.0*u(rng) - 1.0;
+
+        std::array<Jetscape::real, 4> jmu_all = {0.0, 0.0, 0.0, 0.0};
+        for(int idx=0; idx<lqf.get_dropletlist_size(); idx++){
+            const Droplet drop_i = lqf.get_a_droplet(idx);
+            const auto x_drop = drop_i.get_xmu();
+            double ds2 = tau * tau + x_drop[0] * x_drop[0] -
+                         2.0 * tau * x_drop[0] * cosh(eta - x_drop[3]) -
+                         (x - x_drop[1]) * (x - x_drop[1]) -
+                         (y - x_drop[2]) * (y - x_drop[2]);
+            if (tau >= x_drop[0] && ds2 >= 0.0) {
+                std::array<Jetscape::real, 4> jmu_i = {0.0, 0.0, 0.0, 0.0};
+                lqf.smearing_kernel(tau, x, y, eta, drop_i, jmu_i);
+                for (int k = 0; k < 4; k++) jmu_all[k] += jmu_i[k];
+            }
+        }
+
+        std::array<Jetscape::real, 4> jmu = {0.0, 0.0, 0.0, 0.0};
+        lqf.get_source(tau, x, y, eta, jmu);
+        for (int k = 0; k < 4; k++) EXPECT_EQ(jmu_all[k], jmu[k]);
+        if (jmu_all[0] != 0.0) n_nonzero++;
+    }
+    EXPECT_GT(n_nonzero, 10);
+}
@@ -13,8 +13,14 @@
  * See COPYING for details.
  ******************************************************************************/
 
+#include <cmath>
+#include <thread>
 #include "FluidDynamics.h"
 #include "FluidEvolutionHistory.h"
+#include "JetEnergyLoss.h"
+#include "MainClock.h"
+#include "SurfaceFinder.h"
+#include "LinearInterpolation.h"
 #include "gtest/gtest.h"
 
 using namespace Jetscape;
@@ -69,3 +75,418 @@ TEST(EvolutionHistoryTest, TEST_WRITE){
     // check almost equal for two float numbers
     ASSERT_NEAR(hist.get(0.8, 0.0, 0.0, 0.0).energy_density, static_cast<real>(const_ed), 1.0E-6);
 }
+
+// fill a small evolution history with a smooth profile
+void fill_test_history(EvolutionHistory &hist) {
+    hist.tau_min = 0.6;
+    hist.dtau = 0.1;
+    hist.x_min = -2;
+    hist.y_min = -2;
+    hist.eta_min = -2;
+    hist.dx = 0.5;
+    hist.dy = 0.5;
+    hist.deta = 0.5;
+    hist.ntau = 5;
+    hist.nx = 9;
+    hist.ny = 9;
+    hist.neta = 9;
+    hist.tau_eta_is_tz = false;
+    hist.boost_invariant = false;
+    for (int n=0; n != hist.ntau; n++)
+        for (int i=0; i != hist.nx; i++)
+            for (int j=0; j != hist.ny; j++)
+                for (int k=0; k != hist.neta; k++) {
+                    auto cell = FluidCellInfo();
+                    cell.energy_density = 10.0 - n - 0.3*i + 0.1*j;
+                    cell.temperature = 0.3 - 0.01*n - 0.002*k;
+                    cell.mu_B = 0.01*i;
+                    cell.vx = 0.05*(i - 4);
+                    cell.pi[1][2] = 0.02*j - 0.01*k;
+                    cell.pi[2][1] = cell.pi[1][2];
+                    cell.bulk_Pi = -0.003*n;
+                    hist.AddCell(cell);
+                }
+}
+
+// test the columnar storage of EvolutionHistory
+TEST(EvolutionHistoryTest, TEST_COLUMNAR){
+    auto hist = EvolutionHistory();
+    fill_test_history(hist);
+    auto columnar_hist = EvolutionHistory();
+    fill_test_history(columnar_hist);
+    columnar_hist.SetColumnarStorage();
+
+    EXPECT_TRUE(columnar_hist.is_columnar());
+    EXPECT_EQ(hist.get_data_size(), columnar_hist.get_data_size());
+    EXPECT_LT(columnar_hist.GetMemoryFootprint(), hist.GetMemoryFootprint());
+
+    auto cell = hist.get(0.83, 0.12, -0.4, 0.7);
+    auto columnar_cell = columnar_hist.get(0.83, 0.12, -0.4, 0.7);
+    EXPECT_FLOAT_EQ(cell.energy_density, columnar_cell.energy_density);
+    EXPECT_FLOAT_EQ(cell.temperature, columnar_cell.temperature);
+    EXPECT_FLOAT_EQ(cell.vx, columnar_cell.vx);
+    EXPECT_FLOAT_EQ(cell.pi[2][1], columnar_cell.pi[2][1]);
+    EXPECT_FLOAT_EQ(cell.bulk_Pi, columnar_cell.bulk_Pi);
+    EXPECT_FLOAT_EQ(hist.GetFluidCellEntry(2, 3, 4, 5, ENTRY_TEMPERATURE),
+                    columnar_hist.GetFluidCellEntry(2, 3, 4, 5,
+                                                    ENTRY_TEMPERATURE));
+}
+
+// test the sliding window: the time slices are pushed by a producer thread
+// while they are read and released
+TEST(EvolutionHistoryTest, TEST_SLIDING_WINDOW){
+    auto hist = EvolutionHistory();
+    fill_test_history(hist);
+    for (int columnar = 0; columnar < 2; columnar++) {
+        auto window_hist = EvolutionHistory();
+        window_hist.SetSlidingWindow(3);
+        if (columnar == 1) {
+            window_hist.SetColumnarStorage();
+        }
+        window_hist.BeginTimeSlices();
+        std::thread producer([&window_hist]() {
+            fill_test_history(window_hist);
+            window_hist.EndTimeSlices();
+        });
+        for (int i = 0; i < 8; i++) {
+            real tau = 0.62 + 0.05*i;
+            window_hist.WaitForTimeSlice(tau);
+            auto cell = hist.get(tau, 0.12, -0.4, 0.7);
+            auto window_cell = window_hist.get(tau, 0.12, -0.4, 0.7);
+            EXPECT_FLOAT_EQ(cell.energy_density, window_cell.energy_density);
+            EXPECT_FLOAT_EQ(cell.temperature, window_cell.temperature);
+            EXPECT_FLOAT_EQ(cell.bulk_Pi, window_cell.bulk_Pi);
+            window_hist.ReleaseTimeSlices(tau);
+        }
+        producer.join();
+        // evicted slices read as the first kept one
+        EXPECT_NO_THROW(window_hist.WaitForTimeSlice(0.7));
+        EXPECT_FLOAT_EQ(hist.get(0.9, 0.3, 0.2, -0.1).temperature,
+                        window_hist.get(0.7, 0.3, 0.2, -0.1).temperature);
+
+        // only the last two time slices are kept
+        EXPECT_EQ(2*9*9*9, window_hist.get_data_size());
+        EXPECT_LT(window_hist.GetMemoryFootprint(), hist.GetMemoryFootprint());
+        EXPECT_FLOAT_EQ(hist.get(0.95, 0.3, 0.2, -0.1).temperature,
+                        window_hist.get(0.95, 0.3, 0.2, -0.1).temperature);
+    }
+}
+
+// a hydro pushing a 3+1D history with a linear temperature profile
+class StreamingTestHydro : public FluidDynamics {
+public:
+    StreamingTestHydro() {
+        n_evolution_window_frames = 5;
+        evolution_window_tc = 0.15;
+        bulk_info.SetSlidingWindow(n_evolution_window_frames);
+    }
+
+    static real Temperature(real tau, real x, real eta) {
+        return (0.2 + 0.1*tau + 0.01*x + 0.005*eta);
+    }
+
+    void EvolveHydro() {
+        bulk_info.tau_min = 0.6;
+        bulk_info.dtau = 0.1;
+        bulk_info.x_min = -2;
+        bulk_info.y_min = -2;
+        bulk_info.eta_min = -2;
+        bulk_info.dx = 0.5;
+        bulk_info.dy = 0.5;
+        bulk_info.deta = 0.5;
+        bulk_info.ntau = 25;
+        bulk_info.nx = 9;
+        bulk_info.ny = 9;
+        bulk_info.neta = 9;
+        bulk_info.tau_eta_is_tz = false;
+        bulk_info.boost_invariant = false;
+        for (int n=0; n != bulk_info.ntau; n++)
+            for (int i=0; i != bulk_info.nx; i++)
+                for (int j=0; j != bulk_info.ny; j++)
+                    for (int k=0; k != bulk_info.neta; k++) {
+                        auto cell = FluidCellInfo();
+                        cell.temperature = Temperature(
+                            bulk_info.TauCoord(n), bulk_info.XCoord(i),
+                            bulk_info.EtaCoord(k));
+                        bulk_info.AddCell(cell);
+                    }
+    }
+
+    void GetHydroInfo(real t, real x, real y, real z,
+                      std::unique_ptr<FluidCellInfo> &fluid_cell_info_ptr) {
+        fluid_cell_info_ptr.reset(
+            new FluidCellInfo(bulk_info.get_tz(t, x, y, z)));
+    }
+
+    int GetSlidingWindow() const { return (bulk_info.GetSlidingWindow()); }
+};
+
+// runs two jets on the main clock against a streamed history, one at
+// midrapidity and one at the given rapidity; returns the largest window
+int stream_with_forward_parton(real rapidity) {
+    if (!TimeModule::GetMainClock()) {
+        JetEnergyLoss().AddMainClock(
+            std::make_shared<MainClock>("TestClock", 0.6, 2.6, 0.1));
+    }
+    auto clock = TimeModule::GetMainClock();
+    clock->Reset();
+
+    StreamingTestHydro hydro;
+    hydro.Exec();
+
+    // partons formed at t = 0.6 at the center of the grid
+    auto central = std::make_shared<JetEnergyLoss>();
+    central->AddShowerInitiatingParton(std::make_shared<Parton>(
+        0, 21, 0, FourVector(3.0, 0.0, 0.0, 10.0),
+        FourVector(0.0, 0.0, 0.0, 0.6)));
+    real vz = std::tanh(rapidity);
+    auto forward = std::make_shared<JetEnergyLoss>();
+    forward->AddShowerInitiatingParton(std::make_shared<Parton>(
+        0, 21, 0, FourVector(0.0, 0.0, 10.0*vz, 10.0),
+        FourVector(0.0, 0.0, 0.6*vz, 0.6)));
+    std::vector<std::shared_ptr<JetEnergyLoss>> showers = {central, forward};
+
+    int max_window = 0;
+    do {
+        real t = clock->GetCurrentTime();
+        // the cells read during the time step
+        for (real t_read : {t, t + static_cast<real>(clock->GetDeltaT())}) {
+            real x = 0.3*(t_read - 0.6);
+            std::unique_ptr<FluidCellInfo> cell;
+            hydro.GetHydroCell(t_read, x, 0.0, 0.0, cell);
+            EXPECT_NEAR(StreamingTestHydro::Temperature(t_read, x, 0.0),
+                        cell->temperature, 1.0e-5);
+            real tau = t_read/std::cosh(rapidity);
+            if (tau >= 0.6 && rapidity <= 2) {
+                hydro.GetHydroCell(t_read, 0.0, 0.0, vz*t_read, cell);
+                EXPECT_NEAR(
+                    StreamingTestHydro::Temperature(tau, 0.0, rapidity),
+                    cell->temperature, 1.0e-5);
+            }
+        }
+        EXPECT_NO_THROW(hydro.ReleaseHydroEvolutionHistory(
+            showers, t + 2*clock->GetDeltaT()));
+        max_window = std::max(max_window, hydro.GetSlidingWindow());
+    } while (clock->Tick());
+    EXPECT_NO_THROW(hydro.FinishHydroEvolution());
+    return (max_window);
+}
+
+// partons beyond the eta range do not hold back the sliding window, the
+// ones inside it make it grow
+TEST(FluidDynamicsTest, TEST_STREAMING_FORWARD_RAPIDITY){
+    EXPECT_EQ(5, stream_with_forward_parton(3.0));
+    EXPECT_GT(stream_with_forward_parton(1.5), 5);
+}
+
+// test field selection and 16-bit quantisation
+TEST(EvolutionHistoryTest, TEST_COLUMNAR_SELECTED_FIELDS){
+    auto hist = EvolutionHistory();
+    fill_test_history(hist);
+    auto columnar_hist = EvolutionHistory();
+    columnar_hist.SetColumnarStorage(
+        EntryMask(ENTRY_ENERGY_DENSITY) | EntryMask(ENTRY_TEMPERATURE) |
+        ENTRY_MASK_SHEAR | EntryMask(ENTRY_BULK_PI),
+        ENTRY_MASK_SHEAR | EntryMask(ENTRY_BULK_PI));
+    fill_test_history(columnar_hist);
+
+    auto cell = hist.get(1.0, 0.3, 0.2, -0.1);
+    auto columnar_cell = columnar_hist.get(1.0, 0.3, 0.2, -0.1);
+    EXPECT_FLOAT_EQ(cell.energy_density, columnar_cell.energy_density);
+    EXPECT_FLOAT_EQ(cell.temperature, columnar_cell.temperature);
+    // dropped fields read back as zero
+    EXPECT_EQ(columnar_cell.mu_B, 0.0);
+    EXPECT_EQ(columnar_cell.vx, 0.0);
+    // half precision fields
+    EXPECT_NEAR(cell.pi[1][2], columnar_cell.pi[1][2], 1e-4);
+    EXPECT_EQ(columnar_cell.pi[1][2], columnar_cell.pi[2][1]);
+    EXPECT_NEAR(cell.bulk_Pi, columnar_cell.bulk_Pi, 1e-5);
+
+    // 4 fields in 32 bits and 11 fields in 16 bits per cell
+    EXPECT_LT(2 * columnar_hist.GetMemoryFootprint(),
+              hist.GetMemoryFootprint());
+}
+
+// test the batched query against single point queries
+TEST(EvolutionHistoryTest, TEST_BATCH){
+    auto hist = EvolutionHistory();
+    fill_test_history(hist);
+
+    const int n_points = 4;
+    real tau[n_points] = {0.65, 0.83, 1.0, 2.5};
+    real x[n_points] = {0.1, 0.12, -1.3, 0.0};
+    real y[n_points] = {0.0, -0.4, 1.1, 0.0};
+    real eta[n_points] = {0.2, 0.7, -0.1, 0.0};
+    unsigned int field_mask = (EntryMask(ENTRY_ENERGY_DENSITY) |
+                               EntryMask(ENTRY_TEMPERATURE) |
+                               EntryMask(ENTRY_VX) | EntryMask(ENTRY_PI12));
+    EXPECT_EQ(NumberOfEntries(field_mask), 4);
+    real output[4 * n_points];
+    hist.get_batch(n_points, tau, x, y, eta, field_mask, output);
+    for (int i = 0; i < n_points; i++) {
+        auto cell = hist.get(tau[i], x[i], y[i], eta[i]);
+        EXPECT_FLOAT_EQ(output[i], cell.energy_density);
+        EXPECT_FLOAT_EQ(output[n_points + i], cell.temperature);
+        EXPECT_FLOAT_EQ(output[2 * n_points + i], cell.vx);
+        EXPECT_FLOAT_EQ(output[3 * n_points + i], cell.pi[1][2]);
+    }
+    // the last point is outside of the evolution history
+    EXPECT_EQ(output[n_points - 1], 0.0);
+}
+
+// test the flat data_vector representation with a compiled data_info
+TEST(EvolutionHistoryTest, TEST_FROM_VECTOR){
+    auto hist = EvolutionHistory();
+    fill_test_history(hist);
+
+    std::vector<std::string> data_info = {"temperature", "vx", "energy_density",
+                                          "pi12", "bulk_pi"};
+    std::vector<float> data_vector;
+    for (int n=0; n != hist.ntau; n++)
+        for (int i=0; i != hist.nx; i++)
+            for (int j=0; j != hist.ny; j++)
+                for (int k=0; k != hist.neta; k++) {
+                    auto cell = hist.GetFluidCell(n, i, j, k);
+                    data_vector.push_back(cell.temperature);
+                    data_vector.push_back(cell.vx);
+                    data_vector.push_back(cell.energy_density);
+                    data_vector.push_back(cell.pi[1][2]);
+                    data_vector.push_back(cell.bulk_Pi);
+                }
+    auto vector_hist = EvolutionHistory();
+    vector_hist.FromVector(data_vector, data_info, hist.tau_min, hist.dtau,
+                           hist.x_min, hist.dx, hist.nx, hist.y_min, hist.dy,
+                           hist.ny, hist.eta_min, hist.deta, hist.neta, false);
+    vector_hist.boost_invariant = false;
+    EXPECT_EQ(vector_hist.ntau, hist.ntau);
+    EXPECT_EQ(vector_hist.get_data_size(), hist.get_data_size());
+
+    FluidCellInfo cell;
+    vector_hist.GetFluidCell(3, 2, 5, 7, cell);
+    auto reference_cell = hist.GetFluidCell(3, 2, 5, 7);
+    EXPECT_EQ(cell.temperature, reference_cell.temperature);
+    EXPECT_EQ(cell.pi[2][1], reference_cell.pi[1][2]);
+    EXPECT_EQ(vector_hist.GetFluidCellEntry(3, 2, 5, 7, ENTRY_VX),
+              reference_cell.vx);
+    EXPECT_EQ(vector_hist.GetFluidCellEntry(3, 2, 5, 7, ENTRY_MU_B), 0.0);
+
+    auto interpolated = vector_hist.get(0.83, 0.12, -0.4, 0.7);
+    auto reference = hist.get(0.83, 0.12, -0.4, 0.7);
+    EXPECT_FLOAT_EQ(interpolated.energy_density, reference.energy_density);
+    EXPECT_FLOAT_EQ(interpolated.bulk_Pi, reference.bulk_Pi);
+
+    // a data_vector shorter than the grid is caught at the missing cells
+    data_vector.resize(data_vector.size() - data_info.size());
+    vector_hist.FromVector(data_vector, data_info, hist.tau_min, hist.dtau,
+                           hist.x_min, hist.dx, hist.nx, hist.y_min, hist.dy,
+                           hist.ny, hist.eta_min, hist.deta, hist.neta, false);
+    vector_hist.ntau = hist.ntau;
+    EXPECT_NO_THROW(vector_hist.GetFluidCell(0, 0, 0, 0, cell));
+    EXPECT_THROW(vector_hist.GetFluidCell(hist.ntau - 1, hist.nx - 1,
+                                          hist.ny - 1, hist.neta - 1, cell),
+                 std::out_of_range);
+}
+
+// reference interpolation through the generic templates on FluidCellInfo
+FluidCellInfo generic_interpolation(const EvolutionHistory &hist, real tau,
+                                    real x, real y, real eta) {
+    int id_tau = hist.GetIdTau(tau);
+    return LinearInt(hist.TauCoord(id_tau), hist.TauCoord(id_tau + 1),
+                     hist.GetAtTimeStep(id_tau, x, y, eta),
+                     hist.GetAtTimeStep(id_tau + 1, x, y, eta), tau);
+}
+
+// test the 4D interpolation kernel against the generic templates
+TEST(EvolutionHistoryTest, TEST_INTERPOLATION_KERNEL){
+    auto hist = EvolutionHistory();
+    fill_test_history(hist);
+    const int n_points = 4;
+    real tau[n_points] = {0.6, 0.83, 0.97, 1.0};
+    real x[n_points] = {-2.0, 0.12, 1.3, 2.0};
+    real y[n_points] = {0.3, -0.4, 1.1, 2.0};
+    real eta[n_points] = {0.2, 0.7, -1.9, 2.0};
+    for (int i = 0; i < n_points; i++) {
+        auto cell = hist.get(tau[i], x[i], y[i], eta[i]);
+        auto reference = generic_interpolation(hist, tau[i], x[i], y[i],
+                                               eta[i]);
+        EXPECT_NEAR(cell.energy_density, reference.energy_density, 1e-5);
+        EXPECT_NEAR(cell.temperature, reference.temperature, 1e-6);
+        EXPECT_NEAR(cell.mu_B, reference.mu_B, 1e-6);
+        EXPECT_NEAR(cell.vx, reference.vx, 1e-6);
+        EXPECT_NEAR(cell.pi[2][1], reference.pi[2][1], 1e-6);
+        EXPECT_NEAR(cell.bulk_Pi, reference.bulk_Pi, 1e-6);
+    }
+
+    // boost invariant history with a single eta slice
+    auto hist_2d = EvolutionHistory();
+    fill_test_history(hist_2d);
+    hist_2d.clear_up_evolution_data();
+    hist_2d.neta = 1;
+    hist_2d.eta_min = 0.0;
+    hist_2d.boost_invariant = true;
+    for (int n = 0; n != hist.ntau; n++)
+        for (int i = 0; i != hist.nx; i++)
+            for (int j = 0; j != hist.ny; j++)
+                hist_2d.AddCell(hist.GetFluidCell(n, i, j, 4));
+    auto cell = hist_2d.get(0.74, 0.33, -1.2, 3.0);
+    auto reference = generic_interpolation(hist_2d, 0.74, 0.33, -1.2, 3.0);
+    EXPECT_NEAR(cell.energy_density, reference.energy_density, 1e-5);
+    EXPECT_NEAR(cell.temperature, reference.temperature, 1e-6);
+    EXPECT_NEAR(cell.vx, reference.vx, 1e-6);
+}
+
+// the surface cells do not depend on the number of threads
+void compare_surfaces(const EvolutionHistory &hist, real T_cut) {
+    SurfaceFinder serial(T_cut, hist, 1);
+    serial.Find_full_hypersurface();
+    SurfaceFinder parallel(T_cut, hist, 3);
+    parallel.Find_full_hypersurface();
+
+    auto cells = serial.get_surface_cells_vector();
+    auto parallel_cells = parallel.get_surface_cells_vector();
+    ASSERT_GT(cells.size(), 0u);
+    ASSERT_EQ(cells.size(), parallel_cells.size());
+    for (unsigned int i = 0; i < cells.size(); i++) {
+        EXPECT_EQ(cells[i].tau, parallel_cells[i].tau);
+        EXPECT_EQ(cells[i].x, parallel_cells[i].x);
+        EXPECT_EQ(cells[i].y, parallel_cells[i].y);
+        EXPECT_EQ(cells[i].eta, parallel_cells[i].eta);
+        EXPECT_EQ(cells[i].d3sigma_mu[0], parallel_cells[i].d3sigma_mu[0]);
+        EXPECT_EQ(cells[i].d3sigma_mu[3], parallel_cells[i].d3sigma_mu[3]);
+        EXPECT_NEAR(cells[i].temperature, T_cut, 0.01);
+    }
+}
+
+TEST(SurfaceFinderTest, TEST_THREADS_3D){
+    auto hist = EvolutionHistory();
+    hist.tau_min = 0.6;
+    hist.dtau = 0.1;
+    hist.x_min = -3;
+    hist.y_min = -3;
+    hist.eta_min = 0;
+    hist.dx = 0.25;
+    hist.dy = 0.25;
+    hist.deta = 0.1;
+    hist.ntau = 11;
+    hist.nx = 25;
+    hist.ny = 25;
+    hist.neta = 1;
+    hist.tau_eta_is_tz = false;
+    hist.boost_invariant = true;
+    for (int n=0; n != hist.ntau; n++)
+        for (int i=0; i != hist.nx; i++)
+            for (int j=0; j != hist.ny; j++) {
+                real x = hist.XCoord(i);
+                real y = hist.YCoord(j);
+                auto cell = FluidCellInfo();
+                cell.temperature = 0.3 - 0.04 * std::sqrt(x*x + y*y) - 0.05*n;
+                hist.AddCell(cell);
+            }
+    compare_surfaces(hist, 0.2);
+}
+
+TEST(SurfaceFinderTest, TEST_THREADS_4D){
+    auto hist = EvolutionHistory();
+    fill_test_history(hist);
+    compare_surfaces(hist, 0.28);
+}
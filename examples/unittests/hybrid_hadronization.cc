@@ -0,0 +1,162 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "HybridHadronization.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// compares the thermal partners found in the cells of bin_thermal with the
+// distance cuts of recomb applied to all thermal partons
+class HybridHadronizationTest : public ::testing::Test {
+protected:
+    typedef HybridHadronization::HHparton HHparton;
+
+    HybridHadronization hadronization;
+    HybridHadronization::parton_collection showerquarks;
+    std::vector<int> perm2;
+    std::mt19937 generator;
+
+    HHparton random_parton(double t_min, double t_max, double size) {
+        std::uniform_real_distribution<double> time(t_min, t_max);
+        std::uniform_real_distribution<double> position(-size, size);
+        std::uniform_real_distribution<double> momentum(-1.0, 1.0);
+        HHparton parton;
+        parton.id(1);
+        parton.pos(FourVector(position(generator), position(generator),
+                              position(generator), time(generator)));
+        double px = momentum(generator);
+        double py = momentum(generator);
+        double pz = momentum(generator);
+        parton.P(FourVector(px, py, pz,
+                            std::sqrt(px*px + py*py + pz*pz + 0.09)));
+        return parton;
+    }
+
+    void fill(int n_shower, int n_thermal, double size, double dist2cut) {
+        hadronization.dist2cut = dist2cut;
+        showerquarks.clear();
+        hadronization.HH_thermal.clear();
+        perm2.clear();
+        for (int i = 0; i < n_shower; i++) {
+            showerquarks.add(random_parton(0.5, 3.0, size));
+            perm2.push_back(i + 1);
+        }
+        for (int i = 0; i < n_thermal; i++) {
+            hadronization.HH_thermal.add(random_parton(0.5, 3.0, size));
+            perm2.push_back(-(i + 1));
+        }
+        std::shuffle(perm2.begin(), perm2.end(), generator);
+        hadronization.bin_thermal(showerquarks, perm2.data());
+    }
+
+    // position of the parton moved along p/e to time t
+    static FourVector moved(HHparton &parton, double t) {
+        FourVector pos = parton.pos();
+        double dt_E = (t - pos.t()) / parton.e();
+        return FourVector(pos.x() + parton.px() * dt_E,
+                          pos.y() + parton.py() * dt_E,
+                          pos.z() + parton.pz() * dt_E, 0.);
+    }
+
+    // the cut of recomb for a thermal second quark
+    bool passes_cut(HHparton &q1, HHparton &thermal) {
+        double t = std::max(q1.pos().t(), thermal.pos().t());
+        return (HybridHadronization::dif2(moved(q1, t), moved(thermal, t)) <=
+                hadronization.dist2cut);
+    }
+
+    // the cut of recomb for a thermal third quark
+    bool passes_cut(HHparton &q1, HHparton &q2, HHparton &thermal) {
+        double t = std::max(std::max(q1.pos().t(), q2.pos().t()),
+                            thermal.pos().t());
+        FourVector pos1 = moved(q1, t);
+        FourVector pos2 = moved(q2, t);
+        FourVector pos3 = moved(thermal, t);
+        double cut = hadronization.dist2cut;
+        return (HybridHadronization::dif2(pos3, pos1) <= cut &&
+                HybridHadronization::dif2(pos3, pos2) <= cut &&
+                HybridHadronization::dif2(pos1, pos2) <= cut);
+    }
+
+    bool cells_used() const { return (hadronization.thermcell_use); }
+    int n_thermal() { return (hadronization.HH_thermal.num()); }
+
+    int n_partners_of_first_quark() {
+        std::vector<int> partners;
+        hadronization.near_thermal(showerquarks[0].pos(),
+                                   showerquarks[0].pos().t(), partners);
+        return (partners.size());
+    }
+
+    // checks all queries of recomb, returns the average number of partners
+    double compare_with_brute_force() {
+        int n_partners = 0;
+        int n_queries = 0;
+        std::vector<int> partners;
+        for (int i = 0; i < showerquarks.num(); i++) {
+            HHparton &q1 = showerquarks[i];
+            for (int j = -1; j < showerquarks.num(); j++) {
+                if (j == i)
+                    continue;
+                HHparton &q2 = (j < 0) ? q1 : showerquarks[j];
+                hadronization.near_thermal(q1.pos(), q2.pos().t(), partners);
+                EXPECT_TRUE(std::is_sorted(partners.begin(), partners.end()));
+                n_partners += partners.size();
+                n_queries++;
+                for (int k : partners) {
+                    EXPECT_LT(perm2[k], 0);
+                }
+                for (int k = 0; k < static_cast<int>(perm2.size()); k++) {
+                    if (perm2[k] > 0)
+                        continue;
+                    HHparton &thermal = hadronization.HH_thermal[-(perm2[k] + 1)];
+                    bool passes = (j < 0) ? passes_cut(q1, thermal)
+                                          : passes_cut(q1, q2, thermal);
+                    if (passes) {
+                        EXPECT_TRUE(std::binary_search(partners.begin(),
+                                                       partners.end(), k))
+                            << "thermal parton " << k << " is missed";
+                    }
+                }
+            }
+        }
+        return (static_cast<double>(n_partners) / n_queries);
+    }
+};
+
+// no parton passing the cuts is missed, and the cells leave most out
+TEST_F(HybridHadronizationTest, TEST_NEAR_THERMAL){
+    generator.seed(11);
+    fill(20, 2000, 6.0, 0.64);
+    EXPECT_TRUE(cells_used());
+    double average = compare_with_brute_force();
+    EXPECT_LT(average, 0.5 * n_thermal());
+
+    // a dense medium with partners in many cells
+    fill(10, 3000, 2.0, 0.8);
+    compare_with_brute_force();
+}
+
+// without the cells all thermal partons are returned
+TEST_F(HybridHadronizationTest, TEST_NEAR_THERMAL_NO_CELLS){
+    generator.seed(12);
+    fill(5, 100, 3.0, 0.0);
+    EXPECT_FALSE(cells_used());
+    EXPECT_EQ(100, n_partners_of_first_quark());
+    compare_with_brute_force();
+}
@@ -0,0 +1,150 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "Hydroinfo_h5.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+
+// a small VISHNew style file, every field is linear in tau, x and y so the
+// interpolation gives it back exactly
+static const int XL = -6, XH = 4, YL = -3, YH = 5, n_frames = 7;
+static const double DX = 0.5, DY = 0.25, Tau0 = 0.6, dTau = 0.2;
+
+static const char *field_names[] = {"e", "s", "Vx", "Vy", "Temp", "P",
+                                    "Pi00", "Pi01", "Pi02", "Pi03", "Pi11",
+                                    "Pi12", "Pi13", "Pi22", "Pi23", "Pi33",
+                                    "BulkPi"};
+static const int n_fields = 17;
+
+static double field_value(int field, double tau, double x, double y) {
+    return (1. + field + 0.3 * field * tau - 0.1 * x + 0.02 * (field + 1) * y);
+}
+
+static void add_attribute(hid_t id, const char *name, hid_t type,
+                          const void *value) {
+    hsize_t dims = 1;
+    hid_t space_id = H5Screate_simple(1, &dims, NULL);
+    hid_t attribute_id = H5Acreate(id, name, type, space_id, H5P_DEFAULT,
+                                   H5P_DEFAULT);
+    H5Awrite(attribute_id, type, value);
+    H5Aclose(attribute_id);
+    H5Sclose(space_id);
+}
+
+static void write_hydro_file(const std::string &file_name) {
+    hid_t file_id = H5Fcreate(file_name.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT,
+                              H5P_DEFAULT);
+    hid_t event_id = H5Gcreate(file_id, "/Event", H5P_DEFAULT, H5P_DEFAULT,
+                               H5P_DEFAULT);
+    int ints[] = {XL, XH, YL, YH, 1};
+    const char *int_names[] = {"XL", "XH", "YL", "YH", "OutputViscousFlag"};
+    for (int i = 0; i < 5; i++)
+        add_attribute(event_id, int_names[i], H5T_NATIVE_INT, &ints[i]);
+    double doubles[] = {DX, DY, Tau0, dTau};
+    const char *double_names[] = {"DX", "DY", "Tau0", "dTau"};
+    for (int i = 0; i < 4; i++)
+        add_attribute(event_id, double_names[i], H5T_NATIVE_DOUBLE,
+                      &doubles[i]);
+
+    const int nx = XH - XL + 1;
+    const int ny = YH - YL + 1;
+    hsize_t dims[2] = {(hsize_t)nx, (hsize_t)ny};
+    std::vector<double> data(nx * ny);
+    for (int frame = 0; frame < n_frames; frame++) {
+        std::ostringstream frame_name;
+        frame_name << "Frame_" << std::setw(4) << std::setfill('0') << frame;
+        hid_t frame_id = H5Gcreate(event_id, frame_name.str().c_str(),
+                                   H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        for (int f = 0; f < n_fields; f++) {
+            for (int i = 0; i < nx; i++)
+                for (int j = 0; j < ny; j++)
+                    data[i * ny + j] = field_value(f, Tau0 + frame * dTau,
+                                                   (XL + i) * DX,
+                                                   (YL + j) * DY);
+            hid_t space_id = H5Screate_simple(2, dims, NULL);
+            hid_t dataset_id = H5Dcreate(frame_id, field_names[f],
+                                         H5T_NATIVE_DOUBLE, space_id,
+                                         H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+            H5Dwrite(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL,
+                     H5P_DEFAULT, data.data());
+            H5Dclose(dataset_id);
+            H5Sclose(space_id);
+        }
+        H5Gclose(frame_id);
+    }
+    H5Gclose(event_id);
+    H5Fclose(file_id);
+}
+
+static void check_cell(const hydrofluidCell &cell, double tau, double x,
+                       double y, bool viscous) {
+    EXPECT_NEAR(field_value(0, tau, x, y), cell.ed, 1e-10);
+    EXPECT_NEAR(field_value(1, tau, x, y), cell.sd, 1e-10);
+    EXPECT_NEAR(field_value(2, tau, x, y), cell.vx, 1e-10);
+    EXPECT_NEAR(field_value(3, tau, x, y), cell.vy, 1e-10);
+    EXPECT_NEAR(field_value(4, tau, x, y), cell.temperature, 1e-10);
+    EXPECT_NEAR(field_value(5, tau, x, y), cell.pressure, 1e-10);
+    double pi00 = viscous ? field_value(6, tau, x, y) : 0.;
+    double pi23 = viscous ? field_value(14, tau, x, y) : 0.;
+    double bulk = viscous ? field_value(16, tau, x, y) : 0.;
+    EXPECT_NEAR(pi00, cell.pi[0][0], 1e-10);
+    EXPECT_NEAR(pi23, cell.pi[2][3], 1e-10);
+    EXPECT_NEAR(pi23, cell.pi[3][2], 1e-10);
+    EXPECT_NEAR(bulk, cell.bulkPi, 1e-10);
+}
+
+static void read_and_check(int viscous) {
+    std::string file_name = "hydroinfo_h5_test.h5";
+    write_hydro_file(file_name);
+    HydroinfoH5 hydro(file_name, 500, viscous);
+    std::remove(file_name.c_str());
+
+    EXPECT_EQ(n_frames, hydro.getNumberofFrames());
+    EXPECT_DOUBLE_EQ(Tau0 + (n_frames - 1) * dTau, hydro.getHydrogridTaumax());
+    EXPECT_DOUBLE_EQ(XL * DX, hydro.getHydrogridX0());
+    EXPECT_DOUBLE_EQ(YH * DY, hydro.getHydrogridYmax());
+
+    hydrofluidCell cell;
+    hydro.getHydroinfoOnlattice(3, 2, 5, &cell);
+    check_cell(cell, Tau0 + 3 * dTau, (XL + 2) * DX, (YL + 5) * DY,
+               viscous == 1);
+    hydro.getHydroinfoOnlattice(n_frames - 1, XH - XL, YH - YL, &cell);
+    check_cell(cell, Tau0 + (n_frames - 1) * dTau, XH * DX, YH * DY,
+               viscous == 1);
+
+    for (int k = 0; k < 50; k++) {
+        double tau = Tau0 + 0.0231 * k;
+        double x = XL * DX + 0.0917 * k;
+        double y = YL * DY + 0.0373 * k;
+        hydro.getHydroinfo(tau, x, y, &cell);
+        check_cell(cell, tau, x, y, viscous == 1);
+    }
+
+    // outside of the grid the medium is empty
+    hydro.getHydroinfo(Tau0 + 0.1, XH * DX + 0.1, 0., &cell);
+    EXPECT_EQ(0., cell.ed);
+    EXPECT_EQ(0., cell.temperature);
+}
+
+TEST(HydroinfoH5Test, TEST_IDEAL){
+    read_and_check(0);
+}
+
+TEST(HydroinfoH5Test, TEST_VISCOUS){
+    read_and_check(1);
+}
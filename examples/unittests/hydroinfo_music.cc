@@ -0,0 +1,145 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "Hydroinfo_MUSIC.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+
+static const std::string input_file = "hydroinfo_music_test_input";
+static const std::string evolution_file = "hydroinfo_music_test_evo.dat";
+
+static void write_input(int shear, int bulk) {
+    std::ofstream out(input_file.c_str());
+    out << "Initial_time_tau_0 0.6\n"
+        << "Delta_Tau 0.02\n"
+        << "X_grid_size_in_fm 10\n"
+        << "Grid_size_in_x 21\n"
+        << "Eta_grid_size 1\n"
+        << "Grid_size_in_eta 1\n"
+        << "output_evolution_every_N_timesteps 5\n"
+        << "output_evolution_every_N_x 1\n"
+        << "output_evolution_every_N_eta 1\n"
+        << "Include_Rhob_Yes_1_No_0 0\n"
+        << "Include_Shear_Visc_Yes_1_No_0 " << shear << "\n"
+        << "Include_Bulk_Visc_Yes_1_No_0 " << bulk << "\n"
+        << "turn_on_baryon_diffusion 0\n";
+}
+
+// the evolution of the boost invariant modes, n_eta slices of 20 x 20
+// cells for every tau frame, the last frame is cut short
+template <class T> static void write_evolution_2D(int n_eta) {
+    std::ofstream out(evolution_file.c_str(), std::ios::binary);
+    int n_records = (12 * n_eta + 1) * 400 - 150;
+    for (int ik = 0; ik < n_records; ik++) {
+        int itau = ik / (400 * n_eta);
+        int ieta = (ik / 400) % n_eta;
+        int ixy = ik % 400;
+        T record[5] = {T(0.4 - 0.01 * itau - 0.0005 * ixy + 0.1 * ieta), T(1),
+                       T(0.2 * std::sin(0.1 * ixy + itau)),
+                       T(0.2 * std::cos(0.07 * ixy)), T(0.01 * ieta)};
+        out.write(reinterpret_cast<const char *>(record), sizeof(record));
+    }
+}
+
+static void compare_2D(int mode, int nskip_tau) {
+    Hydroinfo_MUSIC read;
+    read.readHydroData(mode, nskip_tau, input_file, evolution_file, "", "");
+    Hydroinfo_MUSIC mapped;
+    mapped.set_use_mmap(true);
+    mapped.readHydroData(mode, nskip_tau, input_file, evolution_file, "", "");
+    EXPECT_FALSE(read.is_mapped());
+    ASSERT_TRUE(mapped.is_mapped());
+    EXPECT_DOUBLE_EQ(read.get_hydro_tau_max(), mapped.get_hydro_tau_max());
+    EXPECT_DOUBLE_EQ(read.get_hydro_dtau(), mapped.get_hydro_dtau());
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> u(0., 1.);
+    hydrofluidCell a, b;
+    double tau_range = read.get_hydro_tau_max() - read.get_hydro_tau0();
+    for (int i = 0; i < 500; i++) {
+        double tau = read.get_hydro_tau0() + tau_range * u(rng);
+        double x = -5. + 9.4 * u(rng);
+        double y = -5. + 9.4 * u(rng);
+        double z = 0.1 * tau * (u(rng) - 0.5);
+        double t = std::sqrt(tau * tau + z * z);
+        read.getHydroValues(x, y, z, t, &a);
+        mapped.getHydroValues(x, y, z, t, &b);
+        EXPECT_NEAR(a.temperature, b.temperature, 1e-12);
+        EXPECT_NEAR(a.vx, b.vx, 1e-12);
+        EXPECT_NEAR(a.vy, b.vy, 1e-12);
+        EXPECT_NEAR(a.vz, b.vz, 1e-12);
+        EXPECT_NEAR(a.pi[1][2], b.pi[1][2], 1e-12);
+        EXPECT_NEAR(a.bulkPi, b.bulkPi, 1e-12);
+    }
+    mapped.clean_hydro_event();
+    EXPECT_FALSE(mapped.is_mapped());
+}
+
+TEST(HydroinfoMUSICTest, TEST_MAPPED_2D){
+    write_input(0, 0);
+    write_evolution_2D<float>(2);
+    compare_2D(8, 1);
+    compare_2D(8, 2);
+    write_evolution_2D<double>(1);
+    compare_2D(9, 1);
+    compare_2D(9, 3);
+    std::remove(input_file.c_str());
+    std::remove(evolution_file.c_str());
+}
+
+TEST(HydroinfoMUSICTest, TEST_MAPPED_3D){
+    write_input(1, 1);
+    std::ofstream out(evolution_file.c_str(), std::ios::binary);
+    for (int ik = 0; ik < 1000; ik++) {
+        int idx[4] = {ik / 100, ik % 10, (ik / 10) % 10, ik % 3};
+        double values[10];
+        for (int i = 0; i < 10; i++)
+            values[i] = 0.01 * ik + 0.1 * i;
+        out.write(reinterpret_cast<const char *>(idx), sizeof(idx));
+        out.write(reinterpret_cast<const char *>(values), sizeof(values));
+    }
+    out.close();
+
+    Hydroinfo_MUSIC read;
+    read.readHydroData(10, 1, input_file, evolution_file, "", "");
+    Hydroinfo_MUSIC mapped;
+    mapped.set_use_mmap(true);
+    mapped.readHydroData(10, 1, input_file, evolution_file, "", "");
+    ASSERT_TRUE(mapped.is_mapped());
+    ASSERT_EQ(1000, read.get_number_of_fluid_cells_3d());
+    ASSERT_EQ(1000, mapped.get_number_of_fluid_cells_3d());
+    EXPECT_DOUBLE_EQ(read.get_hydro_tau_max(), mapped.get_hydro_tau_max());
+
+    fluidCell_3D_new a, b;
+    for (int i = 0; i < 1000; i++) {
+        read.get_hydro_cell_info_3d(i, &a);
+        mapped.get_hydro_cell_info_3d(i, &b);
+        EXPECT_EQ(a.itau, b.itau);
+        EXPECT_EQ(a.ix, b.ix);
+        EXPECT_EQ(a.ieta, b.ieta);
+        EXPECT_EQ(a.temperature, b.temperature);
+        EXPECT_EQ(a.ueta, b.ueta);
+        EXPECT_EQ(a.pi11, b.pi11);
+        EXPECT_EQ(a.pi23, b.pi23);
+        EXPECT_EQ(a.bulkPi, b.bulkPi);
+    }
+    std::remove(input_file.c_str());
+    std::remove(evolution_file.c_str());
+}
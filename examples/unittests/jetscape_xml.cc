@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ * 
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "JetScapeXML.h"
+#include "ThreadPool.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+using namespace Jetscape;
+
+TEST(JetScapeXMLTest, TEST_CACHED_PARAMETERS){
+    std::string master_name = "jetscape_xml_test_master.xml";
+    std::string user_name = "jetscape_xml_test_user.xml";
+    std::ofstream(master_name)
+        << "<jetscape>\n"
+        << "  <nEvents> 10 </nEvents>\n"
+        << "  <Eloss> <Matter> <Q0> 1.0 </Q0> <name>Matter</name> </Matter>"
+        << "  <nThreads>1</nThreads> </Eloss>\n"
+        << "</jetscape>\n";
+    std::ofstream(user_name)
+        << "<jetscape>\n"
+        << "  <Eloss> <Matter> <Q0> 2.5 </Q0> </Matter> </Eloss>\n"
+        << "</jetscape>\n";
+
+    auto xml = JetScapeXML::Instance();
+    xml->OpenXMLMasterFile(master_name);
+    xml->OpenXMLUserFile(user_name);
+
+    // the user file overrides the master file
+    EXPECT_EQ(10, xml->GetElementInt({"nEvents"}));
+    EXPECT_DOUBLE_EQ(2.5, xml->GetElementDouble({"Eloss", "Matter", "Q0"}));
+    EXPECT_EQ("Matter", xml->GetElementText({"Eloss", "Matter", "name"}));
+    EXPECT_EQ(1, xml->GetElementInt({"Eloss", "nThreads"}));
+    EXPECT_TRUE(xml->GetElement({"Eloss", "Matter"}) != nullptr);
+
+    // missing optional elements give zero, also when asked for again
+    for (int i = 0; i < 2; i++) {
+        EXPECT_EQ(0, xml->GetElementInt({"Eloss", "Matter", "Missing"}, false));
+        EXPECT_EQ(0., xml->GetElementDouble({"Eloss", "Matter", "Missing"}, false));
+        EXPECT_EQ("", xml->GetElementText({"Eloss", "Matter", "Missing"}, false));
+        EXPECT_TRUE(xml->GetElement({"Eloss", "Matter", "Missing"}, false) == nullptr);
+    }
+
+    // concurrent lookups agree with the serial ones
+    ThreadPool pool(4);
+    std::vector<double> values(200, 0.);
+    pool.ParallelFor(values.size(), [&](int i) {
+        if (i % 2)
+            values[i] = xml->GetElementDouble({"Eloss", "Matter", "Q0"});
+        else
+            values[i] = xml->GetElementInt({"nEvents"});
+    });
+    for (unsigned int i = 0; i < values.size(); i++) {
+        EXPECT_EQ(i % 2 ? 2.5 : 10., values[i]);
+    }
+
+    std::remove(master_name.c_str());
+    std::remove(user_name.c_str());
+}
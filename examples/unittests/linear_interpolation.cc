@@ -26,3 +26,36 @@ TEST(LinearInterpolationTest, TEST_TRUE){
 TEST(LinearInterpolationTest, TEST_INT){
     EXPECT_EQ(0, LinearInt(0.0, 1.0, 0, 1, 0.5));
 }
+
+// the 4D kernel reproduces a multilinear function exactly
+TEST(LinearInterpolationTest, TEST_QUADRILINEAR){
+    real t = 0.3, u = 0.8, v = 0.55, w = 0.1;
+    real weights[16];
+    QuadrilinearWeights(t, u, v, w, weights);
+    real sum = 0;
+    for (int c = 0; c < 16; c++) sum += weights[c];
+    EXPECT_FLOAT_EQ(1.0, sum);
+
+    // two fields: f = 1 + 2t - u + 0.5vw and g = t*u*v*w
+    real corner_values[32];
+    for (int c = 0; c < 16; c++) {
+        real ct = (c >> 3) & 1, cu = (c >> 2) & 1, cv = (c >> 1) & 1;
+        real cw = c & 1;
+        corner_values[c] = 1 + 2*ct - cu + 0.5*cv*cw;
+        corner_values[16 + c] = ct*cu*cv*cw;
+    }
+    real result[2];
+    QuadrilinearInt(weights, 2, corner_values, result);
+    EXPECT_FLOAT_EQ(1 + 2*t - u + 0.5*v*w, result[0]);
+    EXPECT_FLOAT_EQ(t*u*v*w, result[1]);
+
+    // same as TrilinearInt on the lower face along the first axis
+    QuadrilinearWeights(0.0, u, v, w, weights);
+    QuadrilinearInt(weights, 1, corner_values, result);
+    EXPECT_FLOAT_EQ(TrilinearInt(0.0, 1.0, 0.0, 1.0, 0.0, 1.0,
+                                 corner_values[0], corner_values[1],
+                                 corner_values[2], corner_values[3],
+                                 corner_values[4], corner_values[5],
+                                 corner_values[6], corner_values[7],
+                                 u, v, w), result[0]);
+}
@@ -0,0 +1,75 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ * 
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "JetScapeLogger.h"
+#include "ThreadPool.h"
+#include "gtest/gtest.h"
+
+#include <iomanip>
+#include <string>
+
+using namespace Jetscape;
+
+static int count_calls(int &n_calls) { return ++n_calls; }
+
+// disabled messages do not evaluate their arguments
+TEST(JetScapeLoggerTest, TEST_DISABLED){
+    auto logger = JetScapeLogger::Instance();
+    logger->SetVerboseLevel(2);
+    logger->SetDebug(false);
+    int n_calls = 0;
+    VERBOSE(5) << count_calls(n_calls);
+    JSDEBUG << count_calls(n_calls);
+    EXPECT_EQ(0, n_calls);
+
+    std::ostringstream output;
+    auto cout_buffer = std::cout.rdbuf(output.rdbuf());
+    VERBOSE(1) << count_calls(n_calls);
+    // the macros can be used in an unbraced if else
+    if (n_calls == 1)
+        VERBOSE(5) << "not printed";
+    else
+        n_calls = -1;
+    std::cout.rdbuf(cout_buffer);
+    EXPECT_EQ(1, n_calls);
+    EXPECT_NE(std::string::npos, output.str().find("[Verbose][1]"));
+    logger->SetVerboseLevel(0);
+}
+
+// the lines of concurrent threads are not mixed and the format of a
+// message does not leak into the next one
+TEST(JetScapeLoggerTest, TEST_THREADS){
+    std::ostringstream output;
+    auto cout_buffer = std::cout.rdbuf(output.rdbuf());
+    ThreadPool pool(4);
+    pool.ParallelFor(400, [](int i) {
+        JSINFO << "job " << i << " " << std::setprecision(2) << 3.14159
+               << " end";
+        JSINFO << "job " << i << " " << 3.14159 << " end";
+    });
+    std::cout.rdbuf(cout_buffer);
+
+    std::istringstream lines(output.str());
+    std::string line;
+    int n_short = 0, n_long = 0;
+    while (std::getline(lines, line)) {
+        EXPECT_EQ(0u, line.find("[Info] "));
+        EXPECT_NE(std::string::npos, line.find(" end"));
+        if (line.find(" 3.1 end") != std::string::npos) n_short++;
+        if (line.find(" 3.14159 end") != std::string::npos) n_long++;
+    }
+    EXPECT_EQ(400, n_short);
+    EXPECT_EQ(400, n_long);
+}
@@ -0,0 +1,124 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "Matter.h"
+#include "SudakovTable.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace Jetscape;
+
+// exponent log(t/t1) / t0 per channel, so that the tables are exact in u
+static double power_law(int channel, double t0, double t1, double t2) {
+    return ((channel + 1) * std::log(t2 / t1) / t0);
+}
+
+// check the interpolation and the inversion on a known exponent
+TEST(SudakovTableTest, TEST_INVERSION){
+    SudakovTable table;
+    table.Build(2, power_law, 1.0, 4.0, 3, 1.0e4, 101);
+
+    EXPECT_FALSE(table.InRange(0.5, 10.));
+    EXPECT_FALSE(table.InRange(2.0, 3.));
+    EXPECT_TRUE(table.InRange(2.0, 100.));
+    EXPECT_FALSE(table.InRange(1.0, 1.0e5));
+
+    EXPECT_NEAR(std::log(50.), table.Exponent(0, 1.0, 100.), 1e-12);
+    EXPECT_NEAR(2. * std::log(50.) / 4., table.Exponent(1, 4.0, 400.), 1e-12);
+
+    std::vector<double> weights = {1.0, 0.5};
+    for (double t : {2.5, 17., 300., 4000.}) {
+        double exponent = table.Exponent(weights, 1.0, t);
+        EXPECT_NEAR(2. * std::log(t / 2.), exponent, 1e-12);
+        EXPECT_NEAR(t, table.Invert(weights, 1.0, exponent), 1e-9 * t);
+    }
+    // between two rows in t0 the inversion stays consistent
+    for (double t : {5., 80., 900.}) {
+        double exponent = table.Exponent(weights, 1.5, t);
+        EXPECT_NEAR(t, table.Invert(weights, 1.5, exponent), 1e-9 * t);
+    }
+    EXPECT_DOUBLE_EQ(2.0, table.Invert(weights, 1.0, -1.));
+}
+
+// check that a table read from a file is the one written
+TEST(SudakovTableTest, TEST_FILE){
+    SudakovTable table;
+    table.Build(2, power_law, 1.0, 4.0, 3, 1.0e4, 101);
+    std::string file_name = "sudakov_table_test.dat";
+    ASSERT_TRUE(table.Write(file_name));
+
+    SudakovTable other_grid;
+    EXPECT_FALSE(other_grid.Read(file_name, 2, 1.0, 4.0, 3, 1.0e4, 51));
+    EXPECT_FALSE(other_grid.IsFilled());
+
+    SudakovTable read;
+    ASSERT_TRUE(read.Read(file_name, 2, 1.0, 4.0, 3, 1.0e4, 101));
+    for (double t : {3., 60., 700.}) {
+        EXPECT_EQ(table.Exponent(1, 2.0, t), read.Exponent(1, 2.0, t));
+    }
+    std::remove(file_name.c_str());
+}
+
+// compare the tabulated Sudakov factors with the integrals of MATTER
+TEST(SudakovTableTest, TEST_MATTER_ACCURACY){
+    Matter matter;
+    matter.in_vac = true;
+    double loc = 0.0;
+    double E = 100.0;
+
+    std::vector<double> ts = {1.5, 1.7, 4.0, 12.0, 55.0, 230.0,
+                              1.0e3, 4.5e3, 2.0e4, 1.0e5};
+    std::vector<double> t0s = {0.405, 0.3, 0.7};
+    std::vector<std::vector<double>> integrals;
+    for (double t0 : t0s) {
+        for (double t : ts) {
+            integrals.push_back({matter.sudakov_Pgg(t0, t, loc, E),
+                                 matter.sudakov_Pqq(t0, t, loc, E),
+                                 matter.sudakov_Pqg(t0, t, loc, E),
+                                 matter.sudakov_Pqp(t0, t, loc, E)});
+        }
+    }
+
+    matter.InitSudakovTable("");
+    ASSERT_TRUE(matter.sudakov_table != nullptr);
+    int n = 0;
+    for (double t0 : t0s) {
+        for (double t : ts) {
+            EXPECT_TRUE(matter.UseSudakovTable(t0, t, loc));
+            std::vector<double> tabulated = {
+                matter.sudakov_Pgg(t0, t, loc, E),
+                matter.sudakov_Pqq(t0, t, loc, E),
+                matter.sudakov_Pqg(t0, t, loc, E),
+                matter.sudakov_Pqp(t0, t, loc, E)};
+            for (int channel = 0; channel < 4; channel++) {
+                // the integrals themselves are adaptive to about 1e-3
+                EXPECT_NEAR(integrals[n][channel], tabulated[channel],
+                            2e-3 * integrals[n][channel])
+                    << "channel " << channel << " t0 = " << t0
+                    << " t = " << t;
+            }
+            n++;
+        }
+    }
+
+    // the medium-induced part is not tabulated
+    matter.in_vac = false;
+    matter.length = 10.0;
+    EXPECT_FALSE(matter.UseSudakovTable(0.405, 100., loc));
+    EXPECT_TRUE(matter.UseSudakovTable(0.405, 100., 11.0));
+}
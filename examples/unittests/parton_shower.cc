@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "PartonShower.h"
+#include "JetScapeParticles.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace Jetscape;
+
+// build a chain of splittings 0 -> 1 -> 2 ... and check the indexed access
+TEST(PartonShowerTest, TEST_INDEXED_ACCESS){
+    auto shower = std::make_shared<PartonShower>();
+    const int n_partons = 1000;
+
+    std::vector<node> vertices;
+    vertices.push_back(shower->new_vertex(Vertex(0, 0, 0, 0)));
+    for (int i = 0; i < n_partons; i++) {
+        vertices.push_back(shower->new_vertex(Vertex(0, 0, 0, i + 1.)));
+        Parton p(i, 21, 0, 10. + i, 0.1, 0.2, 20. + i);
+        int edgeid = shower->new_parton(vertices[i], vertices[i + 1], p);
+        EXPECT_EQ(i, edgeid);
+    }
+    // a parton shared with the caller
+    auto extra = std::make_shared<Parton>(-1, 1, 0, 5., 0., 0., 6.);
+    vertices.push_back(shower->new_vertex(std::make_shared<Vertex>()));
+    shower->new_parton(vertices[0], vertices.back(), extra);
+
+    ASSERT_EQ(n_partons + 1, shower->GetNumberOfPartons());
+    ASSERT_EQ(n_partons + 2, shower->GetNumberOfVertices());
+    for (int i = 0; i < n_partons; i++) {
+        EXPECT_EQ(i, shower->GetPartonAt(i)->plabel());
+        EXPECT_EQ(i, shower->GetEdgeAt(i).id());
+        EXPECT_EQ(shower->GetPartonAt(i), shower->GetParton(shower->GetEdgeAt(i)));
+        EXPECT_EQ(i, shower->GetPartonSource(i));
+        EXPECT_EQ(i + 1, shower->GetPartonTarget(i));
+        EXPECT_DOUBLE_EQ(i + 1., shower->GetVertexAt(i + 1)->x_in().t());
+        EXPECT_EQ(vertices[i + 1], shower->GetNodeAt(i + 1));
+    }
+    EXPECT_EQ(extra, shower->GetPartonAt(n_partons));
+    EXPECT_EQ(n_partons + 1, shower->GetPartonTarget(n_partons));
+    EXPECT_EQ(1, shower->GetNumberOfChilds(0));
+    EXPECT_EQ(0, shower->GetNumberOfChilds(n_partons - 1));
+    EXPECT_EQ(1, shower->GetNumberOfParents(1));
+
+    // the final partons are the ends of the chain and the extra parton
+    auto final_partons = shower->GetFinalPartons();
+    ASSERT_EQ(2u, final_partons.size());
+}
+
+// partons handed out stay valid after the shower is cleared
+TEST(PartonShowerTest, TEST_CLEAR){
+    auto shower = std::make_shared<PartonShower>();
+    node v0 = shower->new_vertex(Vertex());
+    node v1 = shower->new_vertex(Vertex(1, 2, 3, 4));
+    shower->new_parton(v0, v1, Parton(7, 2, 0, 3., 0., 0., 4.));
+    auto parton = shower->GetPartonAt(0);
+    auto vertex = shower->GetVertexAt(1);
+
+    shower->clear();
+    EXPECT_EQ(0, shower->GetNumberOfPartons());
+    EXPECT_EQ(0, shower->GetNumberOfVertices());
+    EXPECT_EQ(7, parton->plabel());
+    EXPECT_DOUBLE_EQ(4., vertex->x_in().t());
+
+    // the indices start again from zero
+    v0 = shower->new_vertex(Vertex());
+    v1 = shower->new_vertex(Vertex());
+    EXPECT_EQ(0, shower->new_parton(v0, v1, Parton(8, 2, 0, 3., 0., 0., 4.)));
+    EXPECT_EQ(8, shower->GetPartonAt(0)->plabel());
+    EXPECT_EQ(7, parton->plabel());
+}
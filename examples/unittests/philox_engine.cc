@@ -0,0 +1,96 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ * 
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "PhiloxEngine.h"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+using namespace Jetscape;
+
+// known answers of the Random123 reference implementation
+TEST(PhiloxEngineTest, TEST_KNOWN_ANSWERS){
+    uint32_t out[4];
+    uint32_t key0[2] = {0, 0};
+    uint32_t ctr0[4] = {0, 0, 0, 0};
+    PhiloxEngine::Block(key0, ctr0, out);
+    EXPECT_EQ(0x6627e8d5u, out[0]);
+    EXPECT_EQ(0xe169c58du, out[1]);
+    EXPECT_EQ(0xbc57ac4cu, out[2]);
+    EXPECT_EQ(0x9b00dbd8u, out[3]);
+
+    uint32_t key1[2] = {0xa4093822u, 0x299f31d0u};
+    uint32_t ctr1[4] = {0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u};
+    PhiloxEngine::Block(key1, ctr1, out);
+    EXPECT_EQ(0xd16cfe09u, out[0]);
+    EXPECT_EQ(0x94fdccebu, out[1]);
+    EXPECT_EQ(0x5001e420u, out[2]);
+    EXPECT_EQ(0x24126ea1u, out[3]);
+}
+
+// same key gives the same sequence, any other key a different one
+TEST(PhiloxEngineTest, TEST_STREAMS){
+    PhiloxEngine engine(42, 7, 3, 0);
+    PhiloxEngine same(42, 7, 3, 0);
+    std::vector<PhiloxEngine> others = {
+        PhiloxEngine(43, 7, 3, 0), PhiloxEngine(42, 8, 3, 0),
+        PhiloxEngine(42, 7, 4, 0), PhiloxEngine(42, 7, 3, 1)};
+    for (int i = 0; i < 100; i++) {
+        auto value = engine();
+        EXPECT_EQ(value, same());
+        int n_equal = 0;
+        for (auto &other : others) n_equal += (other() == value);
+        EXPECT_LT(n_equal, 2);
+    }
+    EXPECT_TRUE(engine == same);
+    EXPECT_TRUE(engine != others[0]);
+}
+
+// discard jumps to the same state as drawing the numbers
+TEST(PhiloxEngineTest, TEST_DISCARD){
+    for (int n : {0, 1, 3, 4, 5, 1000, 1003}) {
+        PhiloxEngine drawn(1, 2, 3, 4);
+        PhiloxEngine jumped(1, 2, 3, 4);
+        for (int i = 0; i < n; i++) drawn();
+        jumped.discard(n);
+        EXPECT_EQ(static_cast<uint64_t>(n), jumped.Position());
+        EXPECT_TRUE(drawn == jumped);
+        EXPECT_EQ(drawn(), jumped());
+    }
+    // discard from the middle of a block
+    PhiloxEngine drawn(5);
+    PhiloxEngine jumped(5);
+    drawn();
+    jumped();
+    for (int i = 0; i < 6; i++) drawn();
+    jumped.discard(6);
+    EXPECT_EQ(drawn(), jumped());
+}
+
+// usable with the std distributions
+TEST(PhiloxEngineTest, TEST_DISTRIBUTION){
+    PhiloxEngine engine(2018, 1, 10, 0);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const int n_samples = 100000;
+    double sum = 0.0;
+    for (int i = 0; i < n_samples; i++) {
+        double r = uniform(engine);
+        ASSERT_GE(r, 0.0);
+        ASSERT_LT(r, 1.0);
+        sum += r;
+    }
+    EXPECT_NEAR(0.5, sum / n_samples, 0.005);
+}
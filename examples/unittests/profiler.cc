@@ -0,0 +1,164 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "JetScapeProfiler.h"
+#include "JetScapeTask.h"
+#include "ThreadPool.h"
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <sstream>
+#include <thread>
+
+using namespace Jetscape;
+
+static JetScapeProfiler::RegionSummary find_region(const std::string &name) {
+    for (const auto &region : JetScapeProfiler::Instance()->GetSummary()) {
+        if (region.name == name)
+            return region;
+    }
+    return JetScapeProfiler::RegionSummary();
+}
+
+// a recursive region is counted at every call but timed once
+static void recurse(int depth) {
+    JSPROFILE("Signal", "recurse");
+    std::unique_ptr<int> allocated(new int(depth));
+    if (depth > 0)
+        recurse(depth - 1);
+}
+
+TEST(JetScapeProfilerTest, TEST_REGIONS){
+    auto profiler = JetScapeProfiler::Instance();
+    profiler->Reset();
+
+    // nothing is recorded when off
+    JetScapeProfiler::SetActive(false);
+    {
+        JetScapeProfiler::Scope scope("Exec", "off");
+    }
+    JetScapeProfiler::SetActive(true);
+    EXPECT_EQ(profiler->Register("Exec", "a"), profiler->Register("Exec", "a"));
+
+    for (int event = 0; event < 3; event++) {
+        {
+            JetScapeProfiler::Scope scope("Exec", "sleep");
+            std::this_thread::sleep_for(std::chrono::milliseconds(2 * event + 1));
+        }
+        recurse(4);
+        profiler->EndEvent();
+    }
+    JetScapeProfiler::SetActive(false);
+
+    EXPECT_EQ(3, profiler->GetNumberOfEvents());
+    EXPECT_EQ(0, find_region("off").events);
+
+    auto sleep = find_region("sleep");
+    EXPECT_EQ(3, sleep.calls);
+    EXPECT_EQ(3, sleep.events);
+    EXPECT_GE(sleep.time, 9e-3);
+    EXPECT_GE(sleep.max_event_time, 5e-3);
+    EXPECT_LT(sleep.max_event_time, sleep.time);
+
+    auto recursion = find_region("recurse");
+    EXPECT_EQ("Signal", recursion.kind);
+    EXPECT_EQ(15, recursion.calls);
+    if (JetScapeProfiler::CountsAllocations()) {
+        EXPECT_EQ(15, recursion.allocations);
+        EXPECT_EQ(static_cast<long long>(15 * sizeof(int)),
+                  recursion.allocated_bytes);
+    } else {
+        EXPECT_EQ(0, recursion.allocations);
+        EXPECT_EQ(0, recursion.allocated_bytes);
+    }
+    EXPECT_LT(recursion.time, sleep.time);
+
+    std::ostringstream table, report;
+    profiler->PrintSummary(table);
+    profiler->WriteReport(report);
+    EXPECT_NE(std::string::npos, table.str().find("sleep"));
+    EXPECT_NE(std::string::npos, report.str().find("\"name\": \"recurse\", \"calls\": 15"));
+    EXPECT_EQ(std::string::npos, report.str().find("\"off\""));
+}
+
+// the regions of all threads are added to the event
+TEST(JetScapeProfilerTest, TEST_THREADS){
+    auto profiler = JetScapeProfiler::Instance();
+    profiler->Reset();
+    JetScapeProfiler::SetActive(true);
+    ThreadPool pool(4);
+    int id = profiler->Register("Signal", "parallel");
+    for (int event = 0; event < 2; event++) {
+        pool.ParallelFor(100, [id](int i) {
+            JetScapeProfiler::Scope scope(id);
+            std::vector<double> values(i + 1);
+        });
+        profiler->EndEvent();
+    }
+    JetScapeProfiler::SetActive(false);
+
+    auto parallel = find_region("parallel");
+    EXPECT_EQ(200, parallel.calls);
+    EXPECT_EQ(2, parallel.events);
+    if (JetScapeProfiler::CountsAllocations()) {
+        EXPECT_EQ(200, parallel.allocations);
+        EXPECT_EQ(static_cast<long long>(2 * 5050 * sizeof(double)),
+                  parallel.allocated_bytes);
+    }
+}
+
+// the regions of a task are registered once, and only with the profiler on
+TEST(JetScapeProfilerTest, TEST_TASK_REGIONS){
+    auto profiler = JetScapeProfiler::Instance();
+    JetScapeTask task;
+    task.SetId("task");
+    JetScapeProfiler::SetActive(false);
+    EXPECT_EQ(-1, task.GetProfileId(JetScapeTask::PROFILE_EXEC));
+    JetScapeProfiler::SetActive(true);
+    int id = task.GetProfileId(JetScapeTask::PROFILE_EXEC);
+    EXPECT_EQ(profiler->Register("Exec", "task"), id);
+    EXPECT_EQ(id, task.GetProfileId(JetScapeTask::PROFILE_EXEC));
+    EXPECT_EQ(profiler->Register("ExecTime", "task"),
+              task.GetProfileId(JetScapeTask::PROFILE_EXEC_TIME));
+    task.SetId("renamed");
+    EXPECT_EQ(profiler->Register("Exec", "renamed"),
+              task.GetProfileId(JetScapeTask::PROFILE_EXEC));
+    JetScapeProfiler::SetActive(false);
+}
+
+// a new thread per event reuses the table of the exited one
+TEST(JetScapeProfilerTest, TEST_THREAD_TABLES){
+    auto profiler = JetScapeProfiler::Instance();
+    profiler->Reset();
+    JetScapeProfiler::SetActive(true);
+    int id = profiler->Register("Signal", "per event thread");
+    int n_tables = 0;
+    for (int event = 0; event < 5; event++) {
+        std::thread thread([id]() { JetScapeProfiler::Scope scope(id); });
+        thread.join();
+        if (event == 0)
+            n_tables = profiler->GetNumberOfThreadTables();
+        EXPECT_EQ(n_tables, profiler->GetNumberOfThreadTables());
+        // the table of the exited thread still counts for the event
+        std::thread other([id]() { JetScapeProfiler::Scope scope(id); });
+        other.join();
+        profiler->EndEvent();
+    }
+    JetScapeProfiler::SetActive(false);
+
+    auto region = find_region("per event thread");
+    EXPECT_EQ(10, region.calls);
+    EXPECT_EQ(5, region.events);
+}
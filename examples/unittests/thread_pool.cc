@@ -0,0 +1,64 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ * 
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "ThreadPool.h"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace Jetscape;
+
+// every job writes only its own slot, seeded by its index
+std::vector<double> run_jobs(ThreadPool &pool, int n_jobs) {
+    std::vector<double> results(n_jobs, 0.0);
+    pool.ParallelFor(n_jobs, [&results](int i) {
+        std::mt19937 generator(1000 + i);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        double sum = 0.0;
+        for (int k = 0; k < 10000; k++) sum += uniform(generator);
+        results[i] = sum;
+    });
+    return results;
+}
+
+// the results do not depend on the number of threads
+TEST(ThreadPoolTest, TEST_DETERMINISTIC){
+    ThreadPool serial_pool(1);
+    ThreadPool pool(4);
+    EXPECT_EQ(4, pool.GetNumberOfThreads());
+    auto reference = run_jobs(serial_pool, 37);
+    // the same pool is reused several times
+    for (int repeat = 0; repeat < 5; repeat++) {
+        auto results = run_jobs(pool, 37);
+        ASSERT_EQ(reference.size(), results.size());
+        for (unsigned int i = 0; i < results.size(); i++)
+            EXPECT_EQ(reference[i], results[i]);
+    }
+    // no jobs at all
+    EXPECT_EQ(0, run_jobs(pool, 0).size());
+}
+
+// an exception thrown by a job is passed to the caller
+TEST(ThreadPoolTest, TEST_EXCEPTION){
+    ThreadPool pool(3);
+    EXPECT_THROW(pool.ParallelFor(10, [](int i) {
+                     if (i == 4) throw std::runtime_error("job failed");
+                 }),
+                 std::runtime_error);
+    // the pool is still usable afterwards
+    EXPECT_EQ(20, run_jobs(pool, 20).size());
+}
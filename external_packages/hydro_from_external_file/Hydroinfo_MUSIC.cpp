@@ -11,19 +11,32 @@
 #include <iomanip>
 #include <cstdlib>
 #include <cmath>
+#include <cstring>
 #include <sstream>
 #include <vector>
 #include <string>
 
 #include "./Hydroinfo_MUSIC.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 using namespace std;
 
 Hydroinfo_MUSIC::Hydroinfo_MUSIC() {
     hbarC = 0.19733;
+    boost_invariant = false;
     lattice_2D = new vector<fluidCell_2D>;
     lattice_3D = new vector<fluidCell_3D>;
     lattice_3D_new = new vector<fluidCell_3D_new>;
+    use_mmap = false;
+    mapped_data = nullptr;
+    mapped_size = 0;
+    mapped_record_size = 0;
+    mapped_n_eta = 1;
+    n_fluid_cells = 0;
 }
 
 Hydroinfo_MUSIC::~Hydroinfo_MUSIC() {
@@ -40,6 +53,120 @@ void Hydroinfo_MUSIC::clean_hydro_event() {
         lattice_3D->clear();
         lattice_3D_new->clear();
     }
+    unmap_evolution_file();
+    n_fluid_cells = 0;
+}
+
+bool Hydroinfo_MUSIC::map_evolution_file(string filename,
+                                         std::size_t record_size) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return(false);
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0 || status.st_size == 0) {
+        close(fd);
+        return(false);
+    }
+    std::size_t size = static_cast<std::size_t>(status.st_size);
+    if (hydroWhichHydro == 10 && size%record_size != 0) {
+        // let the reader report the broken file
+        close(fd);
+        return(false);
+    }
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return(false);
+    }
+    mapped_data = static_cast<const char*>(mapping);
+    mapped_size = size;
+    mapped_record_size = record_size;
+    // a record cut short at the end of the file is not used
+    n_fluid_cells = static_cast<long>(size/record_size);
+    cout << "Hydroinfo_MUSIC:: mapped " << size << " bytes of " << filename
+         << endl;
+    return(true);
+}
+
+void Hydroinfo_MUSIC::unmap_evolution_file() {
+    if (mapped_data != nullptr) {
+        munmap(const_cast<char*>(mapped_data), mapped_size);
+    }
+    mapped_data = nullptr;
+    mapped_size = 0;
+}
+
+long Hydroinfo_MUSIC::count_mapped_cells_2D(int num_fluid_cell_trans,
+                                            int n_eta) const {
+    // the same cells as the reader keeps: the last eta slice of every
+    // nskip_tau-th tau frame, the last frame may be incomplete
+    long n_records = n_fluid_cells;
+    long frame_size = static_cast<long>(num_fluid_cell_trans)*n_eta;
+    long n_frames = n_records/frame_size;
+    long n_cells = (n_frames + nskip_tau - 1)/nskip_tau*num_fluid_cell_trans;
+    if (n_frames%nskip_tau == 0) {
+        long n_last = (n_records%frame_size
+                       - static_cast<long>(n_eta - 1)*num_fluid_cell_trans);
+        if (n_last > 0)
+            n_cells += n_last;
+    }
+    return(n_cells);
+}
+
+void Hydroinfo_MUSIC::get_cell_2D(long cell_id, fluidCell_2D *info) const {
+    if (mapped_data == nullptr) {
+        *info = (*lattice_2D)[cell_id];
+        return;
+    }
+    // position of the cell in the file, see readHydroData
+    long num_fluid_cell_trans = static_cast<long>(ixmax)*ixmax;
+    long itau_idx = cell_id/num_fluid_cell_trans*nskip_tau;
+    long record = ((itau_idx*mapped_n_eta + mapped_n_eta - 1)
+                   *num_fluid_cell_trans + cell_id%num_fluid_cell_trans);
+    const char *record_ptr = mapped_data + record*mapped_record_size;
+    double T, vx, vy, vz, v2;
+    if (hydroWhichHydro == 8) {
+        float values[5];
+        std::memcpy(values, record_ptr, sizeof(values));
+        T = values[0];
+        vx = values[2];
+        vy = values[3];
+        vz = values[4];
+        v2 = values[2]*values[2] + values[3]*values[3] + values[4]*values[4];
+    } else {
+        double values[5];
+        std::memcpy(values, record_ptr, sizeof(values));
+        T = values[0];
+        vx = values[2];
+        vy = values[3];
+        vz = values[4];
+        v2 = vx*vx + vy*vy + vz*vz;
+    }
+    // the same check as the reader in readHydroData
+    if (v2 > 1.0) {
+        cerr << "[Hydroinfo_MUSIC::get_cell_2D:] Error: "
+             << "v > 1! vx = " << vx << ", vy = " << vy
+             << ", vz = " << vz << ", T = " << T << endl;
+        if (T > 0.01) {
+            exit(1);
+        } else {
+            v2 = 0.0;
+        }
+    }
+    double gamma = 1./sqrt(1. - v2);
+    info->temperature = T;
+    info->ux = gamma*vx;
+    info->uy = gamma*vy;
+    info->ueta = gamma*vz;  // assuming eta = 0
+    info->pi00 = 0.0;
+    info->pi01 = 0.0;
+    info->pi02 = 0.0;
+    info->pi11 = 0.0;
+    info->pi12 = 0.0;
+    info->pi22 = 0.0;
+    info->pi33 = 0.0;
+    info->bulkPi = 0.0;
 }
 
 void Hydroinfo_MUSIC::readHydroData(int whichHydro, int nskip_tau_in,
@@ -52,6 +179,8 @@ void Hydroinfo_MUSIC::readHydroData(int whichHydro, int nskip_tau_in,
     lattice_2D->clear();
     lattice_3D->clear();
     lattice_3D_new->clear();
+    unmap_evolution_file();
+    n_fluid_cells = 0;
 
     input_filename = input_filename_in;
     hydro_ideal_filename = hydro_ideal_filename_in;
@@ -170,6 +299,7 @@ void Hydroinfo_MUSIC::readHydroData(int whichHydro, int nskip_tau_in,
         }
         cout << ik << endl;
         fin.close();
+        n_fluid_cells = lattice_3D->size();
     } else if (whichHydro == 8) {
         // event-by-event (2+1)-d MUSIC hydro from JF
         // there are two slices in medium in eta_s
@@ -199,165 +329,172 @@ void Hydroinfo_MUSIC::readHydroData(int whichHydro, int nskip_tau_in,
         std::FILE *fin;
         string evolution_file_name = evolution_name;
         cout << "Evolution file name = " << evolution_file_name << endl;
-        fin = std::fopen(evolution_file_name.c_str(), "rb");
-
-        if (fin == NULL) {
-            cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
-                 << "Unable to open file: " << evolution_file_name << endl;
-            exit(1);
-        }
-
-        std::FILE *fin1 = NULL;
-        if (turn_on_shear == 1) {
-            fin1 = std::fopen(evolution_name_Wmunu.c_str(), "rb");
-            if (fin1 == NULL) {
-                cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
-                     << "Unable to open file: " << evolution_name_Wmunu << endl;
-                exit(1);
-            }
-        }
+        if (use_mmap && turn_on_shear == 0 && turn_on_bulk == 0
+                && map_evolution_file(evolution_file_name, 5*sizeof(float))) {
+            mapped_n_eta = n_eta;
+            n_fluid_cells = count_mapped_cells_2D(num_fluid_cell_trans, n_eta);
+        } else {
+            fin = std::fopen(evolution_file_name.c_str(), "rb");
 
-        std::FILE *fin2 = NULL;
-        if (turn_on_bulk == 1) {
-            fin2 = std::fopen(evolution_name_Pi.c_str(), "rb");
-            if (fin2 == NULL) {
+            if (fin == NULL) {
                 cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
-                     << "Unable to open file: " << evolution_name_Pi << endl;
+                     << "Unable to open file: " << evolution_file_name << endl;
                 exit(1);
             }
-        }
-
-        int ik = 0;
-        fluidCell_2D newCell;
-        float T, QGPfrac, vx, vy, vz;
-        double ux, uy, ueta;
-        float pi00 = 0.0;
-        float pi01 = 0.0;
-        float pi02 = 0.0;
-        float pi03 = 0.0;
-        float pi11 = 0.0;
-        float pi12 = 0.0;
-        float pi13 = 0.0;
-        float pi22 = 0.0;
-        float pi23 = 0.0;
-        float pi33 = 0.0;;
-        float bulkPi = 0.0;
-        float e_plus_P = 1e-15;
-        float cs2 = 0.0;
-        int size = sizeof(float);
-        while (true) {
-            int status = 0;
-            status = std::fread(&T, size, 1, fin);
-            status += std::fread(&QGPfrac, size, 1, fin);
-            status += std::fread(&vx, size, 1, fin);
-            status += std::fread(&vy, size, 1, fin);
-            status += std::fread(&vz, size, 1, fin);
-
-            if (status != 5) {  // this is the end of file
-                break;
-            }
 
-            int status_pi = 0;
+            std::FILE *fin1 = NULL;
             if (turn_on_shear == 1) {
-                status_pi = std::fread(&pi00, size, 1, fin1);
-                status_pi += std::fread(&pi01, size, 1, fin1);
-                status_pi += std::fread(&pi02, size, 1, fin1);
-                status_pi += std::fread(&pi03, size, 1, fin1);
-                status_pi += std::fread(&pi11, size, 1, fin1);
-                status_pi += std::fread(&pi12, size, 1, fin1);
-                status_pi += std::fread(&pi13, size, 1, fin1);
-                status_pi += std::fread(&pi22, size, 1, fin1);
-                status_pi += std::fread(&pi23, size, 1, fin1);
-                status_pi += std::fread(&pi33, size, 1, fin1);
-            
-                if (status_pi != 10) {
-                    cout << "Error:Hydroinfo_MUSIC::readHydroData: "
-                         << "Wmunu file does not have the same number of "
-                         << "fluid cells as the ideal file!" << endl;
+                fin1 = std::fopen(evolution_name_Wmunu.c_str(), "rb");
+                if (fin1 == NULL) {
+                    cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
+                         << "Unable to open file: " << evolution_name_Wmunu << endl;
                     exit(1);
                 }
             }
 
-            int status_bulkPi = 0;
+            std::FILE *fin2 = NULL;
             if (turn_on_bulk == 1) {
-                status_bulkPi = std::fread(&bulkPi, size, 1, fin2);
-                status_bulkPi += std::fread(&e_plus_P, size, 1, fin2);
-                status_bulkPi += std::fread(&cs2, size, 1, fin2);
-                
-                if (status_bulkPi != 3) {
-                    cout << "Error:Hydroinfo_MUSIC::readHydroData: "
-                         << "bulkPi file does not have the same number of "
-                         << "fluid cells as the ideal file!" << endl;
+                fin2 = std::fopen(evolution_name_Pi.c_str(), "rb");
+                if (fin2 == NULL) {
+                    cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
+                         << "Unable to open file: " << evolution_name_Pi << endl;
                     exit(1);
                 }
             }
 
-            int ieta_idx = static_cast<int>(ik/num_fluid_cell_trans) % n_eta;
-            int itau_idx = static_cast<int>(ik/(num_fluid_cell_trans*n_eta));
-            ik++;
-            if (itau_idx%nskip_tau != 0)  // skip in tau
-                continue;
-
-            // print out tau information
-            double tau_local = hydroTau0 + itau_idx*hydroDtau/nskip_tau;
-            if ((ik-1)%(num_fluid_cell_trans*n_eta) == 0) {
-                cout << "read in tau frame: " << itau_idx
-                     << " tau_local = " << setprecision(3) << tau_local
-                     << " fm ..."<< endl;
-            }
+            int ik = 0;
+            fluidCell_2D newCell;
+            float T, QGPfrac, vx, vy, vz;
+            double ux, uy, ueta;
+            float pi00 = 0.0;
+            float pi01 = 0.0;
+            float pi02 = 0.0;
+            float pi03 = 0.0;
+            float pi11 = 0.0;
+            float pi12 = 0.0;
+            float pi13 = 0.0;
+            float pi22 = 0.0;
+            float pi23 = 0.0;
+            float pi33 = 0.0;;
+            float bulkPi = 0.0;
+            float e_plus_P = 1e-15;
+            float cs2 = 0.0;
+            int size = sizeof(float);
+            while (true) {
+                int status = 0;
+                status = std::fread(&T, size, 1, fin);
+                status += std::fread(&QGPfrac, size, 1, fin);
+                status += std::fread(&vx, size, 1, fin);
+                status += std::fread(&vy, size, 1, fin);
+                status += std::fread(&vz, size, 1, fin);
+
+                if (status != 5) {  // this is the end of file
+                    break;
+                }
 
-            if (ieta_idx == (n_eta-1)) {
-                // store the hydro medium at eta_s = 0.0
-                double v2 = vx*vx + vy*vy + vz*vz;
-                if (v2 > 1.0) {
-                    cerr << "[Hydroinfo_MUSIC::readHydroData:] Error: "
-                         << "v > 1! vx = " << vx << ", vy = " << vy
-                         << ", vz = " << vz << ", T = " << T << endl;
-                    if (T > 0.01) {
+                int status_pi = 0;
+                if (turn_on_shear == 1) {
+                    status_pi = std::fread(&pi00, size, 1, fin1);
+                    status_pi += std::fread(&pi01, size, 1, fin1);
+                    status_pi += std::fread(&pi02, size, 1, fin1);
+                    status_pi += std::fread(&pi03, size, 1, fin1);
+                    status_pi += std::fread(&pi11, size, 1, fin1);
+                    status_pi += std::fread(&pi12, size, 1, fin1);
+                    status_pi += std::fread(&pi13, size, 1, fin1);
+                    status_pi += std::fread(&pi22, size, 1, fin1);
+                    status_pi += std::fread(&pi23, size, 1, fin1);
+                    status_pi += std::fread(&pi33, size, 1, fin1);
+            
+                    if (status_pi != 10) {
+                        cout << "Error:Hydroinfo_MUSIC::readHydroData: "
+                             << "Wmunu file does not have the same number of "
+                             << "fluid cells as the ideal file!" << endl;
                         exit(1);
-                    } else {
-                        v2 = 0.0;
                     }
                 }
-                double gamma = 1./sqrt(1. - v2);
-                ux = gamma*vx;
-                uy = gamma*vy;
-                ueta = gamma*vz;  // assuming eta = 0
-
-                newCell.temperature = T;
-                // convert vx and vy to longitudinal co-moving frame
-                newCell.ux = ux;
-                newCell.uy = uy;
-                newCell.ueta = ueta;
-
-                // pi^\mu\nu tensor
-                newCell.pi00 = pi00;
-                newCell.pi01 = pi01;
-                newCell.pi02 = pi02;
-                newCell.pi11 = pi11;
-                newCell.pi12 = pi12;
-                newCell.pi22 = pi22;
-                newCell.pi33 = pi33;
 
-                // bulk pressure
-                if (T > 0.18) {
-                    // QGP phase prefactor is divided out here
-                    newCell.bulkPi = bulkPi/(15.*(1./3. - cs2)*e_plus_P);
-                } else {
-                    newCell.bulkPi = bulkPi;   // [1/fm^4]
+                int status_bulkPi = 0;
+                if (turn_on_bulk == 1) {
+                    status_bulkPi = std::fread(&bulkPi, size, 1, fin2);
+                    status_bulkPi += std::fread(&e_plus_P, size, 1, fin2);
+                    status_bulkPi += std::fread(&cs2, size, 1, fin2);
+                
+                    if (status_bulkPi != 3) {
+                        cout << "Error:Hydroinfo_MUSIC::readHydroData: "
+                             << "bulkPi file does not have the same number of "
+                             << "fluid cells as the ideal file!" << endl;
+                        exit(1);
+                    }
+                }
+
+                int ieta_idx = static_cast<int>(ik/num_fluid_cell_trans) % n_eta;
+                int itau_idx = static_cast<int>(ik/(num_fluid_cell_trans*n_eta));
+                ik++;
+                if (itau_idx%nskip_tau != 0)  // skip in tau
+                    continue;
+
+                // print out tau information
+                double tau_local = hydroTau0 + itau_idx*hydroDtau/nskip_tau;
+                if ((ik-1)%(num_fluid_cell_trans*n_eta) == 0) {
+                    cout << "read in tau frame: " << itau_idx
+                         << " tau_local = " << setprecision(3) << tau_local
+                         << " fm ..."<< endl;
+                }
+
+                if (ieta_idx == (n_eta-1)) {
+                    // store the hydro medium at eta_s = 0.0
+                    double v2 = vx*vx + vy*vy + vz*vz;
+                    if (v2 > 1.0) {
+                        cerr << "[Hydroinfo_MUSIC::readHydroData:] Error: "
+                             << "v > 1! vx = " << vx << ", vy = " << vy
+                             << ", vz = " << vz << ", T = " << T << endl;
+                        if (T > 0.01) {
+                            exit(1);
+                        } else {
+                            v2 = 0.0;
+                        }
+                    }
+                    double gamma = 1./sqrt(1. - v2);
+                    ux = gamma*vx;
+                    uy = gamma*vy;
+                    ueta = gamma*vz;  // assuming eta = 0
+
+                    newCell.temperature = T;
+                    // convert vx and vy to longitudinal co-moving frame
+                    newCell.ux = ux;
+                    newCell.uy = uy;
+                    newCell.ueta = ueta;
+
+                    // pi^\mu\nu tensor
+                    newCell.pi00 = pi00;
+                    newCell.pi01 = pi01;
+                    newCell.pi02 = pi02;
+                    newCell.pi11 = pi11;
+                    newCell.pi12 = pi12;
+                    newCell.pi22 = pi22;
+                    newCell.pi33 = pi33;
+
+                    // bulk pressure
+                    if (T > 0.18) {
+                        // QGP phase prefactor is divided out here
+                        newCell.bulkPi = bulkPi/(15.*(1./3. - cs2)*e_plus_P);
+                    } else {
+                        newCell.bulkPi = bulkPi;   // [1/fm^4]
+                    }
+                    lattice_2D->push_back(newCell);
                 }
-                lattice_2D->push_back(newCell);
             }
+            std::fclose(fin);
+            if (turn_on_shear == 1) {
+                std::fclose(fin1);
+            }
+            if (turn_on_bulk == 1) {
+                std::fclose(fin2);
+            }
+            cout << endl;
+            n_fluid_cells = lattice_2D->size();
         }
-        std::fclose(fin);
-        if (turn_on_shear == 1) {
-            std::fclose(fin1);
-        }
-        if (turn_on_bulk == 1) {
-            std::fclose(fin2);
-        }
-        cout << endl;
-        cout << "number of fluid cells: " << lattice_2D->size() << endl;
+        cout << "number of fluid cells: " << n_fluid_cells << endl;
     } else if (whichHydro == 9) {
         // event-by-event (2+1)-d MUSIC hydro
         // the output medium is at middle rapidity
@@ -386,158 +523,165 @@ void Hydroinfo_MUSIC::readHydroData(int whichHydro, int nskip_tau_in,
         std::FILE *fin;
         string evolution_file_name = evolution_name;
         cout << "Evolution file name = " << evolution_file_name << endl;
-        fin = std::fopen(evolution_file_name.c_str(), "rb");
-
-        if (fin == NULL) {
-            cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
-                 << "Unable to open file: " << evolution_file_name << endl;
-            exit(1);
-        }
-
-        std::FILE *fin1 = NULL;
-        if (turn_on_shear == 1) {
-            fin1 = std::fopen(evolution_name_Wmunu.c_str(), "rb");
-            if (fin1 == NULL) {
-                cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
-                     << "Unable to open file: " << evolution_name_Wmunu << endl;
-                exit(1);
-            }
-        }
+        if (use_mmap && turn_on_shear == 0 && turn_on_bulk == 0
+                && map_evolution_file(evolution_file_name, 5*sizeof(double))) {
+            mapped_n_eta = n_eta;
+            n_fluid_cells = count_mapped_cells_2D(num_fluid_cell_trans, n_eta);
+        } else {
+            fin = std::fopen(evolution_file_name.c_str(), "rb");
 
-        std::FILE *fin2 = NULL;
-        if (turn_on_bulk == 1) {
-            fin2 = std::fopen(evolution_name_Pi.c_str(), "rb");
-            if (fin2 == NULL) {
+            if (fin == NULL) {
                 cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
-                     << "Unable to open file: " << evolution_name_Pi << endl;
+                     << "Unable to open file: " << evolution_file_name << endl;
                 exit(1);
             }
-        }
 
-        int ik = 0;
-        fluidCell_2D newCell;
-        double T, QGPfrac, ux, uy, ueta;
-        double vx, vy, vz;
-        float pi00 = 0.0;
-        float pi01 = 0.0;
-        float pi02 = 0.0;
-        float pi03 = 0.0;
-        float pi11 = 0.0;
-        float pi12 = 0.0;
-        float pi13 = 0.0;
-        float pi22 = 0.0;
-        float pi23 = 0.0;
-        float pi33 = 0.0;;
-        float bulkPi = 0.0;
-        float e_plus_P = 1e-15;
-        float cs2 = 0.0;
-        int size = sizeof(double);
-        while (true) {
-            int status = 0;
-            status = std::fread(&T, size, 1, fin);
-            status += std::fread(&QGPfrac, size, 1, fin);
-            status += std::fread(&vx, size, 1, fin);
-            status += std::fread(&vy, size, 1, fin);
-            status += std::fread(&vz, size, 1, fin);
-            if (status != 5) {  // this is the end of file
-                break;
-            }
-
-            double v2 = vx*vx + vy*vy + vz*vz;
-            if (v2 > 1.) {
-                cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
-                     << "v > 1! vx = " << vx << ", vy = " << vy
-                     << ", vz = " << vz << endl;
-                exit(1);
-            }
-            double gamma = 1./sqrt(1. - v2);
-            ux = vx*gamma;
-            uy = vy*gamma;
-            ueta = vz*gamma;  // assuming at the eta = 0
-            
-            int status_pi = 0;
+            std::FILE *fin1 = NULL;
             if (turn_on_shear == 1) {
-                status_pi = std::fread(&pi00, size, 1, fin1);
-                status_pi += std::fread(&pi01, size, 1, fin1);
-                status_pi += std::fread(&pi02, size, 1, fin1);
-                status_pi += std::fread(&pi03, size, 1, fin1);
-                status_pi += std::fread(&pi11, size, 1, fin1);
-                status_pi += std::fread(&pi12, size, 1, fin1);
-                status_pi += std::fread(&pi13, size, 1, fin1);
-                status_pi += std::fread(&pi22, size, 1, fin1);
-                status_pi += std::fread(&pi23, size, 1, fin1);
-                status_pi += std::fread(&pi33, size, 1, fin1);
-                
-                if (status_pi != 10) {
-                    cout << "Error:Hydroinfo_MUSIC::readHydroData: "
-                         << "Wmunu file does not have the same number of "
-                         << "fluid cells as the ideal file!" << endl;
+                fin1 = std::fopen(evolution_name_Wmunu.c_str(), "rb");
+                if (fin1 == NULL) {
+                    cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
+                         << "Unable to open file: " << evolution_name_Wmunu << endl;
                     exit(1);
                 }
             }
 
-            int status_bulkPi = 0;
+            std::FILE *fin2 = NULL;
             if (turn_on_bulk == 1) {
-                status_bulkPi = std::fread(&bulkPi, size, 1, fin2);
-                status_bulkPi += std::fread(&e_plus_P, size, 1, fin2);
-                status_bulkPi += std::fread(&cs2, size, 1, fin2);
-                
-                if (status_bulkPi != 3) {
-                    cout << "Error:Hydroinfo_MUSIC::readHydroData: "
-                         << "bulkPi file does not have the same number of "
-                         << "fluid cells as the ideal file!" << endl;
+                fin2 = std::fopen(evolution_name_Pi.c_str(), "rb");
+                if (fin2 == NULL) {
+                    cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
+                         << "Unable to open file: " << evolution_name_Pi << endl;
                     exit(1);
                 }
             }
 
-            int ieta_idx = static_cast<int>(ik/num_fluid_cell_trans) % n_eta;
-            int itau_idx = static_cast<int>(ik/(num_fluid_cell_trans*n_eta));
-            ik++;
-            if (itau_idx%nskip_tau != 0)  // skip in tau
-                continue;
-
-            // print out tau information
-            double tau_local = hydroTau0 + itau_idx*hydroDtau/nskip_tau;
-            if ((ik-1)%(num_fluid_cell_trans*n_eta) == 0) {
-                cout << "read in tau frame: " << itau_idx
-                     << " tau_local = " << setprecision(3) << tau_local
-                     << " fm ..."<< endl;
-            }
+            int ik = 0;
+            fluidCell_2D newCell;
+            double T, QGPfrac, ux, uy, ueta;
+            double vx, vy, vz;
+            float pi00 = 0.0;
+            float pi01 = 0.0;
+            float pi02 = 0.0;
+            float pi03 = 0.0;
+            float pi11 = 0.0;
+            float pi12 = 0.0;
+            float pi13 = 0.0;
+            float pi22 = 0.0;
+            float pi23 = 0.0;
+            float pi33 = 0.0;;
+            float bulkPi = 0.0;
+            float e_plus_P = 1e-15;
+            float cs2 = 0.0;
+            int size = sizeof(double);
+            while (true) {
+                int status = 0;
+                status = std::fread(&T, size, 1, fin);
+                status += std::fread(&QGPfrac, size, 1, fin);
+                status += std::fread(&vx, size, 1, fin);
+                status += std::fread(&vy, size, 1, fin);
+                status += std::fread(&vz, size, 1, fin);
+                if (status != 5) {  // this is the end of file
+                    break;
+                }
 
-            if (ieta_idx == (n_eta-1)) {
-                newCell.temperature = T;
-                newCell.ux = ux;
-                newCell.uy = uy;
-                newCell.ueta = ueta;
+                double v2 = vx*vx + vy*vy + vz*vz;
+                if (v2 > 1.) {
+                    cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
+                         << "v > 1! vx = " << vx << ", vy = " << vy
+                         << ", vz = " << vz << endl;
+                    exit(1);
+                }
+                double gamma = 1./sqrt(1. - v2);
+                ux = vx*gamma;
+                uy = vy*gamma;
+                ueta = vz*gamma;  // assuming at the eta = 0
+            
+                int status_pi = 0;
+                if (turn_on_shear == 1) {
+                    status_pi = std::fread(&pi00, size, 1, fin1);
+                    status_pi += std::fread(&pi01, size, 1, fin1);
+                    status_pi += std::fread(&pi02, size, 1, fin1);
+                    status_pi += std::fread(&pi03, size, 1, fin1);
+                    status_pi += std::fread(&pi11, size, 1, fin1);
+                    status_pi += std::fread(&pi12, size, 1, fin1);
+                    status_pi += std::fread(&pi13, size, 1, fin1);
+                    status_pi += std::fread(&pi22, size, 1, fin1);
+                    status_pi += std::fread(&pi23, size, 1, fin1);
+                    status_pi += std::fread(&pi33, size, 1, fin1);
+                
+                    if (status_pi != 10) {
+                        cout << "Error:Hydroinfo_MUSIC::readHydroData: "
+                             << "Wmunu file does not have the same number of "
+                             << "fluid cells as the ideal file!" << endl;
+                        exit(1);
+                    }
+                }
 
-                // pi^\mu\nu tensor
-                newCell.pi00 = pi00;
-                newCell.pi01 = pi01;
-                newCell.pi02 = pi02;
-                newCell.pi11 = pi11;
-                newCell.pi12 = pi12;
-                newCell.pi22 = pi22;
-                newCell.pi33 = pi33;
+                int status_bulkPi = 0;
+                if (turn_on_bulk == 1) {
+                    status_bulkPi = std::fread(&bulkPi, size, 1, fin2);
+                    status_bulkPi += std::fread(&e_plus_P, size, 1, fin2);
+                    status_bulkPi += std::fread(&cs2, size, 1, fin2);
+                
+                    if (status_bulkPi != 3) {
+                        cout << "Error:Hydroinfo_MUSIC::readHydroData: "
+                             << "bulkPi file does not have the same number of "
+                             << "fluid cells as the ideal file!" << endl;
+                        exit(1);
+                    }
+                }
 
-                // bulk pressure
-                if (T > 0.18) {
-                    // QGP phase prefactor is divided out here
-                    newCell.bulkPi = bulkPi/(15.*(1./3. - cs2)*e_plus_P);
-                } else {
-                    newCell.bulkPi = bulkPi;   // [1/fm^4]
+                int ieta_idx = static_cast<int>(ik/num_fluid_cell_trans) % n_eta;
+                int itau_idx = static_cast<int>(ik/(num_fluid_cell_trans*n_eta));
+                ik++;
+                if (itau_idx%nskip_tau != 0)  // skip in tau
+                    continue;
+
+                // print out tau information
+                double tau_local = hydroTau0 + itau_idx*hydroDtau/nskip_tau;
+                if ((ik-1)%(num_fluid_cell_trans*n_eta) == 0) {
+                    cout << "read in tau frame: " << itau_idx
+                         << " tau_local = " << setprecision(3) << tau_local
+                         << " fm ..."<< endl;
+                }
+
+                if (ieta_idx == (n_eta-1)) {
+                    newCell.temperature = T;
+                    newCell.ux = ux;
+                    newCell.uy = uy;
+                    newCell.ueta = ueta;
+
+                    // pi^\mu\nu tensor
+                    newCell.pi00 = pi00;
+                    newCell.pi01 = pi01;
+                    newCell.pi02 = pi02;
+                    newCell.pi11 = pi11;
+                    newCell.pi12 = pi12;
+                    newCell.pi22 = pi22;
+                    newCell.pi33 = pi33;
+
+                    // bulk pressure
+                    if (T > 0.18) {
+                        // QGP phase prefactor is divided out here
+                        newCell.bulkPi = bulkPi/(15.*(1./3. - cs2)*e_plus_P);
+                    } else {
+                        newCell.bulkPi = bulkPi;   // [1/fm^4]
+                    }
+                    lattice_2D->push_back(newCell);
                 }
-                lattice_2D->push_back(newCell);
             }
+            std::fclose(fin);
+            if (turn_on_shear == 1) {
+                std::fclose(fin1);
+            }
+            if (turn_on_bulk == 1) {
+                std::fclose(fin2);
+            }
+            cout << endl;
+            n_fluid_cells = lattice_2D->size();
         }
-        std::fclose(fin);
-        if (turn_on_shear == 1) {
-            std::fclose(fin1);
-        }
-        if (turn_on_bulk == 1) {
-            std::fclose(fin2);
-        }
-        cout << endl;
-        cout << "number of fluid cells: " << lattice_2D->size() << endl;
+        cout << "number of fluid cells: " << n_fluid_cells << endl;
     } else if (whichHydro == 10) {
         // new 3+1D MUSIC hydro (Schenke, Jeon, Gale, Shen)
         cout << "Using 3+1D new MUSIC hydro reading data ..." << endl;
@@ -550,100 +694,115 @@ void Hydroinfo_MUSIC::readHydroData(int whichHydro, int nskip_tau_in,
         // The name of the evolution file: evolution_name
         string evolution_name = hydro_ideal_filename;
         cout << "Evolution file name = " << evolution_name << endl;
-        std::FILE *fin;
-        fin = std::fopen(evolution_name.c_str(), "rb");
-        if (fin == NULL) {
-            cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
-                 << "Unable to open file: " << evolution_name << endl;
-            exit(1);
-        }
-        
-        int idx[4];
         int itau_max = 0;
-        double ideal_variables[4];
-        fluidCell_3D_new newCell;
-        int ik = 0;
-        while (true) {
-            int status = 0;
-            status = std::fread(&idx, sizeof(int), 4, fin);
-            if (status == 0) break;
-            
-            status = std::fread(&ideal_variables, sizeof(double), 4, fin);
-            if (status == 0) {
+        // the size of a fluid cell record follows from the flags
+        std::size_t record_size = (
+                4*sizeof(int) + (4 + turn_on_rhob + 5*turn_on_shear
+                                 + turn_on_bulk + 3*turn_on_diff)*sizeof(double));
+        if (use_mmap && map_evolution_file(evolution_name, record_size)) {
+            for (long ik = 0; ik < n_fluid_cells; ik++) {
+                int itau_local;
+                std::memcpy(&itau_local, mapped_data + ik*record_size,
+                            sizeof(int));
+                if (itau_max < itau_local)
+                    itau_max = itau_local;
+            }
+        } else {
+            std::FILE *fin;
+            fin = std::fopen(evolution_name.c_str(), "rb");
+            if (fin == NULL) {
                 cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
-                     << "file format is read in wrong" << endl;
+                     << "Unable to open file: " << evolution_name << endl;
                 exit(1);
             }
-
-            double muB_local = 0.0;
-            if (turn_on_rhob == 1) {
-                status = std::fread(&muB_local, sizeof(double), 1, fin);
+        
+            int idx[4];
+            double ideal_variables[4];
+            fluidCell_3D_new newCell;
+            int ik = 0;
+            while (true) {
+                int status = 0;
+                status = std::fread(&idx, sizeof(int), 4, fin);
+                if (status == 0) break;
+            
+                status = std::fread(&ideal_variables, sizeof(double), 4, fin);
                 if (status == 0) {
                     cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
                          << "file format is read in wrong" << endl;
                     exit(1);
                 }
-            }
+
+                double muB_local = 0.0;
+                if (turn_on_rhob == 1) {
+                    status = std::fread(&muB_local, sizeof(double), 1, fin);
+                    if (status == 0) {
+                        cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
+                             << "file format is read in wrong" << endl;
+                        exit(1);
+                    }
+                }
             
-            double Wmunu[5] = {0., 0., 0., 0., 0.};
-            if (turn_on_shear == 1) {
-                status = std::fread(&Wmunu, sizeof(double), 5, fin);
-                if (status == 0) {
-                    cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
-                         << "file format is read in wrong" << endl;
-                    exit(1);
+                double Wmunu[5] = {0., 0., 0., 0., 0.};
+                if (turn_on_shear == 1) {
+                    status = std::fread(&Wmunu, sizeof(double), 5, fin);
+                    if (status == 0) {
+                        cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
+                             << "file format is read in wrong" << endl;
+                        exit(1);
+                    }
                 }
-            }
 
-            double pi11 = Wmunu[0];
-            double pi12 = Wmunu[1];
-            double pi13 = Wmunu[2];
-            double pi22 = Wmunu[3];
-            double pi23 = Wmunu[4];
+                double pi11 = Wmunu[0];
+                double pi12 = Wmunu[1];
+                double pi13 = Wmunu[2];
+                double pi22 = Wmunu[3];
+                double pi23 = Wmunu[4];
            
-            double bulkPi;
-            if (turn_on_bulk == 1) {
-                status = std::fread(&bulkPi, sizeof(double), 1, fin);
-                if (status == 0) {
-                    cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
-                         << "file format is read in wrong" << endl;
-                    exit(1);
+                double bulkPi;
+                if (turn_on_bulk == 1) {
+                    status = std::fread(&bulkPi, sizeof(double), 1, fin);
+                    if (status == 0) {
+                        cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
+                             << "file format is read in wrong" << endl;
+                        exit(1);
+                    }
                 }
-            }
 
-            double qmu[3] = {0., 0., 0.};
-            if (turn_on_diff == 1) {
-                status = std::fread(&qmu, sizeof(double), 3, fin);
-                if (status == 0) {
-                    cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
-                         << "file format is read in wrong" << endl;
-                    exit(1);
+                double qmu[3] = {0., 0., 0.};
+                if (turn_on_diff == 1) {
+                    status = std::fread(&qmu, sizeof(double), 3, fin);
+                    if (status == 0) {
+                        cerr << "[Hydroinfo_MUSIC::readHydroData]: ERROR: "
+                             << "file format is read in wrong" << endl;
+                        exit(1);
+                    }
                 }
-            }
 
-            if (itau_max < idx[0])
-                itau_max = idx[0];
-            newCell.itau = idx[0];
-            newCell.ix = idx[1];
-            newCell.iy = idx[2];
-            newCell.ieta = idx[3];
-            newCell.temperature = ideal_variables[0];
-            newCell.ux = ideal_variables[1];
-            newCell.uy = ideal_variables[2];
-            newCell.ueta = ideal_variables[3];
-            newCell.pi11 = pi11;
-            newCell.pi12 = pi12;
-            newCell.pi13 = pi13;
-            newCell.pi22 = pi22;
-            newCell.pi23 = pi23;
-            newCell.bulkPi = bulkPi;
-            lattice_3D_new->push_back(newCell);
-            ik++;
-            if (ik%50000 == 0)
-                cout << "o" << flush;
+                if (itau_max < idx[0])
+                    itau_max = idx[0];
+                newCell.itau = idx[0];
+                newCell.ix = idx[1];
+                newCell.iy = idx[2];
+                newCell.ieta = idx[3];
+                newCell.temperature = ideal_variables[0];
+                newCell.ux = ideal_variables[1];
+                newCell.uy = ideal_variables[2];
+                newCell.ueta = ideal_variables[3];
+                newCell.pi11 = pi11;
+                newCell.pi12 = pi12;
+                newCell.pi13 = pi13;
+                newCell.pi22 = pi22;
+                newCell.pi23 = pi23;
+                newCell.bulkPi = bulkPi;
+                lattice_3D_new->push_back(newCell);
+                ik++;
+                if (ik%50000 == 0)
+                    cout << "o" << flush;
+            }
+            cout << endl;
+            std::fclose(fin);
+        n_fluid_cells = lattice_3D_new->size();
         }
-        cout << endl;
-        std::fclose(fin);
         itaumax = itau_max;
         hydroTauMax = hydroTau0 + hydroDtau*itaumax;
     }
@@ -662,7 +821,7 @@ void Hydroinfo_MUSIC::readHydroData(int whichHydro, int nskip_tau_in,
     if (whichHydro == 8 || whichHydro == 9) {
         hydroTauMax = (
             hydroTau0 + hydroDtau*static_cast<int>(
-                        static_cast<double>(lattice_2D->size())
+                        static_cast<double>(n_fluid_cells)
                         /((2.*hydroXmax/hydroDx)*(2.*hydroXmax/hydroDx)) - 1));
         itaumax = static_cast<int>((hydroTauMax - hydroTau0)/hydroDtau);
     }
@@ -678,6 +837,32 @@ void Hydroinfo_MUSIC::readHydroData(int whichHydro, int nskip_tau_in,
 
 void Hydroinfo_MUSIC::get_hydro_cell_info_3d(int cell_id,
                                              fluidCell_3D_new *info) {
+    if (mapped_data != nullptr) {
+        // the record layout is the one of readHydroData
+        const char *record_ptr = mapped_data + cell_id*mapped_record_size;
+        int idx[4];
+        double values[16];
+        std::memcpy(idx, record_ptr, sizeof(idx));
+        std::memcpy(values, record_ptr + sizeof(idx),
+                    mapped_record_size - sizeof(idx));
+        int i_shear = 4 + turn_on_rhob;
+        int i_bulk = i_shear + 5*turn_on_shear;
+        info->itau = idx[0];
+        info->ix = idx[1];
+        info->iy = idx[2];
+        info->ieta = idx[3];
+        info->temperature = values[0];
+        info->ux = values[1];
+        info->uy = values[2];
+        info->ueta = values[3];
+        info->pi11 = turn_on_shear == 1 ? values[i_shear] : 0.0;
+        info->pi12 = turn_on_shear == 1 ? values[i_shear + 1] : 0.0;
+        info->pi13 = turn_on_shear == 1 ? values[i_shear + 2] : 0.0;
+        info->pi22 = turn_on_shear == 1 ? values[i_shear + 3] : 0.0;
+        info->pi23 = turn_on_shear == 1 ? values[i_shear + 4] : 0.0;
+        info->bulkPi = turn_on_bulk == 1 ? values[i_bulk] : 0.0;
+        return;
+    }
     info->itau = (*lattice_3D_new)[cell_id].itau;
     info->ix = (*lattice_3D_new)[cell_id].ix;
     info->iy = (*lattice_3D_new)[cell_id].iy;
@@ -808,7 +993,7 @@ void Hydroinfo_MUSIC::getHydroValues(double x, double y,
                     peta = ieta + 1;
                 for (int iptau = 0; iptau < 2; iptau++) {
                     int ptau;
-                    if (iptau == 0 || itau == itaumax-1)
+                    if (iptau == 0 || itau >= itaumax-1)
                         ptau = itau;
                     else
                         ptau = itau + 1;
@@ -839,7 +1024,9 @@ void Hydroinfo_MUSIC::getHydroValues(double x, double y,
     double pi33 = 0.0;
     double bulkPi = 0.0;
 
-    fluidCell_2D *HydroCell_2D_ptr1, *HydroCell_2D_ptr2;
+    fluidCell_2D HydroCell_2D_1, HydroCell_2D_2;
+    fluidCell_2D *HydroCell_2D_ptr1 = &HydroCell_2D_1;
+    fluidCell_2D *HydroCell_2D_ptr2 = &HydroCell_2D_2;
     fluidCell_3D *HydroCell_3D_ptr1, *HydroCell_3D_ptr2;
     for (int iptau = 0; iptau < 2; iptau++) {
         double taufactor;
@@ -863,10 +1050,10 @@ void Hydroinfo_MUSIC::getHydroValues(double x, double y,
                 double prefrac = yfactor*etafactor*taufactor;
 
                 if (boost_invariant) {
-                    HydroCell_2D_ptr1 = (
-                            &(*lattice_2D)[position[0][ipy][ipeta][iptau]]);
-                    HydroCell_2D_ptr2 = (
-                            &(*lattice_2D)[position[1][ipy][ipeta][iptau]]);
+                    get_cell_2D(position[0][ipy][ipeta][iptau],
+                                HydroCell_2D_ptr1);
+                    get_cell_2D(position[1][ipy][ipeta][iptau],
+                                HydroCell_2D_ptr2);
                     T += prefrac*((1. - xfrac)*HydroCell_2D_ptr1->temperature
                                   + xfrac*HydroCell_2D_ptr2->temperature);
                     ux += prefrac*((1. - xfrac)*HydroCell_2D_ptr1->ux
@@ -9,6 +9,7 @@
 #ifndef SRC_HYDROINFO_MUSIC_H_
 #define SRC_HYDROINFO_MUSIC_H_
 
+#include <cstddef>
 #include <vector>
 #include <string>
 #include "fluidCell.h"
@@ -49,6 +50,22 @@ class Hydroinfo_MUSIC {
     std::vector<fluidCell_3D> *lattice_3D;  // array to store hydro information
     std::vector<fluidCell_3D_new> *lattice_3D_new;
 
+    // With use_mmap the binary evolution files (whichHydro = 8, 9, 10) are
+    // mapped read-only and the fluid cells are decoded in place instead of
+    // being copied into the lattices. The pages are shared by all the
+    // processes reading the same file.
+    bool use_mmap;
+    const char *mapped_data;
+    std::size_t mapped_size;
+    std::size_t mapped_record_size;  // bytes per fluid cell in the file
+    int mapped_n_eta;                // eta slices per tau frame (8, 9)
+    long n_fluid_cells;              // number of cells in the lattice
+
+    bool map_evolution_file(std::string filename, std::size_t record_size);
+    void unmap_evolution_file();
+    long count_mapped_cells_2D(int num_fluid_cell_trans, int n_eta) const;
+    void get_cell_2D(long cell_id, fluidCell_2D *info) const;
+
  public:
     Hydroinfo_MUSIC();       // constructor
     ~Hydroinfo_MUSIC();      // destructor
@@ -64,7 +81,11 @@ class Hydroinfo_MUSIC {
     int get_hydro_Nskip_tau() {return(nskip_tau);}
     int get_hydro_Nskip_x() {return(nskip_x);}
     int get_hydro_Nskip_eta() {return(nskip_eta);}
-    int get_number_of_fluid_cells_3d() {return(lattice_3D_new->size());}
+    int get_number_of_fluid_cells_3d() {return(n_fluid_cells);}
+
+    //! map the binary evolution files instead of reading them into memory
+    void set_use_mmap(bool use_mmap_in) {use_mmap = use_mmap_in;}
+    bool is_mapped() const {return(mapped_data != nullptr);}
 
     void readHydroData(int whichHydro, int nskip_tau_in,
             std::string input_filename_in, std::string hydro_ideal_filename,
@@ -36,64 +36,33 @@ HydroinfoH5::~HydroinfoH5() {
 }
 
 void HydroinfoH5::clean_hydro_event() {
-    for (int i=0; i<Buffersize; i++) {
-        for (int j=0; j<dimensionX; j++) {
-           delete[] ed[i][j];
-           delete[] sd[i][j];
-           delete[] vx[i][j];
-           delete[] vy[i][j];
-           delete[] Temperature[i][j];
-           delete[] Pressure[i][j];
-           delete[] pi00[i][j];
-           delete[] pi01[i][j];
-           delete[] pi02[i][j];
-           delete[] pi03[i][j];
-           delete[] pi11[i][j];
-           delete[] pi12[i][j];
-           delete[] pi13[i][j];
-           delete[] pi22[i][j];
-           delete[] pi23[i][j];
-           delete[] pi33[i][j];
-           delete[] BulkPi[i][j];
-        }
-        delete[] ed[i];
-        delete[] sd[i];
-        delete[] vx[i];
-        delete[] vy[i];
-        delete[] Temperature[i];
-        delete[] Pressure[i];
-        delete[] pi00[i];
-        delete[] pi01[i];
-        delete[] pi02[i];
-        delete[] pi03[i];
-        delete[] pi11[i];
-        delete[] pi12[i];
-        delete[] pi13[i];
-        delete[] pi22[i];
-        delete[] pi23[i];
-        delete[] pi33[i];
-        delete[] BulkPi[i];
+    vector<double>* fields[] = {&ed, &sd, &vx, &vy, &Temperature, &Pressure,
+                                &pi00, &pi01, &pi02, &pi03, &pi11, &pi12,
+                                &pi13, &pi22, &pi23, &pi33, &BulkPi};
+    for (auto field : fields) {
+        vector<double>().swap(*field);
     }
-    delete[] ed;
-    delete[] sd;
-    delete[] vx;
-    delete[] vy;
-    delete[] Temperature;
-    delete[] Pressure;
-    delete[] pi00;
-    delete[] pi01;
-    delete[] pi02;
-    delete[] pi03;
-    delete[] pi11;
-    delete[] pi12;
-    delete[] pi13;
-    delete[] pi22;
-    delete[] pi23;
-    delete[] pi33;
-    delete[] BulkPi;
     readinFlag = 0;
 }
 
+void HydroinfoH5::allocateHydroFields(int nFrames) {
+    size_t n_cells = static_cast<size_t>(nFrames)*dimensionX*dimensionY;
+    vector<double>* fields[] = {&ed, &sd, &vx, &vy, &Temperature, &Pressure};
+    for (auto field : fields) {
+        field->assign(n_cells, 0.0);
+    }
+    // the viscous fields are only kept when they are read in
+    vector<double>* viscous_fields[] = {&pi00, &pi01, &pi02, &pi03, &pi11,
+                                        &pi12, &pi13, &pi22, &pi23, &pi33,
+                                        &BulkPi};
+    for (auto field : viscous_fields) {
+        if (Visflag == 1)
+            field->assign(n_cells, 0.0);
+        else
+            vector<double>().swap(*field);
+    }
+}
+
 void HydroinfoH5::setHydroFiles(int XL_in, int XH_in, double DX_in, int LSX_in, int YL_in, int YH_in, double DY_in, int LSY_in, double Tau0_in, double dTau_in, double LST_in, int Visflag_in, string filename_in)
 {
     outputFlag = 1;
@@ -303,64 +272,8 @@ void HydroinfoH5::readHydroinfoH5(string filename_in, int bufferSize_in, int Vis
       cout << "Buffersize is too small, increase it to at lease to " << grid_Framenum << endl;
       exit(1);
    }
-   //initialize all matrices
-   ed = new double** [Buffersize];
-   sd = new double** [Buffersize];
-   vx = new double** [Buffersize];
-   vy = new double** [Buffersize];
-   Temperature = new double** [Buffersize];
-   Pressure = new double** [Buffersize];
-   pi00 = new double** [Buffersize];
-   pi01 = new double** [Buffersize];
-   pi02 = new double** [Buffersize];
-   pi03 = new double** [Buffersize];
-   pi11 = new double** [Buffersize];
-   pi12 = new double** [Buffersize];
-   pi13 = new double** [Buffersize];
-   pi22 = new double** [Buffersize];
-   pi23 = new double** [Buffersize];
-   pi33 = new double** [Buffersize];
-   BulkPi = new double** [Buffersize];
-   for(int i=0; i<Buffersize; i++)
-   {
-      ed[i] = new double* [dimensionX];
-      sd[i] = new double* [dimensionX];
-      vx[i] = new double* [dimensionX];
-      vy[i] = new double* [dimensionX];
-      Temperature[i] = new double* [dimensionX];
-      Pressure[i] = new double* [dimensionX];
-      pi00[i] = new double* [dimensionX];
-      pi01[i] = new double* [dimensionX];
-      pi02[i] = new double* [dimensionX];
-      pi03[i] = new double* [dimensionX];
-      pi11[i] = new double* [dimensionX];
-      pi12[i] = new double* [dimensionX];
-      pi13[i] = new double* [dimensionX];
-      pi22[i] = new double* [dimensionX];
-      pi23[i] = new double* [dimensionX];
-      pi33[i] = new double* [dimensionX];
-      BulkPi[i] = new double* [dimensionX];
-      for(int j=0; j<dimensionX; j++)
-      {
-         ed[i][j] = new double [dimensionY];
-         sd[i][j] = new double [dimensionY];
-         vx[i][j] = new double [dimensionY];
-         vy[i][j] = new double [dimensionY];
-         Temperature[i][j] = new double [dimensionY];
-         Pressure[i][j] = new double [dimensionY];
-         pi00[i][j] = new double [dimensionY];
-         pi01[i][j] = new double [dimensionY];
-         pi02[i][j] = new double [dimensionY];
-         pi03[i][j] = new double [dimensionY];
-         pi11[i][j] = new double [dimensionY];
-         pi12[i][j] = new double [dimensionY];
-         pi13[i][j] = new double [dimensionY];
-         pi22[i][j] = new double [dimensionY];
-         pi23[i][j] = new double [dimensionY];
-         pi33[i][j] = new double [dimensionY];
-         BulkPi[i][j] = new double [dimensionY];
-      }
-   }
+   // only the frames in the file are stored
+   allocateHydroFields(grid_Framenum);
   
    readHydroinfoBuffered_total(); 
 
@@ -443,44 +356,8 @@ double HydroinfoH5::readH5Attribute_double(hid_t id, string attributeName)
 
 void HydroinfoH5::readHydroinfoBuffered_total()
 {
-   hid_t group_id;
-   herr_t status;
-   
-   int frameIdx;
-   for(int i=0; i<Buffersize; i++)
-   {
-      frameIdx = i;
-      if(frameIdx < (int) grid_Framenum)
-      {
-         stringstream frameName;
-         frameName << "Frame_" <<  setw(4) << setfill('0') << frameIdx;
-         group_id = H5Gopen(H5groupEventid, frameName.str().c_str(), H5P_DEFAULT);
-      
-         readH5Dataset_double(group_id, "e", ed[i]);
-         readH5Dataset_double(group_id, "s", sd[i]);
-         readH5Dataset_double(group_id, "Vx", vx[i]);
-         readH5Dataset_double(group_id, "Vy", vy[i]);
-         readH5Dataset_double(group_id, "Temp", Temperature[i]);
-         readH5Dataset_double(group_id, "P", Pressure[i]);
-         if(Visflag == 1)
-         {
-            readH5Dataset_double(group_id, "Pi00", pi00[i]);
-            readH5Dataset_double(group_id, "Pi01", pi01[i]);
-            readH5Dataset_double(group_id, "Pi02", pi02[i]);
-            readH5Dataset_double(group_id, "Pi03", pi03[i]);
-            readH5Dataset_double(group_id, "Pi11", pi11[i]);
-            readH5Dataset_double(group_id, "Pi12", pi12[i]);
-            readH5Dataset_double(group_id, "Pi13", pi13[i]);
-            readH5Dataset_double(group_id, "Pi22", pi22[i]);
-            readH5Dataset_double(group_id, "Pi23", pi23[i]);
-            readH5Dataset_double(group_id, "Pi33", pi33[i]);
-            readH5Dataset_double(group_id, "BulkPi", BulkPi[i]);
-         }
-         status = H5Gclose(group_id);
-      }
-      else
-         break;
-   }
+   for(int frameIdx=0; frameIdx<grid_Framenum; frameIdx++)
+      readHydroinfoSingleframe(frameIdx);
 }
 
 void HydroinfoH5::readHydroinfoSingleframe(int frameIdx)
@@ -494,27 +371,25 @@ void HydroinfoH5::readHydroinfoSingleframe(int frameIdx)
       frameName << "Frame_" <<  setw(4) << setfill('0') << frameIdx;
       group_id = H5Gopen(H5groupEventid, frameName.str().c_str(), H5P_DEFAULT);
       
-      int Idx = frameIdx;
-
-      readH5Dataset_double(group_id, "e", ed[Idx]);
-      readH5Dataset_double(group_id, "s", sd[Idx]);
-      readH5Dataset_double(group_id, "Vx", vx[Idx]);
-      readH5Dataset_double(group_id, "Vy", vy[Idx]);
-      readH5Dataset_double(group_id, "Temp", Temperature[Idx]);
-      readH5Dataset_double(group_id, "P", Pressure[Idx]);
+      readH5Dataset_double(group_id, "e", frameIdx, ed);
+      readH5Dataset_double(group_id, "s", frameIdx, sd);
+      readH5Dataset_double(group_id, "Vx", frameIdx, vx);
+      readH5Dataset_double(group_id, "Vy", frameIdx, vy);
+      readH5Dataset_double(group_id, "Temp", frameIdx, Temperature);
+      readH5Dataset_double(group_id, "P", frameIdx, Pressure);
       if(Visflag == 1)
       {
-         readH5Dataset_double(group_id, "Pi00", pi00[Idx]);
-         readH5Dataset_double(group_id, "Pi01", pi01[Idx]);
-         readH5Dataset_double(group_id, "Pi02", pi02[Idx]);
-         readH5Dataset_double(group_id, "Pi03", pi03[Idx]);
-         readH5Dataset_double(group_id, "Pi11", pi11[Idx]);
-         readH5Dataset_double(group_id, "Pi12", pi12[Idx]);
-         readH5Dataset_double(group_id, "Pi13", pi13[Idx]);
-         readH5Dataset_double(group_id, "Pi22", pi22[Idx]);
-         readH5Dataset_double(group_id, "Pi23", pi23[Idx]);
-         readH5Dataset_double(group_id, "Pi33", pi33[Idx]);
-         readH5Dataset_double(group_id, "BulkPi", BulkPi[Idx]);
+         readH5Dataset_double(group_id, "Pi00", frameIdx, pi00);
+         readH5Dataset_double(group_id, "Pi01", frameIdx, pi01);
+         readH5Dataset_double(group_id, "Pi02", frameIdx, pi02);
+         readH5Dataset_double(group_id, "Pi03", frameIdx, pi03);
+         readH5Dataset_double(group_id, "Pi11", frameIdx, pi11);
+         readH5Dataset_double(group_id, "Pi12", frameIdx, pi12);
+         readH5Dataset_double(group_id, "Pi13", frameIdx, pi13);
+         readH5Dataset_double(group_id, "Pi22", frameIdx, pi22);
+         readH5Dataset_double(group_id, "Pi23", frameIdx, pi23);
+         readH5Dataset_double(group_id, "Pi33", frameIdx, pi33);
+         readH5Dataset_double(group_id, "BulkPi", frameIdx, BulkPi);
       }
       status = H5Gclose(group_id);
    }
@@ -526,52 +401,94 @@ void HydroinfoH5::readHydroinfoSingleframe(int frameIdx)
    }
 }
 
-void HydroinfoH5::readH5Dataset_double(hid_t id, string datasetName, double** dset_data)
+void HydroinfoH5::readH5Dataset_double(hid_t id, string datasetName,
+                                       int frameIdx, vector<double> &dset_data)
 {
    herr_t status;
-   hid_t dataset_id;
-   
-   double temp_data[dimensionX][dimensionY];
+   hid_t dataset_id, filespace_id, memspace_id;
+
    dataset_id = H5Dopen(id, datasetName.c_str(), H5P_DEFAULT);
-   status = H5Dread(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, temp_data);
-   for(int i=0; i<dimensionX; i++)
-      for(int j=0; j<dimensionY; j++)
-         dset_data[i][j] = temp_data[i][j];
+   if(dataset_id < 0)
+   {
+      cout << "Error: readH5Dataset_double :: can not find dataset "
+           << datasetName << " in " << filename << endl;
+      exit(1);
+   }
+   filespace_id = H5Dget_space(dataset_id);
+   hsize_t file_dims[2] = {0, 0};
+   if(H5Sget_simple_extent_ndims(filespace_id) != 2
+      || H5Sget_simple_extent_dims(filespace_id, file_dims, NULL) != 2
+      || file_dims[0] != (hsize_t) dimensionX
+      || file_dims[1] != (hsize_t) dimensionY)
+   {
+      cout << "Error: readH5Dataset_double :: dataset " << datasetName
+           << " does not match the hydro grid " << dimensionX << " x "
+           << dimensionY << endl;
+      exit(1);
+   }
+
+   // read the frame straight into its slab of the field
+   hsize_t mem_dims[3] = {dset_data.size()/(file_dims[0]*file_dims[1]),
+                          file_dims[0], file_dims[1]};
+   hsize_t mem_start[3] = {(hsize_t) frameIdx, 0, 0};
+   hsize_t mem_count[3] = {1, file_dims[0], file_dims[1]};
+   memspace_id = H5Screate_simple(3, mem_dims, NULL);
+   status = H5Sselect_hyperslab(memspace_id, H5S_SELECT_SET, mem_start, NULL,
+                                mem_count, NULL);
+   status = H5Dread(dataset_id, H5T_NATIVE_DOUBLE, memspace_id, filespace_id,
+                    H5P_DEFAULT, dset_data.data());
+   if(status < 0)
+   {
+      cout << "Error: readH5Dataset_double :: can not read dataset "
+           << datasetName << " in " << filename << endl;
+      exit(1);
+   }
+   status = H5Sclose(memspace_id);
+   status = H5Sclose(filespace_id);
    status = H5Dclose(dataset_id);
 }
 
 void HydroinfoH5::getHydroinfoOnlattice(int frameIdx, int xIdx, int yIdx, hydrofluidCell* fluidCellptr)
 {
-   if(frameIdx < 0 || frameIdx > grid_Framenum || xIdx < 0 || xIdx > (grid_XH - grid_XL) || yIdx < 0 || yIdx > (grid_YH - grid_YL))
+   if(frameIdx < 0 || frameIdx >= grid_Framenum || xIdx < 0 || xIdx > (grid_XH - grid_XL) || yIdx < 0 || yIdx > (grid_YH - grid_YL))
    {
       cout << "Error: getHydroinfoOnlattice:: Index is wrong" << endl;
       cout << "frameIdx = " << frameIdx << " xIdx = " << xIdx 
            << "yIdx = " << yIdx << endl;
       exit(1);
    }
-   fluidCellptr->ed = ed[frameIdx][xIdx][yIdx];
-   fluidCellptr->sd = sd[frameIdx][xIdx][yIdx];
-   fluidCellptr->vx = vx[frameIdx][xIdx][yIdx];
-   fluidCellptr->vy = vy[frameIdx][xIdx][yIdx];
-   fluidCellptr->temperature = Temperature[frameIdx][xIdx][yIdx];
-   fluidCellptr->pressure = Pressure[frameIdx][xIdx][yIdx];
-   fluidCellptr->pi[0][0] = pi00[frameIdx][xIdx][yIdx];
-   fluidCellptr->pi[0][1] = pi01[frameIdx][xIdx][yIdx];
-   fluidCellptr->pi[0][2] = pi02[frameIdx][xIdx][yIdx];
-   fluidCellptr->pi[0][3] = pi03[frameIdx][xIdx][yIdx];
+   int idx = cellIndex(frameIdx, xIdx, yIdx);
+   fluidCellptr->ed = ed[idx];
+   fluidCellptr->sd = sd[idx];
+   fluidCellptr->vx = vx[idx];
+   fluidCellptr->vy = vy[idx];
+   fluidCellptr->temperature = Temperature[idx];
+   fluidCellptr->pressure = Pressure[idx];
+   if(Visflag != 1)
+   {
+      for(int i=0; i<4; i++)
+         for(int j=0; j<4; j++)
+            fluidCellptr->pi[i][j] = 0.0e0;
+      fluidCellptr->bulkPi = 0.0e0;
+      return;
+   }
+   fluidCellptr->pi[0][0] = pi00[idx];
+   fluidCellptr->pi[0][1] = pi01[idx];
+   fluidCellptr->pi[0][2] = pi02[idx];
+   fluidCellptr->pi[0][3] = pi03[idx];
    fluidCellptr->pi[1][0] = fluidCellptr->pi[0][1];
-   fluidCellptr->pi[1][1] = pi11[frameIdx][xIdx][yIdx];
-   fluidCellptr->pi[1][2] = pi12[frameIdx][xIdx][yIdx];
-   fluidCellptr->pi[1][3] = pi13[frameIdx][xIdx][yIdx];
+   fluidCellptr->pi[1][1] = pi11[idx];
+   fluidCellptr->pi[1][2] = pi12[idx];
+   fluidCellptr->pi[1][3] = pi13[idx];
    fluidCellptr->pi[2][0] = fluidCellptr->pi[0][2];
    fluidCellptr->pi[2][1] = fluidCellptr->pi[1][2];
-   fluidCellptr->pi[2][2] = pi22[frameIdx][xIdx][yIdx];
-   fluidCellptr->pi[2][3] = pi23[frameIdx][xIdx][yIdx];
+   fluidCellptr->pi[2][2] = pi22[idx];
+   fluidCellptr->pi[2][3] = pi23[idx];
    fluidCellptr->pi[3][0] = fluidCellptr->pi[0][3];
    fluidCellptr->pi[3][1] = fluidCellptr->pi[1][3];
    fluidCellptr->pi[3][2] = fluidCellptr->pi[2][3];
-   fluidCellptr->pi[3][3] = pi33[frameIdx][xIdx][yIdx];
-   fluidCellptr->bulkPi = BulkPi[frameIdx][xIdx][yIdx];
+   fluidCellptr->pi[3][3] = pi33[idx];
+   fluidCellptr->bulkPi = BulkPi[idx];
 }
 
 
@@ -599,31 +516,32 @@ void HydroinfoH5::getHydroinfo(double tau, double x, double y, hydrofluidCell* f
    yIdx = (int) floor(temp);
    yInc = temp - yIdx;
 
-   fluidCellptr->ed = cubeInterpShell(xIdx, yIdx, frameIdx, xInc, yInc, tauInc, ed);
-   fluidCellptr->sd = cubeInterpShell(xIdx, yIdx, frameIdx, xInc, yInc, tauInc, sd);
-   fluidCellptr->vx = cubeInterpShell(xIdx, yIdx, frameIdx, xInc, yInc, tauInc, vx);
-   fluidCellptr->vy = cubeInterpShell(xIdx, yIdx, frameIdx, xInc, yInc, tauInc, vy);
-   fluidCellptr->temperature = cubeInterpShell(xIdx, yIdx, frameIdx, xInc, yInc, tauInc, Temperature);
-   fluidCellptr->pressure = cubeInterpShell(xIdx, yIdx, frameIdx, xInc, yInc, tauInc, Pressure);
+   int idx = cellIndex(frameIdx, xIdx, yIdx);
+   fluidCellptr->ed = cubeInterpShell(idx, xInc, yInc, tauInc, ed);
+   fluidCellptr->sd = cubeInterpShell(idx, xInc, yInc, tauInc, sd);
+   fluidCellptr->vx = cubeInterpShell(idx, xInc, yInc, tauInc, vx);
+   fluidCellptr->vy = cubeInterpShell(idx, xInc, yInc, tauInc, vy);
+   fluidCellptr->temperature = cubeInterpShell(idx, xInc, yInc, tauInc, Temperature);
+   fluidCellptr->pressure = cubeInterpShell(idx, xInc, yInc, tauInc, Pressure);
    if(Visflag == 1)
    {
-      fluidCellptr->pi[0][0] = cubeInterpShell(xIdx, yIdx, frameIdx, xInc, yInc, tauInc, pi00);
-      fluidCellptr->pi[0][1] = cubeInterpShell(xIdx, yIdx, frameIdx, xInc, yInc, tauInc, pi01);
-      fluidCellptr->pi[0][2] = cubeInterpShell(xIdx, yIdx, frameIdx, xInc, yInc, tauInc, pi02);
-      fluidCellptr->pi[0][3] = cubeInterpShell(xIdx, yIdx, frameIdx, xInc, yInc, tauInc, pi03);
+      fluidCellptr->pi[0][0] = cubeInterpShell(idx, xInc, yInc, tauInc, pi00);
+      fluidCellptr->pi[0][1] = cubeInterpShell(idx, xInc, yInc, tauInc, pi01);
+      fluidCellptr->pi[0][2] = cubeInterpShell(idx, xInc, yInc, tauInc, pi02);
+      fluidCellptr->pi[0][3] = cubeInterpShell(idx, xInc, yInc, tauInc, pi03);
       fluidCellptr->pi[1][0] = fluidCellptr->pi[0][1];
-      fluidCellptr->pi[1][1] = cubeInterpShell(xIdx, yIdx, frameIdx, xInc, yInc, tauInc, pi11);
-      fluidCellptr->pi[1][2] = cubeInterpShell(xIdx, yIdx, frameIdx, xInc, yInc, tauInc, pi12);
-      fluidCellptr->pi[1][3] = cubeInterpShell(xIdx, yIdx, frameIdx, xInc, yInc, tauInc, pi13);
+      fluidCellptr->pi[1][1] = cubeInterpShell(idx, xInc, yInc, tauInc, pi11);
+      fluidCellptr->pi[1][2] = cubeInterpShell(idx, xInc, yInc, tauInc, pi12);
+      fluidCellptr->pi[1][3] = cubeInterpShell(idx, xInc, yInc, tauInc, pi13);
       fluidCellptr->pi[2][0] = fluidCellptr->pi[0][2];
       fluidCellptr->pi[2][1] = fluidCellptr->pi[1][2];
-      fluidCellptr->pi[2][2] = cubeInterpShell(xIdx, yIdx, frameIdx, xInc, yInc, tauInc, pi22);
-      fluidCellptr->pi[2][3] = cubeInterpShell(xIdx, yIdx, frameIdx, xInc, yInc, tauInc, pi23);
+      fluidCellptr->pi[2][2] = cubeInterpShell(idx, xInc, yInc, tauInc, pi22);
+      fluidCellptr->pi[2][3] = cubeInterpShell(idx, xInc, yInc, tauInc, pi23);
       fluidCellptr->pi[3][0] = fluidCellptr->pi[0][3];
       fluidCellptr->pi[3][1] = fluidCellptr->pi[1][3];
       fluidCellptr->pi[3][2] = fluidCellptr->pi[2][3];
-      fluidCellptr->pi[3][3] = cubeInterpShell(xIdx, yIdx, frameIdx, xInc, yInc, tauInc, pi33);
-      fluidCellptr->bulkPi = cubeInterpShell(xIdx, yIdx, frameIdx, xInc, yInc, tauInc, BulkPi);
+      fluidCellptr->pi[3][3] = cubeInterpShell(idx, xInc, yInc, tauInc, pi33);
+      fluidCellptr->bulkPi = cubeInterpShell(idx, xInc, yInc, tauInc, BulkPi);
    }
    else
    {
@@ -648,11 +566,15 @@ void HydroinfoH5::setZero_fluidCell(hydrofluidCell* fluidCellptr)
    fluidCellptr->bulkPi = 0.0e0;
 }
 
-double HydroinfoH5::cubeInterpShell(int idx_x, int idx_y, int idx_z, double x, double y, double z, double ***dataset)
+double HydroinfoH5::cubeInterpShell(int idx, double x, double y, double z, const vector<double> &dataset)
+// idx is the cell at the lower corner of the cube, see cellIndex()
 {
+   const int dx = dimensionY;
+   const int dz = dimensionX*dimensionY;
+   const double* A = dataset.data() + idx;
    double result = cubeInterp(x, y, z,
-      dataset[idx_z][idx_x][idx_y], dataset[idx_z][idx_x+1][idx_y], dataset[idx_z][idx_x][idx_y+1], dataset[idx_z][idx_x+1][idx_y+1], 
-      dataset[idx_z+1][idx_x][idx_y], dataset[idx_z+1][idx_x+1][idx_y], dataset[idx_z+1][idx_x][idx_y+1], dataset[idx_z+1][idx_x+1][idx_y+1]); 
+      A[0], A[dx], A[1], A[dx+1],
+      A[dz], A[dz+dx], A[dz+1], A[dz+dx+1]);
    return(result);
 }
 
@@ -39,10 +39,17 @@ class HydroinfoH5
       int LST_cur;
 
       int dimensionX, dimensionY;
-      double ***ed, ***sd, ***vx, ***vy, ***Temperature, ***Pressure;
-      double ***pi00, ***pi01, ***pi02, ***pi03, ***pi11, ***pi12, ***pi13;
-      double ***pi22, ***pi23, ***pi33;
-      double ***BulkPi;
+      // every field is one contiguous array with the layout
+      // [frame][x][y], the index of a cell is given by cellIndex()
+      vector<double> ed, sd, vx, vy, Temperature, Pressure;
+      vector<double> pi00, pi01, pi02, pi03, pi11, pi12, pi13;
+      vector<double> pi22, pi23, pi33;
+      vector<double> BulkPi;
+
+      int cellIndex(int frameIdx, int xIdx, int yIdx) const {
+         return((frameIdx*dimensionX + xIdx)*dimensionY + yIdx);
+      }
+      void allocateHydroFields(int nFrames);
 
    public:
       HydroinfoH5();
@@ -74,7 +81,8 @@ class HydroinfoH5
 
       void readHydroinfoBuffered_total();
       void readHydroinfoSingleframe(int frameIdx);
-      void readH5Dataset_double(hid_t id, string datasetName, double** dset_data);
+      void readH5Dataset_double(hid_t id, string datasetName, int frameIdx,
+                                vector<double> &dset_data);
 
       int getNumberofFrames() {return((int)grid_Framenum);};
       double getHydrogridDX() {return(grid_dx);};
@@ -92,8 +100,8 @@ class HydroinfoH5
       void getHydroinfo(double tau, double x, double y, hydrofluidCell* fluidCellptr);
       void setZero_fluidCell(hydrofluidCell* fluidCellptr);
 
-      double cubeInterpShell(int idx_x, int idx_y, int idx_z,
-                             double x, double y, double z, double ***dataset);
+      double cubeInterpShell(int idx, double x, double y, double z,
+                             const vector<double> &dataset);
       double cubeInterp(double x, double y, double z,
                         double A000, double A100, double A010, double A110,
                         double A001, double A101, double A011, double A111);
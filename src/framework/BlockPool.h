@@ -0,0 +1,72 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#ifndef BLOCKPOOL_H
+#define BLOCKPOOL_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace Jetscape {
+
+/** @class BlockPool
+ * Copies of objects stored side by side in blocks of fixed size, so that
+ * adding an object costs one heap allocation per block instead of one per
+ * object. Objects never move. Each one is handed out as a shared_ptr that
+ * shares the ownership of its block: a block lives as long as one of its
+ * objects is referenced, also after Clear().
+ * Not thread safe, like the containers of the standard library.
+ */
+template <class T> class BlockPool {
+public:
+  explicit BlockPool(std::size_t block_size = 256) : block_size(block_size) {}
+
+  /** @return Shared pointer to a copy of value. */
+  std::shared_ptr<T> Add(const T &value) {
+    if (!current || current->n_used == block_size) {
+      current = std::make_shared<Block>(block_size);
+    }
+    T *object = new (&current->storage[current->n_used]) T(value);
+    current->n_used++;
+    return (std::shared_ptr<T>(current, object));
+  }
+
+  /** Start a new block with the next object. */
+  void Clear() { current.reset(); }
+
+private:
+  // T may be incomplete where the pool is declared
+  struct Block {
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+
+    explicit Block(std::size_t size) : storage(new Slot[size]), n_used(0) {}
+    ~Block() {
+      for (std::size_t i = 0; i < n_used; i++) {
+        reinterpret_cast<T *>(&storage[i])->~T();
+      }
+    }
+    std::unique_ptr<Slot[]> storage;
+    std::size_t n_used;
+  };
+
+  std::size_t block_size;
+  std::shared_ptr<Block> current;
+};
+
+} // end namespace Jetscape
+
+#endif // BLOCKPOOL_H
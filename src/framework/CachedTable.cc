@@ -0,0 +1,270 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "CachedTable.h"
+#include "JetScapeLogger.h"
+
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Jetscape {
+
+namespace {
+
+const char cache_tag[8] = {'J', 'S', 'T', 'A', 'B', 'L', 'E', '1'};
+
+// layout of the cache file, followed by the numbers
+struct CacheHeader {
+  char tag[8];
+  std::uint64_t source_size;
+  std::uint64_t source_hash;
+  std::uint64_t n_values;
+};
+
+std::mutex cache_directory_mutex;
+std::string cache_directory;
+
+std::string DefaultCacheDirectory() {
+  const char *xdg_cache_home = std::getenv("XDG_CACHE_HOME");
+  if (xdg_cache_home && xdg_cache_home[0] != '\0') {
+    return (std::string(xdg_cache_home) + "/jetscape");
+  }
+  return (".");
+}
+
+} // end namespace
+
+void CachedTable::SetCacheDirectory(const std::string &directory) {
+  std::lock_guard<std::mutex> lock(cache_directory_mutex);
+  cache_directory = directory;
+}
+
+std::string CachedTable::GetCacheDirectory() {
+  std::lock_guard<std::mutex> lock(cache_directory_mutex);
+  if (cache_directory.empty()) {
+    return (DefaultCacheDirectory());
+  }
+  return (cache_directory);
+}
+
+std::string CachedTable::CacheFileName(const std::string &source_file) {
+  // tables of the same name in different directories get different caches
+  std::string full_path = source_file;
+  char working_directory[PATH_MAX];
+  if (source_file[0] != '/' && getcwd(working_directory, PATH_MAX)) {
+    full_path = std::string(working_directory) + "/" + source_file;
+  }
+  std::uint64_t path_hash = 14695981039346656037ULL;
+  for (char c : full_path) {
+    path_hash = (path_hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+  }
+  std::string::size_type slash = source_file.find_last_of('/');
+  std::ostringstream name;
+  name << GetCacheDirectory() << "/"
+       << (slash == std::string::npos ? source_file
+                                      : source_file.substr(slash + 1))
+       << "." << std::hex << std::setw(16) << std::setfill('0') << path_hash
+       << ".cache";
+  return (name.str());
+}
+
+CachedTable::CachedTable()
+    : mapping(nullptr), mapping_size(0), values(nullptr), n_values(0) {}
+
+CachedTable::~CachedTable() {
+  if (mapping) {
+    munmap(mapping, mapping_size);
+  }
+}
+
+double CachedTable::at(std::size_t i) const {
+  if (i >= n_values) {
+    throw std::out_of_range("CachedTable::at: index out of range");
+  }
+  return (values[i]);
+}
+
+std::shared_ptr<const CachedTable>
+CachedTable::FromValues(std::vector<double> values_in) {
+  std::shared_ptr<CachedTable> table(new CachedTable());
+  table->owned_values.swap(values_in);
+  table->values = table->owned_values.data();
+  table->n_values = table->owned_values.size();
+  return (table);
+}
+
+std::shared_ptr<const CachedTable>
+CachedTable::Load(const std::string &source_file, const Parser &parser) {
+  std::uint64_t source_size = 0;
+  std::uint64_t source_hash = 0;
+  if (!HashFile(source_file, source_size, source_hash)) {
+    return (nullptr);
+  }
+
+  std::string cache_directory_name = GetCacheDirectory();
+  if (mkdir(cache_directory_name.c_str(), 0755) != 0 && errno != EEXIST) {
+    JSWARN << "Could not create the table cache directory "
+           << cache_directory_name;
+  }
+  std::string cache_file = CacheFileName(source_file);
+  auto table = Map(cache_file, source_size, source_hash);
+  if (table) {
+    JSINFO << "Mapped " << cache_file;
+    return (table);
+  }
+
+  JSINFO << "Reading " << source_file << " ...";
+  std::ifstream in(source_file.c_str());
+  std::vector<double> parsed;
+  if (!in || !parser(in, parsed)) {
+    JSWARN << "Could not parse " << source_file;
+    return (nullptr);
+  }
+
+  if (Write(cache_file, source_size, source_hash, parsed)) {
+    table = Map(cache_file, source_size, source_hash);
+    if (table) {
+      return (table);
+    }
+  }
+  JSWARN << "Could not write " << cache_file
+         << ", the table is only kept in memory";
+  return (FromValues(std::move(parsed)));
+}
+
+bool CachedTable::HashFile(const std::string &file_name, std::uint64_t &size,
+                           std::uint64_t &hash) {
+  std::ifstream in(file_name.c_str(), std::ios::in | std::ios::binary);
+  if (!in) {
+    return (false);
+  }
+  // FNV-1a over 8-byte words
+  const std::uint64_t prime = 1099511628211ULL;
+  hash = 14695981039346656037ULL;
+  size = 0;
+  std::vector<char> buffer(1 << 20);
+  while (in) {
+    in.read(buffer.data(), buffer.size());
+    std::size_t n_read = static_cast<std::size_t>(in.gcount());
+    if (n_read == 0) {
+      break;
+    }
+    size += n_read;
+    std::size_t n_words = n_read / 8;
+    for (std::size_t i = 0; i < n_words; i++) {
+      std::uint64_t word;
+      std::memcpy(&word, &buffer[8 * i], 8);
+      hash = (hash ^ word) * prime;
+    }
+    for (std::size_t i = 8 * n_words; i < n_read; i++) {
+      hash = (hash ^ static_cast<unsigned char>(buffer[i])) * prime;
+    }
+  }
+  return (true);
+}
+
+std::shared_ptr<const CachedTable>
+CachedTable::Map(const std::string &cache_file, std::uint64_t source_size,
+                 std::uint64_t source_hash) {
+  int fd = open(cache_file.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return (nullptr);
+  }
+  struct stat status;
+  CacheHeader header;
+  bool valid =
+      fstat(fd, &status) == 0 &&
+      static_cast<std::size_t>(status.st_size) >= sizeof(header) &&
+      pread(fd, &header, sizeof(header), 0) ==
+          static_cast<ssize_t>(sizeof(header)) &&
+      std::memcmp(header.tag, cache_tag, sizeof(cache_tag)) == 0 &&
+      header.source_size == source_size && header.source_hash == source_hash &&
+      static_cast<std::uint64_t>(status.st_size) ==
+          sizeof(header) + header.n_values * sizeof(double);
+  if (!valid) {
+    close(fd);
+    return (nullptr);
+  }
+
+  std::size_t mapping_size = static_cast<std::size_t>(status.st_size);
+  void *mapping = mmap(nullptr, mapping_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    return (nullptr);
+  }
+
+  std::shared_ptr<CachedTable> table(new CachedTable());
+  table->mapping = mapping;
+  table->mapping_size = mapping_size;
+  table->values = reinterpret_cast<const double *>(
+      static_cast<const char *>(mapping) + sizeof(header));
+  table->n_values = static_cast<std::size_t>(header.n_values);
+  return (table);
+}
+
+bool CachedTable::Write(const std::string &cache_file,
+                        std::uint64_t source_size, std::uint64_t source_hash,
+                        const std::vector<double> &values) {
+  // write to a unique file and rename it, so that concurrent jobs, also of
+  // other hosts sharing the directory, never see a partial cache
+  std::string temporary_file = cache_file + ".tmp.XXXXXX";
+  std::vector<char> temporary_name(temporary_file.begin(),
+                                   temporary_file.end());
+  temporary_name.push_back('\0');
+  int fd = mkstemp(temporary_name.data());
+  if (fd < 0) {
+    return (false);
+  }
+  // mkstemp creates the file readable by the owner only
+  fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+  close(fd);
+  temporary_file = temporary_name.data();
+
+  CacheHeader header;
+  std::memcpy(header.tag, cache_tag, sizeof(cache_tag));
+  header.source_size = source_size;
+  header.source_hash = source_hash;
+  header.n_values = values.size();
+
+  std::ofstream out(temporary_file.c_str(), std::ios::out | std::ios::binary);
+  if (!out) {
+    std::remove(temporary_file.c_str());
+    return (false);
+  }
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char *>(values.data()),
+            values.size() * sizeof(double));
+  out.close();
+  if (!out || std::rename(temporary_file.c_str(), cache_file.c_str()) != 0) {
+    std::remove(temporary_file.c_str());
+    return (false);
+  }
+  return (true);
+}
+
+} // end namespace Jetscape
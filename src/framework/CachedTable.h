@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#ifndef CACHEDTABLE_H
+#define CACHEDTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Jetscape {
+
+/** @class CachedTable
+ * Numbers parsed once from an ASCII table file and kept in a binary cache
+ * file. The caches are written to the cache directory (SetCacheDirectory,
+ * <tableCacheDir> in the XML), by default $XDG_CACHE_HOME/jetscape if
+ * XDG_CACHE_HOME is set and the working directory otherwise, never next to
+ * the source. The cache records the size and a hash of the source, so that
+ * it is rebuilt when the source changes. It is memory mapped read-only:
+ * loading is almost instant and the pages are shared by all the processes
+ * of a node using the table.
+ * When the cache cannot be written, the parsed numbers are kept in memory.
+ */
+class CachedTable {
+public:
+  /** Parse the source file into a flat list of numbers.
+      @return False if the file is not valid.
+   */
+  typedef std::function<bool(std::istream &in, std::vector<double> &values)>
+      Parser;
+
+  /** Map the cache of a table file, building it with parser if it is
+      missing or was made from another version of the file.
+      @return nullptr if the file cannot be read or parsed.
+   */
+  static std::shared_ptr<const CachedTable> Load(const std::string &source_file,
+                                                 const Parser &parser);
+
+  /** @return A table holding the given numbers, not cached. */
+  static std::shared_ptr<const CachedTable>
+  FromValues(std::vector<double> values);
+
+  /** Set the directory the caches are written to and read from. It is
+      created if it does not exist. An empty name restores the default.
+      Call it before loading the tables.
+   */
+  static void SetCacheDirectory(const std::string &directory);
+  static std::string GetCacheDirectory();
+
+  /** @return The cache of a table file: the file name, a hash of its full
+      path and ".cache", in the cache directory.
+   */
+  static std::string CacheFileName(const std::string &source_file);
+
+  ~CachedTable();
+
+  CachedTable(const CachedTable &) = delete;
+  CachedTable &operator=(const CachedTable &) = delete;
+
+  std::size_t size() const { return (n_values); }
+  const double *data() const { return (values); }
+  double operator[](std::size_t i) const { return (values[i]); }
+  /** Bounds-checked access, throws std::out_of_range. */
+  double at(std::size_t i) const;
+
+  bool IsMapped() const { return (mapping != nullptr); }
+
+private:
+  CachedTable();
+
+  static bool HashFile(const std::string &file_name, std::uint64_t &size,
+                       std::uint64_t &hash);
+  static std::shared_ptr<const CachedTable>
+  Map(const std::string &cache_file, std::uint64_t source_size,
+      std::uint64_t source_hash);
+  static bool Write(const std::string &cache_file, std::uint64_t source_size,
+                    std::uint64_t source_hash,
+                    const std::vector<double> &values);
+
+  void *mapping;
+  std::size_t mapping_size;
+  std::vector<double> owned_values; // used when not mapped
+  const double *values;
+  std::size_t n_values;
+};
+
+} // end namespace Jetscape
+
+#endif // CACHEDTABLE_H
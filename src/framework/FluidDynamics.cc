@@ -15,8 +15,11 @@
 // This is a general basic class for hydrodynamics
 
 #include <iostream>
+#include <algorithm>
 #include <array>
+#include <limits>
 #include "FluidDynamics.h"
+#include "JetEnergyLoss.h"
 #include "LinearInterpolation.h"
 #include "JetScapeSignalManager.h"
 #include "MakeUniqueHelper.h"
@@ -31,11 +34,19 @@ namespace Jetscape {
 FluidDynamics::FluidDynamics() {
   VERBOSE(8);
   eta = -99.99;
+  n_surface_finder_threads = 1;
+  n_evolution_window_frames = 0;
+  evolution_window_tc = 0.0;
+  hydro_status = NOT_START;
   SetId("FluidDynamics");
 }
 
 FluidDynamics::~FluidDynamics() {
   VERBOSE(8);
+  if (hydro_evolution.valid()) {
+    bulk_info.ReleaseTimeSlices(std::numeric_limits<Jetscape::real>::max());
+    hydro_evolution.wait();
+  }
   disconnect_all();
 }
 
@@ -58,6 +69,32 @@ void FluidDynamics::Init() {
     JSWARN << "No Pre-equilibrium module";
   }
 
+  n_surface_finder_threads =
+      std::max(1, GetXMLElementInt({"Hydro", "nSurfaceFinderThreads"}, false));
+
+  // the time slices are consumed by the jets running on the main clock,
+  // the evolution history of a reused hydro event has to be kept in full
+  n_evolution_window_frames =
+      std::max(0, GetXMLElementInt({"Hydro", "nEvolutionWindowFrames"}, false));
+  if (n_evolution_window_frames > 0) {
+    bool reuse_hydro =
+        GetXMLElementText({"setReuseHydro"}, false).find("true") !=
+            std::string::npos &&
+        GetXMLElementInt({"nReuseHydro"}, false) > 1;
+    if (!ClockUsed() || reuse_hydro) {
+      JSWARN << "<Hydro><nEvolutionWindowFrames> needs the main clock and no "
+             << "reused hydro events, the full evolution history is kept.";
+      n_evolution_window_frames = 0;
+    } else {
+      n_evolution_window_frames = std::max(2, n_evolution_window_frames);
+      evolution_window_tc =
+          GetXMLElementDouble({"Hydro", "evolutionWindowTc"}, false);
+      JSINFO << "Sliding window of " << n_evolution_window_frames
+             << " time slices for the evolution history";
+    }
+  }
+  bulk_info.SetSlidingWindow(n_evolution_window_frames);
+
   InitializeHydro(parameter_list);
   InitTask();
 
@@ -73,11 +110,56 @@ void FluidDynamics::Exec() {
                << ini->GetEntropyDensityDistribution().size();
   }
 
-  EvolveHydro();
-  JetScapeTask::ExecuteTasks();
+  if (n_evolution_window_frames == 0) {
+    EvolveHydro();
+    JetScapeTask::ExecuteTasks();
+    return;
+  }
+
+  // the time slices are pushed in the background while the jets run on
+  // the main clock, see FinishHydroEvolution()
+  FinishHydroEvolution();
+  bulk_info.BeginTimeSlices();
+  hydro_evolution = std::async(std::launch::async, [this]() {
+    JetScapeProfiler::Scope scope("EvolveHydro", GetId());
+    try {
+      EvolveHydro();
+      JetScapeTask::ExecuteTasks();
+    } catch (...) {
+      bulk_info.EndTimeSlices();
+      throw;
+    }
+    bulk_info.EndTimeSlices();
+  });
+}
+
+void FluidDynamics::ReleaseHydroEvolutionHistory(
+    const std::vector<std::shared_ptr<JetEnergyLoss>> &showers,
+    Jetscape::real t_next) {
+  // partons that left the medium do not hold back the window
+  auto in_medium = [this](double t, double x, double y, double z,
+                          double vz) {
+    return (bulk_info.IsReachable(t, x, y, z, vz, evolution_window_tc));
+  };
+  double tau_slowest = std::numeric_limits<double>::max();
+  for (auto &jloss : showers)
+    tau_slowest =
+        std::min(tau_slowest, jloss->GetSlowestPartonProperTime(in_medium));
+  bulk_info.ReleaseTimeSlices(
+      std::min<double>(tau_slowest, std::numeric_limits<Jetscape::real>::max()));
+  bulk_info.ReserveTimeSlices(t_next);
+}
+
+void FluidDynamics::FinishHydroEvolution() {
+  if (!hydro_evolution.valid()) {
+    return;
+  }
+  bulk_info.ReleaseTimeSlices(std::numeric_limits<Jetscape::real>::max());
+  hydro_evolution.get();
 }
 
 void FluidDynamics::Clear() {
+  FinishHydroEvolution();
   clear_up_evolution_data();
   if (!weak_ptr_is_uninitialized(liquefier_ptr)) {
     liquefier_ptr.lock()->Clear();
@@ -94,8 +176,12 @@ void FluidDynamics::CollectHeader(weak_ptr<JetScapeWriter> w) {
 
 std::vector<SurfaceCellInfo>
 FluidDynamics::FindAConstantTemperatureSurface(Jetscape::real T_sw) {
+  if (IsStreamingEvolutionHistory()) {
+    JSWARN << "Only the time slices in the sliding window of the evolution "
+           << "history are scanned for the surface.";
+  }
   std::unique_ptr<SurfaceFinder> surface_finder_ptr(
-      new SurfaceFinder(T_sw, bulk_info));
+      new SurfaceFinder(T_sw, bulk_info, n_surface_finder_threads));
   surface_finder_ptr->Find_full_hypersurface();
   auto surface_cells = surface_finder_ptr->get_surface_cells_vector();
   JSINFO << "number of surface cells: " << surface_cells.size();
@@ -148,6 +234,43 @@ Jetscape::real FluidDynamics::GetQgpFraction(Jetscape::real time,
   return (qgp_fraction);
 }
 
+void FluidDynamics::GetHydroInfoBatch(int n_points, const Jetscape::real *t,
+                                      const Jetscape::real *x,
+                                      const Jetscape::real *y,
+                                      const Jetscape::real *z,
+                                      unsigned int field_mask,
+                                      Jetscape::real *output) {
+  EntryName entries[ENTRY_INVALID];
+  int n_entries = 0;
+  for (int i = 0; i < ENTRY_INVALID; i++) {
+    if (field_mask & EntryMask(static_cast<EntryName>(i))) {
+      entries[n_entries++] = static_cast<EntryName>(i);
+    }
+  }
+  std::unique_ptr<FluidCellInfo> fluid_cell_ptr;
+  for (int i = 0; i < n_points; i++) {
+    GetHydroInfo(t[i], x[i], y[i], z[i], fluid_cell_ptr);
+    for (int k = 0; k < n_entries; k++) {
+      output[k * n_points + i] = GetEntryValue(*fluid_cell_ptr, entries[k]);
+    }
+  }
+}
+
+void FluidDynamics::GetHydroCellBatch(int n_points, const Jetscape::real *t,
+                                      const Jetscape::real *x,
+                                      const Jetscape::real *y,
+                                      const Jetscape::real *z,
+                                      unsigned int field_mask,
+                                      Jetscape::real *output) {
+  JSPROFILE("Signal", "GetHydroCellBatch");
+  if (IsStreamingEvolutionHistory()) {
+    for (int i = 0; i < n_points; i++) {
+      bulk_info.WaitForTimeSlice_tz(t[i], z[i]);
+    }
+  }
+  GetHydroInfoBatch(n_points, t, x, y, z, field_mask, output);
+}
+
 void FluidDynamics::get_source_term(Jetscape::real tau, Jetscape::real x,
                                     Jetscape::real y, Jetscape::real eta,
                                     std::array<Jetscape::real, 4> jmu) const {
@@ -20,14 +20,17 @@
 #include <memory>
 #include <vector>
 #include <array>
+#include <atomic>
 #include <cstring>
 #include <stdexcept>
 #include <cmath>
 #include <iostream>
 #include <map>
+#include <future>
 
 #include "InitialState.h"
 #include "JetScapeModuleBase.h"
+#include "JetScapeProfiler.h"
 #include "PreequilibriumDynamics.h"
 #include "RealType.h"
 #include "FluidCellInfo.h"
@@ -37,6 +40,8 @@
 
 namespace Jetscape {
 
+class JetEnergyLoss;
+
 /// Flags for hydrodynamics status.
 enum HydroStatus { NOT_START, INITIALIZED, EVOLVING, FINISHED, ERROR };
 
@@ -52,8 +57,9 @@ protected:
   Jetscape::real hydro_tau_0, hydro_tau_max;
   // record hydro freeze out temperature [GeV]
   Jetscape::real hydro_freeze_out_temperature;
-  // record hydro running status
-  HydroStatus hydro_status;
+  // record hydro running status, set by EvolveHydro() which may run in
+  // the background while the jets read it
+  std::atomic<HydroStatus> hydro_status;
 
   // add initial state shared pointer
   /** A pointer of type InitialState class.
@@ -72,6 +78,20 @@ protected:
 
   std::weak_ptr<LiquefierBase> liquefier_ptr;
 
+  /** Number of threads of the surface finder, <Hydro><nSurfaceFinderThreads>. */
+  int n_surface_finder_threads;
+
+  /** Time slices kept in the sliding window of bulk_info,
+      <Hydro><nEvolutionWindowFrames>; 0 keeps the full history. */
+  int n_evolution_window_frames;
+
+  /** Partons in cells colder than this no longer hold back the sliding
+      window, <Hydro><evolutionWindowTc> [GeV]. */
+  Jetscape::real evolution_window_tc;
+
+  /** EvolveHydro() running in the background with a sliding window. */
+  std::future<void> hydro_evolution;
+
 public:
   /** Default constructor. task ID as "FluidDynamics",  
         eta is initialized to -99.99.
@@ -129,9 +149,44 @@ public:
     */
   virtual void GetHydroCell(double t, double x, double y, double z,
                             std::unique_ptr<FluidCellInfo> &fCell) {
+    JSPROFILE("Signal", "GetHydroCell");
+    bulk_info.WaitForTimeSlice_tz(t, z);
     GetHydroInfo(t, x, y, z, fCell);
   }
 
+  /** Slot of the batched hydro signal: it waits for the time slices of the
+      points if the evolution history is streamed, and calls
+      GetHydroInfoBatch().
+    */
+  void GetHydroCellBatch(int n_points, const Jetscape::real *t,
+                         const Jetscape::real *x, const Jetscape::real *y,
+                         const Jetscape::real *z, unsigned int field_mask,
+                         Jetscape::real *output);
+
+  /** @return true if the hydro pushes its evolution history into a sliding
+      window while the jets run on the main clock, see
+      <Hydro><nEvolutionWindowFrames>.
+    */
+  bool IsStreamingEvolutionHistory() const {
+    return (n_evolution_window_frames > 0);
+  }
+
+  /** Evict the time slices below the slowest parton of the showers that
+      can still read this medium (see EvolutionHistory::IsReachable()), and
+      make room in the sliding window for the slices read up to t_next.
+      Called between two time steps of the main clock.
+	@param showers The energy loss modules, see JetEnergyLoss::GetSlowestPartonProperTime().
+	@param t_next Largest time the jets read before the next call.
+    */
+  void ReleaseHydroEvolutionHistory(
+      const std::vector<std::shared_ptr<JetEnergyLoss>> &showers,
+      Jetscape::real t_next);
+
+  /** Release the whole sliding window and wait for the hydro evolution of
+      the event running in the background; its exceptions are rethrown.
+    */
+  void FinishHydroEvolution();
+
   // currently we have no standard for passing configurations
   // pure virtual function; to be implemented by users
   // should make it easy to save evolution history to bulk_info
@@ -147,7 +202,7 @@ public:
 
   void StoreHydroEvolutionHistory(
       std::unique_ptr<FluidCellInfo> &fluid_cell_info_ptr) {
-    bulk_info.data.push_back(*fluid_cell_info_ptr);
+    bulk_info.AddCell(*fluid_cell_info_ptr);
   }
 
   void clear_up_evolution_data() { bulk_info.clear_up_evolution_data(); }
@@ -178,7 +233,7 @@ public:
   GetHydroInfo(Jetscape::real t, Jetscape::real x, Jetscape::real y,
                Jetscape::real z,
                std::unique_ptr<FluidCellInfo> &fluid_cell_info_ptr) {
-    if (hydro_status != FINISHED || bulk_info.data.size() == 0) {
+    if (hydro_status != FINISHED || bulk_info.get_data_size() == 0) {
       throw std::runtime_error("Hydro evolution is not finished "
                                "or EvolutionHistory is empty");
     }
@@ -194,6 +249,28 @@ public:
     }
   }
 
+  /** Retrieves the hydro information at a batch of space-time points.
+     * Only the fields selected in field_mask are written, the k-th selected
+     * field (in the order of EntryName) at the i-th point goes to
+     * output[k * n_points + i]. The output buffer is owned by the caller and
+     * must hold NumberOfEntries(field_mask) * n_points values. The default
+     * implementation calls GetHydroInfo() for every point, modules are
+     * expected to override it with an allocation-free version.
+     @param n_points Number of space-time points.
+     @param t Time or tau coordinates.
+     @param x Space coordinates.
+     @param y Space coordinates.
+     @param z Space or eta coordinates.
+     @param field_mask Bit mask of the requested fields, see EntryMask().
+     @param output Caller-owned output buffer.
+    */
+  virtual void GetHydroInfoBatch(int n_points, const Jetscape::real *t,
+                                 const Jetscape::real *x,
+                                 const Jetscape::real *y,
+                                 const Jetscape::real *z,
+                                 unsigned int field_mask,
+                                 Jetscape::real *output);
+
   // this function print out the information of the fluid cell to the screen
   /** It prints out the information of the fluid cell.
 	@param fluid_cell_info_ptr A pointer to FluidCellInfor class.
@@ -202,7 +279,7 @@ public:
 
   // this function returns hypersurface for Cooper-Frye or recombination
   // the detailed implementation is left to the hydro developper
-  /** @return Default function to get the hypersurface for Cooper-Frye or recombination model. It can overridden by different modules.
+  /** @return Default function to get the hypersurface for Cooper-Frye or recombination model. The time slices are scanned on <Hydro><nSurfaceFinderThreads> threads. It can overridden by different modules.
      */
   std::vector<SurfaceCellInfo>
   FindAConstantTemperatureSurface(Jetscape::real T_sw);
@@ -15,6 +15,12 @@
 // This is a general basic class for hydrodynamics
 
 #include <string>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <limits>
 #include <MakeUniqueHelper.h>
 #include "FluidEvolutionHistory.h"
 #include "FluidCellInfo.h"
@@ -57,6 +63,226 @@ EntryName ResolveEntryName(std::string input) {
   }
 }
 
+// read one entry of a fluid cell given its EntryName
+Jetscape::real GetEntryValue(const FluidCellInfo &cell, EntryName entry) {
+  switch (entry) {
+  case ENTRY_ENERGY_DENSITY:
+    return cell.energy_density;
+  case ENTRY_ENTROPY_DENSITY:
+    return cell.entropy_density;
+  case ENTRY_TEMPERATURE:
+    return cell.temperature;
+  case ENTRY_PRESSURE:
+    return cell.pressure;
+  case ENTRY_QGP_FRACTION:
+    return cell.qgp_fraction;
+  case ENTRY_MU_B:
+    return cell.mu_B;
+  case ENTRY_MU_C:
+    return cell.mu_C;
+  case ENTRY_MU_S:
+    return cell.mu_S;
+  case ENTRY_VX:
+    return cell.vx;
+  case ENTRY_VY:
+    return cell.vy;
+  case ENTRY_VZ:
+    return cell.vz;
+  case ENTRY_PI00:
+    return cell.pi[0][0];
+  case ENTRY_PI01:
+    return cell.pi[0][1];
+  case ENTRY_PI02:
+    return cell.pi[0][2];
+  case ENTRY_PI03:
+    return cell.pi[0][3];
+  case ENTRY_PI11:
+    return cell.pi[1][1];
+  case ENTRY_PI12:
+    return cell.pi[1][2];
+  case ENTRY_PI13:
+    return cell.pi[1][3];
+  case ENTRY_PI22:
+    return cell.pi[2][2];
+  case ENTRY_PI23:
+    return cell.pi[2][3];
+  case ENTRY_PI33:
+    return cell.pi[3][3];
+  case ENTRY_BULK_PI:
+    return cell.bulk_Pi;
+  default:
+    return 0.0;
+  }
+}
+
+// write one entry of a fluid cell given its EntryName
+void SetEntryValue(FluidCellInfo &cell, EntryName entry, Jetscape::real value) {
+  switch (entry) {
+  case ENTRY_ENERGY_DENSITY:
+    cell.energy_density = value;
+    break;
+  case ENTRY_ENTROPY_DENSITY:
+    cell.entropy_density = value;
+    break;
+  case ENTRY_TEMPERATURE:
+    cell.temperature = value;
+    break;
+  case ENTRY_PRESSURE:
+    cell.pressure = value;
+    break;
+  case ENTRY_QGP_FRACTION:
+    cell.qgp_fraction = value;
+    break;
+  case ENTRY_MU_B:
+    cell.mu_B = value;
+    break;
+  case ENTRY_MU_C:
+    cell.mu_C = value;
+    break;
+  case ENTRY_MU_S:
+    cell.mu_S = value;
+    break;
+  case ENTRY_VX:
+    cell.vx = value;
+    break;
+  case ENTRY_VY:
+    cell.vy = value;
+    break;
+  case ENTRY_VZ:
+    cell.vz = value;
+    break;
+  case ENTRY_PI00:
+    cell.pi[0][0] = value;
+    break;
+  case ENTRY_PI01:
+    cell.pi[0][1] = value;
+    cell.pi[1][0] = value;
+    break;
+  case ENTRY_PI02:
+    cell.pi[0][2] = value;
+    cell.pi[2][0] = value;
+    break;
+  case ENTRY_PI03:
+    cell.pi[0][3] = value;
+    cell.pi[3][0] = value;
+    break;
+  case ENTRY_PI11:
+    cell.pi[1][1] = value;
+    break;
+  case ENTRY_PI12:
+    cell.pi[1][2] = value;
+    cell.pi[2][1] = value;
+    break;
+  case ENTRY_PI13:
+    cell.pi[1][3] = value;
+    cell.pi[3][1] = value;
+    break;
+  case ENTRY_PI22:
+    cell.pi[2][2] = value;
+    break;
+  case ENTRY_PI23:
+    cell.pi[2][3] = value;
+    cell.pi[3][2] = value;
+    break;
+  case ENTRY_PI33:
+    cell.pi[3][3] = value;
+    break;
+  case ENTRY_BULK_PI:
+    cell.bulk_Pi = value;
+    break;
+  default:
+    break;
+  }
+}
+
+namespace {
+
+// copy the time slices [first_frame, end_frame) of a ring of old_frames
+// slices to their slots in a ring of new_frames slices
+template <class T>
+void ResizeRing(std::vector<T> &ring, int old_frames, int new_frames,
+                int first_frame, int end_frame, size_t frame_size) {
+  std::vector<T> resized(new_frames * frame_size);
+  for (int frame = first_frame; frame < end_frame; frame++) {
+    auto begin = ring.begin() + (frame % old_frames) * frame_size;
+    std::copy(begin, begin + frame_size,
+              resized.begin() + (frame % new_frames) * frame_size);
+  }
+  ring.swap(resized);
+}
+
+// IEEE 754 binary16 conversions with round-to-nearest-even,
+// used to quantise the columns selected as half precision
+uint16_t FloatToHalf(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  uint32_t sign = (bits >> 16) & 0x8000u;
+  int exponent_float = (bits >> 23) & 0xff;
+  uint32_t mantissa = bits & 0x7fffffu;
+  if (exponent_float == 0xff) {
+    // inf or nan
+    return static_cast<uint16_t>(sign | 0x7c00u | (mantissa ? 0x200u : 0u));
+  }
+  int exponent = exponent_float - 127 + 15;
+  if (exponent >= 0x1f) {
+    // overflow
+    return static_cast<uint16_t>(sign | 0x7c00u);
+  }
+  if (exponent <= 0) {
+    // subnormal numbers in half precision
+    if (exponent < -10) {
+      return static_cast<uint16_t>(sign);
+    }
+    mantissa |= 0x800000u;
+    int shift = 14 - exponent;
+    uint32_t half_mantissa = mantissa >> shift;
+    uint32_t remainder = mantissa & ((1u << shift) - 1u);
+    uint32_t halfway = 1u << (shift - 1);
+    if (remainder > halfway ||
+        (remainder == halfway && (half_mantissa & 1u))) {
+      half_mantissa++;
+    }
+    return static_cast<uint16_t>(sign | half_mantissa);
+  }
+  uint32_t half = sign | (exponent << 10) | (mantissa >> 13);
+  uint32_t remainder = mantissa & 0x1fffu;
+  // a carry into the exponent gives the correct rounded result
+  if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+    half++;
+  }
+  return static_cast<uint16_t>(half);
+}
+
+float HalfToFloat(uint16_t half) {
+  uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+  uint32_t exponent = (half >> 10) & 0x1fu;
+  uint32_t mantissa = half & 0x3ffu;
+  uint32_t bits;
+  if (exponent == 0) {
+    if (mantissa == 0) {
+      bits = sign;
+    } else {
+      // renormalise the subnormal number
+      exponent = 127 - 15 + 1;
+      while ((mantissa & 0x400u) == 0) {
+        mantissa <<= 1;
+        exponent--;
+      }
+      mantissa &= 0x3ffu;
+      bits = sign | (exponent << 23) | (mantissa << 13);
+    }
+  } else if (exponent == 0x1f) {
+    bits = sign | 0x7f800000u | (mantissa << 13);
+  } else {
+    bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+  }
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+} // end anonymous namespace
+
 // It checks whether a space-time point (tau, x, y, eta) is inside evolution
 // history or outside.
 int EvolutionHistory::CheckInRange(Jetscape::real tau, Jetscape::real x,
@@ -106,8 +332,36 @@ void EvolutionHistory::FromVector(const std::vector<float> &data_,
                                   float dx_, int nx_, float y_min_, float dy_,
                                   int ny_, float eta_min_, float deta_,
                                   int neta_, bool tau_eta_is_tz_) {
-  data_vector = data_;
-  data_info = data_info_;
+  if (window_frames > 0) {
+    JSWARN << "The sliding window is only used for the cells appended with "
+           << "AddCell(), the full evolution history is kept.";
+    window_frames = 0;
+    sliding_window = false;
+  }
+  if (columnar) {
+    // keep only the selected fields, one array per field
+    clear_up_evolution_data();
+    data_vector.clear();
+    data_info.clear();
+    std::vector<EntryName> entry_names;
+    for (const auto &name : data_info_) {
+      entry_names.push_back(ResolveEntryName(name));
+    }
+    int entries_per_record = data_info_.size();
+    int number_of_records = data_.size() / entries_per_record;
+    for (int i = 0; i < number_of_records; i++) {
+      FluidCellInfo fluid_cell;
+      for (int j = 0; j < entries_per_record; j++) {
+        SetEntryValue(fluid_cell, entry_names[j],
+                      data_[i * entries_per_record + j]);
+      }
+      AddCell(fluid_cell);
+    }
+  } else {
+    data_vector = data_;
+    data_info = data_info_;
+    CompileDataInfo();
+  }
   tau_min = tau_min_;
   x_min = x_min_;
   y_min = y_min_;
@@ -123,10 +377,403 @@ void EvolutionHistory::FromVector(const std::vector<float> &data_,
   ntau = data_.size() / (data_info_.size() * nx * ny * neta);
 }
 
+/** Resolve the entry names in data_info once */
+void EvolutionHistory::CompileDataInfo() {
+  data_info_entries.clear();
+  data_info_offsets.assign(ENTRY_INVALID, -1);
+  for (unsigned int i = 0; i < data_info.size(); i++) {
+    auto entry_name = ResolveEntryName(data_info[i]);
+    if (entry_name == ENTRY_INVALID) {
+      JSWARN << "The entry name in data_info_ must be one of the \
+                        energy_density, entropy_density, temperature, pressure, qgp_fraction, \
+                        mu_b, mu_c, mu_s, vx, vy, vz, pi00, pi01, pi02, pi03, pi11, pi12, \
+                        pi13, pi22, pi23, pi33, bulk_pi; got " << data_info[i];
+    } else {
+      data_info_offsets[entry_name] = i;
+    }
+    data_info_entries.push_back(entry_name);
+  }
+}
+
+/** Switch to one array per field, moving the cells already stored */
+void EvolutionHistory::SetColumnarStorage(unsigned int kept_fields,
+                                          unsigned int half_precision_fields) {
+  std::vector<FluidCellInfo> stored_cells;
+  if (window_frames > 0) {
+    // the ring of time slices can not be moved cell by cell
+    if (n_window_cells > 0) {
+      JSWARN << "Switching to columnar storage drops the "
+             << n_window_cells << " cells of the sliding window.";
+    }
+  } else if (columnar) {
+    for (int i = 0; i < n_column_cells; i++) {
+      FluidCellInfo fluid_cell;
+      for (const auto &entry_name : column_entries) {
+        SetEntryValue(fluid_cell, entry_name, ColumnValue(entry_name, i));
+      }
+      stored_cells.push_back(fluid_cell);
+    }
+  } else {
+    stored_cells.swap(data);
+  }
+  clear_up_evolution_data();
+
+  columnar = true;
+  column_fields = kept_fields & ENTRY_MASK_ALL;
+  half_precision_column_fields = half_precision_fields & column_fields;
+  column_entries.clear();
+  for (int i = 0; i < ENTRY_INVALID; i++) {
+    auto entry_name = static_cast<EntryName>(i);
+    if (column_fields & EntryMask(entry_name)) {
+      column_entries.push_back(entry_name);
+    }
+  }
+
+  for (const auto &fluid_cell : stored_cells) {
+    AddCell(fluid_cell);
+  }
+}
+
+/** Append one fluid cell in the active storage mode */
+void EvolutionHistory::AddCell(const FluidCellInfo &cell) {
+  if (sliding_window) {
+    int frame_size = nx * ny * std::max(1, neta);
+    int64_t frame = n_window_cells / frame_size;
+    if (n_window_cells % frame_size == 0) {
+      if (n_window_cells == 0) {
+        // the ring is allocated once, the slots are then overwritten
+        int capacity = window_frames * frame_size;
+        if (columnar) {
+          for (const auto &entry_name : column_entries) {
+            if (half_precision_column_fields & EntryMask(entry_name)) {
+              half_columns[entry_name].assign(capacity, 0);
+            } else {
+              columns[entry_name].assign(capacity, 0.0);
+            }
+          }
+          n_column_cells = capacity;
+        } else {
+          data.assign(capacity, FluidCellInfo());
+        }
+      }
+      // wait until the slot of this time slice is released
+      std::unique_lock<std::mutex> lock(window_state.mutex);
+      window_state.changed.wait(lock, [&]() {
+        return (frame - window_state.first_frame < window_frames &&
+                !window_state.resize_pending);
+      });
+      window_state.writing = true;
+    }
+    StoreCell(static_cast<int>((frame % window_frames) * frame_size +
+                               n_window_cells % frame_size),
+              cell);
+    n_window_cells++;
+    if (n_window_cells % frame_size == 0) {
+      std::lock_guard<std::mutex> lock(window_state.mutex);
+      window_state.n_complete_frames = static_cast<int>(frame) + 1;
+      window_state.writing = false;
+      AdvanceWindow();
+      window_state.changed.notify_all();
+    }
+    return;
+  }
+  if (!columnar) {
+    data.push_back(cell);
+    return;
+  }
+  for (const auto &entry_name : column_entries) {
+    auto value = GetEntryValue(cell, entry_name);
+    if (half_precision_column_fields & EntryMask(entry_name)) {
+      half_columns[entry_name].push_back(FloatToHalf(value));
+    } else {
+      columns[entry_name].push_back(value);
+    }
+  }
+  n_column_cells++;
+}
+
+void EvolutionHistory::StoreCell(int cell_index, const FluidCellInfo &cell) {
+  if (!columnar) {
+    data[cell_index] = cell;
+    return;
+  }
+  for (const auto &entry_name : column_entries) {
+    auto value = GetEntryValue(cell, entry_name);
+    if (half_precision_column_fields & EntryMask(entry_name)) {
+      half_columns[entry_name][cell_index] = FloatToHalf(value);
+    } else {
+      columns[entry_name][cell_index] = value;
+    }
+  }
+}
+
+void EvolutionHistory::SetSlidingWindow(int n_frames) {
+  window_frames = (n_frames > 0) ? std::max(2, n_frames) : 0;
+  sliding_window = (window_frames > 0);
+  clear_up_evolution_data();
+}
+
+int EvolutionHistory::WindowFrame(Jetscape::real tau) const {
+  if (tau <= tau_min) {
+    return (0);
+  }
+  if (tau >= TauMax()) {
+    return (std::max(0, ntau - 1));
+  }
+  return (std::min(ntau - 1, GetIdTau(tau)));
+}
+
+void EvolutionHistory::AdvanceWindow() {
+  if (window_state.n_complete_frames == 0) {
+    return;
+  }
+  // the last complete time slice is always kept
+  int released_frame = std::min(WindowFrame(window_state.released_tau),
+                                window_state.n_complete_frames - 1);
+  window_state.first_frame =
+      std::max(window_state.first_frame.load(), released_frame);
+}
+
+void EvolutionHistory::ResizeWindow(int n_frames) {
+  size_t frame_size = nx * ny * std::max(1, neta);
+  int first_frame = window_state.first_frame;
+  int end_frame = window_state.n_complete_frames;
+  // the kept slices move to their slots in the larger ring
+  if (columnar) {
+    for (const auto &entry_name : column_entries) {
+      if (half_precision_column_fields & EntryMask(entry_name)) {
+        ResizeRing(half_columns[entry_name], window_frames, n_frames,
+                   first_frame, end_frame, frame_size);
+      } else {
+        ResizeRing(columns[entry_name], window_frames, n_frames, first_frame,
+                   end_frame, frame_size);
+      }
+    }
+    n_column_cells = n_frames * frame_size;
+  } else {
+    ResizeRing(data, window_frames, n_frames, first_frame, end_frame,
+               frame_size);
+  }
+  window_frames = n_frames;
+}
+
+void EvolutionHistory::BeginTimeSlices() {
+  clear_up_evolution_data();
+  std::lock_guard<std::mutex> lock(window_state.mutex);
+  window_state.released_tau = -1e30;
+  window_state.finished = false;
+  window_state.warned = false;
+}
+
+void EvolutionHistory::EndTimeSlices() {
+  std::lock_guard<std::mutex> lock(window_state.mutex);
+  window_state.finished = true;
+  window_state.writing = false;
+  window_state.changed.notify_all();
+}
+
+void EvolutionHistory::WaitForTimeSlice(Jetscape::real tau) const {
+  if (window_frames == 0) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(window_state.mutex);
+  // the grid is known once the first time slice is complete
+  window_state.changed.wait(lock, [&]() {
+    if (window_state.finished) {
+      return (true);
+    }
+    if (window_state.n_complete_frames == 0) {
+      return (false);
+    }
+    int upper_frame = std::min(WindowFrame(tau) + 1, ntau - 1);
+    return (upper_frame < window_state.n_complete_frames ||
+            upper_frame >= window_state.first_frame + window_frames);
+  });
+  // Slices beyond the window are only stored once the jets asking for
+  // them have released the earlier ones, ReserveTimeSlices() makes room for
+  // them in time. Evicted slices belong to partons that left the medium.
+  if (window_state.n_complete_frames > 0 && !window_state.warned &&
+      std::min(WindowFrame(tau) + 1, ntau - 1) >=
+          window_state.first_frame + window_frames) {
+    window_state.warned = true;
+    JSWARN << "tau = " << tau << " is beyond the sliding window ["
+           << TauCoord(window_state.first_frame) << ", "
+           << TauCoord(window_state.first_frame + window_frames - 1)
+           << "] of the evolution history, the last time slice of the window "
+           << "is read instead; increase nEvolutionWindowFrames.";
+  }
+}
+
+void EvolutionHistory::WaitForTimeSlice_tz(Jetscape::real t,
+                                           Jetscape::real z) const {
+  if (window_frames == 0) {
+    return;
+  }
+  Jetscape::real tau = t;
+  if (!tau_eta_is_tz) {
+    tau = (t * t > z * z) ? sqrt(t * t - z * z) : 0.0;
+  }
+  WaitForTimeSlice(tau);
+}
+
+void EvolutionHistory::ReleaseTimeSlices(Jetscape::real tau) {
+  if (window_frames == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(window_state.mutex);
+  window_state.released_tau = std::max(window_state.released_tau, tau);
+  AdvanceWindow();
+  window_state.changed.notify_all();
+}
+
+void EvolutionHistory::ReserveTimeSlices(Jetscape::real tau) {
+  if (window_frames == 0) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(window_state.mutex);
+  // half a slice more, the reads at tau may round up to the next slice
+  auto needed_frames = [&]() {
+    return (std::min(WindowFrame(tau + 0.5 * dtau) + 1, ntau - 1) -
+            window_state.first_frame + 1);
+  };
+  // all the slices are stored once the producer has finished
+  if (window_state.finished || window_state.n_complete_frames == 0 ||
+      needed_frames() <= window_frames) {
+    return;
+  }
+  window_state.resize_pending = true;
+  window_state.changed.wait(lock, [&]() { return (!window_state.writing); });
+  int n_frames = std::min(std::max(needed_frames(), 2 * window_frames), ntau);
+  if (n_frames > window_frames) {
+    JSINFO << "The jets read the time slices from tau = "
+           << TauCoord(window_state.first_frame) << " to " << tau
+           << ", the sliding window of the evolution history grows to "
+           << n_frames << " slices.";
+    ResizeWindow(n_frames);
+  }
+  window_state.resize_pending = false;
+  window_state.changed.notify_all();
+}
+
+bool EvolutionHistory::IsReachable(Jetscape::real t, Jetscape::real x,
+                                   Jetscape::real y, Jetscape::real z,
+                                   Jetscape::real vz,
+                                   Jetscape::real T_min) const {
+  int first_frame = 0;
+  int end_frame = ntau;
+  if (window_frames > 0) {
+    std::lock_guard<std::mutex> lock(window_state.mutex);
+    if (window_state.n_complete_frames == 0) {
+      // the grid is not known yet
+      return (true);
+    }
+    first_frame = window_state.first_frame;
+    end_frame = window_state.n_complete_frames;
+  }
+  if (x < x_min || x > XMax() || y < y_min || y > YMax()) {
+    return (false);
+  }
+
+  Jetscape::real tau = t;
+  Jetscape::real eta = z;
+  // the value eta tends to along the straight line
+  Jetscape::real eta_limit = z;
+  if (vz != 0) {
+    eta_limit = std::copysign(std::numeric_limits<Jetscape::real>::max(), vz);
+  }
+  if (!tau_eta_is_tz) {
+    if (t <= std::abs(z)) {
+      // outside of the light cone, it enters unless it moves at the speed
+      // of light
+      return (std::abs(vz) < 1.0);
+    }
+    tau = sqrt(t * t - z * z);
+    eta = 0.5 * log((t + z) / (t - z));
+    // the space-time rapidity tends to the rapidity of the velocity
+    if (std::abs(vz) < 1.0) {
+      eta_limit = 0.5 * log((1.0 + vz) / (1.0 - vz));
+    }
+  }
+  if (!boost_invariant && ((eta < eta_min && eta_limit <= eta_min) ||
+                           (eta > EtaMax() && eta_limit >= EtaMax()))) {
+    return (false);
+  }
+  if (tau > TauMax()) {
+    return (false);
+  }
+  if (tau < tau_min) {
+    return (true);
+  }
+
+  int lower_frame = std::min(ntau - 1, GetIdTau(tau));
+  int upper_frame = std::min(lower_frame + 1, ntau - 1);
+  if (lower_frame < first_frame) {
+    return (false);
+  }
+  if (upper_frame >= end_frame) {
+    return (true);
+  }
+  return (get(tau, x, y, eta).temperature >= T_min);
+}
+
+Jetscape::real EvolutionHistory::ColumnValue(int entry, int cell_index) const {
+  if (half_precision_column_fields & (1u << entry)) {
+    return (HalfToFloat(half_columns[entry][cell_index]));
+  }
+  return (columns[entry][cell_index]);
+}
+
+void EvolutionHistory::clear_up_evolution_data() {
+  data.clear();
+  for (int i = 0; i < ENTRY_INVALID; i++) {
+    columns[i].clear();
+    half_columns[i].clear();
+  }
+  n_column_cells = 0;
+  n_window_cells = 0;
+  std::lock_guard<std::mutex> lock(window_state.mutex);
+  window_state.n_complete_frames = 0;
+  window_state.first_frame = 0;
+}
+
+int EvolutionHistory::get_data_size() const {
+  if (window_frames > 0) {
+    // the time slices kept in the window
+    std::lock_guard<std::mutex> lock(window_state.mutex);
+    return ((window_state.n_complete_frames - window_state.first_frame) *
+            nx * ny * std::max(1, neta));
+  }
+  if (columnar) {
+    return (n_column_cells);
+  }
+  if (data_info.size() > 0) {
+    return (data_vector.size() / data_info.size());
+  }
+  return (data.size());
+}
+
+size_t EvolutionHistory::GetMemoryFootprint() const {
+  size_t bytes = data.capacity() * sizeof(FluidCellInfo);
+  bytes += data_vector.capacity() * sizeof(float);
+  for (int i = 0; i < ENTRY_INVALID; i++) {
+    bytes += columns[i].capacity() * sizeof(float);
+    bytes += half_columns[i].capacity() * sizeof(uint16_t);
+  }
+  return (bytes);
+}
+
 /* This function will read the sparse data stored in data_ with associated 
  * information data_info_ into to FluidCellInfo object */
 FluidCellInfo EvolutionHistory::GetFluidCell(int id_tau, int id_x, int id_y,
                                              int id_eta) const {
+  FluidCellInfo fluid_cell;
+  GetFluidCell(id_tau, id_x, id_y, id_eta, fluid_cell);
+  return fluid_cell;
+}
+
+/* Same as above, filling a fluid cell owned by the caller */
+void EvolutionHistory::GetFluidCell(int id_tau, int id_x, int id_y, int id_eta,
+                                    FluidCellInfo &fluid_cell) const {
   int entries_per_record = data_info.size();
   int id_eta_corrected = id_eta;
   // set id_eta=0 if hydro is in 2+1D mode
@@ -136,101 +783,85 @@ FluidCellInfo EvolutionHistory::GetFluidCell(int id_tau, int id_x, int id_y,
 
   int record_starting_id = CellIndex(id_tau, id_x, id_y, id_eta_corrected);
 
+  // columnar storage: only the stored fields are filled
+  if (columnar) {
+    fluid_cell = FluidCellInfo();
+    for (const auto &entry_name : column_entries) {
+      SetEntryValue(fluid_cell, entry_name,
+                    ColumnValue(entry_name, record_starting_id));
+    }
+    return;
+  }
+
   // if data_vector and data_info are not used to construct evolution history
   // then the data should have the format of vector<FluidCellInfo>.
   if (entries_per_record == 0) {
-    return data.at(record_starting_id);
+    fluid_cell = data.at(record_starting_id);
+    return;
   }
+
   // otherwise construct the fluid cell info from data_vector and data_info
-  auto fluid_cell_ptr = make_unique<FluidCellInfo>();
+  if (record_starting_id < 0 ||
+      static_cast<size_t>(record_starting_id + 1) * entries_per_record >
+          data_vector.size()) {
+    std::ostringstream message;
+    message << "EvolutionHistory::GetFluidCell: cell " << record_starting_id
+            << " is outside data_vector of " << data_vector.size()
+            << " entries (" << entries_per_record << " per cell)";
+    throw std::out_of_range(message.str());
+  }
+  fluid_cell = FluidCellInfo();
+  const float *record =
+      data_vector.data() + record_starting_id * entries_per_record;
+  if (data_info_entries.size() == data_info.size()) {
+    for (int i = 0; i < entries_per_record; i++) {
+      SetEntryValue(fluid_cell, data_info_entries[i], record[i]);
+    }
+  } else {
+    // data_info was modified without calling CompileDataInfo()
+    for (int i = 0; i < entries_per_record; i++) {
+      SetEntryValue(fluid_cell, ResolveEntryName(data_info[i]), record[i]);
+    }
+  }
+}
+
+/* Read a single field for a given lattice cell, without building
+ * the full FluidCellInfo when the storage allows it */
+Jetscape::real EvolutionHistory::GetFluidCellEntry(int id_tau, int id_x,
+                                                   int id_y, int id_eta,
+                                                   EntryName entry) const {
+  if (neta == 0 || neta == 1) {
+    id_eta = 0;
+  }
+  return (EntryAtIndex(CellIndex(id_tau, id_x, id_y, id_eta), entry));
+}
 
-  record_starting_id *= entries_per_record;
+Jetscape::real EvolutionHistory::EntryAtIndex(int cell_index,
+                                              EntryName entry) const {
+  if (columnar) {
+    if ((column_fields & EntryMask(entry)) == 0) {
+      return (0.0);
+    }
+    return (ColumnValue(entry, cell_index));
+  }
+  int entries_per_record = data_info.size();
+  if (entries_per_record == 0) {
+    return (GetEntryValue(data[cell_index], entry));
+  }
+  if (data_info_entries.size() == data_info.size()) {
+    int offset = data_info_offsets[entry];
+    if (offset < 0) {
+      return (0.0);
+    }
+    return (data_vector[cell_index * entries_per_record + offset]);
+  }
+  Jetscape::real value = 0.0;
   for (int i = 0; i < entries_per_record; i++) {
-    auto entry_name = ResolveEntryName(data_info.at(i));
-    auto entry_data = data_vector.at(record_starting_id + i);
-    switch (entry_name) {
-    case ENTRY_ENERGY_DENSITY:
-      fluid_cell_ptr->energy_density = entry_data;
-      break;
-    case ENTRY_ENTROPY_DENSITY:
-      fluid_cell_ptr->entropy_density = entry_data;
-      break;
-    case ENTRY_TEMPERATURE:
-      fluid_cell_ptr->temperature = entry_data;
-      break;
-    case ENTRY_PRESSURE:
-      fluid_cell_ptr->pressure = entry_data;
-      break;
-    case ENTRY_QGP_FRACTION:
-      fluid_cell_ptr->qgp_fraction = entry_data;
-      break;
-    case ENTRY_MU_B:
-      fluid_cell_ptr->mu_B = entry_data;
-      break;
-    case ENTRY_MU_C:
-      fluid_cell_ptr->mu_C = entry_data;
-      break;
-    case ENTRY_MU_S:
-      fluid_cell_ptr->mu_S = entry_data;
-      break;
-    case ENTRY_VX:
-      fluid_cell_ptr->vx = entry_data;
-      break;
-    case ENTRY_VY:
-      fluid_cell_ptr->vy = entry_data;
-      break;
-    case ENTRY_VZ:
-      fluid_cell_ptr->vz = entry_data;
-      break;
-    case ENTRY_PI00:
-      fluid_cell_ptr->pi[0][0] = entry_data;
-      break;
-    case ENTRY_PI01:
-      fluid_cell_ptr->pi[0][1] = entry_data;
-      fluid_cell_ptr->pi[1][0] = entry_data;
-      break;
-    case ENTRY_PI02:
-      fluid_cell_ptr->pi[0][2] = entry_data;
-      fluid_cell_ptr->pi[2][0] = entry_data;
-      break;
-    case ENTRY_PI03:
-      fluid_cell_ptr->pi[0][3] = entry_data;
-      fluid_cell_ptr->pi[3][0] = entry_data;
-      break;
-    case ENTRY_PI11:
-      fluid_cell_ptr->pi[1][1] = entry_data;
-      break;
-    case ENTRY_PI12:
-      fluid_cell_ptr->pi[1][2] = entry_data;
-      fluid_cell_ptr->pi[2][1] = entry_data;
-      break;
-    case ENTRY_PI13:
-      fluid_cell_ptr->pi[1][3] = entry_data;
-      fluid_cell_ptr->pi[3][1] = entry_data;
-      break;
-    case ENTRY_PI22:
-      fluid_cell_ptr->pi[2][2] = entry_data;
-      break;
-    case ENTRY_PI23:
-      fluid_cell_ptr->pi[2][3] = entry_data;
-      fluid_cell_ptr->pi[3][2] = entry_data;
-      break;
-    case ENTRY_PI33:
-      fluid_cell_ptr->pi[3][3] = entry_data;
-      break;
-    case ENTRY_BULK_PI:
-      fluid_cell_ptr->bulk_Pi = entry_data;
-      break;
-    default:
-      JSWARN << "The entry name in data_info_ must be one of the \
-                        energy_density, entropy_density, temperature, pressure, qgp_fraction, \
-                        mu_b, mu_c, mu_s, vx, vy, vz, pi00, pi01, pi02, pi03, pi11, pi12, \
-                        pi13, pi22, pi23, pi33, bulk_pi";
-      break;
+    if (ResolveEntryName(data_info[i]) == entry) {
+      value = data_vector[cell_index * entries_per_record + i];
     }
   }
-
-  return *fluid_cell_ptr;
+  return (value);
 }
 
 /** For one given time step id_tau,
@@ -265,22 +896,119 @@ FluidCellInfo EvolutionHistory::GetAtTimeStep(int id_tau, Jetscape::real x,
                       c101, c110, c111, x, y, eta);
 }
 
+void EvolutionHistory::GatherEntry(EntryName entry, const int *cell_indices,
+                                   int n_cells, Jetscape::real *values) const {
+  int entries_per_record = data_info.size();
+  if (columnar) {
+    if ((column_fields & EntryMask(entry)) == 0) {
+      std::fill(values, values + n_cells, 0.0);
+    } else if (half_precision_column_fields & EntryMask(entry)) {
+      const uint16_t *column = half_columns[entry].data();
+      for (int c = 0; c < n_cells; c++) {
+        values[c] = HalfToFloat(column[cell_indices[c]]);
+      }
+    } else {
+      const float *column = columns[entry].data();
+      for (int c = 0; c < n_cells; c++) {
+        values[c] = column[cell_indices[c]];
+      }
+    }
+  } else if (entries_per_record == 0) {
+    for (int c = 0; c < n_cells; c++) {
+      values[c] = GetEntryValue(data[cell_indices[c]], entry);
+    }
+  } else if (data_info_entries.size() == data_info.size()) {
+    int offset = data_info_offsets[entry];
+    if (offset < 0) {
+      std::fill(values, values + n_cells, 0.0);
+    } else {
+      const float *record = data_vector.data() + offset;
+      for (int c = 0; c < n_cells; c++) {
+        values[c] = record[cell_indices[c] * entries_per_record];
+      }
+    }
+  } else {
+    for (int c = 0; c < n_cells; c++) {
+      values[c] = EntryAtIndex(cell_indices[c], entry);
+    }
+  }
+}
+
+void EvolutionHistory::InterpolateEntries(Jetscape::real tau, Jetscape::real x,
+                                          Jetscape::real y, Jetscape::real eta,
+                                          const EntryName *entries,
+                                          int n_entries,
+                                          Jetscape::real *result,
+                                          int result_stride) const {
+  if (CheckInRange(tau, x, y, eta) == 0) {
+    for (int k = 0; k < n_entries; k++) {
+      result[k * result_stride] = 0.0;
+    }
+    return;
+  }
+  int id_tau = GetIdTau(tau);
+  int id_x = GetIdX(x);
+  int id_y = GetIdY(y);
+  int id_eta = 0;
+  if (!boost_invariant)
+    id_eta = GetIdEta(eta);
+
+  // same fractions as in get(); along a degenerated direction
+  // (non-finite fraction) the lower grid point is used
+  real frac[4];
+  frac[0] = (tau - TauCoord(id_tau)) / (TauCoord(id_tau + 1) - TauCoord(id_tau));
+  frac[1] = (x - XCoord(id_x)) / (XCoord(id_x + 1) - XCoord(id_x));
+  frac[2] = (y - YCoord(id_y)) / (YCoord(id_y + 1) - YCoord(id_y));
+  real eta1 = 0.0;
+  if (!boost_invariant)
+    eta1 = EtaCoord(id_eta + 1);
+  frac[3] = (eta - EtaCoord(id_eta)) / (eta1 - EtaCoord(id_eta));
+  for (int i = 0; i < 4; i++) {
+    if (std::isfinite(frac[i]) == 0)
+      frac[i] = 0.0;
+  }
+  real weights[16];
+  QuadrilinearWeights(frac[0], frac[1], frac[2], frac[3], weights);
+
+  // set id_eta=0 if hydro is in 2+1D mode
+  int id_eta_corrected = id_eta;
+  if (neta == 0 || neta == 1) {
+    id_eta_corrected = 0;
+  }
+  int cell_indices[16];
+  for (int c = 0; c < 16; c++) {
+    cell_indices[c] =
+        CellIndex(id_tau + ((c >> 3) & 1), id_x + ((c >> 2) & 1),
+                  id_y + ((c >> 1) & 1), id_eta_corrected + (c & 1));
+  }
+
+  real corner_values[16 * ENTRY_INVALID];
+  real values[ENTRY_INVALID];
+  for (int k = 0; k < n_entries; k++) {
+    GatherEntry(entries[k], cell_indices, 16, corner_values + 16 * k);
+  }
+  QuadrilinearInt(weights, n_entries, corner_values, values);
+  for (int k = 0; k < n_entries; k++) {
+    result[k * result_stride] = values[k];
+  }
+}
+
 // do interpolation along time direction; we may also need high order
 // interpolation functions
 FluidCellInfo EvolutionHistory::get(Jetscape::real tau, Jetscape::real x,
                                     Jetscape::real y,
                                     Jetscape::real eta) const {
-  int status = CheckInRange(tau, x, y, eta);
-  if (status == 0) {
-    FluidCellInfo zero_cell;
-    return (zero_cell);
+  EntryName entries[ENTRY_INVALID];
+  real values[ENTRY_INVALID];
+  for (int i = 0; i < ENTRY_INVALID; i++) {
+    entries[i] = static_cast<EntryName>(i);
   }
-  int id_tau = GetIdTau(tau);
-  auto tau0 = TauCoord(id_tau);
-  auto tau1 = TauCoord(id_tau + 1);
-  auto bulk0 = GetAtTimeStep(id_tau, x, y, eta);
-  auto bulk1 = GetAtTimeStep(id_tau + 1, x, y, eta);
-  return (LinearInt(tau0, tau1, bulk0, bulk1, tau));
+  InterpolateEntries(tau, x, y, eta, entries, ENTRY_INVALID, values, 1);
+  FluidCellInfo fluid_cell;
+  for (int i = 0; i < ENTRY_INVALID; i++) {
+    SetEntryValue(fluid_cell, entries[i], values[i]);
+  }
+  return (fluid_cell);
 }
 
 FluidCellInfo EvolutionHistory::get_tz(Jetscape::real t, Jetscape::real x,
@@ -298,4 +1026,51 @@ FluidCellInfo EvolutionHistory::get_tz(Jetscape::real t, Jetscape::real x,
   return (get(tau, x, y, eta));
 }
 
+void EvolutionHistory::get_batch(int n_points, const Jetscape::real *tau,
+                                 const Jetscape::real *x,
+                                 const Jetscape::real *y,
+                                 const Jetscape::real *eta,
+                                 unsigned int field_mask,
+                                 Jetscape::real *output) const {
+  EntryName entries[ENTRY_INVALID];
+  int n_entries = 0;
+  for (int i = 0; i < ENTRY_INVALID; i++) {
+    if (field_mask & (1u << i)) {
+      entries[n_entries++] = static_cast<EntryName>(i);
+    }
+  }
+  for (int i = 0; i < n_points; i++) {
+    InterpolateEntries(tau[i], x[i], y[i], eta[i], entries, n_entries,
+                       output + i, n_points);
+  }
+}
+
+void EvolutionHistory::get_tz_batch(int n_points, const Jetscape::real *t,
+                                    const Jetscape::real *x,
+                                    const Jetscape::real *y,
+                                    const Jetscape::real *z,
+                                    unsigned int field_mask,
+                                    Jetscape::real *output) const {
+  EntryName entries[ENTRY_INVALID];
+  int n_entries = 0;
+  for (int i = 0; i < ENTRY_INVALID; i++) {
+    if (field_mask & (1u << i)) {
+      entries[n_entries++] = static_cast<EntryName>(i);
+    }
+  }
+  for (int i = 0; i < n_points; i++) {
+    Jetscape::real tau = 0.0;
+    Jetscape::real eta = 0.0;
+    if (t[i] * t[i] > z[i] * z[i]) {
+      tau = sqrt(t[i] * t[i] - z[i] * z[i]);
+      eta = 0.5 * log((t[i] + z[i]) / (t[i] - z[i]));
+    } else {
+      JSWARN << "the quest point is outside the light cone! "
+             << "t = " << t[i] << ", z = " << z[i];
+    }
+    InterpolateEntries(tau, x[i], y[i], eta, entries, n_entries, output + i,
+                       n_points);
+  }
+}
+
 } // end namespace Jetscape
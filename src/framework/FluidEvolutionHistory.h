@@ -18,7 +18,11 @@
 #define EVOLUTIONHISTORY_H
 
 #include <vector>
+#include <atomic>
+#include <cstdint>
 #include <stdexcept>
+#include <mutex>
+#include <condition_variable>
 #include "FluidCellInfo.h"
 #include "RealType.h"
 
@@ -68,6 +72,30 @@ enum EntryName {
 
 EntryName ResolveEntryName(std::string input);
 
+// Bit masks of EntryName used to select the fields kept by the columnar
+// storage, e.g. EntryMask(ENTRY_TEMPERATURE) | EntryMask(ENTRY_VX).
+inline unsigned int EntryMask(EntryName entry) { return (1u << entry); }
+const unsigned int ENTRY_MASK_ALL = (1u << ENTRY_INVALID) - 1u;
+const unsigned int ENTRY_MASK_SHEAR =
+    (1u << ENTRY_PI00) | (1u << ENTRY_PI01) | (1u << ENTRY_PI02) |
+    (1u << ENTRY_PI03) | (1u << ENTRY_PI11) | (1u << ENTRY_PI12) |
+    (1u << ENTRY_PI13) | (1u << ENTRY_PI22) | (1u << ENTRY_PI23) |
+    (1u << ENTRY_PI33);
+
+// number of fields selected in a bit mask of EntryName
+inline int NumberOfEntries(unsigned int field_mask) {
+  int n_entries = 0;
+  for (int i = 0; i < ENTRY_INVALID; i++) {
+    n_entries += (field_mask >> i) & 1u;
+  }
+  return (n_entries);
+}
+
+// read and write one entry of a fluid cell given its EntryName;
+// the off-diagonal shear components are kept symmetric
+Jetscape::real GetEntryValue(const FluidCellInfo &cell, EntryName entry);
+void SetEntryValue(FluidCellInfo &cell, EntryName entry, Jetscape::real value);
+
 class InvalidSpaceTimeRange : public std::invalid_argument {
   using std::invalid_argument::invalid_argument;
 };
@@ -88,7 +116,7 @@ public:
   int neta; //!< @param neta Number of grid points in eta-axis.
 
   /** Default is set to false. Set flag tau_eta_is_tz to true if hydro dynamics is setup in (t,x,y,z) coordinate. */
-  bool tau_eta_is_tz;
+  bool tau_eta_is_tz = false;
 
   bool boost_invariant;
 
@@ -106,6 +134,18 @@ public:
   /** Store the entry names of one record in the data array*/
   std::vector<std::string> data_info;
 
+  // The bulk information can also be stored column by column, i.e. one
+  // contiguous array per EntryName, see SetColumnarStorage(). Jet modules
+  // typically read only a few fields per query, so this layout costs less
+  // memory and much fewer cache misses than the vector of FluidCellInfo.
+
+  // With a sliding window, see SetSlidingWindow(), only the last few time
+  // slices appended with AddCell() are kept in a ring of frames. The hydro
+  // module pushes the slices while it runs, the jet modules wait for the
+  // slices they need with WaitForTimeSlice() and the framework evicts the
+  // slices that no jet can reach anymore with ReleaseTimeSlices(). The
+  // window grows if the jets need more slices, see ReserveTimeSlices().
+
   /** Default constructor. */
   EvolutionHistory() = default;
 
@@ -122,6 +162,89 @@ public:
                   float dy, int ny, float eta_min, float deta, int neta,
                   bool tau_eta_is_tz);
 
+  /** Resolve the entry names of data_info once into a table of offsets
+     * within one record, so that reading data_vector needs no string lookup.
+     * It is called by FromVector(); producers that fill data_vector and
+     * data_info by hand should call it afterwards. */
+  void CompileDataInfo();
+
+  /** Switch the evolution history to columnar storage. Only the fields
+     * in kept_fields (a combination of EntryMask) are stored, all the
+     * others read back as zero. The fields in half_precision_fields are
+     * quantised to 16-bit floating point numbers (relative precision about
+     * 5e-4), which is meant for rarely used fields such as the viscous
+     * corrections. Cells already stored in data are moved to the columns.
+     * @param kept_fields Bit mask of the fields to store.
+     * @param half_precision_fields Bit mask of the fields stored in 16 bits.
+     */
+  void SetColumnarStorage(unsigned int kept_fields = ENTRY_MASK_ALL,
+                          unsigned int half_precision_fields = 0);
+
+  /** @return true if the history is stored as one array per field. */
+  bool is_columnar() const { return (columnar); }
+
+  /** Append one fluid cell to the evolution history. The cells have to be
+     * stored in the order of CellIndex(). With a sliding window the grid
+     * (ntau, nx, ny, neta, ...) has to be set before the first cell, and
+     * the call waits while the window is full of slices not yet released. */
+  void AddCell(const FluidCellInfo &cell);
+
+  /** Keep n_frames time slices of the cells appended with AddCell()
+     * instead of the full history; 0 (default) keeps the full history.
+     * The window holds at least 2 slices, the interpolation in tau needs
+     * them. The consumers have to call WaitForTimeSlice() before reading.
+     * A time slice outside of the window reads as the nearest slice kept,
+     * so the slices must not be released while a jet can still read them.
+     * The history given by FromVector() is always kept in full.
+     * @param n_frames Number of time slices in the window. */
+  void SetSlidingWindow(int n_frames);
+
+  /** @return Number of time slices in the sliding window, 0 if the full
+     * history is kept. */
+  int GetSlidingWindow() const { return (window_frames); }
+
+  /** Start streaming a new evolution into the sliding window: forget the
+     * slices and the released time of the previous evolution. */
+  void BeginTimeSlices();
+
+  /** The producer has finished, WaitForTimeSlice() does not block anymore. */
+  void EndTimeSlices();
+
+  /** Wait until the two time slices around tau are stored, or the
+     * evolution is finished. It returns at once without a sliding window.
+     * It never waits for slices beyond the window, which are only stored
+     * once the earlier ones are released. These read as the last slice of
+     * the window, with a warning, and evicted slices as the first one.
+     * @param tau Light-cone coordinate (or t if tau_eta_is_tz). */
+  void WaitForTimeSlice(Jetscape::real tau) const;
+  void WaitForTimeSlice_tz(Jetscape::real t, Jetscape::real z) const;
+
+  /** No consumer reads before tau anymore, the slices below it can be
+     * evicted. The released time only increases within one evolution.
+     * @param tau Light-cone coordinate (or t if tau_eta_is_tz). */
+  void ReleaseTimeSlices(Jetscape::real tau);
+
+  /** The consumers may read the slices up to tau before the next release.
+     * If the window can not hold them together with the slices still kept,
+     * it grows (at least doubles) and keeps its size for the next
+     * evolutions. The producer is paused between two slices meanwhile.
+     * It must be called while no consumer reads the history.
+     * @param tau Light-cone coordinate (or t if tau_eta_is_tz). */
+  void ReserveTimeSlices(Jetscape::real tau);
+
+  /** @return False if a particle at the Cartesian point (t, x, y, z),
+     * moving along the beam axis with velocity vz, can not read this
+     * history again: it is outside of the transverse grid, beyond the eta
+     * range for good, past the last time slice, in a cell
+     * colder than T_min, or at a time slice already evicted. It is true
+     * while its time slices are not stored yet. */
+  bool IsReachable(Jetscape::real t, Jetscape::real x, Jetscape::real y,
+                   Jetscape::real z, Jetscape::real vz,
+                   Jetscape::real T_min) const;
+
+  /** @return Approximate memory used by the stored bulk information [bytes]. */
+  size_t GetMemoryFootprint() const;
+
   /** Default destructor. */
   ~EvolutionHistory() {
     data.clear();
@@ -129,9 +252,9 @@ public:
     data_info.clear();
   }
 
-  void clear_up_evolution_data() { data.clear(); }
+  void clear_up_evolution_data();
 
-  int get_data_size() const { return (data.size()); }
+  int get_data_size() const;
   bool is_boost_invariant() const { return (boost_invariant); }
 
   Jetscape::real Tau0() const { return (tau_min); }
@@ -229,12 +352,32 @@ public:
     id_x = std::min(nx - 1, std::max(0, id_x));
     id_y = std::min(ny - 1, std::max(0, id_y));
     id_eta = std::min(neta - 1, std::max(0, id_eta));
+    if (window_frames > 0) {
+      // slot of the time slice in the ring of the sliding window; the slots
+      // of the slices outside of the window hold other slices, these read
+      // the nearest slice kept
+      int first_frame =
+          window_state.first_frame.load(std::memory_order_relaxed);
+      int end_frame = std::min(
+          first_frame + window_frames,
+          window_state.n_complete_frames.load(std::memory_order_relaxed));
+      id_tau = std::max(first_frame, std::min(end_frame - 1, id_tau));
+      id_tau = id_tau % window_frames;
+    }
     return (id_tau * nx * ny * neta + id_x * ny * neta + id_y * neta + id_eta);
   }
 
   /* Read fluid cell info for a given lattice cell*/
   FluidCellInfo GetFluidCell(int id_tau, int id_x, int id_y, int id_eta) const;
 
+  /* Read fluid cell info for a given lattice cell into fluid_cell*/
+  void GetFluidCell(int id_tau, int id_x, int id_y, int id_eta,
+                    FluidCellInfo &fluid_cell) const;
+
+  /* Read a single field for a given lattice cell*/
+  Jetscape::real GetFluidCellEntry(int id_tau, int id_x, int id_y, int id_eta,
+                                   EntryName entry) const;
+
   // get the FluidCellInfo at space point given time step
   /** @return FluidCellInfo at a point (x,y,eta) and time-step id_tau.
 	@param id_tau tau-step number.
@@ -256,6 +399,112 @@ public:
                     Jetscape::real etas) const;
   FluidCellInfo get_tz(Jetscape::real t, Jetscape::real x, Jetscape::real y,
                        Jetscape::real z) const;
+
+  // get the fields selected in field_mask at n_points space time points
+  /** The k-th selected field (in the order of EntryName) at the i-th point
+     * is written to output[k * n_points + i]; the output buffer is owned by
+     * the caller and must hold NumberOfEntries(field_mask) * n_points values.
+     * Points outside the evolution history give zeros, as in get().
+        @param n_points Number of space time points.
+        @param tau Light-cone coordinates.
+        @param x Space coordinates.
+        @param y Space coordinates.
+        @param eta Light-cone coordinates.
+        @param field_mask Bit mask of the requested fields, see EntryMask().
+        @param output Caller-owned output buffer.
+    */
+  void get_batch(int n_points, const Jetscape::real *tau,
+                 const Jetscape::real *x, const Jetscape::real *y,
+                 const Jetscape::real *eta, unsigned int field_mask,
+                 Jetscape::real *output) const;
+  void get_tz_batch(int n_points, const Jetscape::real *t,
+                    const Jetscape::real *x, const Jetscape::real *y,
+                    const Jetscape::real *z, unsigned int field_mask,
+                    Jetscape::real *output) const;
+
+private:
+  // value of one field in the columnar storage
+  Jetscape::real ColumnValue(int entry, int cell_index) const;
+
+  // write one cell at a given position of the sliding window
+  void StoreCell(int cell_index, const FluidCellInfo &cell);
+
+  // move the first kept time slice up to the released time; the caller
+  // holds window_state.mutex
+  void AdvanceWindow();
+
+  // copy the kept time slices into a ring of n_frames slices; the caller
+  // holds window_state.mutex and the producer is paused
+  void ResizeWindow(int n_frames);
+
+  // time slice index of tau in the sliding window, clamped to [0, ntau];
+  // the caller holds window_state.mutex
+  int WindowFrame(Jetscape::real tau) const;
+
+  // value of one field for a given CellIndex, in any storage
+  Jetscape::real EntryAtIndex(int cell_index, EntryName entry) const;
+
+  // values of one field at n_cells given CellIndex, in any storage
+  void GatherEntry(EntryName entry, const int *cell_indices, int n_cells,
+                   Jetscape::real *values) const;
+
+  // interpolate the n_entries fields in entries at (tau, x, y, eta);
+  // the k-th field is written to result[k * result_stride]. The 16 corner
+  // weights are computed once and shared by all the fields.
+  void InterpolateEntries(Jetscape::real tau, Jetscape::real x,
+                          Jetscape::real y, Jetscape::real eta,
+                          const EntryName *entries, int n_entries,
+                          Jetscape::real *result, int result_stride) const;
+
+  // entry names of data_info and their offset in one record of data_vector
+  // (-1 if not provided), compiled by CompileDataInfo()
+  std::vector<EntryName> data_info_entries;
+  std::vector<int> data_info_offsets;
+
+  bool columnar = false;
+  unsigned int column_fields = 0;
+  unsigned int half_precision_column_fields = 0;
+  int n_column_cells = 0;
+  std::vector<EntryName> column_entries;
+  std::vector<float> columns[ENTRY_INVALID];
+  std::vector<uint16_t> half_columns[ENTRY_INVALID];
+
+  // sliding window of time slices, 0 for the full history; it only changes
+  // while the producer is paused, see ReserveTimeSlices()
+  int window_frames = 0;
+  // window_frames > 0, read by the producer at any time
+  bool sliding_window = false;
+  // cells appended to the window, only used by the producer
+  int64_t n_window_cells = 0;
+
+  // state shared between the producer and the consumers of the sliding
+  // window, guarded by its mutex; a copy gets its own mutex
+  struct SlidingWindowState {
+    SlidingWindowState() = default;
+    SlidingWindowState(const SlidingWindowState &other) { *this = other; }
+    SlidingWindowState &operator=(const SlidingWindowState &other) {
+      n_complete_frames = other.n_complete_frames.load();
+      first_frame = other.first_frame.load();
+      released_tau = other.released_tau;
+      finished = other.finished;
+      writing = other.writing;
+      resize_pending = other.resize_pending;
+      warned = other.warned;
+      return (*this);
+    }
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    // also read without the mutex by CellIndex()
+    std::atomic<int> n_complete_frames{0}; //!< time slices completely stored
+    std::atomic<int> first_frame{0};       //!< first time slice still kept
+    Jetscape::real released_tau = -1e30;
+    bool finished = true;
+    bool writing = false;        //!< the producer is storing a time slice
+    bool resize_pending = false; //!< the producer waits for ResizeWindow()
+    bool warned = false; //!< a slice beyond the window was asked for
+  };
+  mutable SlidingWindowState window_state;
 };
 
 } // namespace Jetscape
@@ -15,6 +15,7 @@
 
 #include "Hadronization.h"
 #include "JetScapeLogger.h"
+#include "JetScapeProfiler.h"
 #include <string>
 #include <vector>
 #include <iostream>
@@ -25,7 +26,10 @@ using namespace std;
 
 namespace Jetscape {
 
-Hadronization::Hadronization() { TransformPartonsConnected = false; }
+Hadronization::Hadronization() {
+  TransformPartonsConnected = false;
+  do_hadronization_profile_id = -1;
+}
 
 Hadronization::~Hadronization() {}
 
@@ -49,6 +53,16 @@ void Hadronization::Init() {
   JetScapeTask::InitTasks();
 }
 
+void Hadronization::ProfiledDoHadronization(
+    vector<vector<shared_ptr<Parton>>> &pIn, vector<shared_ptr<Hadron>> &hOut,
+    vector<shared_ptr<Parton>> &pOut) {
+  if (do_hadronization_profile_id < 0 && JetScapeProfiler::IsActive())
+    do_hadronization_profile_id = JetScapeProfiler::Instance()->Register(
+        "Signal", "DoHadronization:" + GetId());
+  JetScapeProfiler::Scope scope(do_hadronization_profile_id);
+  DoHadronization(pIn, hOut, pOut);
+}
+
 void Hadronization::DoHadronize() {
   VERBOSE(2) << "Get Recombination Partons...";
 
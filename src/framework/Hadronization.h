@@ -37,6 +37,10 @@ public:
   virtual void DoHadronization(vector<vector<shared_ptr<Parton>>> &pIn,
                                vector<shared_ptr<Hadron>> &hOut,
                                vector<shared_ptr<Parton>> &pOut){};
+  // Slot of TransformPartons: DoHadronization() recorded by JetScapeProfiler
+  void ProfiledDoHadronization(vector<vector<shared_ptr<Parton>>> &pIn,
+                               vector<shared_ptr<Hadron>> &hOut,
+                               vector<shared_ptr<Parton>> &pOut);
   virtual void WriteTask(weak_ptr<JetScapeWriter> w);
   virtual void Clear();
 
@@ -67,6 +71,7 @@ private:
   void DoHadronize();
 
   bool TransformPartonsConnected;
+  int do_hadronization_profile_id; // registered at the first call
 };
 
 } // namespace Jetscape
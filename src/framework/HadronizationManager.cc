@@ -15,6 +15,7 @@
 
 #include "HadronizationManager.h"
 #include "JetScapeLogger.h"
+#include "JetScapeProfiler.h"
 #include "JetScapeSignalManager.h"
 #include <string>
 #include "Hadronization.h"
@@ -123,6 +124,7 @@ void HadronizationManager::CreateSignalSlots() {
 }
 
 void HadronizationManager::GetHadrons(vector<shared_ptr<Hadron>>& signal){
+	JSPROFILE("Signal", "GetHadrons");
 	//signal = outHadrons;
 	signal.clear();
 	// foreach hadronizon object tasks
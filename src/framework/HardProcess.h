@@ -19,6 +19,7 @@
 #include "InitialState.h"
 #include "JetScapeModuleBase.h"
 #include "JetClass.h"
+#include "JetScapeProfiler.h"
 #include <vector>
 
 namespace Jetscape {
@@ -89,7 +90,10 @@ public:
   /** This function stores the vector of hard partons into a vector plist.
       @param plist A output vector of Parton class.
    */
-  void GetHardPartonList(vector<shared_ptr<Parton>> &plist) { plist = hp_list; }
+  void GetHardPartonList(vector<shared_ptr<Parton>> &plist) {
+    JSPROFILE("Signal", "GetHardPartonList");
+    plist = hp_list;
+  }
 
   /** Generated cross section.
       To be overwritten by implementations that have such information.
@@ -115,7 +119,10 @@ public:
   /** This function stores the vector of hadrons into a vector hlist.
       @param hlist an output vector of Hadron class.
    */
-  void GetHadronList(vector<shared_ptr<Hadron>> &hlist) { hlist = hd_list; }
+  void GetHadronList(vector<shared_ptr<Hadron>> &hlist) {
+    JSPROFILE("Signal", "GetHadronList");
+    hlist = hd_list;
+  }
 
   /** @return A vector of the Hadron class.
    */
@@ -66,6 +66,7 @@ public:
   void set_location(FourVector &x) { x_in_ = x; }
 
   FourVector &x_in() { return (x_in_); }
+  const FourVector &x_in() const { return (x_in_); }
 
   friend ostream &operator<<(ostream &output, Vertex &vertex) {
     output << vertex.x_in().x() << " " << vertex.x_in().y() << " "
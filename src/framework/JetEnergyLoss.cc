@@ -15,6 +15,8 @@
 
 #include <iostream>
 #include <thread>
+#include <limits>
+#include <algorithm>
 //#include <mutex>
 //#include <condition_variable>
 //#include <future>
@@ -50,6 +52,7 @@ JetEnergyLoss::JetEnergyLoss() {
   edensitySignalConnected = false;
   GetHydroCellSignalConnected = false;
   SentInPartonsConnected = false;
+  do_energy_loss_profile_id = -1;
 
   deltaT = 0;
   maxT = 0;
@@ -75,6 +78,7 @@ JetEnergyLoss::JetEnergyLoss(const JetEnergyLoss &j) {
   SetEdensitySignalConnected(false);
   SetGetHydroCellSignalConnected(false);
   SetSentInPartonsConnected(false);
+  do_energy_loss_profile_id = -1;
   AddModuleClock(j.GetModuleClock()); //JP: Check if memory leak ... should not due to shared_ptr usage, but confirm ...
 
   deltaT = j.deltaT;
@@ -91,6 +95,17 @@ JetEnergyLoss::JetEnergyLoss(const JetEnergyLoss &j) {
   }
 }
 
+void JetEnergyLoss::ProfiledDoEnergyLoss(double deltaT, double time,
+                                         double Q2, vector<Parton> &pIn,
+                                         vector<Parton> &pOut) {
+  // a module instance runs on one thread, the id needs no lock
+  if (do_energy_loss_profile_id < 0 && JetScapeProfiler::IsActive())
+    do_energy_loss_profile_id = JetScapeProfiler::Instance()->Register(
+        "Signal", "DoEnergyLoss:" + GetId());
+  JetScapeProfiler::Scope scope(do_energy_loss_profile_id);
+  DoEnergyLoss(deltaT, time, Q2, pIn, pOut);
+}
+
 void JetEnergyLoss::Clear() {
   VERBOSESHOWER(8);
   if (pShower)
@@ -102,6 +117,7 @@ void JetEnergyLoss::Clear() {
 
   pIn.clear();
   vStartVec.clear();
+  staged_droplets.clear();
 }
 
 void JetEnergyLoss::Init() {
@@ -161,8 +177,8 @@ void JetEnergyLoss::DoShower() {
 
   //vector<node> vStartVec;
   // Add here the Hard Shower emitting parton ...
-  vStart = pShower->new_vertex(make_shared<Vertex>());
-  vEnd = pShower->new_vertex(make_shared<Vertex>());
+  vStart = pShower->new_vertex(Vertex());
+  vEnd = pShower->new_vertex(Vertex());
   // Add original parton later, after it had a chance to acquire virtuality
   // pShower->new_parton(vStart,vEnd,make_shared<Parton>(*GetShowerInitiatingParton()));
 
@@ -203,7 +219,8 @@ void JetEnergyLoss::DoShower() {
 
       // apply liquefier
       if (!weak_ptr_is_uninitialized(liquefier_ptr)) {
-        liquefier_ptr.lock()->add_hydro_sources(pInTempModule, pOutTemp);
+        liquefier_ptr.lock()->add_hydro_sources(pInTempModule, pOutTemp,
+                                                staged_droplets);
       }
 
       // stuffs related to vertex
@@ -213,7 +230,7 @@ void JetEnergyLoss::DoShower() {
         // cerr << " ---------------------------------------------- "
         //      << endl;
         pShower->new_parton(vStart, vEnd,
-                            make_shared<Parton>(pInTempModule.at(0)));
+                            pInTempModule.at(0));
         foundchangedorig = true;
       }
 
@@ -241,14 +258,14 @@ void JetEnergyLoss::DoShower() {
           int edgeid = 0;
           if (pOutTemp[k].pstat() == neg_stat) {
             node vNewRootNode = pShower->new_vertex(
-                                  make_shared<Vertex>(0, 0, 0, currentTime - deltaT));
+                                  Vertex(0, 0, 0, currentTime - deltaT));
             edgeid = pShower->new_parton(vNewRootNode, vStart,
-                                         make_shared<Parton>(pOutTemp[k]));
+                                         pOutTemp[k]);
           } else {
             vEnd =
-              pShower->new_vertex(make_shared<Vertex>(0, 0, 0, currentTime));
+              pShower->new_vertex(Vertex(0, 0, 0, currentTime));
             edgeid = pShower->new_parton(vStart, vEnd,
-                                         make_shared<Parton>(pOutTemp[k]));
+                                         pOutTemp[k]);
           }
           pOutTemp[k].set_shower(pShower);
           pOutTemp[k].set_edgeid(edgeid);
@@ -278,9 +295,9 @@ void JetEnergyLoss::DoShower() {
 
             for (int l = 1; l < pInTempModule.size(); l++) {
               node vNewRootNode = pShower->new_vertex(
-                                    make_shared<Vertex>(0, 0, 0, currentTime - deltaT));
+                                    Vertex(0, 0, 0, currentTime - deltaT));
               pShower->new_parton(vNewRootNode, vEnd,
-                                  make_shared<Parton>(pInTempModule[l]));
+                                  pInTempModule[l]);
             }
           }
         }
@@ -361,48 +378,8 @@ void JetEnergyLoss::Exec() {
   //DEBUGTHREAD<<"Task Id = "<<this_thread::get_id()<<" | Found "<<GetNumberOfTasks()<<" Eloss Tasks/Modules Execute them ... ";
 
   if (GetShowerInitiatingParton()) {
-    pShower = make_shared<PartonShower>();
-
-    /*
-       //Check Memory ...
-       VERBOSE(8)<<"Use PartonShowerGenerator to do Parton shower stored in PartonShower Graph class";
-       JSDEBUG<<"Use PartonShowerGenerator to do Parton shower stored in PartonShower Graph class";
-
-       PartonShowerGenerator PSG;
-       PSG.DoShower(*shared_from_this()); //needed otherwise all signal slots have to be recreated for shower module ....
-       // Overall not the nicest logic though .... Just to make changing and expanding the shower code in the future ...
-       // (basically, just now to remove the code out of the jet energy loss class ...) TBD
-       // also not really nice, since now the energy loss part in the parton shower and not really visible in this class ...
-       // Keep both codes so far ...
-       */
-
-    // Shower handled in this class ...
-    DoShower();
-
-    pShower->PrintNodes();
-    pShower->PrintEdges();
-
-    weak_ptr<HardProcess> hproc =
-      JetScapeSignalManager::Instance()->GetHardProcessPointer();
-
-    for (unsigned int ipart = 0; ipart < pShower->GetNumberOfPartons();
-         ipart++) {
-      //   Uncomment to dump the whole parton shower into the parton container
-      // auto hp = hproc.lock();
-      // if ( hp ) hp->AddParton(pShower->GetPartonAt(ipart));
-    }
-
-    shared_ptr<PartonPrinter> pPrinter =
-      JetScapeSignalManager::Instance()->GetPartonPrinterPointer().lock();
-    if (pPrinter) {
-      pPrinter->GetFinalPartons(pShower);
-    }
-
-    shared_ptr<JetEnergyLoss> pEloss =
-      JetScapeSignalManager::Instance()->GetEnergyLossPointer().lock();
-    if (pEloss) {
-      pEloss->GetFinalPartonsForEachShower(pShower);
-    }
+    GenerateShower();
+    PublishShower();
   } else {
     JSWARN << "NO Initial Hard Parton for Parton shower received ...";
   }
@@ -411,6 +388,58 @@ void JetEnergyLoss::Exec() {
   //JetScapeTask::ExecuteTasks(); // prevent Further modules to be execute, everything done by JetEnergyLoss ... (also set the no active flag ...!?)
 }
 
+void JetEnergyLoss::GenerateShower() {
+  pShower = make_shared<PartonShower>();
+
+  /*
+     //Check Memory ...
+     VERBOSE(8)<<"Use PartonShowerGenerator to do Parton shower stored in PartonShower Graph class";
+     JSDEBUG<<"Use PartonShowerGenerator to do Parton shower stored in PartonShower Graph class";
+
+     PartonShowerGenerator PSG;
+     PSG.DoShower(*shared_from_this()); //needed otherwise all signal slots have to be recreated for shower module ....
+     // Overall not the nicest logic though .... Just to make changing and expanding the shower code in the future ...
+     // (basically, just now to remove the code out of the jet energy loss class ...) TBD
+     // also not really nice, since now the energy loss part in the parton shower and not really visible in this class ...
+     // Keep both codes so far ...
+     */
+
+  // Shower handled in this class ...
+  DoShower();
+
+  pShower->PrintNodes();
+  pShower->PrintEdges();
+}
+
+void JetEnergyLoss::PublishShower() {
+  weak_ptr<HardProcess> hproc =
+    JetScapeSignalManager::Instance()->GetHardProcessPointer();
+
+  for (unsigned int ipart = 0; ipart < pShower->GetNumberOfPartons();
+       ipart++) {
+    //   Uncomment to dump the whole parton shower into the parton container
+    // auto hp = hproc.lock();
+    // if ( hp ) hp->AddParton(pShower->GetPartonAt(ipart));
+  }
+
+  shared_ptr<PartonPrinter> pPrinter =
+    JetScapeSignalManager::Instance()->GetPartonPrinterPointer().lock();
+  if (pPrinter) {
+    pPrinter->GetFinalPartons(pShower);
+  }
+
+  shared_ptr<JetEnergyLoss> pEloss =
+    JetScapeSignalManager::Instance()->GetEnergyLossPointer().lock();
+  if (pEloss) {
+    pEloss->GetFinalPartonsForEachShower(pShower);
+  }
+
+  if (!weak_ptr_is_uninitialized(liquefier_ptr)) {
+    liquefier_ptr.lock()->add_droplets(staged_droplets);
+  }
+  staged_droplets.clear();
+}
+
 void JetEnergyLoss::InitPerEvent()
 {
   VERBOSE(3) << "InitPerEvent() for usage per time step ...";
@@ -420,8 +449,8 @@ void JetEnergyLoss::InitPerEvent()
     pShower = make_shared<PartonShower>();
     pIn.push_back(*GetShowerInitiatingParton());
 
-    vStart = pShower->new_vertex(make_shared<Vertex>());
-    vEnd = pShower->new_vertex(make_shared<Vertex>());
+    vStart = pShower->new_vertex(Vertex());
+    vEnd = pShower->new_vertex(Vertex());
 
     // start then the recursive shower ...
     vStartVec.push_back(vEnd);
@@ -526,7 +555,7 @@ void JetEnergyLoss::ExecTime()
         // cerr << " ---------------------------------------------- "
         //      << endl;
         pShower->new_parton(vStart, vEnd,
-                            make_shared<Parton>(pInTempModule.at(0)));
+                            pInTempModule.at(0));
         foundchangedorig = true;
       }
 
@@ -554,14 +583,14 @@ void JetEnergyLoss::ExecTime()
           int edgeid = 0;
           if (pOutTemp[k].pstat() == neg_stat) {
             node vNewRootNode = pShower->new_vertex(
-                                  make_shared<Vertex>(0, 0, 0, currentTime - deltaT));
+                                  Vertex(0, 0, 0, currentTime - deltaT));
             edgeid = pShower->new_parton(vNewRootNode, vStart,
-                                         make_shared<Parton>(pOutTemp[k]));
+                                         pOutTemp[k]);
           } else {
             vEnd =
-              pShower->new_vertex(make_shared<Vertex>(0, 0, 0, currentTime));
+              pShower->new_vertex(Vertex(0, 0, 0, currentTime));
             edgeid = pShower->new_parton(vStart, vEnd,
-                                         make_shared<Parton>(pOutTemp[k]));
+                                         pOutTemp[k]);
           }
           pOutTemp[k].set_shower(pShower);
           pOutTemp[k].set_edgeid(edgeid);
@@ -591,9 +620,9 @@ void JetEnergyLoss::ExecTime()
 
             for (int l = 1; l < pInTempModule.size(); l++) {
               node vNewRootNode = pShower->new_vertex(
-                                    make_shared<Vertex>(0, 0, 0, currentTime - deltaT));
+                                    Vertex(0, 0, 0, currentTime - deltaT));
               pShower->new_parton(vNewRootNode, vEnd,
-                                  make_shared<Parton>(pInTempModule[l]));
+                                  pInTempModule[l]);
             }
           }
         }
@@ -668,6 +697,39 @@ void JetEnergyLoss::ExecTime()
   }
 }
 
+double
+JetEnergyLoss::GetSlowestPartonProperTime(const PartonSelector &selected) {
+  double tau_slowest = std::numeric_limits<double>::max();
+  // A shower not started yet begins with the shower initiating parton
+  vector<Parton> pending;
+  if (pIn.empty() && GetShowerInitiatingParton())
+    pending.push_back(*GetShowerInitiatingParton());
+  const vector<Parton> &partons = pIn.empty() ? pending : pIn;
+
+  double currentTime = GetModuleCurrentTime();
+  for (const auto &p : partons) {
+    // a parton formed later is first seen at its formation point
+    double t = std::max(currentTime, p.x_in().t());
+    double x = p.x_in().x();
+    double y = p.x_in().y();
+    double z = p.x_in().z();
+    double vz = 0.0;
+    if (p.e() > 0) {
+      x += p.px() / p.e() * (t - p.x_in().t());
+      y += p.py() / p.e() * (t - p.x_in().t());
+      vz = p.pz() / p.e();
+      z += vz * (t - p.x_in().t());
+    }
+    if (selected && !selected(t, x, y, z, vz))
+      continue;
+    double tau = 0.0;
+    if (t * t > z * z)
+      tau = sqrt(t * t - z * z);
+    tau_slowest = std::min(tau_slowest, tau);
+  }
+  return tau_slowest;
+}
+
 void JetEnergyLoss::WriteTask(weak_ptr<JetScapeWriter> w) {
   VERBOSE(8);
   VERBOSE(4) << "In JetEnergyLoss::WriteTask";
@@ -17,6 +17,7 @@
 #define JETENERGYLOSS_H
 
 #include "JetScapeModuleBase.h"
+#include "JetScapeProfiler.h"
 #include "FluidDynamics.h"
 #include "FluidCellInfo.h"
 #include "JetClass.h"
@@ -25,6 +26,7 @@
 #include "PartonPrinter.h"
 #include "MakeUniqueHelper.h"
 #include "LiquefierBase.h"
+#include <functional>
 #include <vector>
 #include <random>
 
@@ -65,6 +67,25 @@ public:
   virtual void
   Exec() final; // prevents eloss modules from overwrting and missusing
 
+  /** First half of Exec(): it runs DoShower() for the shower-initiating
+      parton. Nothing outside this task is modified, so that the showers of
+      different copies can be generated concurrently, see IsThreadSafe().
+   */
+  void GenerateShower();
+
+  /** Second half of Exec(): it hands the shower made by GenerateShower()
+      to the parton printer and to the final state parton list, and the
+      collected droplets to the liquefier.
+   */
+  void PublishShower();
+
+  /** @return true if the energy loss module keeps no mutable state shared
+      between its clones (static members, global random engines, ...), so
+      that JetEnergyLossManager may run the showers of different hard
+      partons on different threads. Modules have to opt in.
+   */
+  virtual bool IsThreadSafe() const { return (false); }
+
   /** Write output information for each tasks/subtasks attached to the JetEnergyLoss module using JetScapeWriter functionality.
       @param w A pointer of type JetScapeWriter.
   */
@@ -78,6 +99,26 @@ public:
 
   virtual void ExecTime() final;
 
+  /** Selects the partons by their Cartesian position (t, x, y, z) and
+      their velocity vz along the beam axis.
+   */
+  typedef std::function<bool(double t, double x, double y, double z,
+                             double vz)>
+      PartonSelector;
+
+  /** @return Smallest proper time sqrt(t^2 - z^2) of the partons of the
+      shower at the current module time, the partons moving on straight
+      lines from x_in(). Partons formed later count at their formation
+      point, and a shower not started yet by its shower initiating parton.
+      Partons can not go back below it, so the earlier hydro time slices
+      can be evicted, see FluidDynamics::ReleaseHydroEvolutionHistory().
+      It is the largest double if no parton counts.
+      @param selected Only the partons it returns true for count, all if
+      it is empty.
+   */
+  double GetSlowestPartonProperTime(
+      const PartonSelector &selected = PartonSelector());
+
   virtual void InitPerEvent();
 
   virtual void FinishPerEvent();
@@ -92,11 +133,23 @@ public:
   virtual void DoEnergyLoss(double deltaT, double time, double Q2,
                             vector<Parton> &pIn, vector<Parton> &pOut){};
 
+  /** Slot of SentInPartons: DoEnergyLoss() recorded by JetScapeProfiler
+      as a region of this module.
+   */
+  void ProfiledDoEnergyLoss(double deltaT, double time, double Q2,
+                            vector<Parton> &pIn, vector<Parton> &pOut);
+
   //! Core signal to receive information from the medium
   sigslot::signal5<double, double, double, double,
                    std::unique_ptr<FluidCellInfo> &, multi_threaded_local>
       GetHydroCellSignal;
 
+  //! Batched version of GetHydroCellSignal, see FluidDynamics::GetHydroInfoBatch
+  sigslot::signal7<int, const Jetscape::real *, const Jetscape::real *,
+                   const Jetscape::real *, const Jetscape::real *, unsigned int,
+                   Jetscape::real *, multi_threaded_local>
+      GetHydroInfoBatchSignal;
+
   /** For future development. A signal to connect the JetEnergyLoss object to the function UpdateEnergyDeposit() of the FluidDynamics class.
    */
   sigslot::signal2<int, double, multi_threaded_local> jetSignal;
@@ -207,6 +260,7 @@ public:
 
   // The Slot method to send the vector of Hadronization module
   void SendFinalStatePartons(vector<vector<shared_ptr<Parton>>> &fPartons) {
+    JSPROFILE("Signal", "SendFinalStatePartons");
     fPartons = final_Partons;
   }
 
@@ -228,6 +282,9 @@ private:
   bool GetHydroCellSignalConnected;
   bool SentInPartonsConnected;
 
+  // JetScapeProfiler region of DoEnergyLoss(), registered at the first call
+  int do_energy_loss_profile_id;
+
   /** This function executes the shower process for the partons produced from the hard scaterring.                                                                         
   */
   void DoShower();
@@ -238,6 +295,9 @@ private:
   vector<Parton> pIn;
   vector<node> vStartVec;
 
+  // droplets of this shower, handed to the liquefier in PublishShower()
+  vector<Droplet> staged_droplets;
+
   bool foundchangedorig = false;
   int droplet_stat = -11;
   int miss_stat = -13;
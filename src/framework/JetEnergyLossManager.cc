@@ -16,6 +16,7 @@
 #include "JetEnergyLossManager.h"
 #include "JetScapeLogger.h"
 #include "JetScapeSignalManager.h"
+#include "JetScapeTaskSupport.h"
 #include "MakeUniqueHelper.h"
 #include <string>
 
@@ -31,6 +32,7 @@ JetEnergyLossManager::JetEnergyLossManager() : JetScapeModuleBase() {
   SetId("JLossManager");
   GetHardPartonListConnected = false;
   copiesMade = false;
+  nThreads = 1;
   VERBOSE(8);
 }
 
@@ -84,6 +86,36 @@ void JetEnergyLossManager::Init() {
       JetScapeSignalManager::Instance()->SetEnergyLossPointer(
           dynamic_pointer_cast<JetEnergyLoss>(it));
   }
+
+  // Number of threads running the showers of the hard partons
+  nThreads = GetXMLElementInt({"Eloss", "nThreads"}, false);
+  if (nThreads > 1 && !CanExecuteConcurrently()) {
+    nThreads = 1;
+  }
+  if (nThreads > 1) {
+    JSINFO << "Run the parton showers on " << nThreads << " threads";
+  } else {
+    nThreads = 1;
+  }
+}
+
+bool JetEnergyLossManager::CanExecuteConcurrently() {
+  for (auto it : GetTaskList()) {
+    for (auto it2 : it->GetTaskList()) {
+      auto eloss_module = dynamic_pointer_cast<JetEnergyLoss>(it2);
+      if (eloss_module && !eloss_module->IsThreadSafe()) {
+        JSWARN << it2->GetId() << " does not support concurrent showers, "
+               << "ignore <nThreads> and run the showers serially.";
+        return false;
+      }
+    }
+  }
+  if (!JetScapeTaskSupport::GetOneGeneratorPerTask()) {
+    JSWARN << "Concurrent showers need one random engine per task, i.e. "
+           << "a non-zero <Random><seed>; run the showers serially.";
+    return false;
+  }
+  return true;
 }
 
 void JetEnergyLossManager::WriteTask(weak_ptr<JetScapeWriter> w) {
@@ -152,67 +184,47 @@ void JetEnergyLossManager::Exec() {
   if (!copiesMade)
     MakeCopies();
 
-  // ----------------------------------
-  /*
-  // quick and dirty here, only include after further testing (flag in init xml files ...)
-  bool multiTask = false;
-
-  // ----------------------------------
-  //Excute JetEnergyLoss tasks and their subtasks (done via signal/slot) by hand ...
-  //needed if only JetEnergyloss tasks in parallel (otherwise could be done via JetScapeTask, then every task a new thread for example)
-  // Of course now the number of threads if plainly given by the number of initial hard partons and can exceed the allowed # of threads >1000
-  // so to really do this properly one has to think about and limit to number of CPU's * N threads or something in that directions. See a quick attempt below.
-
-  //DEBUG:
-  //unsigned num_cpus = thread::hardware_concurrency();
-  //cout << "Num of CPU's = " << num_cpus << " threads\n";
-
-  if (multiTask) {
-    int nTasks = GetNumberOfTasks();
-    int nCPUs = thread::hardware_concurrency();
-
-    vector<thread> threads;
-
-    int nMaxThreads = nCPUs * 2;
-    int n = 0;
+  if (nThreads > 1 && GetNumberOfTasks() > 1) {
+    ExecuteTasksConcurrently();
+  } else {
+    // Standard "serial" execution for the JetEnerguLoss (+submodules) task ...
+    JetScapeTask::ExecuteTasks();
+  }
 
-    VERBOSE(3) << " Use multi-threading: (max) # of threads = # of CPU's "
-               << nCPUs << " (found) * 2";
+  //Add acheck if the parton shower was actually created for the Modules ....
+  VERBOSE(3) << " " << GetNumberOfTasks()
+             << " Eloss Manager Tasks/Modules finished.";
+}
 
-    for (auto it : GetTaskList()) {
-      if (it->GetActive()) {
-        threads.push_back(thread(&JetEnergyLoss::Exec,
-                                 dynamic_pointer_cast<JetEnergyLoss>(it)));
-        n++;
-      }
-      if (n == nMaxThreads) {
-        //DEBUGTHREAD<<n;
-        for (auto &th : threads)
-          th.join();
-        n = 0;
-        threads.clear();
-
-        //DEBUG:
-        //std::this_thread::sleep_for(std::chrono::milliseconds(5000));
+void JetEnergyLossManager::ExecuteTasksConcurrently() {
+  vector<shared_ptr<JetEnergyLoss>> copies;
+  for (auto it : GetTaskList()) {
+    auto jloss = dynamic_pointer_cast<JetEnergyLoss>(it);
+    if (jloss && jloss->GetActive()) {
+      if (jloss->GetShowerInitiatingParton()) {
+        copies.push_back(jloss);
+      } else {
+        JSWARN << "NO Initial Hard Parton for Parton shower received ...";
       }
     }
-
-    if (nTasks < nMaxThreads) {
-      for (auto &th : threads)
-        th.join();
-      threads.clear();
-    }
   }
-  // ----------------------------------
-  else
-  */
-  
-  // Standard "serial" execution for the JetEnerguLoss (+submodules) task ...
-  JetScapeTask::ExecuteTasks();
 
-  //Add acheck if the parton shower was actually created for the Modules ....
-  VERBOSE(3) << " " << GetNumberOfTasks()
-             << " Eloss Manager Tasks/Modules finished.";
+  // The per-task random engines are seeded from the task number only
+  // (see JetScapeTaskSupport), so they can be created lazily on the
+  // worker threads.
+
+  if (!threadPool || threadPool->GetNumberOfThreads() != nThreads) {
+    threadPool = make_unique<ThreadPool>(nThreads);
+  }
+  VERBOSE(3) << " Run " << copies.size() << " showers on " << nThreads
+             << " threads";
+  threadPool->ParallelFor(copies.size(),
+                          [&copies](int i) { copies[i]->GenerateShower(); });
+
+  // hand over the results in the order of the hard partons
+  for (auto &jloss : copies) {
+    jloss->PublishShower();
+  }
 }
 
 void JetEnergyLossManager::CalculateTime()
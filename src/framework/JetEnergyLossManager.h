@@ -20,7 +20,9 @@
 #include "JetScapeModuleBase.h"
 #include "JetClass.h"
 #include "sigslot.h"
+#include "ThreadPool.h"
 
+#include <memory>
 #include <vector>
 
 namespace Jetscape {
@@ -44,7 +46,7 @@ public:
    */
   virtual void Init();
 
-  /** It reads the Hard Patrons list and calls CreateSignalSlots() function. Then, it executes the energy loss tasks attached with the jet energy loss manager. This function also includes the parallel computing feature. It can be overridden by other tasks.
+  /** It reads the Hard Patrons list and calls CreateSignalSlots() function. Then, it executes the energy loss tasks attached with the jet energy loss manager. The copies run on a pool of <Eloss><nThreads> worker threads if all the energy loss modules support it, serially otherwise. It can be overridden by other tasks.
   */
   virtual void Exec();
 
@@ -95,6 +97,21 @@ private:
   void MakeCopies();
   bool copiesMade;
 
+  /** Runs the showers of the copies on the worker threads and hands them
+      over to the parton printer, hadronization and liquefier in the order
+      of the copies, so that the result does not depend on the scheduling.
+   */
+  void ExecuteTasksConcurrently();
+
+  /** @return true if the showers of the copies can be run concurrently:
+      more than one thread requested, all the energy loss modules declared
+      thread safe and reproducible random engines, one per task.
+   */
+  bool CanExecuteConcurrently();
+
+  int nThreads;
+  std::unique_ptr<ThreadPool> threadPool;
+
   bool GetHardPartonListConnected;
   vector<shared_ptr<Parton>> hp;
 };
@@ -25,12 +25,19 @@
 #include "CausalLiquefier.h"
 
 #include "QueryHistory.h"
+#include "JetScapeProfiler.h"
+#include "CachedTable.h"
+#include "MakeUniqueHelper.h"
 
 #ifdef USE_HEPMC
 #include "JetScapeWriterHepMC.h"
 #endif
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <sstream>
+#include <thread>
 
 using namespace std;
 
@@ -140,6 +147,23 @@ void JetScape::ReadGeneralParametersFromXML() {
     JSINFO << "nReuseHydro: " << nReuseHydro;
   }
 
+  // Profiling of the tasks and signals, reported at Finish()
+  std::string profile = GetXMLElementText({"profile"}, false);
+  profile_file_name = GetXMLElementText({"profileFilename"}, false);
+  if ((int)profile.find("on") >= 0) {
+    JetScapeProfiler::SetActive(true);
+    JSINFO << "Profiling on, report: " << profile_file_name;
+  }
+
+  // Directory of the binary caches of the ASCII rate tables
+  std::string table_cache_dir = GetXMLElementText({"tableCacheDir"}, false);
+  table_cache_dir.erase(0, table_cache_dir.find_first_not_of(" \t\n"));
+  table_cache_dir.erase(table_cache_dir.find_last_not_of(" \t\n") + 1);
+  if (!table_cache_dir.empty()) {
+    CachedTable::SetCacheDirectory(table_cache_dir);
+  }
+  JSINFO << "Table caches in " << CachedTable::GetCacheDirectory();
+
   // Set up helper. Mostly used for random numbers
   // Needs the XML reader singleton set up
   JetScapeTaskSupport::ReadSeedFromXML();
@@ -710,6 +734,7 @@ void JetScape::DetermineWritersFromXML() {
   std::string outputFilenameAscii = outputFilename;
   std::string outputFilenameAsciiGZ = outputFilename;
   std::string outputFilenameHepMC = outputFilename;
+  std::string outputFilenameBinary = outputFilename;
 
   // Check if each writer is enabled, and if so add it to the task list
   CheckForWriterFromXML("JetScapeWriterAscii",
@@ -718,6 +743,8 @@ void JetScape::DetermineWritersFromXML() {
                         outputFilenameAsciiGZ.append(".dat.gz"));
   CheckForWriterFromXML("JetScapeWriterHepMC",
                         outputFilenameHepMC.append(".hepmc"));
+  CheckForWriterFromXML("JetScapeWriterBinary",
+                        outputFilenameBinary.append(".jsbin"));
 
   // Check for custom writers
   tinyxml2::XMLElement *element =
@@ -839,6 +866,7 @@ void JetScape::Exec() {
     }
     VERBOSE(1) << BOLDRED << "Run Event # = " << i;
     JSDEBUG << "Found " << GetNumberOfTasks() << " Modules Execute them ... ";
+    JetScapeProfiler::Scope event_scope("Event", GetId());
 
     // First run all tasks per event if possible/required ...
     JetScapeTask::ExecuteTasks();
@@ -873,73 +901,80 @@ void JetScape::Exec() {
       }
       */
 
-      do {
-        
-        VERBOSE(3)<< BOLDRED << "Current Main Clock Time = "<<GetMainClock()->GetCurrentTime()<<" dT = "<<GetMainClock()->GetDeltaT();
-
-        // quick and dirty here ... (mainly for curiosity ...) and only for CalculateTime assuming that in any case this should take the longest and/or avoiding issues 
-        // via data exchanges in executive part ... as said, just a first quick look at how things could work out .,,.
-        bool multiTask = true;   
-
-        //JP: silly to do everything per time step, everything with task map and task vectors could be done in InitPerTimeStep ...
-        if (multiTask) {
-     
-          int nTasks = GetNumberOfTasks();
-          int nCPUs = thread::hardware_concurrency();
-
-          std::vector<thread> threads;
-
-          int nMaxThreads = nCPUs * 2;
-          int n = 0;
-
-          std::vector<std::weak_ptr<JetScapeTask>> vTaskMulti;
-          std::vector<std::weak_ptr<JetScapeTask>> vTask;
-
-          VERBOSE(2) << " Use multi-threading: (max) # of threads = # of CPU's "
-               << nCPUs << " (found) * 2";
-
-           // also quick and dirty via task map from QueryHistory instance ...     
-          auto tMap = QueryHistory::Instance()->GetTaskMap();
-
-          for(const auto &x: tMap){
-            //if (std::dynamic_pointer_cast<JetScapeModuleBase>(x.second.lock()))
-            if (x.second.lock()->GetMultiThread()) {
-              //DEBUG                                      
-              //cout<<x.second.lock()->GetId()<<endl;
-              vTaskMulti.push_back(x.second);
-            }
-            else
-              vTask.push_back(x.second);
-          }
-          
-          //DEBUG:
-          //cout<<vTaskMulti.size()<<" "<<vTask.size()<<endl;
-
-          for (auto t : vTaskMulti)
-          {
-            if (std::dynamic_pointer_cast<JetScapeModuleBase>(t.lock()))
-              threads.push_back(thread(&JetScapeModuleBase::CalculateTime, dynamic_pointer_cast<JetScapeModuleBase>(t.lock())));
-          }
+      // The modules which calculate in their own thread are collected once
+      // per event. Every clock tick is then a single ParallelFor call on a
+      // pool started once, which returns when all modules are done with
+      // the time step. The other modules run in sequence as one more job.
+      std::vector<std::shared_ptr<JetScapeModuleBase>> vTaskMulti;
+      std::vector<std::shared_ptr<JetScapeModuleBase>> vTask;
+      // A hydro with a sliding window pushes its time slices in the
+      // background; after every time step the slices below the slowest
+      // parton still in the medium are released.
+      std::vector<std::shared_ptr<FluidDynamics>> vStreamingHydro;
+      std::vector<std::shared_ptr<JetEnergyLoss>> vJetEnergyLoss;
+      for (const auto &x : QueryHistory::Instance()->GetTaskMap()) {
+        auto hydro = std::dynamic_pointer_cast<FluidDynamics>(x.second.lock());
+        if (hydro && hydro->IsStreamingEvolutionHistory())
+          vStreamingHydro.push_back(hydro);
+        auto jloss = std::dynamic_pointer_cast<JetEnergyLoss>(x.second.lock());
+        if (jloss)
+          vJetEnergyLoss.push_back(jloss);
+
+        auto module =
+            std::dynamic_pointer_cast<JetScapeModuleBase>(x.second.lock());
+        if (!module)
+          continue;
+        if (module->GetMultiThread())
+          vTaskMulti.push_back(module);
+        else
+          vTask.push_back(module);
+      }
 
-          for (auto t : vTask)
-          {
-            if (std::dynamic_pointer_cast<JetScapeModuleBase>(t.lock()))
-              //threads.push_back(thread(&JetScapeModuleBase::CalculateTime, dynamic_pointer_cast<JetScapeModuleBase>(t.lock())));
-              std::dynamic_pointer_cast<JetScapeModuleBase>(t.lock())->CalculateTime();
+      int nJobs = vTaskMulti.size() + (vTask.empty() ? 0 : 1);
+      int nCPUs = std::max(1u, thread::hardware_concurrency());
+      int nThreads = std::max(1, std::min(nJobs, nCPUs));
+      if (nJobs > 1 && (!clockThreadPool ||
+                        clockThreadPool->GetNumberOfThreads() != nThreads)) {
+        clockThreadPool = make_unique<ThreadPool>(nThreads);
+      }
+      VERBOSE(2) << " Use multi-threading: " << vTaskMulti.size()
+                 << " modules in parallel on " << nThreads << " threads";
+
+      std::function<void(int)> calculateTime = [&](int i) {
+        if (i < static_cast<int>(vTaskMulti.size())) {
+          JetScapeProfiler::Scope scope(
+              vTaskMulti[i]->GetProfileId(PROFILE_CALCULATE_TIME));
+          vTaskMulti[i]->CalculateTime();
+        } else {
+          for (auto &module : vTask) {
+            JetScapeProfiler::Scope scope(module->GetProfileId(PROFILE_CALCULATE_TIME));
+            module->CalculateTime();
           }
+        }
+      };
 
-          for (auto &th : threads)
-            th.join();
+      do {
+        
+        VERBOSE(3)<< BOLDRED << "Current Main Clock Time = "<<GetMainClock()->GetCurrentTime()<<" dT = "<<GetMainClock()->GetDeltaT();
 
-          threads.clear(); vTaskMulti.clear(); vTask.clear();         
-        }
-        else
-          JetScapeModuleBase::CalculateTimeTasks();
+        if (nJobs > 1)
+          clockThreadPool->ParallelFor(nJobs, calculateTime);
+        else if (nJobs == 1)
+          calculateTime(0);
 
         JetScapeModuleBase::ExecTimeTasks();
 
+        // the next time step reads up to two steps ahead of the clock
+        for (auto &hydro : vStreamingHydro)
+          hydro->ReleaseHydroEvolutionHistory(
+              vJetEnergyLoss, GetMainClock()->GetCurrentTime() +
+                                  2 * GetMainClock()->GetDeltaT());
+
       } while (GetMainClock()->Tick());     
 
+      for (auto &hydro : vStreamingHydro)
+        hydro->FinishHydroEvolution();
+
       //JetScapeModuleBase::FinishPerEventTasks();
     }
 
@@ -1033,6 +1068,10 @@ void JetScape::Exec() {
     if (ClockUsed())
       JetScapeModuleBase::FinishPerEventTasks();
 
+    event_scope.Stop();
+    if (JetScapeProfiler::IsActive())
+      JetScapeProfiler::Instance()->EndEvent();
+
     IncrementCurrentEvent();
   }
 }
@@ -1044,6 +1083,20 @@ void JetScape::Finish() {
 
   // same as in Init() and Exec() ...
   JetScapeTask::FinishTasks(); //dummy so far ...
+
+  if (JetScapeProfiler::IsActive()) {
+    std::stringstream table;
+    JetScapeProfiler::Instance()->PrintSummary(table);
+    std::string line;
+    while (std::getline(table, line))
+      JSINFO << line;
+    if (!profile_file_name.empty()) {
+      if (JetScapeProfiler::Instance()->WriteReport(profile_file_name))
+        JSINFO << "Profile written to " << profile_file_name;
+      else
+        JSWARN << "Could not write the profile to " << profile_file_name;
+    }
+  }
 }
 
 } // end namespace Jetscape
@@ -20,6 +20,7 @@
 #include "JetScapeTaskSupport.h"
 #include "JetScapeModuleBase.h"
 #include "CausalLiquefier.h"
+#include "ThreadPool.h"
 
 namespace Jetscape {
 
@@ -94,8 +95,14 @@ protected:
   bool reuse_hydro_;
   unsigned int n_reuse_hydro_;
 
+  // JSON report of JetScapeProfiler written at Finish(), if profiling
+  std::string profile_file_name;
+
   std::shared_ptr<CausalLiquefier> liquefier;
 
+  // workers for the time steps of the main clock, kept for all events
+  std::unique_ptr<ThreadPool> clockThreadPool;
+
   bool
       fEnableAutomaticTaskListDetermination; // Option to automatically determine the task list from the XML file,
       // rather than manually calling JetScapeTask::Add() in the run macro.
@@ -0,0 +1,364 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "JetScapeBinaryFormat.h"
+#include "JetScapeParticles.h"
+#include "JetClass.h"
+#include "PartonShower.h"
+
+#include <cstring>
+
+#ifdef USE_GZIP
+#include <zlib.h>
+#endif
+
+namespace Jetscape {
+
+namespace {
+
+// header of a block, followed by stored_size bytes
+struct BlockHeader {
+  char tag[4];
+  std::uint32_t compression; // 0: none, 1: zlib
+  std::uint64_t raw_size;
+  std::uint64_t stored_size;
+};
+
+const char block_tag[4] = {'E', 'V', 'N', 'T'};
+
+template <class T> void Append(std::string &out, const T &value) {
+  out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <class T>
+void AppendColumn(std::string &out, const std::vector<T> &column) {
+  if (!column.empty()) {
+    out.append(reinterpret_cast<const char *>(column.data()),
+               column.size() * sizeof(T));
+  }
+}
+
+void AppendParticles(std::string &out, const ParticleColumns &p) {
+  Append(out, static_cast<std::uint64_t>(p.size()));
+  AppendColumn(out, p.label);
+  AppendColumn(out, p.pid);
+  AppendColumn(out, p.stat);
+  AppendColumn(out, p.px);
+  AppendColumn(out, p.py);
+  AppendColumn(out, p.pz);
+  AppendColumn(out, p.e);
+  AppendColumn(out, p.x);
+  AppendColumn(out, p.y);
+  AppendColumn(out, p.z);
+  AppendColumn(out, p.t);
+}
+
+void AppendVertices(std::string &out, const VertexColumns &v) {
+  Append(out, static_cast<std::uint64_t>(v.size()));
+  AppendColumn(out, v.x);
+  AppendColumn(out, v.y);
+  AppendColumn(out, v.z);
+  AppendColumn(out, v.t);
+}
+
+// reads the payload of a block front to back
+class Cursor {
+public:
+  explicit Cursor(const std::string &payload)
+      : position(payload.data()), end(payload.data() + payload.size()) {}
+
+  template <class T> bool Get(T &value) {
+    if (static_cast<std::size_t>(end - position) < sizeof(T)) {
+      return (false);
+    }
+    std::memcpy(&value, position, sizeof(T));
+    position += sizeof(T);
+    return (true);
+  }
+
+  template <class T> bool GetColumn(std::vector<T> &column, std::uint64_t n) {
+    if (static_cast<std::uint64_t>(end - position) / sizeof(T) < n) {
+      return (false);
+    }
+    column.resize(n);
+    if (n > 0) {
+      std::memcpy(column.data(), position, n * sizeof(T));
+    }
+    position += n * sizeof(T);
+    return (true);
+  }
+
+  bool GetParticles(ParticleColumns &p) {
+    std::uint64_t n;
+    return (Get(n) && GetColumn(p.label, n) && GetColumn(p.pid, n) &&
+            GetColumn(p.stat, n) && GetColumn(p.px, n) && GetColumn(p.py, n) &&
+            GetColumn(p.pz, n) && GetColumn(p.e, n) && GetColumn(p.x, n) &&
+            GetColumn(p.y, n) && GetColumn(p.z, n) && GetColumn(p.t, n));
+  }
+
+  bool GetVertices(VertexColumns &v) {
+    std::uint64_t n;
+    return (Get(n) && GetColumn(v.x, n) && GetColumn(v.y, n) &&
+            GetColumn(v.z, n) && GetColumn(v.t, n));
+  }
+
+  bool Done() const { return (position == end); }
+
+private:
+  const char *position;
+  const char *end;
+};
+
+} // end namespace
+
+void ParticleColumns::Add(const JetScapeParticleBase &p) {
+  label.push_back(p.plabel());
+  pid.push_back(p.pid());
+  stat.push_back(p.pstat());
+  px.push_back(p.px());
+  py.push_back(p.py());
+  pz.push_back(p.pz());
+  e.push_back(p.e());
+  x.push_back(p.x_in().x());
+  y.push_back(p.x_in().y());
+  z.push_back(p.x_in().z());
+  t.push_back(p.x_in().t());
+}
+
+void ParticleColumns::clear() {
+  label.clear();
+  pid.clear();
+  stat.clear();
+  px.clear();
+  py.clear();
+  pz.clear();
+  e.clear();
+  x.clear();
+  y.clear();
+  z.clear();
+  t.clear();
+}
+
+void VertexColumns::Add(const Vertex &v) {
+  x.push_back(v.x_in().x());
+  y.push_back(v.x_in().y());
+  z.push_back(v.x_in().z());
+  t.push_back(v.x_in().t());
+}
+
+void VertexColumns::clear() {
+  x.clear();
+  y.clear();
+  z.clear();
+  t.clear();
+}
+
+void JetScapeBinaryEvent::Clear() {
+  event_number = 0;
+  sigma_gen = sigma_err = 0.;
+  event_weight = 1.;
+  npart = ncoll = total_entropy = -1.;
+  event_plane_angle = -999.;
+  lines.clear();
+  partons.clear();
+  vertices.clear();
+  hadrons.clear();
+  shower_vertices.clear();
+  shower_partons.clear();
+  shower_vertex_columns.clear();
+  shower_parton_columns.clear();
+  edge_source.clear();
+  edge_target.clear();
+}
+
+void JetScapeBinaryEvent::AddShower(PartonShower &shower) {
+  int n_vertices = shower.GetNumberOfVertices();
+  int n_partons = shower.GetNumberOfPartons();
+  shower_vertices.push_back(n_vertices);
+  shower_partons.push_back(n_partons);
+  for (int i = 0; i < n_vertices; i++) {
+    shower_vertex_columns.Add(*shower.GetVertexAt(i));
+  }
+  for (int i = 0; i < n_partons; i++) {
+    shower_parton_columns.Add(*shower.GetPartonAt(i));
+    edge_source.push_back(shower.GetPartonSource(i));
+    edge_target.push_back(shower.GetPartonTarget(i));
+  }
+}
+
+void JetScapeBinaryEvent::Encode(std::string &payload) const {
+  payload.clear();
+  Append(payload, static_cast<std::int32_t>(event_number));
+  Append(payload, sigma_gen);
+  Append(payload, sigma_err);
+  Append(payload, event_weight);
+  Append(payload, npart);
+  Append(payload, ncoll);
+  Append(payload, total_entropy);
+  Append(payload, event_plane_angle);
+
+  Append(payload, static_cast<std::uint64_t>(lines.size()));
+  for (auto &line : lines) {
+    Append(payload, static_cast<std::uint64_t>(line.size()));
+    payload.append(line);
+  }
+
+  AppendParticles(payload, partons);
+  AppendVertices(payload, vertices);
+  AppendParticles(payload, hadrons);
+
+  Append(payload, static_cast<std::uint64_t>(shower_vertices.size()));
+  AppendColumn(payload, shower_vertices);
+  AppendColumn(payload, shower_partons);
+  AppendVertices(payload, shower_vertex_columns);
+  AppendParticles(payload, shower_parton_columns);
+  AppendColumn(payload, edge_source);
+  AppendColumn(payload, edge_target);
+}
+
+bool JetScapeBinaryEvent::Decode(const std::string &payload) {
+  Clear();
+  Cursor in(payload);
+  std::int32_t number;
+  if (!(in.Get(number) && in.Get(sigma_gen) && in.Get(sigma_err) &&
+        in.Get(event_weight) && in.Get(npart) && in.Get(ncoll) &&
+        in.Get(total_entropy) && in.Get(event_plane_angle))) {
+    return (false);
+  }
+  event_number = number;
+
+  std::uint64_t n_lines;
+  if (!in.Get(n_lines)) {
+    return (false);
+  }
+  std::vector<char> characters;
+  for (std::uint64_t i = 0; i < n_lines; i++) {
+    std::uint64_t length;
+    if (!in.Get(length) || !in.GetColumn(characters, length)) {
+      return (false);
+    }
+    lines.push_back(std::string(characters.begin(), characters.end()));
+  }
+
+  if (!(in.GetParticles(partons) && in.GetVertices(vertices) &&
+        in.GetParticles(hadrons))) {
+    return (false);
+  }
+
+  std::uint64_t n_showers;
+  if (!(in.Get(n_showers) && in.GetColumn(shower_vertices, n_showers) &&
+        in.GetColumn(shower_partons, n_showers) &&
+        in.GetVertices(shower_vertex_columns) &&
+        in.GetParticles(shower_parton_columns))) {
+    return (false);
+  }
+  std::uint64_t n_shower_partons = shower_parton_columns.size();
+  if (!(in.GetColumn(edge_source, n_shower_partons) &&
+        in.GetColumn(edge_target, n_shower_partons))) {
+    return (false);
+  }
+
+  // the showers must add up to the flat lists
+  std::uint64_t total_vertices = 0;
+  std::uint64_t total_partons = 0;
+  for (std::uint64_t i = 0; i < n_showers; i++) {
+    total_vertices += shower_vertices[i];
+    total_partons += shower_partons[i];
+  }
+  return (in.Done() && total_vertices == shower_vertex_columns.size() &&
+          total_partons == n_shower_partons);
+}
+
+namespace JetScapeBinary {
+
+const char file_tag[8] = {'J', 'S', 'B', 'I', 'N', 'E', 'V', '1'};
+
+bool WriteFileTag(std::ostream &out) {
+  out.write(file_tag, sizeof(file_tag));
+  return (out.good());
+}
+
+bool ReadFileTag(std::istream &in) {
+  char tag[sizeof(file_tag)];
+  in.read(tag, sizeof(tag));
+  return (in.good() && std::memcmp(tag, file_tag, sizeof(tag)) == 0);
+}
+
+bool WriteBlock(std::ostream &out, const std::string &payload,
+                int compression_level) {
+  BlockHeader header;
+  std::memcpy(header.tag, block_tag, sizeof(block_tag));
+  header.compression = 0;
+  header.raw_size = payload.size();
+  header.stored_size = payload.size();
+  const char *stored = payload.data();
+
+#ifdef USE_GZIP
+  std::vector<char> compressed;
+  if (compression_level > 0 && !payload.empty()) {
+    uLongf compressed_size = compressBound(payload.size());
+    compressed.resize(compressed_size);
+    if (compress2(reinterpret_cast<Bytef *>(compressed.data()),
+                  &compressed_size,
+                  reinterpret_cast<const Bytef *>(payload.data()),
+                  payload.size(), compression_level) == Z_OK &&
+        compressed_size < payload.size()) {
+      header.compression = 1;
+      header.stored_size = compressed_size;
+      stored = compressed.data();
+    }
+  }
+#endif
+
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(stored, header.stored_size);
+  return (out.good());
+}
+
+bool ReadBlock(std::istream &in, std::string &payload) {
+  BlockHeader header;
+  in.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (!in || std::memcmp(header.tag, block_tag, sizeof(block_tag)) != 0) {
+    return (false);
+  }
+
+  std::string stored(header.stored_size, '\0');
+  if (header.stored_size > 0) {
+    in.read(&stored[0], header.stored_size);
+    if (!in) {
+      return (false);
+    }
+  }
+
+  if (header.compression == 0) {
+    payload.swap(stored);
+    return (header.raw_size == header.stored_size);
+  }
+#ifdef USE_GZIP
+  if (header.compression == 1) {
+    payload.assign(header.raw_size, '\0');
+    uLongf raw_size = header.raw_size;
+    return (uncompress(reinterpret_cast<Bytef *>(&payload[0]), &raw_size,
+                       reinterpret_cast<const Bytef *>(stored.data()),
+                       stored.size()) == Z_OK &&
+            raw_size == header.raw_size);
+  }
+#endif
+  return (false);
+}
+
+} // end namespace JetScapeBinary
+
+} // end namespace Jetscape
@@ -0,0 +1,125 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+// binary column-oriented event format, shared by the writer and the reader
+
+#ifndef JETSCAPEBINARYFORMAT_H
+#define JETSCAPEBINARYFORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Jetscape {
+
+class JetScapeParticleBase;
+class Vertex;
+class PartonShower;
+
+/** Particles stored column by column, with a fixed width per particle:
+    label, pid and status as 32 bit integers, the momentum (px, py, pz, E)
+    and the position (x, y, z, t) as single precision numbers, which keeps
+    more digits than the ASCII output.
+ */
+struct ParticleColumns {
+  std::vector<std::int32_t> label, pid, stat;
+  std::vector<float> px, py, pz, e;
+  std::vector<float> x, y, z, t;
+
+  std::size_t size() const { return label.size(); }
+  void Add(const JetScapeParticleBase &p);
+  void clear();
+};
+
+/** Positions of vertices, column by column. */
+struct VertexColumns {
+  std::vector<float> x, y, z, t;
+
+  std::size_t size() const { return x.size(); }
+  void Add(const Vertex &v);
+  void clear();
+};
+
+/** @class JetScapeBinaryEvent
+ * Content of one event of the binary output. Parton showers are stored as
+ * a flat list of vertices and partons with the integer indices of the
+ * vertices at both ends of every parton, counted from the first vertex of
+ * the shower.
+ */
+class JetScapeBinaryEvent {
+public:
+  JetScapeBinaryEvent() { Clear(); }
+
+  void Clear();
+
+  /** Append the vertices and partons of a shower. */
+  void AddShower(PartonShower &shower);
+
+  /** Serialize the event into payload (its previous content is lost). */
+  void Encode(std::string &payload) const;
+
+  /** @return False if payload is not a complete event. */
+  bool Decode(const std::string &payload);
+
+  int event_number;
+  double sigma_gen;
+  double sigma_err;
+  double event_weight;
+  double npart;
+  double ncoll;
+  double total_entropy;
+  double event_plane_angle;
+
+  std::vector<std::string> lines; ///< Text written by the modules
+  ParticleColumns partons;        ///< Partons written on their own
+  VertexColumns vertices;         ///< Vertices written on their own
+  ParticleColumns hadrons;
+
+  std::vector<std::uint32_t> shower_vertices; ///< Vertices in each shower
+  std::vector<std::uint32_t> shower_partons;  ///< Partons in each shower
+  VertexColumns shower_vertex_columns;        ///< All showers, in order
+  ParticleColumns shower_parton_columns;      ///< All showers, in order
+  std::vector<std::int32_t> edge_source;      ///< Start vertex of a parton
+  std::vector<std::int32_t> edge_target;      ///< End vertex of a parton
+};
+
+namespace JetScapeBinary {
+
+/// File starts with this tag, then one block per event
+extern const char file_tag[8];
+
+/** Write the tag at the beginning of a file. */
+bool WriteFileTag(std::ostream &out);
+
+/** @return False if the stream does not start with the file tag. */
+bool ReadFileTag(std::istream &in);
+
+/** Write one block, compressed with zlib if compression_level > 0. */
+bool WriteBlock(std::ostream &out, const std::string &payload,
+                int compression_level);
+
+/** Read the next block into payload.
+    @return False at the end of the file or if the block is corrupt.
+ */
+bool ReadBlock(std::istream &in, std::string &payload);
+
+} // end namespace JetScapeBinary
+
+} // end namespace Jetscape
+
+#endif // JETSCAPEBINARYFORMAT_H
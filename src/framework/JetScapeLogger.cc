@@ -14,7 +14,10 @@
  ******************************************************************************/
 
 #include <stddef.h>
+#include <atomic>
+#include <chrono>
 #include <fstream>
+#include <vector>
 
 #include "JetScapeLogger.h"
 
@@ -87,14 +90,13 @@ int getMemoryUsage()
 
 namespace Jetscape {
 
-std::ostringstream null;
-
-SafeOstream safe_cout(std::cout);
-SafeOstream safe_cerr(std::cerr);
-SafeOstream safe_null(null);
-
 JetScapeLogger *JetScapeLogger::m_pInstance = NULL;
 
+bool JetScapeLogger::debug = false;
+bool JetScapeLogger::remark = false;
+bool JetScapeLogger::info = true;
+unsigned short JetScapeLogger::vlevel = 0;
+
 JetScapeLogger *JetScapeLogger::Instance() {
   if (!m_pInstance)
     m_pInstance = new JetScapeLogger();
@@ -102,24 +104,93 @@ JetScapeLogger *JetScapeLogger::Instance() {
   return m_pInstance;
 }
 
+namespace {
+
+// guards the output streams, taken once per line
+std::mutex log_mutex;
+
+// message buffers of a thread; a message can be logged while the
+// arguments of another one are formatted, hence a stack of buffers
+struct LogBuffers {
+  std::vector<std::unique_ptr<std::ostringstream>> buffers;
+  std::size_t depth = 0;
+};
+thread_local LogBuffers log_buffers;
+
+std::atomic<long> memory_usage(0);
+std::atomic<long long> next_memory_sample(0);
+
+} // end namespace
+
+long JetScapeLogger::GetMemoryUsage() {
+  long long now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now().time_since_epoch())
+                      .count();
+  long long next = next_memory_sample.load(std::memory_order_relaxed);
+  if (now >= next && next_memory_sample.compare_exchange_strong(
+                         next, now + 1000, std::memory_order_relaxed)) {
+    memory_usage.store(getMemoryUsage(), std::memory_order_relaxed);
+  }
+  return memory_usage.load(std::memory_order_relaxed);
+}
+
+std::ostringstream *LogStreamer::AcquireBuffer() {
+  auto &buffers = log_buffers.buffers;
+  if (log_buffers.depth == buffers.size()) {
+    buffers.emplace_back(new std::ostringstream());
+  }
+  std::ostringstream *buffer = buffers[log_buffers.depth++].get();
+  // a previous message may have changed the format
+  buffer->str("");
+  buffer->clear();
+  buffer->flags(std::ios_base::skipws | std::ios_base::dec);
+  buffer->precision(6);
+  buffer->width(0);
+  buffer->fill(' ');
+  return buffer;
+}
+
+void LogStreamer::ReleaseBuffer() { log_buffers.depth--; }
+
+LogStreamer::LogStreamer(std::ostream &dest, bool flush)
+    : m_collector(AcquireBuffer()), m_dest(&dest), m_flush(flush) {}
+
+LogStreamer::LogStreamer(LogStreamer &&other)
+    : m_collector(other.m_collector), m_dest(other.m_dest),
+      m_flush(other.m_flush) {
+  other.m_collector = nullptr;
+}
+
+LogStreamer::~LogStreamer() {
+  if (!m_collector)
+    return;
+  std::string line = m_collector->str();
+  ReleaseBuffer();
+  std::lock_guard<std::mutex> lock(log_mutex);
+  *m_dest << line << RESET << '\n';
+  if (m_flush)
+    m_dest->flush();
+}
+
 LogStreamer JetScapeLogger::Warn() {
   string s = "[Warning] ";
   //s << __PRETTY_FUNCTION__ <<":"<<__LINE__<<" ";
-  //return LogStreamer(std::cout<<s<<__PRETTY_FUNCTION__ <<":"<<__LINE__<<" ");
-  return LogStreamer(std::cout << BOLDRED << s);
+  LogStreamer streamer(std::cout, true);
+  streamer << BOLDRED << s;
+  return streamer;
 }
 
 LogStreamerThread JetScapeLogger::DebugThread() {
   if (debug) {
     string s = "[Debug Thread] ";
     //s <<  __PRETTY_FUNCTION__ <<":"<<__LINE__<<" ";
-    s += to_string(getMemoryUsage());
+    s += to_string(GetMemoryUsage());
     s += "MB ";
-    return (LogStreamerThread(safe_cout) << BLUE << s);
+    LogStreamerThread streamer(std::cout);
+    streamer << BLUE << s;
+    return streamer;
   } else {
-    // check if it is not written in some system log files ...
-    //safe_null.setstate(std::ios_base::failbit);
-    return LogStreamerThread(safe_null);
+    return LogStreamerThread();
   }
 }
 
@@ -127,49 +198,49 @@ LogStreamer JetScapeLogger::Debug() {
   if (debug) {
     string s = "[Debug] ";
     //s <<  __PRETTY_FUNCTION__ <<":"<<__LINE__<<" ";
-    s += to_string(getMemoryUsage());
+    s += to_string(GetMemoryUsage());
     s += "MB ";
-    return LogStreamer(std::cout << BLUE << s);
+    LogStreamer streamer(std::cout);
+    streamer << BLUE << s;
+    return streamer;
   } else {
-    null.setstate(std::ios_base::failbit);
-    return LogStreamer(null);
+    return LogStreamer();
   }
 }
 
 LogStreamer JetScapeLogger::Info() {
-  string s = "[Info] ";
-  // s <<  __PRETTY_FUNCTION__ <<":"<<__LINE__<<" ";
   if (info) {
     string s = "[Info] ";
     // s <<  __PRETTY_FUNCTION__ <<":"<<__LINE__<<" ";
-    s += to_string(getMemoryUsage());
+    s += to_string(GetMemoryUsage());
     s += "MB ";
-    return LogStreamer(std::cout << s);
+    LogStreamer streamer(std::cout);
+    streamer << s;
+    return streamer;
   } else {
-    null.setstate(std::ios_base::failbit);
-    return LogStreamer(null);
+    return LogStreamer();
   }
 }
 
 LogStreamer JetScapeLogger::InfoNice() {
-  string s = "[Info] ";
-  // s <<  __PRETTY_FUNCTION__ <<":"<<__LINE__<<" ";
-  //s += to_string(getMemoryUsage()); s+="MB ";
   if (info) {
-    return LogStreamer(std::cout << s);
+    string s = "[Info] ";
+    LogStreamer streamer(std::cout);
+    streamer << s;
+    return streamer;
   } else {
-    null.setstate(std::ios_base::failbit);
-    return LogStreamer(null);
+    return LogStreamer();
   }
 }
 
 LogStreamer JetScapeLogger::Remark() {
   if (remark) {
     string s = "[REMARK] ";
-    return LogStreamer(std::cout << BOLDMAGENTA << s);
+    LogStreamer streamer(std::cout);
+    streamer << BOLDMAGENTA << s;
+    return streamer;
   } else {
-    null.setstate(std::ios_base::failbit);
-    return LogStreamer(null);
+    return LogStreamer();
   }
 }
 
@@ -179,12 +250,13 @@ LogStreamer JetScapeLogger::Verbose(unsigned short m_vlevel) {
     string s = "[Verbose][";
     s += std::to_string(m_vlevel);
     s += "] ";
-    s += to_string(getMemoryUsage());
+    s += to_string(GetMemoryUsage());
     s += "MB ";
-    return LogStreamer(std::cout << GREEN << s);
+    LogStreamer streamer(std::cout);
+    streamer << GREEN << s;
+    return streamer;
   } else {
-    null.setstate(std::ios_base::failbit);
-    return LogStreamer(null);
+    return LogStreamer();
   }
 }
 
@@ -194,12 +266,13 @@ LogStreamer JetScapeLogger::VerboseShower(unsigned short m_vlevel) {
     string s = "[Verbose][";
     s += std::to_string(m_vlevel);
     s += "] ";
-    s += to_string(getMemoryUsage());
+    s += to_string(GetMemoryUsage());
     s += "MB ";
-    return LogStreamer(std::cout << BOLDCYAN << s);
+    LogStreamer streamer(std::cout);
+    streamer << BOLDCYAN << s;
+    return streamer;
   } else {
-    null.setstate(std::ios_base::failbit);
-    return LogStreamer(null);
+    return LogStreamer();
   }
 }
 
@@ -209,10 +282,13 @@ LogStreamer JetScapeLogger::VerboseParton(unsigned short m_vlevel, Parton &p) {
     string s = "[Verbose][";
     s += std::to_string(m_vlevel);
     s += "] Parton: ";
-    return LogStreamer(std::cout << GREEN << s << " " << p << endl);
+    std::ostringstream parton;
+    parton << p;
+    LogStreamer streamer(std::cout);
+    streamer << GREEN << s << " " << parton.str() << "\n";
+    return streamer;
   } else {
-    null.setstate(std::ios_base::failbit);
-    return LogStreamer(null);
+    return LogStreamer();
   }
 }
 
@@ -222,10 +298,13 @@ LogStreamer JetScapeLogger::VerboseVertex(unsigned short m_vlevel, Vertex &v) {
     string s = "[Verbose][";
     s += std::to_string(m_vlevel);
     s += "] Vertex: ";
-    return LogStreamer(std::cout << GREEN << s << " " << v << endl);
+    std::ostringstream vertex;
+    vertex << v;
+    LogStreamer streamer(std::cout);
+    streamer << GREEN << s << " " << vertex.str() << "\n";
+    return streamer;
   } else {
-    null.setstate(std::ios_base::failbit);
-    return LogStreamer(null);
+    return LogStreamer();
   }
 }
 
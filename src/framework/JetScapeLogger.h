@@ -19,7 +19,6 @@
 #include <iostream>
 #include <sstream>
 #include <cassert>
-#include <iostream>
 #include <mutex>
 #include <memory>
 
@@ -56,32 +55,58 @@ using std::make_shared;
 
 // define nicer macros to be used for logging and check if they should print stuff ...
 // otherwise quite a performance hit ...
+// The level is an inline check of a static flag, so a disabled message costs
+// one branch and its arguments are not evaluated. The if/else form keeps the
+// macros safe in an unbraced if statement.
+#if defined(__GNUC__)
+#define JS_LOG_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define JS_LOG_UNLIKELY(x) (x)
+#endif
+
 #define JSINFO                                                                 \
-  JetScapeLogger::Instance()->Info() << " " //<<__PRETTY_FUNCTION__<<" : "
-#define INFO_NICE JetScapeLogger::Instance()->InfoNice()
+  if (!Jetscape::JetScapeLogger::InfoEnabled()) {                              \
+  } else                                                                       \
+    Jetscape::JetScapeLogger::Instance()->Info() << " "
+#define INFO_NICE                                                              \
+  if (!Jetscape::JetScapeLogger::InfoEnabled()) {                              \
+  } else                                                                       \
+    Jetscape::JetScapeLogger::Instance()->InfoNice()
 #define JSDEBUG                                                                \
-  if (JetScapeLogger::Instance()->GetDebug())                                  \
-  JetScapeLogger::Instance()->Debug() << __PRETTY_FUNCTION__ << " : "
+  if (!JS_LOG_UNLIKELY(Jetscape::JetScapeLogger::DebugEnabled())) {            \
+  } else                                                                       \
+    Jetscape::JetScapeLogger::Instance()->Debug() << __PRETTY_FUNCTION__       \
+        << " : "
 #define DEBUGTHREAD                                                            \
-  if (JetScapeLogger::Instance()->GetDebug())                                  \
-  JetScapeLogger::Instance()->DebugThread() << __PRETTY_FUNCTION__ << " : "
+  if (!JS_LOG_UNLIKELY(Jetscape::JetScapeLogger::DebugEnabled())) {            \
+  } else                                                                       \
+    Jetscape::JetScapeLogger::Instance()->DebugThread()                        \
+        << __PRETTY_FUNCTION__ << " : "
 #define REMARK                                                                 \
-  if (JetScapeLogger::Instance()->GetRemark())                                 \
-  JetScapeLogger::Instance()->Remark() << __PRETTY_FUNCTION__ << " : "
+  if (!JS_LOG_UNLIKELY(Jetscape::JetScapeLogger::RemarkEnabled())) {           \
+  } else                                                                       \
+    Jetscape::JetScapeLogger::Instance()->Remark() << __PRETTY_FUNCTION__      \
+        << " : "
 #define VERBOSE(l)                                                             \
-  if (l < JetScapeLogger::Instance()->GetVerboseLevel())                       \
-  JetScapeLogger::Instance()->Verbose(l) << __PRETTY_FUNCTION__ << " : "
+  if (!JS_LOG_UNLIKELY(Jetscape::JetScapeLogger::VerboseEnabled(l))) {         \
+  } else                                                                       \
+    Jetscape::JetScapeLogger::Instance()->Verbose(l) << __PRETTY_FUNCTION__    \
+        << " : "
 #define VERBOSESHOWER(l)                                                       \
-  if (l < JetScapeLogger::Instance()->GetVerboseLevel())                       \
-  JetScapeLogger::Instance()->VerboseShower(l) << __PRETTY_FUNCTION__ << " : "
+  if (!JS_LOG_UNLIKELY(Jetscape::JetScapeLogger::VerboseEnabled(l))) {         \
+  } else                                                                       \
+    Jetscape::JetScapeLogger::Instance()->VerboseShower(l)                     \
+        << __PRETTY_FUNCTION__ << " : "
 #define VERBOSEPARTON(l, p)                                                    \
-  if (l < JetScapeLogger::Instance()->GetVerboseLevel())                       \
-  JetScapeLogger::Instance()->VerboseParton(l, p)                              \
-      << __PRETTY_FUNCTION__ << " : "
+  if (!JS_LOG_UNLIKELY(Jetscape::JetScapeLogger::VerboseEnabled(l))) {         \
+  } else                                                                       \
+    Jetscape::JetScapeLogger::Instance()->VerboseParton(l, p)                  \
+        << __PRETTY_FUNCTION__ << " : "
 #define VERBOSEPVERTEX(l, v)                                                   \
-  if (l < JetScapeLogger::Instance()->GetVerboseLevel())                       \
-  JetScapeLogger::Instance()->VerboseVertex(l, v)                              \
-      << __PRETTY_FUNCTION__ << " : "
+  if (!JS_LOG_UNLIKELY(Jetscape::JetScapeLogger::VerboseEnabled(l))) {         \
+  } else                                                                       \
+    Jetscape::JetScapeLogger::Instance()->VerboseVertex(l, v)                  \
+        << __PRETTY_FUNCTION__ << " : "
 #define JSWARN                                                                 \
   JetScapeLogger::Instance()->Warn() << __PRETTY_FUNCTION__ << " : "
 
@@ -91,99 +116,46 @@ namespace Jetscape {
 class Vertex;
 class Parton;
 
-// -------------------------------------------
-struct SafeOstream {
-  struct GuardedImpl {
-    GuardedImpl() = delete;
-    GuardedImpl(const GuardedImpl &) = delete;
-    void operator=(const GuardedImpl &) = delete;
-    GuardedImpl(std::ostream &ostream, std::mutex &mutex)
-        : Ostream(ostream), Guard(mutex) {}
-    ~GuardedImpl() { Ostream.flush(); }
-    template <typename T> void write(const T &x) { Ostream << x; }
-    std::ostream &Ostream;
-    std::lock_guard<std::mutex> Guard;
-  };
-  struct impl {
-    impl() = delete;
-    void operator=(const impl &) = delete;
-    impl(std::ostream &ostream, std::mutex &mutex)
-        : UniqueImpl(new GuardedImpl(ostream, mutex)) {}
-    impl(const impl &rhs) {
-      assert(rhs.UniqueImpl.get());
-      UniqueImpl.swap(rhs.UniqueImpl);
-    }
-    template <typename T> impl &operator<<(const T &x) {
-      GuardedImpl *p = UniqueImpl.get();
-      assert(p);
-      p->write(x);
-      return *this;
-    }
-    mutable std::unique_ptr<GuardedImpl> UniqueImpl;
-  };
-  explicit SafeOstream(std::ostream &ostream) : Ostream(ostream) {}
-  template <typename T> impl operator<<(const T &x) {
-    return impl(Ostream, mutex_) << x;
-  }
-  std::ostream &Ostream;
-  std::mutex mutex_;
-};
-
 // --------------------------------
 // Just a helper class to make the interface
 // consistent with << operator
-// In principle simple extension to
-// log into a file ... via m_dest
-// Think about thread safety ...
-// << overload in Parton class not working!? Check ...
+// A message is collected in a buffer owned by the calling thread, which is
+// reused for the next messages, and is written as one line to the
+// destination when the streamer goes out of scope. Lines of different
+// threads do not mix, the streams are locked once per line.
 
 class LogStreamer {
 
-  shared_ptr<std::ostringstream> m_collector;
+  std::ostringstream *m_collector; // nullptr if the message is dropped
   std::ostream *m_dest;
+  bool m_flush;
+
+  static std::ostringstream *AcquireBuffer();
+  static void ReleaseBuffer();
 
 public:
-  LogStreamer(std::ostream &dest) {
-    m_collector = make_shared<std::ostringstream>();
-    m_dest = &dest;
-  };
-
-  ~LogStreamer() {
-    if (m_collector.unique() && m_dest != nullptr) {
-      //*m_dest << m_collector->str() << RESET << std::endl;
-      *m_dest << m_collector->str() << RESET << std::endl;
-    }
-  }
+  /** A streamer which drops the message. */
+  LogStreamer() : m_collector(nullptr), m_dest(nullptr), m_flush(false) {}
+  /** @param dest Stream the message is written to.
+      @param flush Flush the stream after the message.
+   */
+  explicit LogStreamer(std::ostream &dest, bool flush = false);
+  LogStreamer(LogStreamer &&other);
+  LogStreamer(const LogStreamer &) = delete;
+  LogStreamer &operator=(const LogStreamer &) = delete;
+  ~LogStreamer();
 
   template <typename T> LogStreamer &operator<<(T const &value) {
-    *m_collector << value;
-    return *this;
-  }
-};
-
-class LogStreamerThread {
-
-  shared_ptr<std::ostringstream> m_collector;
-  SafeOstream *m_dest;
-
-public:
-  LogStreamerThread(SafeOstream &dest) {
-    m_collector = make_shared<std::ostringstream>();
-    m_dest = &dest;
-  };
-
-  ~LogStreamerThread() {
-    if (m_collector.unique() && m_dest != nullptr) {
-      *m_dest << m_collector->str() << RESET << "\n";
+    if (m_collector) {
+      *m_collector << value;
     }
-  }
-
-  template <typename T> LogStreamerThread &operator<<(T const &value) {
-    *m_collector << value;
     return *this;
   }
 };
 
+// kept for the interface of DebugThread(), every streamer is thread safe
+typedef LogStreamer LogStreamerThread;
+
 // --------------------------------
 
 class JetScapeLogger {
@@ -215,20 +187,28 @@ public:
   bool GetInfo() { return info; }
   unsigned short GetVerboseLevel() { return vlevel; }
 
+  // checks used by the logging macros before anything else is done
+  static bool DebugEnabled() { return debug; }
+  static bool RemarkEnabled() { return remark; }
+  static bool InfoEnabled() { return info; }
+  static bool VerboseEnabled(unsigned short m_vlevel) {
+    return m_vlevel < vlevel;
+  }
+
+  /** @return Maximum resident memory in MB. It is sampled at most once per
+      second, the messages in between print the last sample.
+   */
+  static long GetMemoryUsage();
+
 private:
-  JetScapeLogger() {
-    info = true;
-    debug = false;
-    remark = false;
-    vlevel = 0;
-  };
+  JetScapeLogger(){};
   JetScapeLogger(JetScapeLogger const &){};
   static JetScapeLogger *m_pInstance;
 
-  bool debug;
-  bool remark;
-  bool info;
-  unsigned short vlevel;
+  static bool debug;
+  static bool remark;
+  static bool info;
+  static unsigned short vlevel;
 };
 
 } // end namespace Jetscape
@@ -17,6 +17,7 @@
 #include "JetScapeXML.h"
 #include "JetScapeTaskSupport.h"
 #include "JetScapeLogger.h"
+#include "JetScapeProfiler.h"
 
 #include <iostream>
 
@@ -66,6 +67,11 @@ shared_ptr<std::mt19937> JetScapeModuleBase::GetMt19937Generator() {
   return mt19937_generator_;
 }
 
+PhiloxEngine JetScapeModuleBase::GetPhiloxEngine(unsigned int stream) const {
+  return JetScapeTaskSupport::GetPhiloxEngine(GetMyTaskNumber(),
+                                              GetCurrentEvent(), stream);
+}
+
 void JetScapeModuleBase::CalculateTimeTasks()
 {
   if (ClockUsed()) {
@@ -76,6 +82,7 @@ void JetScapeModuleBase::CalculateTimeTasks()
     //cout<<it->GetId()<<" "<<it->GetActive()<<endl;
     if (std::dynamic_pointer_cast<JetScapeModuleBase>(it) && !it->GetActive() && std::dynamic_pointer_cast<JetScapeModuleBase>(it)->IsValidModuleTime()) {
     VERBOSE(3) << "Calculate Time Step = " << it->GetId();
+    JetScapeProfiler::Scope scope(it->GetProfileId(PROFILE_CALCULATE_TIME));
     //if (it->active_exec) 
       std::dynamic_pointer_cast<JetScapeModuleBase>(it)->CalculateTime();
     }
@@ -92,6 +99,7 @@ void JetScapeModuleBase::ExecTimeTasks()
       //cout<<it->GetId()<<" "<<it->GetActive()<<endl;
       if (std::dynamic_pointer_cast<JetScapeModuleBase>(it) && !it->GetActive() && std::dynamic_pointer_cast<JetScapeModuleBase>(it)->IsValidModuleTime()) {
 	VERBOSE(3) << "Execute Time Step = " << it->GetId();
+	JetScapeProfiler::Scope scope(it->GetProfileId(PROFILE_EXEC_TIME));
 	//if (it->active_exec) 
 	std::dynamic_pointer_cast<JetScapeModuleBase>(it)->ExecTime();
       }
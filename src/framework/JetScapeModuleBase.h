@@ -24,6 +24,7 @@
 #include "JetScapeTask.h"
 #include "JetScapeXML.h"
 #include "TimeModule.h"
+#include "PhiloxEngine.h"
 #include "sigslot.h"
 
 #include "cpp17/any.hpp"
@@ -134,6 +135,13 @@ public:
    */
   shared_ptr<std::mt19937> GetMt19937Generator();
 
+  /** This function returns a counter-based random engine for this task in
+      the current event. It is cheap to create and independent of any other
+      engine, so it can be used from concurrently running tasks.
+      @param stream Stream id, to get several independent engines.
+   */
+  PhiloxEngine GetPhiloxEngine(unsigned int stream = 0) const;
+
   /** Helper functions for XML parsing, wrapping functionality in JetScapeXML:
    */
   tinyxml2::XMLElement *GetXMLElement(std::initializer_list<const char *> path,
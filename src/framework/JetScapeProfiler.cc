@@ -0,0 +1,298 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "JetScapeProfiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+// Allocations of the thread while the profiler is on, counted by the
+// operator new of JetScapeProfilerAllocator.cc. Plain integers with
+// constant initialization, so operator new can use them at any time.
+thread_local unsigned long long n_thread_allocations = 0;
+thread_local unsigned long long n_thread_allocated_bytes = 0;
+// set while the profiler does its own bookkeeping, which is not counted
+thread_local bool in_profiler = false;
+
+struct ProfilerBookkeeping {
+  bool was_in_profiler = in_profiler;
+  ProfilerBookkeeping() { in_profiler = true; }
+  ~ProfilerBookkeeping() { in_profiler = was_in_profiler; }
+};
+
+std::string JsonString(const std::string &s) {
+  std::string quoted = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\')
+      quoted += '\\';
+    quoted += c;
+  }
+  return quoted + "\"";
+}
+
+} // namespace
+
+namespace Jetscape {
+
+std::atomic<bool> JetScapeProfiler::active_(false);
+
+void JetScapeProfiler::CountAllocation(std::size_t size) {
+  if (IsActive() && !in_profiler) {
+    n_thread_allocations++;
+    n_thread_allocated_bytes += size;
+  }
+}
+
+bool JetScapeProfiler::CountsAllocations() {
+#ifdef JETSCAPE_PROFILE_ALLOCATIONS
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Recorded numbers of one thread. The table outlives its thread, it is
+// owned by the profiler.
+struct ProfilerThreadTable {
+  std::mutex table_mutex;
+  std::vector<JetScapeProfiler::Counters> counters; //!< guarded by table_mutex
+  std::vector<int> depth; //!< open scopes per region, only used by the thread
+};
+
+// Hands the table back to the profiler when its thread exits, so that
+// the threads started for every event (like the one of a streaming
+// hydro) do not add a table each.
+struct ProfilerThreadTableHolder {
+  ProfilerThreadTable *table = nullptr;
+  ~ProfilerThreadTableHolder() {
+    if (table)
+      JetScapeProfiler::Instance()->ReleaseThreadTable(table);
+  }
+};
+
+JetScapeProfiler *JetScapeProfiler::Instance() {
+  // the first scope can be opened on any thread
+  static JetScapeProfiler *instance = new JetScapeProfiler();
+  return instance;
+}
+
+int JetScapeProfiler::Register(const std::string &kind,
+                               const std::string &name) {
+  ProfilerBookkeeping bookkeeping;
+  std::lock_guard<std::mutex> lock(profiler_mutex);
+  auto key = std::make_pair(kind, name);
+  auto it = region_ids.find(key);
+  if (it != region_ids.end())
+    return it->second;
+
+  int id = regions.size();
+  region_ids.emplace(key, id);
+  regions.push_back(key);
+  totals.push_back(Totals());
+  return id;
+}
+
+ProfilerThreadTable *JetScapeProfiler::GetThreadTable() {
+  thread_local ProfilerThreadTableHolder holder;
+  if (!holder.table) {
+    std::lock_guard<std::mutex> lock(profiler_mutex);
+    if (!free_thread_tables.empty()) {
+      holder.table = free_thread_tables.back();
+      free_thread_tables.pop_back();
+    } else {
+      thread_tables.push_back(std::make_shared<ProfilerThreadTable>());
+      holder.table = thread_tables.back().get();
+    }
+  }
+  return holder.table;
+}
+
+void JetScapeProfiler::ReleaseThreadTable(ProfilerThreadTable *table) {
+  ProfilerBookkeeping bookkeeping;
+  std::lock_guard<std::mutex> lock(profiler_mutex);
+  free_thread_tables.push_back(table);
+}
+
+void JetScapeProfiler::Scope::Start(int id) {
+  ProfilerBookkeeping bookkeeping;
+  ProfilerThreadTable *table = Instance()->GetThreadTable();
+  if (static_cast<int>(table->depth.size()) <= id)
+    table->depth.resize(id + 1, 0);
+  table_ = table;
+  id_ = id;
+  if (table->depth[id]++ > 0)
+    return;
+
+  allocations_start_ = n_thread_allocations;
+  bytes_start_ = n_thread_allocated_bytes;
+  start_ = std::chrono::steady_clock::now();
+}
+
+void JetScapeProfiler::Scope::Finish() {
+  auto end = std::chrono::steady_clock::now();
+  ProfilerBookkeeping bookkeeping;
+  ProfilerThreadTable *table = table_;
+  table_ = nullptr;
+  bool outermost = (--table->depth[id_] == 0);
+
+  std::lock_guard<std::mutex> lock(table->table_mutex);
+  if (static_cast<int>(table->counters.size()) <= id_)
+    table->counters.resize(id_ + 1);
+  Counters &counters = table->counters[id_];
+  counters.calls++;
+  if (outermost) {
+    counters.nanoseconds +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start_)
+            .count();
+    counters.allocations += n_thread_allocations - allocations_start_;
+    counters.allocated_bytes += n_thread_allocated_bytes - bytes_start_;
+  }
+}
+
+void JetScapeProfiler::EndEvent() {
+  std::lock_guard<std::mutex> lock(profiler_mutex);
+  std::vector<Counters> event(regions.size());
+  for (auto &table : thread_tables) {
+    std::lock_guard<std::mutex> table_lock(table->table_mutex);
+    for (unsigned int id = 0; id < table->counters.size(); id++) {
+      Counters &counters = table->counters[id];
+      event[id].calls += counters.calls;
+      event[id].nanoseconds += counters.nanoseconds;
+      event[id].allocations += counters.allocations;
+      event[id].allocated_bytes += counters.allocated_bytes;
+      counters = Counters();
+    }
+  }
+
+  for (unsigned int id = 0; id < event.size(); id++) {
+    if (event[id].calls == 0)
+      continue;
+    Totals &total = totals[id];
+    total.sum.calls += event[id].calls;
+    total.sum.nanoseconds += event[id].nanoseconds;
+    total.sum.allocations += event[id].allocations;
+    total.sum.allocated_bytes += event[id].allocated_bytes;
+    total.max_event_nanoseconds =
+        std::max(total.max_event_nanoseconds, event[id].nanoseconds);
+    total.events++;
+  }
+  n_events++;
+}
+
+void JetScapeProfiler::Reset() {
+  std::lock_guard<std::mutex> lock(profiler_mutex);
+  for (auto &table : thread_tables) {
+    std::lock_guard<std::mutex> table_lock(table->table_mutex);
+    table->counters.clear();
+  }
+  totals.assign(regions.size(), Totals());
+  n_events = 0;
+}
+
+std::vector<JetScapeProfiler::RegionSummary>
+JetScapeProfiler::GetSummary() const {
+  std::vector<RegionSummary> summary;
+  {
+    std::lock_guard<std::mutex> lock(profiler_mutex);
+    for (unsigned int id = 0; id < regions.size(); id++) {
+      const Totals &total = totals[id];
+      if (total.events == 0)
+        continue;
+      RegionSummary region;
+      region.kind = regions[id].first;
+      region.name = regions[id].second;
+      region.calls = total.sum.calls;
+      region.time = 1e-9 * total.sum.nanoseconds;
+      region.max_event_time = 1e-9 * total.max_event_nanoseconds;
+      region.allocations = total.sum.allocations;
+      region.allocated_bytes = total.sum.allocated_bytes;
+      region.events = total.events;
+      summary.push_back(region);
+    }
+  }
+  std::stable_sort(summary.begin(), summary.end(),
+                   [](const RegionSummary &a, const RegionSummary &b) {
+                     return (a.time > b.time);
+                   });
+  return summary;
+}
+
+int JetScapeProfiler::GetNumberOfEvents() const {
+  std::lock_guard<std::mutex> lock(profiler_mutex);
+  return n_events;
+}
+
+int JetScapeProfiler::GetNumberOfThreadTables() const {
+  std::lock_guard<std::mutex> lock(profiler_mutex);
+  return (thread_tables.size() - free_thread_tables.size());
+}
+
+void JetScapeProfiler::PrintSummary(std::ostream &out) const {
+  auto summary = GetSummary();
+  int n = std::max(1, GetNumberOfEvents());
+
+  std::ostringstream table;
+  table << "Profile of " << GetNumberOfEvents()
+        << " events, per event, nested regions included\n";
+  if (!CountsAllocations())
+    table << "Allocations are counted only with "
+          << "cmake -DJETSCAPE_PROFILE_ALLOCATIONS=ON\n";
+  table << std::left << std::setw(14) << "Region" << std::setw(32) << "Name"
+        << std::right << std::setw(12) << "Calls" << std::setw(12)
+        << "Time [ms]" << std::setw(12) << "Max [ms]" << std::setw(14)
+        << "Allocations" << std::setw(12) << "Alloc [kB]" << "\n";
+  table << std::fixed;
+  for (const auto &region : summary) {
+    table << std::left << std::setw(14) << region.kind << std::setw(32)
+          << region.name << std::right << std::setprecision(1)
+          << std::setw(12) << static_cast<double>(region.calls) / n
+          << std::setprecision(3) << std::setw(12) << 1e3 * region.time / n
+          << std::setw(12) << 1e3 * region.max_event_time
+          << std::setprecision(1) << std::setw(14)
+          << static_cast<double>(region.allocations) / n << std::setw(12)
+          << 1e-3 * region.allocated_bytes / n << "\n";
+  }
+  out << table.str();
+}
+
+void JetScapeProfiler::WriteReport(std::ostream &out) const {
+  auto summary = GetSummary();
+  out << "{\n  \"events\": " << GetNumberOfEvents() << ",\n  \"regions\": [";
+  for (unsigned int i = 0; i < summary.size(); i++) {
+    const auto &region = summary[i];
+    out << (i == 0 ? "\n" : ",\n") << "    {\"kind\": "
+        << JsonString(region.kind) << ", \"name\": " << JsonString(region.name)
+        << ", \"calls\": " << region.calls << ", \"events\": " << region.events
+        << std::setprecision(9) << ", \"time_s\": " << region.time
+        << ", \"max_event_time_s\": " << region.max_event_time
+        << ", \"allocations\": " << region.allocations
+        << ", \"allocated_bytes\": " << region.allocated_bytes << "}";
+  }
+  out << "\n  ]\n}\n";
+}
+
+bool JetScapeProfiler::WriteReport(const std::string &file_name) const {
+  std::ofstream out(file_name.c_str());
+  if (!out)
+    return false;
+  WriteReport(out);
+  return static_cast<bool>(out);
+}
+
+} // end namespace Jetscape
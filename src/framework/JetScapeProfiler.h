@@ -0,0 +1,194 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#ifndef JETSCAPEPROFILER_H
+#define JETSCAPEPROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Jetscape {
+
+struct ProfilerThreadTable;
+struct ProfilerThreadTableHolder;
+
+/** @class JetScapeProfiler
+ * Opt-in profiler of the task tree (meant as singleton), switched on with
+ * <profile> on </profile>. For every region - the Exec, ExecTime,
+ * CalculateTime, WriteTask and Clear of a task, the slots of the signals
+ * and the whole event - it records the wall time, the number of calls and
+ * the heap allocations made through operator new, per event and summed
+ * over the events.
+ *
+ * Counting the allocations replaces the global operator new of every
+ * program linking libJetScape, so it is only built with
+ * cmake -DJETSCAPE_PROFILE_ALLOCATIONS=ON. Otherwise the allocations
+ * read zero.
+ *
+ * Time and allocations of a region include those of the regions nested
+ * in it. The allocations are the ones of the thread running the region.
+ * A region entered again while it runs (a recursive signal) counts as a
+ * call but is timed once. When switched off a region costs one relaxed
+ * atomic load.
+ */
+class JetScapeProfiler {
+public:
+  static JetScapeProfiler *Instance();
+
+  static bool IsActive() { return (active_.load(std::memory_order_relaxed)); }
+  static void SetActive(bool active) { active_.store(active); }
+
+  /** @return Id of the region, the same for the same kind and name.
+      Thread-safe, but takes a lock: callers running often keep the id.
+   */
+  int Register(const std::string &kind, const std::string &name);
+
+  /** Add what the regions recorded since the last call to the summary, as
+      one event. Called by JetScape after each event.
+   */
+  void EndEvent();
+
+  /** Forget all recorded numbers, the ids stay valid. */
+  void Reset();
+
+  //! Totals of one region over the events
+  struct RegionSummary {
+    std::string kind;
+    std::string name;
+    long calls = 0;
+    double time = 0.;           //!< wall time in s
+    double max_event_time = 0.; //!< largest wall time in one event in s
+    long long allocations = 0;
+    long long allocated_bytes = 0;
+    int events = 0; //!< number of events in which the region was called
+  };
+
+  /** @return The regions called in at least one event, the longest first. */
+  std::vector<RegionSummary> GetSummary() const;
+
+  int GetNumberOfEvents() const;
+
+  /** @return True if the allocations are counted, in builds with
+      JETSCAPE_PROFILE_ALLOCATIONS.
+   */
+  static bool CountsAllocations();
+
+  /** Count an allocation of the current thread, called by the counting
+      operator new. Does not allocate.
+   */
+  static void CountAllocation(std::size_t size);
+
+  /** @return Number of tables of recorded numbers, one per running thread
+      that opened a region. A thread that exits hands its table to the
+      next new thread.
+   */
+  int GetNumberOfThreadTables() const;
+
+  /** Print the summary as a table, per event averages. */
+  void PrintSummary(std::ostream &out) const;
+
+  /** Write the summary as JSON, to compare the runs of a benchmark. */
+  void WriteReport(std::ostream &out) const;
+  bool WriteReport(const std::string &file_name) const;
+
+  /** @class Scope
+   * Records the region from its construction to its destruction or to
+   * Stop(). Nothing is recorded if the profiler is off at construction.
+   */
+  class Scope {
+  public:
+    /** @param id Id from Register(), negative ids are not recorded. */
+    explicit Scope(int id) { if (IsActive() && id >= 0) Start(id); }
+
+    /** Registers the region only if the profiler is on. */
+    Scope(const char *kind, const std::string &name) {
+      if (IsActive())
+        Start(Instance()->Register(kind, name));
+    }
+
+    ~Scope() { Stop(); }
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+    void Stop() {
+      if (table_)
+        Finish();
+    }
+
+  private:
+    void Start(int id);
+    void Finish();
+
+    ProfilerThreadTable *table_ = nullptr;
+    int id_ = -1;
+    std::chrono::steady_clock::time_point start_;
+    unsigned long long allocations_start_ = 0;
+    unsigned long long bytes_start_ = 0;
+  };
+
+private:
+  JetScapeProfiler() {}
+
+  // summed numbers of one region, also used per event
+  struct Counters {
+    long calls = 0;
+    long long nanoseconds = 0;
+    long long allocations = 0;
+    long long allocated_bytes = 0;
+  };
+
+  struct Totals {
+    Counters sum;
+    long long max_event_nanoseconds = 0;
+    int events = 0;
+  };
+
+  friend struct ProfilerThreadTable;
+  friend struct ProfilerThreadTableHolder;
+  friend class Scope;
+  ProfilerThreadTable *GetThreadTable();
+  void ReleaseThreadTable(ProfilerThreadTable *table);
+
+  static std::atomic<bool> active_;
+
+  mutable std::mutex profiler_mutex;
+  std::map<std::pair<std::string, std::string>, int> region_ids;
+  std::vector<std::pair<std::string, std::string>> regions;
+  std::vector<std::shared_ptr<ProfilerThreadTable>> thread_tables;
+  //! tables of exited threads, their counters still count for the event
+  std::vector<ProfilerThreadTable *> free_thread_tables;
+  std::vector<Totals> totals;
+  int n_events = 0;
+};
+
+} // end namespace Jetscape
+
+/// Record the rest of the enclosing block as region (kind, name), the
+/// name being fixed at the first call
+#define JSPROFILE(kind, name)                                                  \
+  static const int jsprofile_id_ =                                             \
+      Jetscape::JetScapeProfiler::Instance()->Register(kind, name);            \
+  Jetscape::JetScapeProfiler::Scope jsprofile_scope_(jsprofile_id_)
+
+#endif // JETSCAPEPROFILER_H
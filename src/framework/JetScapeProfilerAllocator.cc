@@ -0,0 +1,47 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+// Counting versions of the global allocation functions, for the allocation
+// numbers of the profiler. They replace the allocator of every program
+// linking libJetScape, so they are only built with
+// cmake -DJETSCAPE_PROFILE_ALLOCATIONS=ON.
+
+#ifdef JETSCAPE_PROFILE_ALLOCATIONS
+
+#include "JetScapeProfiler.h"
+
+#include <cstdlib>
+#include <new>
+
+// The other forms (array, nothrow) end up in these, and malloc/free keep
+// them compatible with the forms that call malloc directly.
+void *operator new(std::size_t size) {
+  Jetscape::JetScapeProfiler::CountAllocation(size);
+  if (size == 0)
+    size = 1;
+  while (true) {
+    void *p = std::malloc(size);
+    if (p)
+      return p;
+    std::new_handler handler = std::get_new_handler();
+    if (!handler)
+      throw std::bad_alloc();
+    handler();
+  }
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+#endif // JETSCAPE_PROFILE_ALLOCATIONS
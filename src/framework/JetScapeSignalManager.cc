@@ -95,6 +95,8 @@ void JetScapeSignalManager::ConnectGetHydroCellSignal(
     auto hp = GetHydroPointer().lock();
     if (hp) {
       j->GetHydroCellSignal.connect(hp.get(), &FluidDynamics::GetHydroCell);
+      j->GetHydroInfoBatchSignal.connect(hp.get(),
+                                         &FluidDynamics::GetHydroCellBatch);
       j->SetGetHydroCellSignalConnected(true);
       GetHydroCellSignal_map.emplace(num_GetHydroCellSignals,
                                      (weak_ptr<JetEnergyLoss>)j);
@@ -117,7 +119,7 @@ void JetScapeSignalManager::ConnectGetHydroCellSignal(
 void JetScapeSignalManager::ConnectSentInPartonsSignal(
     shared_ptr<JetEnergyLoss> j, shared_ptr<JetEnergyLoss> j2) {
   if (!j2->GetSentInPartonsConnected()) {
-    j->SentInPartons.connect(j2.get(), &JetEnergyLoss::DoEnergyLoss);
+    j->SentInPartons.connect(j2.get(), &JetEnergyLoss::ProfiledDoEnergyLoss);
     j2->SetSentInPartonsConnected(true);
     SentInPartons_map.emplace(num_SentInPartons, (weak_ptr<JetEnergyLoss>)j2);
 
@@ -128,7 +130,8 @@ void JetScapeSignalManager::ConnectSentInPartonsSignal(
 void JetScapeSignalManager::ConnectTransformPartonsSignal(
     shared_ptr<Hadronization> h, shared_ptr<Hadronization> h2) {
   if (!h2->GetTransformPartonsConnected()) {
-    h->TransformPartons.connect(h2.get(), &Hadronization::DoHadronization);
+    h->TransformPartons.connect(h2.get(),
+                                &Hadronization::ProfiledDoHadronization);
     h2->SetTransformPartonsConnected(true);
     TransformPartons_map.emplace(num_TransformPartons,
                                  (weak_ptr<Hadronization>)h2);
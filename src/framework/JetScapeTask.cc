@@ -16,6 +16,7 @@
 #include "JetScapeTask.h"
 #include "JetScapeTaskSupport.h"
 #include "JetScapeLogger.h"
+#include "JetScapeProfiler.h"
 
 #include "JetEnergyLoss.h"
 
@@ -28,6 +29,8 @@ namespace Jetscape {
 JetScapeTask::JetScapeTask() {
   active_exec = true;
   id = "";
+  for (int &profile_id : profile_ids)
+    profile_id = -1;
   my_task_number_ = JetScapeTaskSupport::Instance()->RegisterTask();
   VERBOSE(9);
 }
@@ -40,6 +43,16 @@ JetScapeTask::~JetScapeTask() {
 
 void JetScapeTask::Init() { JSDEBUG; }
 
+int JetScapeTask::GetProfileId(ProfileRegion region) {
+  int &profile_id = profile_ids[region];
+  if (profile_id < 0 && JetScapeProfiler::IsActive()) {
+    static const char *kinds[N_PROFILE_REGIONS] = {
+        "Exec", "Clear", "WriteTask", "CalculateTime", "ExecTime"};
+    profile_id = JetScapeProfiler::Instance()->Register(kinds[region], id);
+  }
+  return profile_id;
+}
+
 /** Recursive initialization of all the subtasks of the JetScapeTask. Subtasks are also of type JetScapeTask such as Pythia Gun, Trento, Energy Loss Matter and Martini etc.
    */
 void JetScapeTask::InitTasks() {
@@ -56,16 +69,20 @@ void JetScapeTask::ExecuteTasks() {
   VERBOSE(7) << " : # Subtasks = " << tasks.size();
   for (auto it : tasks) {
     JSDEBUG << "Executing " << it->GetId();
-    if (it->active_exec)
+    if (it->active_exec) {
+      JetScapeProfiler::Scope scope(it->GetProfileId(PROFILE_EXEC));
       it->Exec();
+    }
   }
 }
 
 void JetScapeTask::ClearTasks() {
   VERBOSE(7) << " : # Subtasks = " << tasks.size();
   for (auto it : tasks)
-    if (it->active_exec)
+    if (it->active_exec) {
+      JetScapeProfiler::Scope scope(it->GetProfileId(PROFILE_CLEAR));
       it->Clear();
+    }
 }
 
 //JP: Quick and dirty fix to force all tasks if active or not to use the writer 
@@ -74,8 +91,10 @@ void JetScapeTask::ClearTasks() {
 void JetScapeTask::WriteTasks(weak_ptr<JetScapeWriter> w) {
   //VERBOSE(10);
   //if (active_exec) {
-    for (auto it : tasks)
+    for (auto it : tasks) {
+      JetScapeProfiler::Scope scope(it->GetProfileId(PROFILE_WRITE_TASK));
       it->WriteTask(w);
+    }
   //}
 }
 
@@ -179,12 +179,32 @@ public:
 
   /** This function sets the string "id" of the task of a JetScapeTask.
    */
-  void SetId(string m_id) { id = m_id; }
+  void SetId(string m_id) {
+    id = m_id;
+    for (int &profile_id : profile_ids)
+      profile_id = -1;
+  }
 
   /** This function returns the id of the task of a JetScapeTask.
    */
   const string GetId() const { return id; }
 
+  /** Regions of a task recorded by JetScapeProfiler. */
+  enum ProfileRegion {
+    PROFILE_EXEC,
+    PROFILE_CLEAR,
+    PROFILE_WRITE_TASK,
+    PROFILE_CALCULATE_TIME,
+    PROFILE_EXEC_TIME,
+    N_PROFILE_REGIONS
+  };
+
+  /** @return JetScapeProfiler id of the region of this task, named after
+      the id of the task. It is registered at the first call with the
+      profiler on and kept, -1 while the profiler is off.
+   */
+  int GetProfileId(ProfileRegion region);
+
   /** This function returns the mutex of a JetScapeTask.
    */
   const shared_ptr<JetScapeModuleMutex> GetMutex() const { return mutex; }
@@ -210,6 +230,9 @@ private:
 
   int my_task_number_;
   shared_ptr<JetScapeModuleMutex> mutex;
+
+  // a task is run by one thread at a time, the ids need no lock
+  int profile_ids[N_PROFILE_REGIONS];
 };
 
 } // end namespace Jetscape
@@ -28,6 +28,9 @@ unsigned int JetScapeTaskSupport::random_seed_ = 0;
 bool JetScapeTaskSupport::initialized_ = false;
 bool JetScapeTaskSupport::one_generator_per_task_ = false;
 
+// stream of the counter-based engine used to seed the per-task mt19937
+static const unsigned int kMt19937SeedStream = 0xffffffffu;
+
 // ---------------------------------------------------------------------------
 JetScapeTaskSupport *JetScapeTaskSupport::Instance() {
   if (!m_pInstance) {
@@ -105,14 +108,13 @@ shared_ptr<std::mt19937> JetScapeTaskSupport::GetMt19937Generator(int TaskId) {
   if (one_generator_per_task_) {
     if (random_seed_ == 0)
       throw std::runtime_error("This should never happen");
-    // reseed to be on the safe side
-    one_for_all_->seed(random_seed_);
-    // Advance according to TaskId
+    // The unique seed for this task is drawn from a counter-based engine
+    // keyed on the task id: O(1) in TaskId, and seeds of neighbouring
+    // tasks are not correlated. It uses a stream of its own.
     // Note that this method can be lied to.
     // Could design a safer interface but for now, trust the user
-    one_for_all_->discard(TaskId);
-    // And get the unique seed for this task
-    unsigned int localseed = (*one_for_all_)();
+    PhiloxEngine seeder(random_seed_, 0, TaskId, kMt19937SeedStream);
+    unsigned int localseed = seeder();
     JSDEBUG << "Asked by " << TaskId
             << " for an individual generator, returning one seeded with "
             << localseed;
@@ -126,6 +128,25 @@ shared_ptr<std::mt19937> JetScapeTaskSupport::GetMt19937Generator(int TaskId) {
   return one_for_all_;
 }
 
+// ---------------------------------------------------------------------------
+PhiloxEngine JetScapeTaskSupport::GetPhiloxEngine(int TaskId,
+                                                  unsigned int Event,
+                                                  unsigned int Stream) {
+  if (!initialized_) {
+    JSWARN << "Trying to use JetScapeTaskSupport::GetPhiloxEngine before "
+              "initialization";
+    throw std::runtime_error(
+        "Trying to use JetScapeTaskSupport::GetPhiloxEngine before "
+        "initialization");
+  }
+  if (Stream == kMt19937SeedStream) {
+    throw std::runtime_error(
+        "JetScapeTaskSupport::GetPhiloxEngine: stream id reserved for the "
+        "seeds of the mt19937 engines");
+  }
+  return PhiloxEngine(random_seed_, Event, TaskId, Stream);
+}
+
 // ---------------------------------------------------------------------------
 
 } // end namespace Jetscape
@@ -38,6 +38,7 @@
 #include "FluidDynamics.h"
 #include "HardProcess.h"
 #include "JetScapeWriter.h"
+#include "PhiloxEngine.h"
 
 #include <iostream>
 #include <atomic>
@@ -72,8 +73,17 @@ public:
   /// every task gets their own
   shared_ptr<std::mt19937> GetMt19937Generator(int TaskId);
 
+  /// Return a counter-based engine keyed on (seed, event, task, stream).
+  /// It is created in O(1), shares no state with other engines and
+  /// gives the same numbers whichever thread uses it first, so tasks
+  /// running concurrently stay reproducible
+  static PhiloxEngine GetPhiloxEngine(int TaskId, unsigned int Event,
+                                      unsigned int Stream = 0);
+
   // Getters
   static unsigned int GetRandomSeed() { return random_seed_; };
+  /// true if every task gets its own, reproducibly seeded engine
+  static bool GetOneGeneratorPerTask() { return one_generator_per_task_; };
 
 protected:
   static bool one_generator_per_task_;
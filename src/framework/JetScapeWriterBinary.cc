@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+// jetscape writer binary class
+
+#include "JetScapeWriterBinary.h"
+#include "JetScapeLogger.h"
+
+namespace Jetscape {
+
+// Register the module with the base class
+RegisterJetScapeModule<JetScapeWriterBinary>
+    JetScapeWriterBinary::reg("JetScapeWriterBinary");
+
+JetScapeWriterBinary::JetScapeWriterBinary(string m_file_name_out)
+    : compression_level(1) {
+  SetOutputFileName(m_file_name_out);
+}
+
+JetScapeWriterBinary::~JetScapeWriterBinary() {
+  VERBOSE(8);
+  if (GetActive())
+    Close();
+}
+
+void JetScapeWriterBinary::Init() {
+  if (GetActive()) {
+    compression_level =
+        GetXMLElementInt({"JetScapeWriterBinaryCompression"}, false);
+    JSINFO << "JetScape Binary Writer initialized with output file = "
+           << GetOutputFileName()
+           << ", compression level = " << compression_level;
+    Open();
+  }
+}
+
+void JetScapeWriterBinary::Open() {
+  output_file.open(GetOutputFileName().c_str(),
+                   std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!JetScapeBinary::WriteFileTag(output_file)) {
+    JSWARN << "Could not open " << GetOutputFileName();
+  }
+}
+
+void JetScapeWriterBinary::WriteHeaderToFile() {
+  VERBOSE(3) << "Run JetScapeWriterBinary: Write header of event # "
+             << GetCurrentEvent() << " ...";
+  event.Clear();
+  event.event_number = GetCurrentEvent();
+  event.sigma_gen = GetHeader().GetSigmaGen();
+  event.sigma_err = GetHeader().GetSigmaErr();
+  event.event_weight = GetHeader().GetEventWeight();
+  event.npart = GetHeader().GetNpart();
+  event.ncoll = GetHeader().GetNcoll();
+  event.total_entropy = GetHeader().GetTotalEntropy();
+  event.event_plane_angle = GetHeader().GetEventPlaneAngle();
+}
+
+void JetScapeWriterBinary::WriteEvent() {
+  event.Encode(payload);
+  if (!JetScapeBinary::WriteBlock(output_file, payload, compression_level)) {
+    JSWARN << "Could not write event " << event.event_number << " to "
+           << GetOutputFileName();
+  }
+  event.Clear();
+}
+
+void JetScapeWriterBinary::Write(weak_ptr<Parton> p) {
+  auto pp = p.lock();
+  if (pp) {
+    event.partons.Add(*pp);
+  }
+}
+
+void JetScapeWriterBinary::Write(weak_ptr<Vertex> v) {
+  auto vv = v.lock();
+  if (vv) {
+    event.vertices.Add(*vv);
+  }
+}
+
+void JetScapeWriterBinary::Write(weak_ptr<Hadron> h) {
+  auto hh = h.lock();
+  if (hh) {
+    event.hadrons.Add(*hh);
+  }
+}
+
+void JetScapeWriterBinary::Write(weak_ptr<PartonShower> ps) {
+  auto pShower = ps.lock();
+  if (pShower) {
+    event.AddShower(*pShower);
+  }
+}
+
+} // end namespace Jetscape
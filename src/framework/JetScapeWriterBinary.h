@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+// jetscape writer binary class
+
+#ifndef JETSCAPEWRITERBINARY_H
+#define JETSCAPEWRITERBINARY_H
+
+#include <fstream>
+#include <string>
+
+#include "JetScapeWriter.h"
+#include "JetScapeBinaryFormat.h"
+
+namespace Jetscape {
+
+/** @class JetScapeWriterBinary
+ * Writes the events in the binary column-oriented format of
+ * JetScapeBinaryEvent, read back by JetScapeBinaryReader. Everything the
+ * modules write for an event is collected and written as one block when
+ * the event is complete, compressed with zlib unless the compression level
+ * (JetScapeWriterBinaryCompression in the XML file) is 0.
+ */
+class JetScapeWriterBinary : public JetScapeWriter {
+
+public:
+  JetScapeWriterBinary() : compression_level(1){};
+  JetScapeWriterBinary(string m_file_name_out);
+  virtual ~JetScapeWriterBinary();
+
+  void Init();
+  void Exec(){};
+
+  bool GetStatus() { return output_file.good(); }
+  void Open();
+  void Close() { output_file.close(); }
+
+  /** @param level zlib compression level, from 0 (none) to 9. */
+  void SetCompressionLevel(int level) { compression_level = level; }
+  int GetCompressionLevel() const { return compression_level; }
+
+  void Write(weak_ptr<PartonShower> ps);
+  void Write(weak_ptr<Parton> p);
+  void Write(weak_ptr<Vertex> v);
+  void Write(weak_ptr<Hadron> h);
+  void WriteHeaderToFile();
+
+  void Write(string s) { event.lines.push_back(s); }
+  void WriteComment(string s) { event.lines.push_back("# " + s); }
+  void WriteEvent();
+
+private:
+  std::ofstream output_file;
+  int compression_level;
+
+  JetScapeBinaryEvent event;
+  std::string payload; // kept to reuse its memory
+
+  // Allows the registration of the module so that it is available to be used by the Jetscape framework.
+  static RegisterJetScapeModule<JetScapeWriterBinary> reg;
+};
+
+} // end namespace Jetscape
+
+#endif // JETSCAPEWRITERBINARY_H
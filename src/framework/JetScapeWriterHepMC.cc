@@ -46,8 +46,6 @@
 #include "JetScapeLogger.h"
 #include "HardProcess.h"
 #include "JetScapeSignalManager.h"
-#include "GTL/node.h"
-#include <GTL/topsort.h>
 
 using HepMC3::Units;
 
@@ -62,15 +60,16 @@ void JetScapeWriterHepMC::WriteHeaderToFile() {
   // Create event here - not actually writing
   // TODO: GeV seems right, but I don't think we actually measure in mm
   // Should multiply all lengths by 1e-12 probably
-  evt = GenEvent(Units::GEV, Units::MM);
+  // A fresh event every time, the previous one may still be in the queue
+  evt.reset(new GenEvent(Units::GEV, Units::MM));
 
   // Expects pb, pythia delivers mb
   auto xsec = make_shared<HepMC3::GenCrossSection>();
   xsec->set_cross_section(GetHeader().GetSigmaGen() * 1e9, 0);
   xsec->set_cross_section(GetHeader().GetSigmaGen() * 1e9,
                           GetHeader().GetSigmaErr() * 1e9);
-  evt.set_cross_section(xsec);
-  evt.weights().push_back(GetHeader().GetEventWeight());
+  evt->set_cross_section(xsec);
+  evt->weights().push_back(GetHeader().GetEventWeight());
 
   auto heavyion = make_shared<HepMC3::GenHeavyIon>();
   // see https://gitlab.cern.ch/hepmc/HepMC3/blob/master/include/HepMC/GenHeavyIon.h
@@ -93,18 +92,23 @@ void JetScapeWriterHepMC::WriteHeaderToFile() {
     heavyion->event_plane_angle = GetHeader().GetEventPlaneAngle();
   }
 
-  evt.set_heavy_ion(heavyion);
+  evt->set_heavy_ion(heavyion);
 
   // also a good moment to initialize the hadron boolean
+  hashadrons = false;
 }
 
 void JetScapeWriterHepMC::WriteEvent() {
   VERBOSE(1) << "Run JetScapeWriterHepMC: Write event # " << GetCurrentEvent();
-  
+  if (!evt) {
+    JSWARN << "JetScapeWriterHepMC: WriteEvent() without WriteHeaderToFile()";
+    return;
+  }
+
   // Have collected all vertices now.
   // Add all vertices to the event
   for (auto v : vertices){
-    evt.add_vertex(v);
+    evt->add_vertex(v);
   }
 
   VERBOSE(1) << " found " << vertices.size() << " vertices in the list";
@@ -116,7 +120,7 @@ void JetScapeWriterHepMC::WriteEvent() {
   // but modules are allowed to assign that number to non-final partons
   if ( !hashadrons ) {
     VERBOSE(1) << " found no hadrons, promoting final partons to status 1";
-    for ( auto p : evt.particles() ){
+    for ( auto p : evt->particles() ){
       if ( p->children().size() == 0 ){
 	if ( p->status() !=11 ){
 	  JSWARN << "Found a final parton with status!=11 : status=" << p->status() << ". This should not happen";
@@ -125,10 +129,138 @@ void JetScapeWriterHepMC::WriteEvent() {
       }
     }
   }
-  evt.set_event_number(GetCurrentEvent());
-  write_event(evt);
+  evt->set_event_number(GetCurrentEvent());
+  // Drop our references before handing the event over
   vertices.clear();
   hadronizationvertex = 0;
+
+  if (!writer_thread.joinable()) {
+    write_event(*evt);
+    evt.reset();
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(queue_mutex);
+  queue_not_full.wait(
+      lock, [this] { return (int)queue.size() < queue_size; });
+  queue.push_back(std::move(evt));
+  lock.unlock();
+  queue_not_empty.notify_one();
+}
+
+bool JetScapeWriterHepMC::GetStatus() {
+  if (writer_thread.joinable())
+    return write_failed;
+  return failed();
+}
+
+void JetScapeWriterHepMC::Close() {
+  if (writer_thread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex);
+      stop_writing = true;
+    }
+    queue_not_empty.notify_one();
+    writer_thread.join();
+  }
+  close();
+}
+
+void JetScapeWriterHepMC::StartWriterThread() {
+  stop_writing = false;
+  write_failed = false;
+  writer_thread = std::thread(&JetScapeWriterHepMC::WriterLoop, this);
+}
+
+void JetScapeWriterHepMC::WriterLoop() {
+  while (true) {
+    std::unique_ptr<GenEvent> event;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex);
+      queue_not_empty.wait(lock,
+                           [this] { return stop_writing || !queue.empty(); });
+      // Finish the queue before stopping
+      if (queue.empty())
+        return;
+      event = std::move(queue.front());
+      queue.pop_front();
+    }
+    queue_not_full.notify_one();
+
+    write_event(*event);
+    if (failed())
+      write_failed = true;
+  }
+}
+
+void JetScapeWriterHepMC::FillShowerGraph(PartonShower &shower) {
+  const int n_vertices = shower.GetNumberOfVertices();
+  const int n_partons = shower.GetNumberOfPartons();
+
+  // Count, then place every parton at its source and target vertex.
+  // The edge lists of a GTL node start with the most recent edge, so the
+  // partons are placed from the last to the first to keep that order.
+  outOffset.assign(n_vertices + 1, 0);
+  inOffset.assign(n_vertices + 1, 0);
+  for (int i = 0; i < n_partons; i++) {
+    outOffset[shower.GetPartonSource(i) + 1]++;
+    inOffset[shower.GetPartonTarget(i) + 1]++;
+  }
+  for (int n = 0; n < n_vertices; n++) {
+    outOffset[n + 1] += outOffset[n];
+    inOffset[n + 1] += inOffset[n];
+  }
+
+  outEdges.resize(n_partons);
+  inEdges.resize(n_partons);
+  // topOrder is free here and serves as the fill position of each vertex
+  topOrder.assign(outOffset.begin(), outOffset.end() - 1);
+  for (int i = n_partons - 1; i >= 0; i--) {
+    outEdges[topOrder[shower.GetPartonSource(i)]++] = i;
+  }
+  topOrder.assign(inOffset.begin(), inOffset.end() - 1);
+  for (int i = n_partons - 1; i >= 0; i--) {
+    inEdges[topOrder[shower.GetPartonTarget(i)]++] = i;
+  }
+}
+
+void JetScapeWriterHepMC::TopologicalOrder(PartonShower &shower) {
+  const int n_vertices = shower.GetNumberOfVertices();
+  // Reverse postorder of a depth first search, starting from the first
+  // vertex and then from every vertex not reached yet, following the
+  // outgoing partons as listed above. This is the order of GTL's topsort, without
+  // going through the node and edge maps of the graph.
+  // visitState: 0 not seen, 1 on the path (or stack), 2 done
+  visitState.assign(n_vertices, 0);
+  topOrder.resize(n_vertices);
+  int position = n_vertices;
+
+  // (vertex, next outgoing parton) pairs of the current path
+  vector<std::pair<int, int>> path;
+  for (int root = 0; root < n_vertices; root++) {
+    if (visitState[root])
+      continue;
+    visitState[root] = 1;
+    path.push_back(std::make_pair(root, outOffset[root]));
+    while (!path.empty()) {
+      int n = path.back().first;
+      int &next = path.back().second;
+      if (next == outOffset[n + 1]) {
+        visitState[n] = 2;
+        topOrder[--position] = n;
+        path.pop_back();
+        continue;
+      }
+      int target = shower.GetPartonTarget(outEdges[next++]);
+      if (visitState[target] == 1)
+        throw std::runtime_error(
+            "PROBLEM in JetScapeWriterHepMC: Graph is not acyclic.");
+      if (visitState[target] == 0) {
+        visitState[target] = 1;
+        path.push_back(std::make_pair(target, outOffset[target]));
+      }
+    }
+  }
 }
 
 //This function dumps the particles in a specific parton shower to the event
@@ -146,34 +278,22 @@ void JetScapeWriterHepMC::Write(weak_ptr<PartonShower> ps) {
   // So instead try to modify the first attempt to respect top. order
   // and don't create vertices and particles more than once
 
-  // Using GTL's topsort
-  // 1. Check that our graph is sane
-  if (!pShower->is_acyclic())
-    throw std::runtime_error(
-        "PROBLEM in JetScapeWriterHepMC: Graph is not acyclic.");
+  // Vertices and partons are numbered in the order they were added,
+  // so everything below works on these indices instead of the graph.
+  // 1. Adjacency of every vertex
+  FillShowerGraph(*pShower);
 
-  // 2.
-  topsort topsortsearch;
-  topsortsearch.scan_whole_graph(true);
-  topsortsearch.start_node(); // defaults to first node
-  topsortsearch.run(*pShower);
-  auto nEnd =
-      topsortsearch.top_order_end(); // this is a topsort::topsort_iterator
+  // 2. Topological order, also checks that our graph is sane
+  TopologicalOrder(*pShower);
+  const int n_vertices = pShower->GetNumberOfVertices();
 
   // Need to keep track of already created ones
-  map<int, GenParticlePtr> CreatedPartons;
+  createdPartons.assign(pShower->GetNumberOfPartons(), GenParticlePtr());
 
-  // probably unnecessary, used for consistency checks
-  map<int, bool> vused;
-  bool foundRoot = false;
-  for (auto nIt = topsortsearch.top_order_begin(); nIt != nEnd; ++nIt) {
-    // cout << *nIt << "  " << nIt->indeg() << "  " << nIt->outdeg() << endl;
-
-    // Should be the only time we see this node.
-    if (vused.find(nIt->id()) != vused.end()){
-      throw std::runtime_error( "PROBLEM in JetScapeWriterHepMC: Reusing a vertex.");
-    }
-    vused[nIt->id()] = true;
+  for (int i = 0; i < n_vertices; i++) {
+    const int n = topOrder[i];
+    const int indeg = inOffset[n + 1] - inOffset[n];
+    const int outdeg = outOffset[n + 1] - outOffset[n];
 
     // 0. No incoming edges?
     // ---------------------
@@ -187,29 +307,27 @@ void JetScapeWriterHepMC::Write(weak_ptr<PartonShower> ps) {
     // as incomers in a later vertex.
     // Note that the [0]=>[1] connection in JETSCAPE
     // already uses a dummy node[0], and [1] is at time t=0; removing that seems correct.
-    if (nIt->indeg() == 0)    continue;
+    if (indeg == 0)    continue;
 
     // 1. Create a new vertex.
     // --------------------------------------------
-    auto v = castVtxToHepMC(pShower->GetVertex(*nIt));
+    auto v = castVtxToHepMC(pShower->GetVertexAt(n));
 
     // 2. Incoming edges
     // -----------------
     //  In the current framework, it should only be one.
     //  So we will catch anything more but provide a mechanism that should work anyway.
-    if (nIt->indeg() > 1) {
+    if (indeg > 1) {
       JSWARN << "Found more than one mother parton! Should only happen if we "
 	"added medium particles. "
 	     << "The code should work, but proceed with caution";
     }
 
-    auto inIt = nIt->in_edges_begin();
-    auto inEnd = nIt->in_edges_end();
-    for (/* nop */; inIt != inEnd; ++inIt) {
-      auto phepin = CreatedPartons.find(inIt->id());
-      if (phepin != CreatedPartons.end()) {
+    for (int k = inOffset[n]; k < inOffset[n + 1]; k++) {
+      const int e = inEdges[k];
+      if (createdPartons[e]) {
 	// We should already have one!
-	v->add_particle_in(phepin->second);
+	v->add_particle_in(createdPartons[e]);
       } else {
 	// This indicates we skipped an earlier vertex without incomers.
 	// JSWARN << "Incoming particle out of nowhere. This could maybe happen "
@@ -219,7 +337,7 @@ void JetScapeWriterHepMC::Write(weak_ptr<PartonShower> ps) {
 	// throw std::runtime_error("PROBLEM in JetScapeWriterHepMC: Incoming "
 	//                          "particle out of nowhere.");
 	
-	auto in = pShower->GetParton(*inIt);
+	auto in = pShower->GetPartonAt(e);
 	auto hepin = castPartonToHepMC(in);
 	auto status = std::abs(hepin->status());
 	if ( status < 11 || status > 200) {
@@ -227,10 +345,10 @@ void JetScapeWriterHepMC::Write(weak_ptr<PartonShower> ps) {
 	  status = 12;
 	}
 	hepin->set_status(status);
-	CreatedPartons[inIt->id()] = hepin;
+	createdPartons[e] = hepin;
 	v->add_particle_in(hepin);
 	
-	if ( nIt->outdeg() == 0 ) {
+	if ( outdeg == 0 ) {
 	  // However, motherless AND childless particles do exist
 	  // I.e., a shower initiator that never actually showers
 	  // For this, we need an out going clone, much like 3) below
@@ -248,13 +366,13 @@ void JetScapeWriterHepMC::Write(weak_ptr<PartonShower> ps) {
     // --------------------------------------------
     // 3.1: No. Need to create one.
     // We'll use this opportunity to copy the incomer but give it a final code
-    if (nIt->outdeg() == 0) {
-      if (nIt->indeg() != 1) {
+    if (outdeg == 0) {
+      if (indeg != 1) {
 	// This won't work with multiple incomers (but that's pretty unphysical)
         throw std::runtime_error("PROBLEM in JetScapeWriterHepMC: Need exactly "
                                  "one parent to clone final state partons.");
       }
-      auto in = pShower->GetParton(*(nIt->in_edges_begin()));
+      auto in = pShower->GetPartonAt(inEdges[inOffset[n]]);
       auto hepout = castPartonToHepMC(in);
       // an outgoing edge without terminator is "final"
       // Since the status information is preserved in the incomer, we'll force 11
@@ -265,28 +383,27 @@ void JetScapeWriterHepMC::Write(weak_ptr<PartonShower> ps) {
     }
 
     // 3.2: Otherwise use and register the outgoing edge
-    if (nIt->outdeg() > 0) {
-      auto outIt = nIt->out_edges_begin();
-      auto outEnd = nIt->out_edges_end();
-      for (/* nop */; outIt != outEnd; ++outIt) {
-        if (CreatedPartons.find(outIt->id()) != CreatedPartons.end()) {
-          throw std::runtime_error("PROBLEM in JetScapeWriterHepMC: Trying to "
-                                   "recreate a preexisting GenParticle.");
-        }
-        auto out = pShower->GetParton(*outIt);
-        auto hepout = castPartonToHepMC(out);
-	if ( !hepout->status()) {
-	  // incoming and outgoing -> status 12
-	  hepout->set_status(12);
-	}
-	
-        CreatedPartons[outIt->id()] = hepout;
-        v->add_particle_out(hepout);
+    for (int k = outOffset[n]; k < outOffset[n + 1]; k++) {
+      const int e = outEdges[k];
+      if (createdPartons[e]) {
+        throw std::runtime_error("PROBLEM in JetScapeWriterHepMC: Trying to "
+                                 "recreate a preexisting GenParticle.");
       }
+      auto out = pShower->GetPartonAt(e);
+      auto hepout = castPartonToHepMC(out);
+      if ( !hepout->status()) {
+	// incoming and outgoing -> status 12
+	hepout->set_status(12);
+      }
+      
+      createdPartons[e] = hepout;
+      v->add_particle_out(hepout);
     }
     
     vertices.push_back(v);
   }
+  // the particles belong to the vertices now
+  createdPartons.clear();
 }
 
 void JetScapeWriterHepMC::Write(weak_ptr<Hadron> h) {
@@ -328,8 +445,11 @@ void JetScapeWriterHepMC::Write(weak_ptr<Hadron> h) {
 
 void JetScapeWriterHepMC::Init() {
   if (GetActive()) {
+    queue_size = GetXMLElementInt({"JetScapeWriterHepMCQueueSize"}, false);
     JSINFO << "JetScape HepMC Writer initialized with output file = "
-           << GetOutputFileName();
+           << GetOutputFileName() << ", queue of " << queue_size << " events";
+    if (queue_size > 0 && !writer_thread.joinable())
+      StartWriterThread();
   }
 }
 
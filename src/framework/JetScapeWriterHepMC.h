@@ -16,8 +16,14 @@
 #ifndef JETSCAPEWRITERHEPMC_H
 #define JETSCAPEWRITERHEPMC_H
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #include "JetScapeWriter.h"
 #include "PartonShower.h"
@@ -36,12 +42,25 @@ using HepMC3::GenParticlePtr;
 
 namespace Jetscape {
 
+/** @class JetScapeWriterHepMC
+ * Converts the events to HepMC3 and writes them in the HepMC3 ASCII format.
+ * After Init(), completed events are handed to a background thread through
+ * a queue of at most JetScapeWriterHepMCQueueSize events (from the XML
+ * file), so that the serialization and the disk I/O overlap with the next
+ * events. The event loop only waits when the queue is full. With a queue
+ * size of 0 the events are written on the calling thread.
+ */
 class JetScapeWriterHepMC : public JetScapeWriter, public HepMC3::WriterAscii {
 
 public:
-  JetScapeWriterHepMC() : HepMC3::WriterAscii("") { SetId("HepMC writer"); };
+  JetScapeWriterHepMC()
+      : HepMC3::WriterAscii(""), queue_size(0), stop_writing(false),
+        write_failed(false) {
+    SetId("HepMC writer");
+  };
   JetScapeWriterHepMC(string m_file_name_out)
-      : JetScapeWriter(m_file_name_out), HepMC3::WriterAscii(m_file_name_out) {
+      : JetScapeWriter(m_file_name_out), HepMC3::WriterAscii(m_file_name_out),
+        queue_size(0), stop_writing(false), write_failed(false) {
     SetId("HepMC writer");
   };
   virtual ~JetScapeWriterHepMC();
@@ -49,8 +68,9 @@ public:
   void Init();
   void Exec();
 
-  bool GetStatus() { return failed(); }
-  void Close() { close(); }
+  bool GetStatus();
+  /** Write the events still in the queue and close the file. */
+  void Close();
 
   // // NEVER use this!
   // // Can work with only one writer, but with a second one it gets called twice
@@ -66,10 +86,35 @@ public:
   void WriteHeaderToFile();
 
 private:
-  HepMC3::GenEvent evt;
+  std::unique_ptr<HepMC3::GenEvent> evt;
   vector<HepMC3::GenVertexPtr> vertices;
   HepMC3::GenVertexPtr hadronizationvertex;
 
+  // Shower graph in compressed rows: the partons leaving vertex n are
+  // outEdges[outOffset[n]] ... outEdges[outOffset[n + 1] - 1], in the order
+  // of the edge lists of the graph, and likewise for the incoming ones.
+  // Kept as members to reuse the memory from one shower to the next.
+  vector<int> outOffset, outEdges;
+  vector<int> inOffset, inEdges;
+  vector<int> topOrder;
+  vector<char> visitState;
+  vector<GenParticlePtr> createdPartons; // indexed by parton
+
+  void FillShowerGraph(PartonShower &shower);
+  void TopologicalOrder(PartonShower &shower);
+
+  // background writing
+  void StartWriterThread();
+  void WriterLoop();
+  int queue_size;
+  std::deque<std::unique_ptr<HepMC3::GenEvent>> queue;
+  std::mutex queue_mutex;
+  std::condition_variable queue_not_empty;
+  std::condition_variable queue_not_full;
+  bool stop_writing;
+  std::atomic<bool> write_failed;
+  std::thread writer_thread;
+
   /// WriteEvent needs to know whether it should overwrite final partons status to 1
   bool hashadrons=false; 
   
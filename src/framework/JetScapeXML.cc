@@ -177,72 +177,68 @@ JetScapeXML::GetXMLElementUser(std::initializer_list<const char *> &path) {
 }
 
 //________________________________________________________________
-tinyxml2::XMLElement *
-JetScapeXML::GetElement(std::initializer_list<const char *> path,
-                        bool isRequired /* = true */) {
+const JetScapeXML::XMLParameter &
+JetScapeXML::GetParameter(std::initializer_list<const char *> path,
+                          bool isRequired) {
 
-  // Try to get value from User XML file
-  tinyxml2::XMLElement *elementUser = GetXMLElementUser(path);
-  if (elementUser) {
-    return elementUser;
+  std::string key;
+  for (auto name : path) {
+    key += name;
+    key += ':';
   }
-  // Else, try to get value from Master XML file
-  else {
-    tinyxml2::XMLElement *elementMaster = GetXMLElementMaster(path);
-    if (elementMaster) {
-      return elementMaster;
-    } else {
-      if (isRequired) {
-        JSWARN << "XML element " << path << " not found, but is required.";
-        exit(-1);
-      }
-      return nullptr;
+
+  std::lock_guard<std::mutex> lock(parameter_mutex);
+  auto it = parameter_cache.find(key);
+  if (it == parameter_cache.end()) {
+    XMLParameter parameter;
+    parameter.int_value = 0;
+    parameter.double_value = 0.;
+
+    // Try to get value from User XML file, else from Master XML file
+    parameter.element = GetXMLElementUser(path);
+    if (!parameter.element) {
+      parameter.element = GetXMLElementMaster(path);
     }
+    if (parameter.element) {
+      const char *text = parameter.element->GetText();
+      parameter.text = text ? text : "";
+      parameter.element->QueryIntText(&parameter.int_value);
+      parameter.element->QueryDoubleText(&parameter.double_value);
+    }
+    it = parameter_cache.emplace(key, parameter).first;
+  }
+
+  if (!it->second.element && isRequired) {
+    JSWARN << "XML element " << path << " not found, but is required.";
+    exit(-1);
   }
+  return it->second;
+}
+
+//________________________________________________________________
+tinyxml2::XMLElement *
+JetScapeXML::GetElement(std::initializer_list<const char *> path,
+                        bool isRequired /* = true */) {
+  return GetParameter(path, isRequired).element;
 }
 
 //________________________________________________________________
 std::string
 JetScapeXML::GetElementText(std::initializer_list<const char *> path,
                             bool isRequired /* = true */) {
-
-  tinyxml2::XMLElement *element = GetElement(path, isRequired);
-
-  if (element) {
-    return element->GetText();
-  } else {
-    return "";
-  }
+  return GetParameter(path, isRequired).text;
 }
 
 //________________________________________________________________
 int JetScapeXML::GetElementInt(std::initializer_list<const char *> path,
                                bool isRequired /* = true */) {
-
-  tinyxml2::XMLElement *element = GetElement(path, isRequired);
-
-  if (element) {
-    int value = 0;
-    element->QueryIntText(&value);
-    return value;
-  } else {
-    return 0;
-  }
+  return GetParameter(path, isRequired).int_value;
 }
 
 //________________________________________________________________
 double JetScapeXML::GetElementDouble(std::initializer_list<const char *> path,
                                      bool isRequired /* = true */) {
-
-  tinyxml2::XMLElement *element = GetElement(path, isRequired);
-
-  if (element) {
-    double value = 0;
-    element->QueryDoubleText(&value);
-    return value;
-  } else {
-    return 0.;
-  }
+  return GetParameter(path, isRequired).double_value;
 }
 
 //________________________________________________________________
@@ -20,6 +20,8 @@
 #include <string>
 #include <stdexcept>
 #include <initializer_list>
+#include <mutex>
+#include <unordered_map>
 
 #include "tinyxml2.h"
 
@@ -29,6 +31,12 @@
  *
  * This class contains the machinery to load two XML configuration files: a Master file, and a User file.
  *
+ * A parameter path is resolved in the XML trees the first time it is asked
+ * for. Its element, text and integer and floating point values are then
+ * kept in a hash map, so repeated lookups do not walk the trees or parse the
+ * text again. The lookups are guarded by a mutex and can be made from
+ * concurrently running tasks.
+ *
  */
 
 using std::string;
@@ -71,6 +79,7 @@ public:
 
   // Helper functions for XML parsing/
   // Look first in user XML file for a parameter, and if not found look in the master XML file.
+  // The result is cached, see GetParameter().
   tinyxml2::XMLElement *GetElement(std::initializer_list<const char *> path,
                                    bool isRequired = true);
   std::string GetElementText(std::initializer_list<const char *> path,
@@ -81,6 +90,19 @@ public:
                           bool isRequired = true);
 
 private:
+  // a parameter path resolved in the user and master files
+  struct XMLParameter {
+    tinyxml2::XMLElement *element; // nullptr if the path is in neither file
+    std::string text;
+    int int_value;
+    double double_value;
+  };
+
+  // resolve the path once and return the cached parameter; exits if the
+  // element is required but not found
+  const XMLParameter &GetParameter(std::initializer_list<const char *> path,
+                                   bool isRequired);
+
   JetScapeXML() {
     xml_master_file_name = "";
     xml_master_file_open = false;
@@ -107,6 +129,11 @@ private:
 
   std::string xml_user_file_name;
   bool xml_user_file_open;
+
+  // parameters by path, joined with ':'; entries are never modified or
+  // removed once they are inserted
+  std::unordered_map<std::string, XMLParameter> parameter_cache;
+  std::mutex parameter_mutex;
 };
 
 // Print the XML element path name
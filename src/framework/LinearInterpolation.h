@@ -86,6 +86,40 @@ type TrilinearInt(real x0, real x1, real y0, real y1, real z0, real z1,
   return temp;
 }
 
+// 4D linear interpolation weights
+// t, u, v, w: fractional position of the point inside the cell along the
+// four axes, e.g. t = (x - x0)/(x1 - x0)
+// the corner (i, j, k, l), with i, j, k, l = 0 or 1 the lower or upper grid
+// point along each axis, gets the weight weights[8*i + 4*j + 2*k + l]
+inline void QuadrilinearWeights(real t, real u, real v, real w,
+                                real weights[16]) {
+  real wt[2] = {1 - t, t};
+  real wu[2] = {1 - u, u};
+  real wv[2] = {1 - v, v};
+  real ww[2] = {1 - w, w};
+  for (int c = 0; c < 16; c++) {
+    weights[c] = wt[(c >> 3) & 1] * wu[(c >> 2) & 1] * wv[(c >> 1) & 1] *
+                 ww[c & 1];
+  }
+}
+
+// interpolate n_fields fields sharing the same 16 corner weights
+// corner_values[16*k + c]: value of the k-th field at corner c, in the
+// corner order of QuadrilinearWeights
+// the sum over the corners runs over contiguous memory with a fixed length
+// so that the compiler can vectorise it
+inline void QuadrilinearInt(const real weights[16], int n_fields,
+                            const real *corner_values, real *result) {
+  for (int k = 0; k < n_fields; k++) {
+    const real *f = corner_values + 16 * k;
+    real temp = 0;
+    for (int c = 0; c < 16; c++) {
+      temp += weights[c] * f[c];
+    }
+    result[k] = temp;
+  }
+}
+
 } //end namespace Jetscape
 
 #endif // LINEARINTERPOLATION_H
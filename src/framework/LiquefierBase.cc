@@ -14,6 +14,8 @@
  ******************************************************************************/
 #include "LiquefierBase.h"
 #include <math.h>
+#include <algorithm>
+#include <limits>
 
 namespace Jetscape {
 
@@ -21,14 +23,129 @@ LiquefierBase::LiquefierBase()
     : hydro_source_abs_err(1e-10), drop_stat(-11), miss_stat(-13),
       neg_stat(-17) {
   GetHydroCellSignalConnected = false;
+  droplet_cell_size = {1.0, 1.0, 1.0, 0.5};
+  droplet_cells_lo.fill(std::numeric_limits<int>::max());
+  droplet_cells_hi.fill(std::numeric_limits<int>::min());
+}
+
+void LiquefierBase::set_droplet_cell_size(Jetscape::real cell_tau,
+                                          Jetscape::real cell_xy,
+                                          Jetscape::real cell_eta) {
+  if (!(cell_tau > 0 && cell_xy > 0 && cell_eta > 0)) {
+    JSWARN << "Droplet cells need a positive size, keeping the previous one";
+    return;
+  }
+  droplet_cell_size = {cell_tau, cell_xy, cell_xy, cell_eta};
+  droplet_cells.clear();
+  droplet_cells_lo.fill(std::numeric_limits<int>::max());
+  droplet_cells_hi.fill(std::numeric_limits<int>::min());
+  for (int idx = 0; idx < dropletlist.size(); idx++)
+    add_to_droplet_cells(idx);
+}
+
+std::array<int, 4>
+LiquefierBase::get_droplet_cell(const Droplet &droplet) const {
+  const auto x_drop = droplet.get_xmu();
+  std::array<int, 4> cell;
+  for (int i = 0; i < 4; i++) {
+    // far away droplets share the outermost cells
+    double c = floor(double(x_drop[i]) / droplet_cell_size[i]);
+    cell[i] = int(std::max(-1.e8, std::min(1.e8, c)));
+  }
+  return cell;
+}
+
+void LiquefierBase::add_to_droplet_cells(int idx) {
+  std::array<int, 4> cell = get_droplet_cell(dropletlist[idx]);
+  droplet_cells[cell].push_back(idx);
+  for (int i = 0; i < 4; i++) {
+    droplet_cells_lo[i] = std::min(droplet_cells_lo[i], cell[i]);
+    droplet_cells_hi[i] = std::max(droplet_cells_hi[i], cell[i]);
+  }
+}
+
+void LiquefierBase::get_droplet_window(Jetscape::real tau,
+                                       double &tau_drop_min,
+                                       double &tau_drop_max) const {
+  tau_drop_min = -std::numeric_limits<double>::infinity();
+  tau_drop_max = tau;
 }
 
 void LiquefierBase::get_source(Jetscape::real tau, Jetscape::real x,
                                Jetscape::real y, Jetscape::real eta,
                                std::array<Jetscape::real, 4> &jmu) const {
   jmu = {0.0, 0.0, 0.0, 0.0};
-  for (const auto &drop_i : dropletlist) {
+  if (droplet_cells.empty())
+    return;
 
+  // Only droplets in the window of the kernel and inside the backward light
+  // cone can contribute. ds2 >= 0 below requires
+  // |x_perp - x_drop_perp| <= tau - tau_drop and
+  // cosh(eta - eta_drop) <= (tau^2 + tau_drop^2)/(2 tau tau_drop),
+  // both largest for the earliest droplets of the window.
+  double tau_drop_min, tau_drop_max;
+  get_droplet_window(tau, tau_drop_min, tau_drop_max);
+  tau_drop_max = std::min(tau_drop_max, double(tau));
+  if (tau_drop_min > tau_drop_max)
+    return;
+
+  const double inf = std::numeric_limits<double>::infinity();
+  double reach_xy = inf, reach_eta = inf;
+  if (tau_drop_min > 0.0) {
+    reach_xy = tau - tau_drop_min;
+    reach_eta = acosh((double(tau) * tau + tau_drop_min * tau_drop_min) /
+                      (2.0 * tau * tau_drop_min));
+  }
+  const double lower[4] = {tau_drop_min, x - reach_xy, y - reach_xy,
+                           eta - reach_eta};
+  const double upper[4] = {tau_drop_max, x + reach_xy, y + reach_xy,
+                           eta + reach_eta};
+  std::array<int, 4> lo, hi;
+  for (int i = 0; i < 4; i++) {
+    // with some room for rounding, ds2 is partly computed in single precision
+    double margin = 1.e-4 * (1.0 + std::abs(tau) + std::abs(upper[i] - lower[i]));
+    lo[i] = int(std::max(floor((lower[i] - margin) / droplet_cell_size[i]),
+                         double(droplet_cells_lo[i])));
+    hi[i] = int(std::min(floor((upper[i] + margin) / droplet_cell_size[i]),
+                         double(droplet_cells_hi[i])));
+    if (lo[i] > hi[i])
+      return;
+  }
+
+  std::vector<int> candidates;
+  auto add_cell = [&](const decltype(droplet_cells)::value_type &cell) {
+    for (int i = 1; i < 4; i++) {
+      if (cell.first[i] < lo[i] || cell.first[i] > hi[i])
+        return;
+    }
+    candidates.insert(candidates.end(), cell.second.begin(),
+                      cell.second.end());
+  };
+  double n_columns = double(hi[0] - lo[0] + 1) * (hi[1] - lo[1] + 1) *
+                     (hi[2] - lo[2] + 1);
+  if (n_columns < droplet_cells.size()) {
+    // look up the columns in eta around the fluid cell
+    for (int itau = lo[0]; itau <= hi[0]; itau++) {
+      for (int ix = lo[1]; ix <= hi[1]; ix++) {
+        for (int iy = lo[2]; iy <= hi[2]; iy++) {
+          auto it = droplet_cells.lower_bound({itau, ix, iy, lo[3]});
+          auto end = droplet_cells.upper_bound({itau, ix, iy, hi[3]});
+          for (; it != end; ++it)
+            add_cell(*it);
+        }
+      }
+    }
+  } else {
+    auto it = droplet_cells.lower_bound({lo[0], lo[1], lo[2], lo[3]});
+    auto end = droplet_cells.upper_bound({hi[0], hi[1], hi[2], hi[3]});
+    for (; it != end; ++it)
+      add_cell(*it);
+  }
+  // same order of the sum as going through the whole list
+  std::sort(candidates.begin(), candidates.end());
+
+  for (int idx : candidates) {
+    const auto &drop_i = dropletlist[idx];
     const auto x_drop = drop_i.get_xmu();
     double ds2 = tau * tau + x_drop[0] * x_drop[0] -
                  2.0 * tau * x_drop[0] * cosh(eta - x_drop[3]) -
@@ -145,6 +262,12 @@ void LiquefierBase::filter_partons(std::vector<Parton> &pOut) {
 
 void LiquefierBase::add_hydro_sources(std::vector<Parton> &pIn,
                                       std::vector<Parton> &pOut) {
+  add_hydro_sources(pIn, pOut, dropletlist);
+}
+
+void LiquefierBase::add_hydro_sources(std::vector<Parton> &pIn,
+                                      std::vector<Parton> &pOut,
+                                      std::vector<Droplet> &droplets) {
   if (pOut.size() == 0) {
     // the process is freestreaming, ignore
     filter_partons(pIn);
@@ -212,11 +335,16 @@ void LiquefierBase::add_hydro_sources(std::vector<Parton> &pIn,
         static_cast<Jetscape::real>(droplet_py),
         static_cast<Jetscape::real>(droplet_pz)};
     Droplet drop_i(droplet_xmu, droplet_pmu);
-    add_a_droplet(drop_i);
+    droplets.push_back(drop_i);
   }
 }
 
-void LiquefierBase::Clear() { dropletlist.clear(); }
+void LiquefierBase::Clear() {
+  dropletlist.clear();
+  droplet_cells.clear();
+  droplet_cells_lo.fill(std::numeric_limits<int>::max());
+  droplet_cells_hi.fill(std::numeric_limits<int>::min());
+}
 
 Jetscape::real LiquefierBase::get_dropletlist_total_energy() const {
   Jetscape::real total_E = 0.0;
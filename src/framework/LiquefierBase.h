@@ -21,6 +21,7 @@
 #include "FluidCellInfo.h"
 
 #include <array>
+#include <map>
 #include <vector>
 #include "RealType.h"
 
@@ -48,6 +49,15 @@ public:
 class LiquefierBase {
 private:
   std::vector<Droplet> dropletlist;
+
+  //! Droplets bucketed in (tau, x, y, eta) cells, so that get_source only
+  //! looks at the droplets which can reach the fluid cell. Values are
+  //! indices in dropletlist.
+  std::map<std::array<int, 4>, std::vector<int>> droplet_cells;
+  std::array<int, 4> droplet_cells_lo, droplet_cells_hi;
+  std::array<double, 4> droplet_cell_size;
+  std::array<int, 4> get_droplet_cell(const Droplet &droplet) const;
+  void add_to_droplet_cells(int idx);
   bool GetHydroCellSignalConnected;
   const int drop_stat;
   const int miss_stat;
@@ -58,7 +68,10 @@ public:
   LiquefierBase();
   ~LiquefierBase() { Clear(); }
 
-  void add_a_droplet(Droplet droplet_in) { dropletlist.push_back(droplet_in); }
+  void add_a_droplet(Droplet droplet_in) {
+    dropletlist.push_back(droplet_in);
+    add_to_droplet_cells(dropletlist.size() - 1);
+  }
 
   int get_drop_stat() const { return (drop_stat); }
   int get_miss_stat() const { return (miss_stat); }
@@ -71,6 +84,23 @@ public:
   void filter_partons(std::vector<Parton> &pOut);
   void add_hydro_sources(std::vector<Parton> &pIn, std::vector<Parton> &pOut);
 
+  //! Same as above, but the new droplets are appended to droplets instead
+  //! of the droplet list of the liquefier; the showers run concurrently
+  //! collect their droplets this way and hand them over in a fixed order
+  //! with add_droplets()
+  void add_hydro_sources(std::vector<Parton> &pIn, std::vector<Parton> &pOut,
+                         std::vector<Droplet> &droplets);
+
+  void add_droplets(const std::vector<Droplet> &droplets) {
+    for (const auto &droplet : droplets)
+      add_a_droplet(droplet);
+  }
+
+  //! Size of the (tau, x, y, eta) cells of the droplet index, the droplets
+  //! added so far are sorted again
+  void set_droplet_cell_size(Jetscape::real cell_tau, Jetscape::real cell_xy,
+                             Jetscape::real cell_eta);
+
   //! Core signal to receive information from the medium
   sigslot::signal5<double, double, double, double,
                    std::unique_ptr<FluidCellInfo> &,
@@ -96,6 +126,12 @@ public:
     jmu = {0, 0, 0, 0};
   }
 
+  //! Range of droplet times tau_drop for which smearing_kernel can be
+  //! nonzero at the time tau. get_source skips all other droplets, so a
+  //! kernel with a finite duration should narrow it down.
+  virtual void get_droplet_window(Jetscape::real tau, double &tau_drop_min,
+                                  double &tau_drop_max) const;
+
   void get_source(Jetscape::real tau, Jetscape::real x, Jetscape::real y,
                   Jetscape::real eta, std::array<Jetscape::real, 4> &jmu) const;
 
@@ -31,73 +31,36 @@ PartonShower::PartonShower() : graph() { VERBOSESHOWER(8); }
 
 node PartonShower::new_vertex(shared_ptr<Vertex> v) {
   node n = graph::new_node();
-  vMap[n] = v;
+  vVec[n.id()] = v;
   return n;
 }
 
 int PartonShower::new_parton(node s, node t, shared_ptr<Parton> p) {
   edge e = graph::new_edge(s, t);
-  pMap[e] = p;
+  pVec[e.id()] = p;
   return e.id();
 }
 
-/*
-void PartonShower::FillPartonVec()
-{
-  VERBOSE(8);
-  
-  edge_iterator eIt, eEnd;
-  
-  for (eIt = edges_begin(), eEnd = edges_end(); eIt != eEnd; ++eIt)
-    pVec.push_back(pMap[*eIt]);     
+node PartonShower::new_vertex(const Vertex &v) {
+  return new_vertex(vPool.Add(v));
 }
 
-void PartonShower::FillVertexVec()
-{
-  VERBOSE(8);
-  
-  node_iterator nIt, nEnd;
-  
-  for (nIt = nodes_begin(), nEnd = nodes_end(); nIt != nEnd; ++nIt)    
-    vVec.push_back(vMap[*nIt]);  
+int PartonShower::new_parton(node s, node t, const Parton &p) {
+  return new_parton(s, t, pPool.Add(p));
 }
-*/
 
-/*
-shared_ptr<Parton> PartonShower::GetPartonAt(int i)
-{
-  if (pVec.size()==0)
-    FillPartonVec();  
-  
-  return pVec[i].lock();
+void PartonShower::post_new_node_handler(node n) {
+  nVec.push_back(n);
+  vVec.push_back(nullptr);
 }
 
-shared_ptr<Vertex> PartonShower::GetVertexAt(int i)
-{
-  if (vVec.size()==0)
-    FillVertexVec();
-
-  return vVec[i].lock();
+void PartonShower::post_new_edge_handler(edge e) {
+  eVec.push_back(e);
+  pVec.push_back(nullptr);
+  pSource.push_back(e.source().id());
+  pTarget.push_back(e.target().id());
 }
-*/
 
-/*
-unique_ptr<Parton> PartonShower::GetPartonAt(int i)
-{
-  if (pVec.size()==0)
-    FillPartonVec();  
-  
-  return make_unique<Parton>(*(pVec[i].lock()));
-}
-
-unique_ptr<Vertex> PartonShower::GetVertexAt(int i)
-{
-  if (vVec.size()==0)
-    FillVertexVec();
-
-  return make_unique<Vertex>(*(vVec[i].lock()));
-}
-*/
 /*
 void PartonShower::CreateMaps()
 {
@@ -122,8 +85,8 @@ vector<shared_ptr<Parton>> PartonShower::GetFinalPartons() {
     edge_iterator eIt, eEnd;
     for (eIt = edges_begin(), eEnd = edges_end(); eIt != eEnd; ++eIt) {
       if (eIt->target().outdeg() < 1) {
-        if (pMap[*eIt]->pstat() > -10) {
-          pFinal.push_back(pMap[*eIt]);
+        if (pVec[eIt->id()]->pstat() > -10) {
+          pFinal.push_back(pVec[eIt->id()]);
         }
         // DEBUG
         //cout<<eIt->target()<<endl;
@@ -155,34 +118,6 @@ int PartonShower::GetNumberOfChilds(int n) {
   return GetEdgeAt(n).target().outdeg();
 }
 
-edge PartonShower::GetEdgeAt(int n) {
-  edge_iterator eIt;
-  eIt = edges_begin();
-  advance(eIt, n);
-  return *eIt;
-}
-
-node PartonShower::GetNodeAt(int n) {
-  node_iterator nIt;
-  nIt = nodes_begin();
-  advance(nIt, n);
-  return *nIt;
-}
-
-shared_ptr<Parton> PartonShower::GetPartonAt(int n) {
-  edge_iterator eIt;
-  eIt = edges_begin();
-  advance(eIt, n);
-  return GetParton(*eIt);
-}
-
-shared_ptr<Vertex> PartonShower::GetVertexAt(int n) {
-  node_iterator nIt;
-  nIt = nodes_begin();
-  advance(nIt, n);
-  return GetVertex(*nIt);
-}
-
 PartonShower::~PartonShower() {
   VERBOSESHOWER(8);
   pFinal.clear(); //pVec.clear();vVec.clear();
@@ -190,37 +125,37 @@ PartonShower::~PartonShower() {
 
 void PartonShower::save_node_info_handler(ostream *o, node n) const {
   *o << "label "
-     << "\"" << n.id() << "(" << fixed << setprecision(2) << vMap[n]->x_in().t()
+     << "\"" << n.id() << "(" << fixed << setprecision(2) << vVec[n.id()]->x_in().t()
      << ")\"" << endl;
-  *o << "x " << vMap[n]->x_in().x() << endl;
-  *o << "y " << vMap[n]->x_in().y() << endl;
-  *o << "z " << vMap[n]->x_in().z() << endl;
-  *o << "t " << vMap[n]->x_in().t() << endl;
+  *o << "x " << vVec[n.id()]->x_in().x() << endl;
+  *o << "y " << vVec[n.id()]->x_in().y() << endl;
+  *o << "z " << vVec[n.id()]->x_in().z() << endl;
+  *o << "t " << vVec[n.id()]->x_in().t() << endl;
 }
 
 void PartonShower::save_edge_info_handler(ostream *o, edge e) const {
   *o << "label "
-     << "\"(" << fixed << setprecision(2) << pMap[e]->pt() << ")\"" << endl;
-  *o << "plabel " << pMap[e]->plabel() << endl;
-  *o << "pid " << pMap[e]->pid() << endl;
-  *o << "pstat " << pMap[e]->pstat() << endl;
-  *o << "pT " << pMap[e]->pt() << endl;
-  *o << "eta " << pMap[e]->eta() << endl;
-  *o << "phi " << pMap[e]->phi() << endl;
-  *o << "E " << pMap[e]->e() << endl;
+     << "\"(" << fixed << setprecision(2) << pVec[e.id()]->pt() << ")\"" << endl;
+  *o << "plabel " << pVec[e.id()]->plabel() << endl;
+  *o << "pid " << pVec[e.id()]->pid() << endl;
+  *o << "pstat " << pVec[e.id()]->pstat() << endl;
+  *o << "pT " << pVec[e.id()]->pt() << endl;
+  *o << "eta " << pVec[e.id()]->eta() << endl;
+  *o << "phi " << pVec[e.id()]->phi() << endl;
+  *o << "E " << pVec[e.id()]->e() << endl;
 }
 
 void PartonShower::pre_clear_handler() {
   VERBOSESHOWER(8);
-  edge_iterator eIt, eEnd;
-  for (eIt = edges_begin(), eEnd = edges_end(); eIt != eEnd; ++eIt) {
-    pMap[*eIt] = nullptr;
-  }
-
-  node_iterator nIt, nEnd;
-  for (nIt = nodes_begin(), nEnd = nodes_end(); nIt != nEnd; ++nIt) {
-    vMap[*nIt] = nullptr;
-  }
+  vVec.clear();
+  pVec.clear();
+  nVec.clear();
+  eVec.clear();
+  pSource.clear();
+  pTarget.clear();
+  vPool.Clear();
+  pPool.Clear();
+  pFinal.clear();
 }
 
 void PartonShower::PrintNodes(bool verbose) {
@@ -229,13 +164,13 @@ void PartonShower::PrintNodes(bool verbose) {
 
   if (verbose && JetScapeLogger::Instance()->GetVerboseLevel() > 8) {
     for (nIt = nodes_begin(), nEnd = nodes_end(); nIt != nEnd; ++nIt)
-      os << *nIt << "=" << vMap[*nIt]->x_in().t() << " ";
+      os << *nIt << "=" << vVec[nIt->id()]->x_in().t() << " ";
     VERBOSESHOWER(8) << os.str();
   }
 
   if (!verbose) {
     for (nIt = nodes_begin(), nEnd = nodes_end(); nIt != nEnd; ++nIt)
-      os << *nIt << "=" << vMap[*nIt]->x_in().t() << " ";
+      os << *nIt << "=" << vVec[nIt->id()]->x_in().t() << " ";
     cout << "Vertex list : " << os.str() << endl;
   }
 }
@@ -246,13 +181,13 @@ void PartonShower::PrintEdges(bool verbose) {
 
   if (verbose && JetScapeLogger::Instance()->GetVerboseLevel() > 8) {
     for (eIt = edges_begin(), eEnd = edges_end(); eIt != eEnd; ++eIt)
-      os << *eIt << "=" << pMap[*eIt]->pt() << " ";
+      os << *eIt << "=" << pVec[eIt->id()]->pt() << " ";
     VERBOSESHOWER(8) << os.str();
   }
 
   if (!verbose) {
     for (eIt = edges_begin(), eEnd = edges_end(); eIt != eEnd; ++eIt)
-      os << *eIt << "=" << pMap[*eIt]->pt() << " ";
+      os << *eIt << "=" << pVec[eIt->id()]->pt() << " ";
     cout << "Parton list : " << os.str() << endl;
   }
 }
@@ -290,7 +225,7 @@ void PartonShower::load_edge_info_handler(edge e, GML_pair *read) {
     tmp = tmp->next;
   }
 
-  pMap[e] = make_shared<Parton>(plabel, pid, pstat, pT, eta, phi, E);
+  pVec[e.id()] = pPool.Add(Parton(plabel, pid, pstat, pT, eta, phi, E));
 }
 
 void PartonShower::load_node_info_handler(node n, GML_pair *read) {
@@ -316,7 +251,7 @@ void PartonShower::load_node_info_handler(node n, GML_pair *read) {
     tmp = tmp->next;
   }
 
-  vMap[n] = make_shared<Vertex>(x, y, z, t);
+  vVec[n.id()] = vPool.Add(Vertex(x, y, z, t));
 }
 
 // use with graphviz (on Mac: brew install graphviz --with-app)
@@ -348,7 +283,7 @@ void PartonShower::SaveAsGV(string fName) {
     label2 = ")\"];";
     stringstream stream;
 
-    stream << fixed << setprecision(2) << (vMap[*nIt]->x_in().t());
+    stream << fixed << setprecision(2) << (vVec[nIt->id()]->x_in().t());
     gv << n << " " << label << stream.str() << label2 << endl;
 
     n++;
@@ -360,19 +295,19 @@ void PartonShower::SaveAsGV(string fName) {
 
   for (eIt = edges_begin(), eEnd = edges_end(); eIt != eEnd; ++eIt) {
     //label = ("[label=\"(");
-    if ((pMap[*eIt]->pstat()) == -13) {
+    if ((pVec[eIt->id()]->pstat()) == -13) {
       // missing energy-momentum
       label = ("[style=\"dotted\" color=\"red\"label=\"(");
-    } else if ((pMap[*eIt]->pstat()) == -11) {
+    } else if ((pVec[eIt->id()]->pstat()) == -11) {
       // liquefied partons
       label = ("[color=\"red\"label=\"(");
-    } else if ((pMap[*eIt]->pstat()) == -17) {
+    } else if ((pVec[eIt->id()]->pstat()) == -17) {
       // thermal partons draw from the medium (negative partons)
       label = ("[color=\"darkorange\"label=\"(");
-    } else if ((pMap[*eIt]->pstat()) == -1) {
+    } else if ((pVec[eIt->id()]->pstat()) == -1) {
       // thermal partons draw from the medium (negative partons)
       label = ("[color=\"green\"label=\"(");
-    } else if ((pMap[*eIt]->t()) < 4.0) {
+    } else if ((pVec[eIt->id()]->t()) < 4.0) {
       // small virtuality parton
       label = ("[color=\"blue\"label=\"(");
     } else {
@@ -380,14 +315,14 @@ void PartonShower::SaveAsGV(string fName) {
     }
     label2 = ")\"];";
     stringstream stream;
-    if ((pMap[*eIt]->pstat()) == -13) {
-      stream << std::scientific << setprecision(1) << (pMap[*eIt]->e()) << ","
-             << (pMap[*eIt]->pt()) << "," << (pMap[*eIt]->t()) << ","
-             << (pMap[*eIt]->pid());
+    if ((pVec[eIt->id()]->pstat()) == -13) {
+      stream << std::scientific << setprecision(1) << (pVec[eIt->id()]->e()) << ","
+             << (pVec[eIt->id()]->pt()) << "," << (pVec[eIt->id()]->t()) << ","
+             << (pVec[eIt->id()]->pid());
     } else {
-      stream << fixed << setprecision(2) << (pMap[*eIt]->e()) << ","
-             << (pMap[*eIt]->pt()) << "," << (pMap[*eIt]->t()) << ","
-             << (pMap[*eIt]->pid());
+      stream << fixed << setprecision(2) << (pVec[eIt->id()]->e()) << ","
+             << (pVec[eIt->id()]->pt()) << "," << (pVec[eIt->id()]->t()) << ","
+             << (pVec[eIt->id()]->pid());
     }
 
     gv << (to_string(eIt->source().id()) + "->" + to_string(eIt->target().id()))
@@ -449,16 +384,16 @@ void PartonShower::SaveAsGraphML(string fName) {
   for (nIt = nodes_begin(), nEnd = nodes_end(); nIt != nEnd; ++nIt) {
     stringstream stream;
 
-    stream << fixed << setprecision(2) << (vMap[*nIt]->x_in().t());
+    stream << fixed << setprecision(2) << (vVec[nIt->id()]->x_in().t());
 
     g << "<node id=\"" << n << "\">" << endl;
-    //g<<"<data key=\"nlabel\">"<<to_string(n)+"("+to_string(vMap[*nIt]->x_in().t())+")"<<"</data>"<<endl;
+    //g<<"<data key=\"nlabel\">"<<to_string(n)+"("+to_string(vVec[nIt->id()]->x_in().t())+")"<<"</data>"<<endl;
     g << "<data key=\"nlabel\">" << to_string(n) + "(" + stream.str() + ")"
       << "</data>" << endl;
-    g << "<data key=\"nx\">" << vMap[*nIt]->x_in().x() << "</data>" << endl;
-    g << "<data key=\"ny\">" << vMap[*nIt]->x_in().y() << "</data>" << endl;
-    g << "<data key=\"nz\">" << vMap[*nIt]->x_in().z() << "</data>" << endl;
-    g << "<data key=\"nt\">" << vMap[*nIt]->x_in().t() << "</data>" << endl;
+    g << "<data key=\"nx\">" << vVec[nIt->id()]->x_in().x() << "</data>" << endl;
+    g << "<data key=\"ny\">" << vVec[nIt->id()]->x_in().y() << "</data>" << endl;
+    g << "<data key=\"nz\">" << vVec[nIt->id()]->x_in().z() << "</data>" << endl;
+    g << "<data key=\"nt\">" << vVec[nIt->id()]->x_in().t() << "</data>" << endl;
     g << "</node>" << endl;
     n++;
   }
@@ -468,15 +403,15 @@ void PartonShower::SaveAsGraphML(string fName) {
   for (eIt = edges_begin(), eEnd = edges_end(); eIt != eEnd; ++eIt) {
     g << "<edge id=\"" << n << "\" source=\"" << to_string(eIt->source().id())
       << "\" target=\"" << to_string(eIt->target().id()) << "\">" << endl;
-    g << "<data key=\"elabel\">" << to_string((pMap[*eIt]->pt())) << "</data>"
+    g << "<data key=\"elabel\">" << to_string((pVec[eIt->id()]->pt())) << "</data>"
       << endl;
-    g << "<data key=\"epl\">" << pMap[*eIt]->plabel() << "</data>" << endl;
-    g << "<data key=\"epid\">" << pMap[*eIt]->pid() << "</data>" << endl;
-    g << "<data key=\"estat\">" << pMap[*eIt]->pstat() << "</data>" << endl;
-    g << "<data key=\"ept\">" << pMap[*eIt]->pt() << "</data>" << endl;
-    g << "<data key=\"eeta\">" << pMap[*eIt]->eta() << "</data>" << endl;
-    g << "<data key=\"ephi\">" << pMap[*eIt]->phi() << "</data>" << endl;
-    g << "<data key=\"ee\">" << pMap[*eIt]->e() << "</data>" << endl;
+    g << "<data key=\"epl\">" << pVec[eIt->id()]->plabel() << "</data>" << endl;
+    g << "<data key=\"epid\">" << pVec[eIt->id()]->pid() << "</data>" << endl;
+    g << "<data key=\"estat\">" << pVec[eIt->id()]->pstat() << "</data>" << endl;
+    g << "<data key=\"ept\">" << pVec[eIt->id()]->pt() << "</data>" << endl;
+    g << "<data key=\"eeta\">" << pVec[eIt->id()]->eta() << "</data>" << endl;
+    g << "<data key=\"ephi\">" << pVec[eIt->id()]->phi() << "</data>" << endl;
+    g << "<data key=\"ee\">" << pVec[eIt->id()]->e() << "</data>" << endl;
     g << "</edge>" << endl;
     n++;
   }
@@ -23,6 +23,7 @@
 #include <GTL/node_map.h>
 #include "JetClass.h"
 #include "JetScapeLogger.h"
+#include "BlockPool.h"
 
 using std::shared_ptr;
 
@@ -34,6 +35,10 @@ namespace Jetscape {
 class Vertex;
 class Parton;
 
+// Vertices and partons are also kept in flat arrays, in the order in which
+// they were added: vertex n is the node with id n and parton n the edge with
+// id n (nodes and edges are never removed one by one), so that all the
+// Get*At() accessors take constant time.
 class PartonShower : public graph {
 
 public:
@@ -43,14 +48,26 @@ public:
   node new_vertex(shared_ptr<Vertex> v);
   int new_parton(node s, node t, shared_ptr<Parton> p);
 
-  shared_ptr<Vertex> GetVertex(node n) { return vMap[n]; }
-  shared_ptr<Parton> GetParton(edge e) { return pMap[e]; }
+  /** Add a copy of v, stored with the other vertices of the shower. */
+  node new_vertex(const Vertex &v);
+  /** Add a copy of p, stored with the other partons of the shower.
+      @return Edge id, which is also the index of the parton.
+   */
+  int new_parton(node s, node t, const Parton &p);
 
-  shared_ptr<Parton> GetPartonAt(int n);
-  shared_ptr<Vertex> GetVertexAt(int n);
+  shared_ptr<Vertex> GetVertex(node n) { return vVec[n.id()]; }
+  shared_ptr<Parton> GetParton(edge e) { return pVec[e.id()]; }
 
-  node GetNodeAt(int n);
-  edge GetEdgeAt(int n);
+  shared_ptr<Parton> GetPartonAt(int n) { return pVec[n]; }
+  shared_ptr<Vertex> GetVertexAt(int n) { return vVec[n]; }
+
+  node GetNodeAt(int n) { return nVec[n]; }
+  edge GetEdgeAt(int n) { return eVec[n]; }
+
+  /** @return Index of the vertex where parton n starts. */
+  int GetPartonSource(int n) const { return pSource[n]; }
+  /** @return Index of the vertex where parton n ends. */
+  int GetPartonTarget(int n) const { return pTarget[n]; }
 
   int GetNumberOfParents(int n);
   int GetNumberOfChilds(int n);
@@ -71,6 +88,8 @@ public:
   void load_edge_info_handler(edge e, GML_pair *read);
   void load_node_info_handler(node n, GML_pair *read);
   void pre_clear_handler();
+  void post_new_node_handler(node n);
+  void post_new_edge_handler(edge e);
 
   void PrintVertices() { PrintNodes(false); }
   void PrintPartons() { PrintEdges(false); }
@@ -82,8 +101,16 @@ public:
   void SaveAsGraphML(string fName);
 
 private:
-  node_map<shared_ptr<Vertex>> vMap;
-  edge_map<shared_ptr<Parton>> pMap;
+  // indexed by node id and edge id
+  vector<shared_ptr<Vertex>> vVec;
+  vector<shared_ptr<Parton>> pVec;
+  vector<node> nVec;
+  vector<edge> eVec;
+  vector<int> pSource;
+  vector<int> pTarget;
+
+  BlockPool<Vertex> vPool;
+  BlockPool<Parton> pPool;
 
   vector<shared_ptr<Parton>> pFinal;
 
@@ -98,11 +125,6 @@ private:
   //In general rethink and clean up pointer types for efficiency and safety ...
   //Only fill when needed via Getters ...
   //Can also be done via lists, a bit slower (interface question ...)
-  //vector<weak_ptr<Parton>> pVec;
-  //vector<weak_ptr<Vertex>> vVec;
-
-  //void FillVertexVec();
-  //void FillPartonVec();
 };
 
 } // end namespace Jetscape
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#ifndef PHILOXENGINE_H
+#define PHILOXENGINE_H
+
+#include <cstdint>
+
+namespace Jetscape {
+
+/** @class PhiloxEngine
+ * Counter-based random number engine, Philox4x32-10 of
+ * Salmon et al., "Parallel random numbers: as easy as 1, 2, 3" (SC11).
+ * The n-th block of four numbers is a bijective function of the key and
+ * of the counter, so that an engine is created and positioned in O(1).
+ * The key is (seed, task id) and the upper half of the counter holds
+ * (event number, stream id): every combination gives an independent
+ * sequence of 2^66 numbers, whatever the order in which engines are made.
+ * It satisfies the UniformRandomBitGenerator requirements and can be used
+ * with the std distributions.
+ */
+class PhiloxEngine {
+public:
+  typedef uint32_t result_type;
+
+  static constexpr result_type min() { return (0u); }
+  static constexpr result_type max() { return (0xffffffffu); }
+
+  /** @param seed Global seed.
+      @param event Event number.
+      @param task Task id.
+      @param stream Stream id, to make several independent engines per task.
+   */
+  PhiloxEngine(uint32_t seed = 0, uint32_t event = 0, uint32_t task = 0,
+               uint32_t stream = 0)
+      : n_used(4) {
+    key[0] = seed;
+    key[1] = task;
+    counter[0] = 0;
+    counter[1] = 0;
+    counter[2] = event;
+    counter[3] = stream;
+  }
+
+  result_type operator()() {
+    if (n_used == 4) {
+      Block(key, counter, buffer);
+      if (++counter[0] == 0)
+        ++counter[1];
+      n_used = 0;
+    }
+    return (buffer[n_used++]);
+  }
+
+  /** Skip n numbers in O(1). */
+  void discard(unsigned long long n) {
+    // position in the stream, counted in numbers
+    uint64_t position = Position() + n;
+    uint64_t block = position / 4;
+    counter[0] = static_cast<uint32_t>(block);
+    counter[1] = static_cast<uint32_t>(block >> 32);
+    n_used = 4;
+    if (position % 4 != 0) {
+      Block(key, counter, buffer);
+      if (++counter[0] == 0)
+        ++counter[1];
+      n_used = static_cast<int>(position % 4);
+    }
+  }
+
+  /** @return Number of numbers drawn from this stream so far. */
+  uint64_t Position() const {
+    uint64_t block = (static_cast<uint64_t>(counter[1]) << 32) | counter[0];
+    return (4 * block - (4 - n_used));
+  }
+
+  bool operator==(const PhiloxEngine &other) const {
+    return (key[0] == other.key[0] && key[1] == other.key[1] &&
+            counter[2] == other.counter[2] &&
+            counter[3] == other.counter[3] &&
+            Position() == other.Position());
+  }
+  bool operator!=(const PhiloxEngine &other) const {
+    return (!(*this == other));
+  }
+
+  /** The Philox4x32-10 bijection: encrypt the counter ctr with the key
+      k into out.
+   */
+  static void Block(const uint32_t k[2], const uint32_t ctr[4],
+                    uint32_t out[4]) {
+    uint32_t k0 = k[0];
+    uint32_t k1 = k[1];
+    uint32_t c0 = ctr[0];
+    uint32_t c1 = ctr[1];
+    uint32_t c2 = ctr[2];
+    uint32_t c3 = ctr[3];
+    for (int round = 0; round < 10; round++) {
+      if (round > 0) {
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+      }
+      uint64_t product0 = static_cast<uint64_t>(0xD2511F53u) * c0;
+      uint64_t product1 = static_cast<uint64_t>(0xCD9E8D57u) * c2;
+      uint32_t hi0 = static_cast<uint32_t>(product0 >> 32);
+      uint32_t lo0 = static_cast<uint32_t>(product0);
+      uint32_t hi1 = static_cast<uint32_t>(product1 >> 32);
+      uint32_t lo1 = static_cast<uint32_t>(product1);
+      c0 = hi1 ^ c1 ^ k0;
+      c1 = lo1;
+      c2 = hi0 ^ c3 ^ k1;
+      c3 = lo0;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+  }
+
+private:
+  uint32_t key[2];
+  uint32_t counter[4];
+  uint32_t buffer[4];
+  int n_used; // numbers of the current block already returned
+};
+
+} // end namespace Jetscape
+
+#endif // PHILOXENGINE_H
@@ -14,20 +14,25 @@
  ******************************************************************************/
 // This is a general basic class for a hyper-surface finder
 
+#include <algorithm>
 #include <cmath>
+#include <memory>
 #include "RealType.h"
 #include "SurfaceFinder.h"
 #include "cornelius.h"
 #include "FluidEvolutionHistory.h"
 #include "JetScapeLogger.h"
+#include "ThreadPool.h"
 
 namespace Jetscape {
 
 SurfaceFinder::SurfaceFinder(const Jetscape::real T_in,
-                             const EvolutionHistory &bulk_data)
+                             const EvolutionHistory &bulk_data,
+                             int n_threads_in)
     : bulk_info(bulk_data) {
 
   T_cut = T_in;
+  n_threads = std::max(1, n_threads_in);
   JSINFO << "Find a surface with temperature T = " << T_cut;
   boost_invariant = bulk_info.is_boost_invariant();
   if (boost_invariant) {
@@ -36,6 +41,9 @@ SurfaceFinder::SurfaceFinder(const Jetscape::real T_in,
     JSINFO << "Hydro medium is not boost invariant.";
   }
   JSINFO << "Number of fluid cells = " << bulk_info.get_data_size();
+  if (n_threads > 1) {
+    JSINFO << "Scan the time slices on " << n_threads << " threads";
+  }
 }
 
 SurfaceFinder::~SurfaceFinder() { surface_cell_list.clear(); }
@@ -50,36 +58,51 @@ void SurfaceFinder::Find_full_hypersurface() {
   }
 }
 
-bool SurfaceFinder::check_intersect_3D(Jetscape::real tau, Jetscape::real x,
-                                       Jetscape::real y, Jetscape::real dt,
-                                       Jetscape::real dx, Jetscape::real dy,
-                                       double ***cube) {
-  bool intersect = true;
+// The temperatures of the nodes (x0 + i dx, y0 + j dy, eta0 + l deta) at
+// time tau, stored at temperatures[(l * (nx + 1) + i) * (ny + 1) + j].
+// Every node is shared by up to 16 cubes, so it is interpolated once here
+// instead of once per cube.
+void SurfaceFinder::FillNodeTemperatures(
+    Jetscape::real tau, Jetscape::real x0, Jetscape::real y0,
+    Jetscape::real eta0, int nx, int ny, int neta, Jetscape::real dx,
+    Jetscape::real dy, Jetscape::real deta,
+    std::vector<Jetscape::real> &temperatures) const {
+  const int n_row = ny + 1;
+  temperatures.resize((neta + 1) * (nx + 1) * n_row);
+
+  std::vector<Jetscape::real> tau_row(n_row, tau);
+  std::vector<Jetscape::real> x_row(n_row);
+  std::vector<Jetscape::real> y_row(n_row);
+  std::vector<Jetscape::real> eta_row(n_row);
+  for (int j = 0; j < n_row; j++) {
+    y_row[j] = y0 + j * static_cast<double>(dy);
+  }
+  for (int l = 0; l <= neta; l++) {
+    std::fill(eta_row.begin(), eta_row.end(),
+              eta0 + l * static_cast<double>(deta));
+    for (int i = 0; i <= nx; i++) {
+      std::fill(x_row.begin(), x_row.end(), x0 + i * static_cast<double>(dx));
+      bulk_info.get_batch(n_row, tau_row.data(), x_row.data(), y_row.data(),
+                          eta_row.data(), EntryMask(ENTRY_TEMPERATURE),
+                          &temperatures[(l * (nx + 1) + i) * n_row]);
+    }
+  }
+}
 
-  auto tau_low = tau - dt / 2.;
-  auto tau_high = tau + dt / 2.;
-  auto x_left = x - dx / 2.;
-  auto x_right = x + dx / 2.;
-  auto y_left = y - dy / 2.;
-  auto y_right = y + dy / 2.;
-
-  auto fluid_cell = bulk_info.get(tau_low, x_left, y_left, 0.0);
-  cube[0][0][0] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_low, x_left, y_right, 0.0);
-  cube[0][0][1] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_low, x_right, y_left, 0.0);
-  cube[0][1][0] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_low, x_right, y_right, 0.0);
-  cube[0][1][1] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_high, x_left, y_left, 0.0);
-  cube[1][0][0] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_high, x_left, y_right, 0.0);
-  cube[1][0][1] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_high, x_right, y_left, 0.0);
-  cube[1][1][0] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_high, x_right, y_right, 0.0);
-  cube[1][1][1] = fluid_cell.temperature;
+void SurfaceFinder::ForEachTimeChunk(
+    int n_chunks, const std::function<void(int)> &job) const {
+  if (n_threads == 1 || n_chunks == 1) {
+    for (int ichunk = 0; ichunk < n_chunks; ichunk++) {
+      job(ichunk);
+    }
+    return;
+  }
+  ThreadPool pool(std::min(n_threads, n_chunks));
+  pool.ParallelFor(n_chunks, job);
+}
 
+bool SurfaceFinder::cube_intersects_3D(double ***cube) const {
+  bool intersect = true;
   if ((T_cut - cube[0][0][0]) * (cube[1][1][1] - T_cut) < 0.0)
     if ((T_cut - cube[0][1][0]) * (cube[1][0][1] - T_cut) < 0.0)
       if ((T_cut - cube[0][1][1]) * (cube[1][0][0] - T_cut) < 0.0)
@@ -89,12 +112,27 @@ bool SurfaceFinder::check_intersect_3D(Jetscape::real tau, Jetscape::real x,
   return (intersect);
 }
 
+bool SurfaceFinder::cube_intersects_4D(double ****cube) const {
+  bool intersect = true;
+  if ((T_cut - cube[0][0][0][0]) * (cube[1][1][1][1] - T_cut) < 0.0)
+    if ((T_cut - cube[0][0][1][1]) * (cube[1][1][0][0] - T_cut) < 0.0)
+      if ((T_cut - cube[0][1][0][1]) * (cube[1][0][1][0] - T_cut) < 0.0)
+        if ((T_cut - cube[0][1][1][0]) * (cube[1][0][0][1] - T_cut) < 0.0)
+          if ((T_cut - cube[0][0][0][1]) * (cube[1][1][1][0] - T_cut) < 0.0)
+            if ((T_cut - cube[0][0][1][0]) * (cube[1][1][0][1] - T_cut) < 0.0)
+              if ((T_cut - cube[0][1][0][0]) * (cube[1][0][1][1] - T_cut) < 0.0)
+                if ((T_cut - cube[0][1][1][1]) * (cube[1][0][0][0] - T_cut) <
+                    0.0)
+                  intersect = false;
+
+  return (intersect);
+}
+
 void SurfaceFinder::Find_full_hypersurface_3D() {
   auto grid_tau0 = bulk_info.Tau0();
   auto grid_tauf = bulk_info.TauMax();
   auto grid_x0 = bulk_info.XMin();
   auto grid_y0 = bulk_info.YMin();
-  ;
 
   Jetscape::real grid_dt = 0.1;
   Jetscape::real grid_dx = 0.2;
@@ -106,42 +144,65 @@ void SurfaceFinder::Find_full_hypersurface_3D() {
   lattice_spacing[1] = grid_dx;
   lattice_spacing[2] = grid_dy;
 
-  std::unique_ptr<Cornelius> cornelius_ptr(new Cornelius());
-  cornelius_ptr->init(dim, T_cut, lattice_spacing);
-
   const int ntime = static_cast<int>((grid_tauf - grid_tau0) / grid_dt);
   const int nx = static_cast<int>(std::abs(2. * grid_x0) / grid_dx);
   const int ny = static_cast<int>(std::abs(2. * grid_y0) / grid_dy);
+  if (ntime < 1 || nx < 1 || ny < 1)
+    return;
+
+  // the time slices are cut into chunks, a few per thread for balance;
+  // the cells of every chunk are appended in time order at the end
+  const int n_chunks = (n_threads == 1) ? 1 : std::min(ntime, 4 * n_threads);
+  std::vector<std::vector<SurfaceCellInfo>> chunk_cells(n_chunks);
+
+  ForEachTimeChunk(n_chunks, [&](int ichunk) {
+    std::unique_ptr<Cornelius> cornelius_ptr(new Cornelius());
+    cornelius_ptr->init(dim, T_cut, lattice_spacing);
+
+    double corners[8];
+    double *cube_rows[4];
+    double **cube_planes[2];
+    for (int i = 0; i < 4; i++)
+      cube_rows[i] = corners + 2 * i;
+    for (int i = 0; i < 2; i++)
+      cube_planes[i] = cube_rows + 2 * i;
+    double ***cube = cube_planes;
+
+    const int itime_begin = ichunk * ntime / n_chunks;
+    const int itime_end = (ichunk + 1) * ntime / n_chunks;
+    std::vector<Jetscape::real> T_low, T_high;
+    FillNodeTemperatures(grid_tau0 + itime_begin * static_cast<double>(grid_dt),
+                         grid_x0, grid_y0, 0.0, nx, ny, 0, grid_dx, grid_dy,
+                         0.0, T_low);
+
+    auto &cells = chunk_cells[ichunk];
+    for (int itime = itime_begin; itime < itime_end; itime++) {
+      // loop over time evolution
+      auto tau_low = grid_tau0 + itime * static_cast<double>(grid_dt);
+      auto tau_high = grid_tau0 + (itime + 1) * static_cast<double>(grid_dt);
+      FillNodeTemperatures(tau_high, grid_x0, grid_y0, 0.0, nx, ny, 0, grid_dx,
+                           grid_dy, 0.0, T_high);
+      for (int i = 0; i < nx; i++) {
+        // loops over the transverse plane
+        auto x_left = grid_x0 + i * static_cast<double>(grid_dx);
+        for (int j = 0; j < ny; j++) {
+          auto y_left = grid_y0 + j * static_cast<double>(grid_dy);
+          for (int b = 0; b < 2; b++) {
+            for (int c = 0; c < 2; c++) {
+              int node = (i + b) * (ny + 1) + j + c;
+              cube[0][b][c] = T_low[node];
+              cube[1][b][c] = T_high[node];
+            }
+          }
+          if (!cube_intersects_3D(cube))
+            continue;
 
-  double ***cube = new double **[2];
-  for (int i = 0; i < 2; i++) {
-    cube[i] = new double *[2];
-    for (int j = 0; j < 2; j++) {
-      cube[i][j] = new double[2];
-      for (int k = 0; k < 2; k++)
-        cube[i][j][k] = 0.0;
-    }
-  }
-
-  for (int itime = 0; itime < ntime; itime++) {
-    // loop over time evolution
-    auto tau_local = grid_tau0 + (itime + 0.5) * grid_dt;
-    for (int i = 0; i < nx; i++) {
-      // loops over the transverse plane
-      auto x_local = grid_x0 + (i + 0.5) * grid_dx;
-      for (int j = 0; j < ny; j++) {
-        auto y_local = grid_y0 + (j + 0.5) * grid_dy;
-        bool intersect = check_intersect_3D(tau_local, x_local, y_local,
-                                            grid_dt, grid_dx, grid_dy, cube);
-        if (intersect) {
           cornelius_ptr->find_surface_3d(cube);
           for (int isurf = 0; isurf < cornelius_ptr->get_Nelements(); isurf++) {
-            auto tau_center = (cornelius_ptr->get_centroid_elem(isurf, 0) +
-                               tau_local - grid_dt / 2.);
-            auto x_center = (cornelius_ptr->get_centroid_elem(isurf, 1) +
-                             x_local - grid_dx / 2.);
-            auto y_center = (cornelius_ptr->get_centroid_elem(isurf, 2) +
-                             y_local - grid_dy / 2.);
+            auto tau_center =
+                cornelius_ptr->get_centroid_elem(isurf, 0) + tau_low;
+            auto x_center = cornelius_ptr->get_centroid_elem(isurf, 1) + x_left;
+            auto y_center = cornelius_ptr->get_centroid_elem(isurf, 2) + y_left;
 
             auto da_tau = cornelius_ptr->get_normal_elem(isurf, 0);
             auto da_x = cornelius_ptr->get_normal_elem(isurf, 1);
@@ -149,86 +210,20 @@ void SurfaceFinder::Find_full_hypersurface_3D() {
 
             auto fluid_cell =
                 bulk_info.get(tau_center, x_center, y_center, 0.0);
-            auto surface_cell =
-                PrepareASurfaceCell(tau_center, x_center, y_center, 0.0, da_tau,
-                                    da_x, da_y, 0.0, fluid_cell);
-            surface_cell_list.push_back(surface_cell);
+            cells.push_back(PrepareASurfaceCell(tau_center, x_center,
+                                                y_center, 0.0, da_tau, da_x,
+                                                da_y, 0.0, fluid_cell));
           }
         }
       }
+      T_low.swap(T_high);
     }
-  }
+  });
 
-  for (int i = 0; i < 2; i++) {
-    for (int j = 0; j < 2; j++)
-      delete[] cube[i][j];
-    delete[] cube[i];
+  for (auto &cells : chunk_cells) {
+    surface_cell_list.insert(surface_cell_list.end(), cells.begin(),
+                             cells.end());
   }
-  delete[] cube;
-}
-
-bool SurfaceFinder::check_intersect_4D(Jetscape::real tau, Jetscape::real x,
-                                       Jetscape::real y, Jetscape::real eta,
-                                       Jetscape::real dt, Jetscape::real dx,
-                                       Jetscape::real dy, Jetscape::real deta,
-                                       double ****cube) {
-
-  bool intersect = true;
-
-  auto tau_low = tau - dt / 2.;
-  auto tau_high = tau + dt / 2.;
-  auto x_left = x - dx / 2.;
-  auto x_right = x + dx / 2.;
-  auto y_left = y - dy / 2.;
-  auto y_right = y + dy / 2.;
-  auto eta_left = eta - deta / 2.;
-  auto eta_right = eta + deta / 2.;
-
-  auto fluid_cell = bulk_info.get(tau_low, x_left, y_left, eta_left);
-  cube[0][0][0][0] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_low, x_left, y_left, eta_right);
-  cube[0][0][0][1] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_low, x_left, y_right, eta_left);
-  cube[0][0][1][0] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_low, x_left, y_right, eta_right);
-  cube[0][0][1][1] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_low, x_right, y_left, eta_left);
-  cube[0][1][0][0] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_low, x_right, y_left, eta_right);
-  cube[0][1][0][1] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_low, x_right, y_right, eta_left);
-  cube[0][1][1][0] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_low, x_right, y_right, eta_right);
-  cube[0][1][1][1] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_high, x_left, y_left, eta_left);
-  cube[1][0][0][0] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_high, x_left, y_left, eta_right);
-  cube[1][0][0][1] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_high, x_left, y_right, eta_left);
-  cube[1][0][1][0] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_high, x_left, y_right, eta_right);
-  cube[1][0][1][1] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_high, x_right, y_left, eta_left);
-  cube[1][1][0][0] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_high, x_right, y_left, eta_right);
-  cube[1][1][0][1] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_high, x_right, y_right, eta_left);
-  cube[1][1][1][0] = fluid_cell.temperature;
-  fluid_cell = bulk_info.get(tau_high, x_right, y_right, eta_right);
-  cube[1][1][1][1] = fluid_cell.temperature;
-
-  if ((T_cut - cube[0][0][0][0]) * (cube[1][1][1][1] - T_cut) < 0.0)
-    if ((T_cut - cube[0][0][1][1]) * (cube[1][1][0][0] - T_cut) < 0.0)
-      if ((T_cut - cube[0][1][0][1]) * (cube[1][0][1][0] - T_cut) < 0.0)
-        if ((T_cut - cube[0][1][1][0]) * (cube[1][0][0][1] - T_cut) < 0.0)
-          if ((T_cut - cube[0][0][0][1]) * (cube[1][1][1][0] - T_cut) < 0.0)
-            if ((T_cut - cube[0][0][1][0]) * (cube[1][1][0][1] - T_cut) < 0.0)
-              if ((T_cut - cube[0][1][0][0]) * (cube[1][0][1][1] - T_cut) < 0.0)
-                if ((T_cut - cube[0][1][1][1]) * (cube[1][0][0][0] - T_cut) <
-                    0.0)
-                  intersect = false;
-
-  return (intersect);
 }
 
 void SurfaceFinder::Find_full_hypersurface_4D() {
@@ -236,9 +231,7 @@ void SurfaceFinder::Find_full_hypersurface_4D() {
   auto grid_tauf = bulk_info.TauMax();
   auto grid_x0 = bulk_info.XMin();
   auto grid_y0 = bulk_info.YMin();
-  ;
   auto grid_eta0 = bulk_info.EtaMin();
-  ;
 
   Jetscape::real grid_dt = 0.1;
   Jetscape::real grid_dx = 0.2;
@@ -252,54 +245,76 @@ void SurfaceFinder::Find_full_hypersurface_4D() {
   lattice_spacing[2] = grid_dy;
   lattice_spacing[3] = grid_deta;
 
-  std::unique_ptr<Cornelius> cornelius_ptr(new Cornelius());
-  cornelius_ptr->init(dim, T_cut, lattice_spacing);
-
   const int ntime = static_cast<int>((grid_tauf - grid_tau0) / grid_dt);
   const int nx = static_cast<int>(std::abs(2. * grid_x0) / grid_dx);
   const int ny = static_cast<int>(std::abs(2. * grid_y0) / grid_dy);
   const int neta = static_cast<int>(std::abs(2. * grid_eta0) / grid_deta);
+  if (ntime < 1 || nx < 1 || ny < 1 || neta < 1)
+    return;
+
+  const int n_chunks = (n_threads == 1) ? 1 : std::min(ntime, 4 * n_threads);
+  std::vector<std::vector<SurfaceCellInfo>> chunk_cells(n_chunks);
+
+  ForEachTimeChunk(n_chunks, [&](int ichunk) {
+    std::unique_ptr<Cornelius> cornelius_ptr(new Cornelius());
+    cornelius_ptr->init(dim, T_cut, lattice_spacing);
+
+    double corners[16];
+    double *cube_rows[8];
+    double **cube_planes[4];
+    double ***cube_blocks[2];
+    for (int i = 0; i < 8; i++)
+      cube_rows[i] = corners + 2 * i;
+    for (int i = 0; i < 4; i++)
+      cube_planes[i] = cube_rows + 2 * i;
+    for (int i = 0; i < 2; i++)
+      cube_blocks[i] = cube_planes + 2 * i;
+    double ****cube = cube_blocks;
+
+    const int itime_begin = ichunk * ntime / n_chunks;
+    const int itime_end = (ichunk + 1) * ntime / n_chunks;
+    std::vector<Jetscape::real> T_low, T_high;
+    FillNodeTemperatures(grid_tau0 + itime_begin * static_cast<double>(grid_dt),
+                         grid_x0, grid_y0, grid_eta0, nx, ny, neta, grid_dx,
+                         grid_dy, grid_deta, T_low);
+
+    auto &cells = chunk_cells[ichunk];
+    for (int itime = itime_begin; itime < itime_end; itime++) {
+      // loop over time evolution
+      auto tau_low = grid_tau0 + itime * static_cast<double>(grid_dt);
+      auto tau_high = grid_tau0 + (itime + 1) * static_cast<double>(grid_dt);
+      FillNodeTemperatures(tau_high, grid_x0, grid_y0, grid_eta0, nx, ny, neta,
+                           grid_dx, grid_dy, grid_deta, T_high);
+      for (int l = 0; l < neta; l++) {
+        auto eta_left = grid_eta0 + l * static_cast<double>(grid_deta);
+        for (int i = 0; i < nx; i++) {
+          // loops over the transverse plane
+          auto x_left = grid_x0 + i * static_cast<double>(grid_dx);
+          for (int j = 0; j < ny; j++) {
+            auto y_left = grid_y0 + j * static_cast<double>(grid_dy);
+            for (int b = 0; b < 2; b++) {
+              for (int c = 0; c < 2; c++) {
+                for (int d = 0; d < 2; d++) {
+                  int node = ((l + d) * (nx + 1) + i + b) * (ny + 1) + j + c;
+                  cube[0][b][c][d] = T_low[node];
+                  cube[1][b][c][d] = T_high[node];
+                }
+              }
+            }
+            if (!cube_intersects_4D(cube))
+              continue;
 
-  double ****cube = new double ***[2];
-  for (int i = 0; i < 2; i++) {
-    cube[i] = new double **[2];
-    for (int j = 0; j < 2; j++) {
-      cube[i][j] = new double *[2];
-      for (int k = 0; k < 2; k++) {
-        cube[i][j][k] = new double[2];
-        for (int l = 0; l < 2; l++) {
-          cube[i][j][k][l] = 0.0;
-        }
-      }
-    }
-  }
-
-  for (int itime = 0; itime < ntime; itime++) {
-    // loop over time evolution
-    auto tau_local = grid_tau0 + (itime + 0.5) * grid_dt;
-    for (int l = 0; l < neta; l++) {
-      auto eta_local = grid_eta0 + (l + 0.5) * grid_deta;
-      // loops over the transverse plane
-      for (int i = 0; i < nx; i++) {
-        // loops over the transverse plane
-        auto x_local = grid_x0 + (i + 0.5) * grid_dx;
-        for (int j = 0; j < ny; j++) {
-          auto y_local = grid_y0 + (j + 0.5) * grid_dy;
-          bool intersect =
-              check_intersect_4D(tau_local, x_local, y_local, eta_local,
-                                 grid_dt, grid_dx, grid_dy, grid_deta, cube);
-          if (intersect) {
             cornelius_ptr->find_surface_4d(cube);
             for (int isurf = 0; isurf < cornelius_ptr->get_Nelements();
                  isurf++) {
-              auto tau_center = (cornelius_ptr->get_centroid_elem(isurf, 0) +
-                                 tau_local - grid_dt / 2.);
-              auto x_center = (cornelius_ptr->get_centroid_elem(isurf, 1) +
-                               x_local - grid_dx / 2.);
-              auto y_center = (cornelius_ptr->get_centroid_elem(isurf, 2) +
-                               y_local - grid_dy / 2.);
-              auto eta_center = (cornelius_ptr->get_centroid_elem(isurf, 3) +
-                                 eta_local - grid_deta / 2.);
+              auto tau_center =
+                  cornelius_ptr->get_centroid_elem(isurf, 0) + tau_low;
+              auto x_center =
+                  cornelius_ptr->get_centroid_elem(isurf, 1) + x_left;
+              auto y_center =
+                  cornelius_ptr->get_centroid_elem(isurf, 2) + y_left;
+              auto eta_center =
+                  cornelius_ptr->get_centroid_elem(isurf, 3) + eta_left;
 
               auto da_tau = (cornelius_ptr->get_normal_elem(isurf, 0));
               auto da_x = (cornelius_ptr->get_normal_elem(isurf, 1));
@@ -308,27 +323,21 @@ void SurfaceFinder::Find_full_hypersurface_4D() {
 
               auto fluid_cell =
                   bulk_info.get(tau_center, x_center, y_center, eta_center);
-              auto surface_cell = PrepareASurfaceCell(
+              cells.push_back(PrepareASurfaceCell(
                   tau_center, x_center, y_center, eta_center, da_tau, da_x,
-                  da_y, da_eta, fluid_cell);
-              surface_cell_list.push_back(surface_cell);
+                  da_y, da_eta, fluid_cell));
             }
           }
         }
       }
+      T_low.swap(T_high);
     }
-  }
+  });
 
-  for (int i = 0; i < 2; i++) {
-    for (int j = 0; j < 2; j++) {
-      for (int k = 0; k < 2; k++) {
-        delete[] cube[i][j][k];
-      }
-      delete[] cube[i][j];
-    }
-    delete[] cube[i];
+  for (auto &cells : chunk_cells) {
+    surface_cell_list.insert(surface_cell_list.end(), cells.begin(),
+                             cells.end());
   }
-  delete[] cube;
 }
 
 SurfaceCellInfo SurfaceFinder::PrepareASurfaceCell(
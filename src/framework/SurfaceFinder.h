@@ -17,6 +17,7 @@
 #ifndef SURFACEFINDER_H_
 #define SURFACEFINDER_H_
 
+#include <functional>
 #include <vector>
 
 #include "RealType.h"
@@ -31,10 +32,32 @@ private:
   const EvolutionHistory &bulk_info;
   bool boost_invariant;
 
+  int n_threads;
+
   std::vector<SurfaceCellInfo> surface_cell_list;
 
+  // interpolate the temperature at the lattice nodes of one time slice
+  void FillNodeTemperatures(Jetscape::real tau, Jetscape::real x0,
+                            Jetscape::real y0, Jetscape::real eta0, int nx,
+                            int ny, int neta, Jetscape::real dx,
+                            Jetscape::real dy, Jetscape::real deta,
+                            std::vector<Jetscape::real> &temperatures) const;
+
+  // run job(ichunk) for the chunks of time slices, on n_threads threads
+  void ForEachTimeChunk(int n_chunks,
+                        const std::function<void(int)> &job) const;
+
+  bool cube_intersects_3D(double ***cube) const;
+  bool cube_intersects_4D(double ****cube) const;
+
 public:
-  SurfaceFinder(const Jetscape::real T_in, const EvolutionHistory &bulk_data);
+  /** @param T_in Temperature of the surface in GeV.
+      @param bulk_data Evolution history to search.
+      @param n_threads_in Number of threads scanning the time slices. The
+      surface cells are in the same order for any number of threads.
+   */
+  SurfaceFinder(const Jetscape::real T_in, const EvolutionHistory &bulk_data,
+                int n_threads_in = 1);
   ~SurfaceFinder();
 
   void Find_full_hypersurface();
@@ -47,16 +70,8 @@ public:
     return (surface_cell_list);
   }
 
-  bool check_intersect_3D(Jetscape::real tau, Jetscape::real x,
-                          Jetscape::real y, Jetscape::real dt,
-                          Jetscape::real dx, Jetscape::real dy, double ***cube);
   void Find_full_hypersurface_3D();
 
-  bool check_intersect_4D(Jetscape::real tau, Jetscape::real x,
-                          Jetscape::real y, Jetscape::real eta,
-                          Jetscape::real dt, Jetscape::real dx,
-                          Jetscape::real dy, Jetscape::real deta,
-                          double ****cube);
   void Find_full_hypersurface_4D();
 
   SurfaceCellInfo PrepareASurfaceCell(Jetscape::real tau, Jetscape::real x,
@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "ThreadPool.h"
+
+namespace Jetscape {
+
+ThreadPool::ThreadPool(int n_threads) {
+  if (n_threads < 1)
+    n_threads = 1;
+  for (int i = 0; i < n_threads; i++) {
+    workers.push_back(std::thread(&ThreadPool::WorkerLoop, this));
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    stopping = true;
+  }
+  work_available.notify_all();
+  for (auto &worker : workers)
+    worker.join();
+}
+
+void ThreadPool::ParallelFor(int n_jobs,
+                             const std::function<void(int)> &job) {
+  if (n_jobs <= 0)
+    return;
+
+  std::unique_lock<std::mutex> lock(pool_mutex);
+  current_job = &job;
+  n_jobs_total = n_jobs;
+  next_job = 0;
+  n_jobs_running = 0;
+  first_exception = nullptr;
+  generation++;
+  work_available.notify_all();
+
+  work_done.wait(lock, [this] {
+    return (next_job >= n_jobs_total && n_jobs_running == 0);
+  });
+  current_job = nullptr;
+
+  if (first_exception) {
+    auto exception = first_exception;
+    first_exception = nullptr;
+    std::rethrow_exception(exception);
+  }
+}
+
+void ThreadPool::WorkerLoop() {
+  unsigned long seen_generation = 0;
+  std::unique_lock<std::mutex> lock(pool_mutex);
+  while (true) {
+    work_available.wait(lock, [this, &seen_generation] {
+      return (stopping || (generation != seen_generation &&
+                           next_job < n_jobs_total));
+    });
+    if (stopping)
+      return;
+    seen_generation = generation;
+
+    // take jobs one at a time until this call of ParallelFor is exhausted
+    while (next_job < n_jobs_total) {
+      int i = next_job++;
+      n_jobs_running++;
+      const auto *job = current_job;
+      lock.unlock();
+      std::exception_ptr exception;
+      try {
+        (*job)(i);
+      } catch (...) {
+        exception = std::current_exception();
+      }
+      lock.lock();
+      n_jobs_running--;
+      if (exception) {
+        if (!first_exception)
+          first_exception = exception;
+        // skip the jobs not started yet
+        next_job = n_jobs_total;
+      }
+    }
+    if (n_jobs_running == 0)
+      work_done.notify_all();
+  }
+}
+
+} // end namespace Jetscape
@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Jetscape {
+
+/** @class ThreadPool
+ * A fixed number of worker threads, started once and reused for every
+ * call of ParallelFor(). Jobs are handed out by index, so the caller
+ * decides in which order the results are used, independently of the
+ * number of threads and of the scheduling.
+ */
+class ThreadPool {
+public:
+  /** Start the worker threads.
+      @param n_threads Number of worker threads, at least one.
+   */
+  explicit ThreadPool(int n_threads);
+
+  /** Stop and join the worker threads. */
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  int GetNumberOfThreads() const { return (static_cast<int>(workers.size())); }
+
+  /** Run job(i) for i = 0, ..., n_jobs - 1 on the worker threads and
+   * return once all of them are finished. If a job throws, the remaining
+   * jobs are skipped and the first exception is rethrown here.
+      @param n_jobs Number of jobs.
+      @param job Function called with the job index.
+   */
+  void ParallelFor(int n_jobs, const std::function<void(int)> &job);
+
+private:
+  void WorkerLoop();
+
+  std::vector<std::thread> workers;
+  std::mutex pool_mutex;
+  std::condition_variable work_available;
+  std::condition_variable work_done;
+
+  // state of the current ParallelFor call, guarded by pool_mutex
+  const std::function<void(int)> *current_job = nullptr;
+  int n_jobs_total = 0;
+  int next_job = 0;
+  int n_jobs_running = 0;
+  unsigned long generation = 0;
+  bool stopping = false;
+  std::exception_ptr first_exception;
+};
+
+} // end namespace Jetscape
+
+#endif // THREADPOOL_H
@@ -24,6 +24,8 @@
 #include <sstream>
 #include <random>
 #include <algorithm>
+#include <iterator>
+#include <limits>
 
 using namespace Jetscape;
 using namespace Pythia8;
@@ -1072,6 +1074,16 @@ void HybridHadronization::recomb() {
   //'q3' loops over all quarks in the event, starting from 'q2' and ending at the last quark
   //when 'q2' is at the last quark, we will not consider quark 'q3' - can only make a meson at that point...
 
+  //rather than going through all of perm2 in the 'q2' and 'q3' loops, only the shower quarks and the thermal quarks
+  //in nearby cells are considered (in the order of perm2) - the others can't pass the distance cut anyway
+  std::vector<int> shower_pos, thermal2, thermal3, partners2, partners3;
+  for (int i = 0; i < showerquarks.num() + HH_thermal.num(); ++i) {
+    if (perm2[i] > 0) {
+      shower_pos.push_back(i);
+    }
+  }
+  bin_thermal(showerquarks, perm2);
+
   parton_collection considering;
   int element[3];
 
@@ -1106,7 +1118,12 @@ void HybridHadronization::recomb() {
     considering.add(showerquarks[element[0]]);
     showerquarks[element[0]].status(-991);
 
-    for (int q2 = 0; q2 < showerquarks.num() + HH_thermal.num(); ++q2) {
+    near_thermal(considering[0].pos(), considering[0].pos().t(), thermal2);
+    partners2.clear();
+    std::merge(shower_pos.begin(), shower_pos.end(), thermal2.begin(),
+               thermal2.end(), std::back_inserter(partners2));
+
+    for (int q2 : partners2) {
       //set q2 variables here - if we can form a meson, then skip q3 loop
       //also skip q3 loop if q2 is at last quark
 
@@ -1206,8 +1223,14 @@ void HybridHadronization::recomb() {
       //will skip third loop in this case - otherwise we will check if we can make a baryon...
       if ((considering[0].id() * considering[1].id() > 0) &&
           (q2 < showerquarks.num() + HH_thermal.num() - 1)) {
-        for (int q3 = q2 + 1; q3 < showerquarks.num() + HH_thermal.num();
-             ++q3) {
+        near_thermal(considering[0].pos(), considering[1].pos().t(), thermal3);
+        partners3.clear();
+        std::merge(std::upper_bound(shower_pos.begin(), shower_pos.end(), q2),
+                   shower_pos.end(),
+                   std::upper_bound(thermal3.begin(), thermal3.end(), q2),
+                   thermal3.end(), std::back_inserter(partners3));
+
+        for (int q3 : partners3) {
 
           double recofactor3 = recofactor2;
 
@@ -2518,6 +2541,166 @@ void HybridHadronization::recomb() {
   //end of recombination routine
 }
 
+void HybridHadronization::bin_thermal(parton_collection &showerquarks,
+                                      int *perm2) {
+  thermcell_keys.clear();
+  thermcell_start.clear();
+  thermcell_pos.clear();
+
+  //before the distance cut, partons are moved to a common time with their velocity p/e,
+  //so a parton can be found sqrt(dist2cut) + thermcell_vmax*|dt| away from its partner
+  thermcell_size = sqrt(dist2cut);
+  thermcell_use = (thermcell_size > 0.) && std::isfinite(thermcell_size);
+  thermcell_vmax = 0.;
+  for (int i = 0; i < showerquarks.num() + HH_thermal.num(); ++i) {
+    HHparton &ptn = (i < showerquarks.num())
+                        ? showerquarks[i]
+                        : HH_thermal[i - showerquarks.num()];
+    double v = sqrt(ptn.px() * ptn.px() + ptn.py() * ptn.py() +
+                    ptn.pz() * ptn.pz()) /
+               ptn.e();
+    if (std::isfinite(v) && (v >= 0.)) {
+      thermcell_vmax = std::max(thermcell_vmax, v);
+    } else {
+      thermcell_use = false;
+    }
+  }
+
+  std::vector<std::pair<std::array<int, 4>, int>> cells;
+  for (int i = 0; i < showerquarks.num() + HH_thermal.num(); ++i) {
+    if (perm2[i] > 0) {
+      continue;
+    }
+    std::array<int, 4> key = {{0, 0, 0, 0}};
+    if (thermcell_use) {
+      FourVector pos = HH_thermal[-(perm2[i] + 1)].pos();
+      double coord[4] = {pos.t(), pos.x(), pos.y(), pos.z()};
+      for (int c = 0; c < 4; ++c) {
+        double cell = floor(coord[c] / thermcell_size);
+        //partons far away (or at nan) would overflow the cell index, go through all of them in that case
+        if (!(std::abs(cell) < 1.e8)) {
+          thermcell_use = false;
+        } else {
+          key[c] = int(cell);
+        }
+      }
+    }
+    cells.push_back(std::make_pair(key, i));
+  }
+
+  //without the cells, near_thermal returns all the thermal partons
+  if (!thermcell_use) {
+    for (auto &cell : cells) {
+      thermcell_pos.push_back(cell.second);
+    }
+    return;
+  }
+
+  std::sort(cells.begin(), cells.end());
+  for (int c = 0; c < 3; ++c) {
+    thermcell_lo[c] = std::numeric_limits<int>::max();
+    thermcell_hi[c] = std::numeric_limits<int>::min();
+  }
+  for (int i = 0; i < cells.size(); ++i) {
+    if (i == 0 || cells[i].first != cells[i - 1].first) {
+      thermcell_keys.push_back(cells[i].first);
+      thermcell_start.push_back(i);
+      for (int c = 0; c < 3; ++c) {
+        thermcell_lo[c] = std::min(thermcell_lo[c], cells[i].first[c + 1]);
+        thermcell_hi[c] = std::max(thermcell_hi[c], cells[i].first[c + 1]);
+      }
+    }
+    thermcell_pos.push_back(cells[i].second);
+  }
+  thermcell_start.push_back(cells.size());
+}
+
+void HybridHadronization::near_thermal(FourVector pos1, double t2,
+                                       std::vector<int> &partners) {
+  partners.clear();
+  double t1 = pos1.t();
+  double x1[3] = {pos1.x(), pos1.y(), pos1.z()};
+  if (!thermcell_use || !std::isfinite(t1) || !std::isfinite(t2) ||
+      !std::isfinite(x1[0]) || !std::isfinite(x1[1]) ||
+      !std::isfinite(x1[2])) {
+    partners = thermcell_pos;
+    std::sort(partners.begin(), partners.end());
+    return;
+  }
+
+  //going through the time slices of the cells
+  int slice = 0;
+  while (slice < thermcell_keys.size()) {
+    int it = thermcell_keys[slice][0];
+    int slice_end = slice;
+    while (slice_end < thermcell_keys.size() &&
+           thermcell_keys[slice_end][0] == it) {
+      ++slice_end;
+    }
+
+    //the partons are moved to the time of one of them, at most by |t1 - t3| or |t2 - t1| + |t2 - t3|
+    //for a thermal parton at t3 - largest at the edges of the slice
+    double dtmax = 0.;
+    for (int edge = 0; edge < 2; ++edge) {
+      double t3 = (it + edge) * thermcell_size;
+      dtmax = std::max(dtmax, std::max(std::abs(t1 - t3),
+                                       std::abs(t2 - t1) + std::abs(t2 - t3)));
+    }
+    //with a small margin for rounding
+    double r = (thermcell_size + thermcell_vmax * dtmax) * (1. + 1.e-9) + 1.e-9;
+
+    int lo[3], hi[3];
+    for (int c = 0; c < 3; ++c) {
+      lo[c] = int(std::max(floor((x1[c] - r) / thermcell_size),
+                           double(thermcell_lo[c])));
+      hi[c] = int(std::min(floor((x1[c] + r) / thermcell_size),
+                           double(thermcell_hi[c])));
+    }
+
+    if (lo[0] <= hi[0] && lo[1] <= hi[1] && lo[2] <= hi[2]) {
+      if ((double(hi[0] - lo[0] + 1) * (hi[1] - lo[1] + 1)) <
+          (slice_end - slice)) {
+        //looking up the cells around pos1, a column in z at a time
+        for (int ix = lo[0]; ix <= hi[0]; ++ix) {
+          for (int iy = lo[1]; iy <= hi[1]; ++iy) {
+            std::array<int, 4> first = {{it, ix, iy, lo[2]}};
+            int cell = std::lower_bound(thermcell_keys.begin() + slice,
+                                        thermcell_keys.begin() + slice_end,
+                                        first) -
+                       thermcell_keys.begin();
+            for (; cell < slice_end && thermcell_keys[cell][1] == ix &&
+                   thermcell_keys[cell][2] == iy &&
+                   thermcell_keys[cell][3] <= hi[2];
+                 ++cell) {
+              partners.insert(partners.end(),
+                              thermcell_pos.begin() + thermcell_start[cell],
+                              thermcell_pos.begin() + thermcell_start[cell + 1]);
+            }
+          }
+        }
+      } else {
+        //fewer cells in the slice than columns to look up
+        for (int cell = slice; cell < slice_end; ++cell) {
+          bool inside = true;
+          for (int c = 0; c < 3; ++c) {
+            inside = inside && (thermcell_keys[cell][c + 1] >= lo[c]) &&
+                     (thermcell_keys[cell][c + 1] <= hi[c]);
+          }
+          if (inside) {
+            partners.insert(partners.end(),
+                            thermcell_pos.begin() + thermcell_start[cell],
+                            thermcell_pos.begin() + thermcell_start[cell + 1]);
+          }
+        }
+      }
+    }
+    slice = slice_end;
+  }
+
+  //in the order of perm2
+  std::sort(partners.begin(), partners.end());
+}
+
 //sets id of formed baryon based on quark content, mass of quark system, and if the baryon formed into an excited state
 void HybridHadronization::set_baryon_id(parton_collection &qrks,
                                         HHhadron &had) {
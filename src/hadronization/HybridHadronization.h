@@ -466,6 +466,22 @@ private:
   //recombination module
   void recomb();
 
+  //the binned partner search is compared with a loop over all partons in the unittests
+  friend class HybridHadronizationTest;
+
+  //thermal partons binned in cells of size sqrt(dist2cut) in t, x, y, z, to find recombination partners quickly
+  //thermcell_pos[thermcell_start[i]] ... thermcell_pos[thermcell_start[i+1]-1] are the perm2 positions of the
+  //thermal partons in the cell thermcell_keys[i], the keys are sorted
+  std::vector<std::array<int, 4>> thermcell_keys;
+  std::vector<int> thermcell_start, thermcell_pos;
+  int thermcell_lo[3], thermcell_hi[3];
+  double thermcell_size, thermcell_vmax;
+  bool thermcell_use;
+  void bin_thermal(parton_collection &showerquarks, int *perm2);
+  //perm2 positions (sorted) of all thermal partons that may pass the distance cut with a parton at pos1,
+  //when the partons are moved to a common time - t2 is the time of a second parton already considered
+  void near_thermal(FourVector pos1, double t2, std::vector<int> &partners);
+
   //functions to set hadron id based on quark content, mass, and if it's in an excited state
   void set_baryon_id(parton_collection &qrks, HHhadron &had);
   void set_meson_id(parton_collection &qrks, HHhadron &had);
@@ -19,6 +19,7 @@
 #include <cstring>
 #include <cmath>
 #include <iostream>
+#include <algorithm>
 #include <MakeUniqueHelper.h>
 
 #include "JetScapeLogger.h"
@@ -116,3 +117,37 @@ void Brick::GetHydroInfo(
     exit(-1);
   }
 }
+
+void Brick::GetHydroInfoBatch(int n_points, const Jetscape::real *t,
+                              const Jetscape::real *x, const Jetscape::real *y,
+                              const Jetscape::real *z, unsigned int field_mask,
+                              Jetscape::real *output) {
+  if (hydro_status != FINISHED) {
+    JSWARN << "Hydro not run yet ...";
+    exit(-1);
+  }
+
+  // only the temperature and the QGP fraction are non-zero in the brick
+  int k = 0;
+  for (int i_entry = 0; i_entry < ENTRY_INVALID; i_entry++) {
+    auto entry_name = static_cast<EntryName>(i_entry);
+    if ((field_mask & EntryMask(entry_name)) == 0) {
+      continue;
+    }
+    Jetscape::real *field = output + k * n_points;
+    if (entry_name == ENTRY_TEMPERATURE) {
+      if (bjorken_expansion_on) {
+        for (int i = 0; i < n_points; i++) {
+          field[i] = T_brick * std::pow(start_time / t[i], 1.0 / 3.0);
+        }
+      } else {
+        std::fill(field, field + n_points, T_brick);
+      }
+    } else if (entry_name == ENTRY_QGP_FRACTION) {
+      std::fill(field, field + n_points, 1.0);
+    } else {
+      std::fill(field, field + n_points, 0.0);
+    }
+    k++;
+  }
+}
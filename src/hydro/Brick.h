@@ -41,6 +41,10 @@ public:
   void GetHydroInfo(Jetscape::real t, Jetscape::real x, Jetscape::real y,
                     Jetscape::real z,
                     std::unique_ptr<FluidCellInfo> &fluid_cell_info_ptr);
+  void GetHydroInfoBatch(int n_points, const Jetscape::real *t,
+                         const Jetscape::real *x, const Jetscape::real *y,
+                         const Jetscape::real *z, unsigned int field_mask,
+                         Jetscape::real *output);
 
   void GetHyperSurface(Jetscape::real T_cut,
                        SurfaceCellInfo *surface_list_ptr){};
@@ -157,3 +157,18 @@ void CLVisc::GetHydroInfo(Jetscape::real t, Jetscape::real x, Jetscape::real y,
     *fluid_cell_info_ptr = bulk_info.get(t, x, y, z);
   }
 }
+
+void CLVisc::GetHydroInfoBatch(int n_points, const Jetscape::real *t,
+                               const Jetscape::real *x, const Jetscape::real *y,
+                               const Jetscape::real *z, unsigned int field_mask,
+                               Jetscape::real *output) {
+  if (hydro_status != FINISHED) {
+    throw std::runtime_error("Hydro evolution is not finished ");
+  }
+
+  if (!bulk_info.tau_eta_is_tz) {
+    bulk_info.get_tz_batch(n_points, t, x, y, z, field_mask, output);
+  } else {
+    bulk_info.get_batch(n_points, t, x, y, z, field_mask, output);
+  }
+}
@@ -68,7 +68,34 @@ void GubserHydro::GetHydroInfo(
     std::unique_ptr<FluidCellInfo> &fluid_cell_info_ptr) {
   // create the unique FluidCellInfo here
   fluid_cell_info_ptr = make_unique<FluidCellInfo>();
+  FillFluidCell(t, x, y, z, *fluid_cell_info_ptr);
+}
+
+void GubserHydro::GetHydroInfoBatch(int n_points, const Jetscape::real *t,
+                                    const Jetscape::real *x,
+                                    const Jetscape::real *y,
+                                    const Jetscape::real *z,
+                                    unsigned int field_mask,
+                                    Jetscape::real *output) {
+  EntryName entries[ENTRY_INVALID];
+  int n_entries = 0;
+  for (int i = 0; i < ENTRY_INVALID; i++) {
+    if (field_mask & EntryMask(static_cast<EntryName>(i))) {
+      entries[n_entries++] = static_cast<EntryName>(i);
+    }
+  }
+  FluidCellInfo fluid_cell;
+  for (int i = 0; i < n_points; i++) {
+    FillFluidCell(t[i], x[i], y[i], z[i], fluid_cell);
+    for (int k = 0; k < n_entries; k++) {
+      output[k * n_points + i] = GetEntryValue(fluid_cell, entries[k]);
+    }
+  }
+}
 
+void GubserHydro::FillFluidCell(Jetscape::real t, Jetscape::real x,
+                                Jetscape::real y, Jetscape::real z,
+                                FluidCellInfo &fluid_cell) {
   double t_local = static_cast<double>(t);
   double x_local = static_cast<double>(x);
   double y_local = static_cast<double>(y);
@@ -100,24 +127,24 @@ void GubserHydro::GetHydroInfo(
 
   // assign all the quantites to JETSCAPE output
   // thermodyanmic quantities
-  fluid_cell_info_ptr->energy_density = e_local;
-  fluid_cell_info_ptr->entropy_density = s_local;
-  fluid_cell_info_ptr->temperature = T_local;
-  fluid_cell_info_ptr->pressure = p_local;
+  fluid_cell.energy_density = e_local;
+  fluid_cell.entropy_density = s_local;
+  fluid_cell.temperature = T_local;
+  fluid_cell.pressure = p_local;
   // QGP fraction
-  fluid_cell_info_ptr->qgp_fraction = 1.0;
+  fluid_cell.qgp_fraction = 1.0;
   // chemical potentials
-  fluid_cell_info_ptr->mu_B = 0.0;
-  fluid_cell_info_ptr->mu_C = 0.0;
-  fluid_cell_info_ptr->mu_S = 0.0;
+  fluid_cell.mu_B = 0.0;
+  fluid_cell.mu_C = 0.0;
+  fluid_cell.mu_S = 0.0;
   // dynamical quantites
-  fluid_cell_info_ptr->vx = vx_local;
-  fluid_cell_info_ptr->vy = vy_local;
-  fluid_cell_info_ptr->vz = vz_local;
+  fluid_cell.vx = vx_local;
+  fluid_cell.vy = vy_local;
+  fluid_cell.vz = vz_local;
   for (int i = 0; i < 4; i++) {
     for (int j = 0; j < 4; j++) {
-      fluid_cell_info_ptr->pi[i][j] = 0.0;
+      fluid_cell.pi[i][j] = 0.0;
     }
   }
-  fluid_cell_info_ptr->bulk_Pi = 0.0;
+  fluid_cell.bulk_Pi = 0.0;
 }
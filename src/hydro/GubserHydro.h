@@ -29,6 +29,8 @@ private:
   double q;
   double e_0;
   double temperature(double e_local);
+  void FillFluidCell(Jetscape::real t, Jetscape::real x, Jetscape::real y,
+                     Jetscape::real z, FluidCellInfo &fluid_cell);
 
   // Allows the registration of the module so that it is available to be used by the Jetscape framework.
   static RegisterJetScapeModule<GubserHydro> reg;
@@ -44,6 +46,10 @@ public:
   void GetHydroInfo(Jetscape::real t, Jetscape::real x, Jetscape::real y,
                     Jetscape::real z,
                     std::unique_ptr<FluidCellInfo> &fluid_cell_info_ptr);
+  void GetHydroInfoBatch(int n_points, const Jetscape::real *t,
+                         const Jetscape::real *x, const Jetscape::real *y,
+                         const Jetscape::real *z, unsigned int field_mask,
+                         Jetscape::real *output);
 
   void GetHyperSurface(Jetscape::real T_cut,
                        SurfaceCellInfo *surface_list_ptr){};
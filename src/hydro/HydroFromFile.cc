@@ -17,7 +17,9 @@
 #include <sys/stat.h>
 #include <MakeUniqueHelper.h>
 
+#include <algorithm>
 #include <cstring>
+#include <fstream>
 #include <sstream>
 #include <cmath>
 #include <iostream>
@@ -33,10 +35,23 @@ RegisterJetScapeModule<HydroFromFile> HydroFromFile::reg("HydroFromFile");
 
 HydroFromFile::HydroFromFile() {
   hydro_status = NOT_START;
+  hydro_type_ = 0;
+  prefetch_next_hydro_ = 0;
+  n_cached_hydro_events_ = 0;
+  mmap_hydro_file_ = 0;
+#ifdef USE_HDF5
+  hydroinfo_h5_ptr = nullptr;
+#endif
+  hydroinfo_MUSIC_ptr = nullptr;
   SetId("hydroFromFile");
 }
 
-HydroFromFile::~HydroFromFile() { clean_hydro_event(); }
+HydroFromFile::~HydroFromFile() {
+  if (prefetched_event_.valid()) {
+    prefetched_event_.wait();
+  }
+  clean_hydro_event();
+}
 
 //! this function loads the hydro files
 void HydroFromFile::InitializeHydro(Parameter parameter_list) {
@@ -54,32 +69,81 @@ void HydroFromFile::InitializeHydro(Parameter parameter_list) {
   T_c_ = GetXMLElementDouble({"Hydro", "hydro_from_file", "T_c"});
   flag_read_in_multiple_hydro_ =
       GetXMLElementInt({"Hydro", "hydro_from_file", "read_in_multiple_hydro"});
+  prefetch_next_hydro_ = GetXMLElementInt(
+      {"Hydro", "hydro_from_file", "prefetch_next_hydro"}, false);
+  n_cached_hydro_events_ = GetXMLElementInt(
+      {"Hydro", "hydro_from_file", "n_cached_hydro_events"}, false);
+  mmap_hydro_file_ = GetXMLElementInt(
+      {"Hydro", "hydro_from_file", "mmap_hydro_file"}, false);
+  if (flag_read_in_multiple_hydro_ == 0) {
+    // the same file is used for every event, read it once
+    n_cached_hydro_events_ = std::max(n_cached_hydro_events_, 1);
+  }
 
   hydro_event_idx_ = 0;
 
   if (hydro_type_ == 1) {
-#ifdef USE_HDF5
-    hydroinfo_h5_ptr = new HydroinfoH5();
-#else
+#ifndef USE_HDF5
     JSWARN << " : hydro_type == 1 requires the hdf5 library~";
     JSWARN << " : please check your inputs~";
     exit(-1);
+#elif !defined(H5_HAVE_THREADSAFE)
+    if (prefetch_next_hydro_) {
+      JSWARN << "The hdf5 library is not thread safe, "
+             << "the hydro events are read without prefetching";
+      prefetch_next_hydro_ = 0;
+    }
 #endif
-  } else if (hydro_type_ == 2 || hydro_type_ == 3 || hydro_type_ == 4) {
-    hydroinfo_MUSIC_ptr = new Hydroinfo_MUSIC();
+  } else if (hydro_type_ < 1 || hydro_type_ > 4) {
+    JSWARN << "main: unrecognized hydro_type = " << hydro_type_;
+    exit(1);
   }
 
   hydro_status = INITIALIZED;
 }
 
+std::shared_ptr<HydroFromFileEvent>
+HydroFromFile::load_hydro_event(const string &input_file,
+                                const string &hydro_file, int buffer_size,
+                                int load_viscous, int nskip_tau) const {
+  auto event = std::make_shared<HydroFromFileEvent>();
+  event->file_name = hydro_file;
+  if (hydro_type_ == 1) {
+    JSINFO << "read in a VISHNew hydro event from file " << hydro_file;
+#ifdef USE_HDF5
+    event->h5 = make_unique<HydroinfoH5>();
+    event->h5->readHydroinfoH5(hydro_file, buffer_size, load_viscous);
+#endif
+  } else {
+    JSINFO << "read in a MUSIC hydro event from file " << hydro_file;
+    // hydro_type 2, 3, 4 are the MUSIC modes 8, 9, 10
+    int hydro_mode = hydro_type_ + 6;
+    string hydro_shear_file = "";
+    string hydro_bulk_file = "";
+    event->music = make_unique<Hydroinfo_MUSIC>();
+    event->music->set_use_mmap(mmap_hydro_file_ != 0);
+    event->music->readHydroData(hydro_mode, nskip_tau, input_file, hydro_file,
+                                hydro_shear_file, hydro_bulk_file);
+  }
+  return event;
+}
+
+void HydroFromFile::set_current_event(
+    std::shared_ptr<HydroFromFileEvent> event) {
+  current_event_ = event;
+#ifdef USE_HDF5
+  hydroinfo_h5_ptr = event->h5.get();
+#endif
+  hydroinfo_MUSIC_ptr = event->music.get();
+  hydro_status = FINISHED;
+}
+
 //! This function load a VISHNew hydro event
 void HydroFromFile::read_in_hydro_event(string VISH_filename, int buffer_size,
                                         int load_viscous) {
-  JSINFO << "read in a VISHNew hydro event from file " << VISH_filename;
   if (hydro_type_ == 1) {
-#ifdef USE_HDF5
-    hydroinfo_h5_ptr->readHydroinfoH5(VISH_filename, buffer_size, load_viscous);
-#endif
+    set_current_event(
+        load_hydro_event("", VISH_filename, buffer_size, load_viscous, 1));
   }
   hydro_status = FINISHED;
 }
@@ -88,127 +152,140 @@ void HydroFromFile::read_in_hydro_event(string VISH_filename, int buffer_size,
 void HydroFromFile::read_in_hydro_event(string MUSIC_input_file,
                                         string MUSIC_hydro_ideal_file,
                                         int nskip_tau) {
-  JSINFO << "read in a MUSIC hydro event from file " << MUSIC_hydro_ideal_file;
-  if (hydro_type_ == 2) {
-    int hydro_mode = 8;
-    string hydro_shear_file = "";
-    string hydro_bulk_file = "";
-    hydroinfo_MUSIC_ptr->readHydroData(hydro_mode, nskip_tau, MUSIC_input_file,
-                                       MUSIC_hydro_ideal_file, hydro_shear_file,
-                                       hydro_bulk_file);
-  } else if (hydro_type_ == 3) {
-    int hydro_mode = 9;
-    string hydro_shear_file = "";
-    string hydro_bulk_file = "";
-    hydroinfo_MUSIC_ptr->readHydroData(hydro_mode, nskip_tau, MUSIC_input_file,
-                                       MUSIC_hydro_ideal_file, hydro_shear_file,
-                                       hydro_bulk_file);
-  } else if (hydro_type_ == 4) {
-    int hydro_mode = 10;
-    string hydro_shear_file = "";
-    string hydro_bulk_file = "";
-    hydroinfo_MUSIC_ptr->readHydroData(hydro_mode, nskip_tau, MUSIC_input_file,
-                                       MUSIC_hydro_ideal_file, hydro_shear_file,
-                                       hydro_bulk_file);
+  if (hydro_type_ == 2 || hydro_type_ == 3 || hydro_type_ == 4) {
+    set_current_event(load_hydro_event(MUSIC_input_file,
+                                       MUSIC_hydro_ideal_file, 500,
+                                       load_viscous_, nskip_tau));
   }
   hydro_status = FINISHED;
 }
 
-void HydroFromFile::EvolveHydro() {
-  if (hydro_status == FINISHED) {
-    clean_hydro_event();
-    hydro_event_idx_ = ini->GetEventId();
-  }
-
-  if (hydro_type_ == 1) {
-    string filename;
-    if (flag_read_in_multiple_hydro_ == 0) {
-      filename = GetXMLElementText({"Hydro", "hydro_from_file", "VISH_file"});
+void HydroFromFile::get_hydro_event_files(int event_idx, string &input_file,
+                                          string &hydro_file) {
+  input_file = "";
+  if (flag_read_in_multiple_hydro_ == 0) {
+    if (hydro_type_ == 1) {
+      hydro_file =
+          GetXMLElementText({"Hydro", "hydro_from_file", "VISH_file"});
     } else {
-      string folder =
-          GetXMLElementText({"Hydro", "hydro_from_file", "hydro_files_folder"});
-      std::ostringstream hydro_filename;
-      hydro_filename << folder << "/event-" << hydro_event_idx_
-                     << "/JetData.h5";
-      filename = hydro_filename.str();
+      input_file =
+          GetXMLElementText({"Hydro", "hydro_from_file", "MUSIC_input_file"});
+      hydro_file = GetXMLElementText({"Hydro", "hydro_from_file", "MUSIC_file"});
     }
-#ifdef USE_HDF5
-    read_in_hydro_event(filename, 500, load_viscous_);
-#endif
-    hydro_status = FINISHED;
-  } else if (hydro_type_ == 2) {
-    string input_file;
-    string hydro_ideal_file;
-    if (flag_read_in_multiple_hydro_ == 0) {
-      input_file = (para_->FirstChildElement("MUSIC_input_file")->GetText());
-      hydro_ideal_file = (para_->FirstChildElement("MUSIC_file")->GetText());
+  } else {
+    string folder =
+        GetXMLElementText({"Hydro", "hydro_from_file", "hydro_files_folder"});
+    std::ostringstream event_folder;
+    event_folder << folder << "/event-" << event_idx;
+    if (hydro_type_ == 1) {
+      hydro_file = event_folder.str() + "/JetData.h5";
     } else {
-      string folder =
-          (para_->FirstChildElement("hydro_files_folder")->GetText());
-      std::ostringstream input_filename;
-      std::ostringstream hydro_filename;
-      input_filename << folder << "/event-" << hydro_event_idx_
-                     << "/MUSIC_input";
-      hydro_filename << folder << "/event-" << hydro_event_idx_
-                     << "/MUSIC_evo.dat";
-      input_file = input_filename.str();
-      hydro_ideal_file = hydro_filename.str();
+      input_file = event_folder.str() + "/MUSIC_input";
+      hydro_file = event_folder.str() + "/MUSIC_evo.dat";
     }
-    read_in_hydro_event(input_file, hydro_ideal_file, nskip_tau_);
-  } else if (hydro_type_ == 3) {
-    string input_file;
-    string hydro_ideal_file;
-    if (flag_read_in_multiple_hydro_ == 0) {
-      input_file = (para_->FirstChildElement("MUSIC_input_file")->GetText());
-      hydro_ideal_file = (para_->FirstChildElement("MUSIC_file")->GetText());
-    } else {
-      string folder =
-          (para_->FirstChildElement("hydro_files_folder")->GetText());
-      std::ostringstream input_filename;
-      std::ostringstream hydro_filename;
-      input_filename << folder << "/event-" << hydro_event_idx_
-                     << "/MUSIC_input";
-      hydro_filename << folder << "/event-" << hydro_event_idx_
-                     << "/MUSIC_evo.dat";
-      input_file = input_filename.str();
-      hydro_ideal_file = hydro_filename.str();
+  }
+}
+
+std::shared_ptr<HydroFromFileEvent>
+HydroFromFile::take_hydro_event(int event_idx) {
+  string input_file;
+  string hydro_file;
+  get_hydro_event_files(event_idx, input_file, hydro_file);
+
+  if (prefetched_event_.valid()) {
+    auto event = prefetched_event_.get();
+    if (event->file_name == hydro_file) {
+      JSINFO << "use the prefetched hydro event from file " << hydro_file;
+      return event;
     }
-    read_in_hydro_event(input_file, hydro_ideal_file, nskip_tau_);
-  } else if (hydro_type_ == 4) {
-    string input_file;
-    string hydro_ideal_file;
-    if (flag_read_in_multiple_hydro_ == 0) {
-      input_file = (para_->FirstChildElement("MUSIC_input_file")->GetText());
-      hydro_ideal_file = (para_->FirstChildElement("MUSIC_file")->GetText());
-    } else {
-      string folder =
-          (para_->FirstChildElement("hydro_files_folder")->GetText());
-      std::ostringstream input_filename;
-      std::ostringstream hydro_filename;
-      input_filename << folder << "/event-" << hydro_event_idx_
-                     << "/MUSIC_input";
-      hydro_filename << folder << "/event-" << hydro_event_idx_
-                     << "/MUSIC_evo.dat";
-      input_file = input_filename.str();
-      hydro_ideal_file = hydro_filename.str();
+    cache_hydro_event(event);
+  }
+
+  for (auto it = cached_events_.begin(); it != cached_events_.end(); ++it) {
+    if ((*it)->file_name == hydro_file) {
+      auto event = *it;
+      cached_events_.erase(it);
+      JSINFO << "use the cached hydro event from file " << hydro_file;
+      return event;
     }
-    read_in_hydro_event(input_file, hydro_ideal_file, 1);
-  } else {
-    JSWARN << "main: unrecognized hydro_type = " << hydro_type_;
-    exit(1);
+  }
+
+  // type 4 files are always read at every tau step
+  int nskip_tau = (hydro_type_ == 4) ? 1 : nskip_tau_;
+  return load_hydro_event(input_file, hydro_file, 500, load_viscous_,
+                          nskip_tau);
+}
+
+void HydroFromFile::prefetch_hydro_event(int event_idx) {
+  string input_file;
+  string hydro_file;
+  get_hydro_event_files(event_idx, input_file, hydro_file);
+
+  if (current_event_ && current_event_->file_name == hydro_file)
+    return;
+  for (auto &event : cached_events_) {
+    if (event->file_name == hydro_file)
+      return;
+  }
+  // the readers stop the program on a missing file, which is only an
+  // error once the event is asked for
+  struct stat file_status;
+  if (stat(hydro_file.c_str(), &file_status) != 0 ||
+      (!input_file.empty() && stat(input_file.c_str(), &file_status) != 0)) {
+    return;
+  }
+
+  int buffer_size = 500;
+  int load_viscous = load_viscous_;
+  int nskip_tau = (hydro_type_ == 4) ? 1 : nskip_tau_;
+  VERBOSE(2) << "prefetch the hydro event from file " << hydro_file;
+  prefetched_event_ = std::async(std::launch::async, [=]() {
+    return load_hydro_event(input_file, hydro_file, buffer_size, load_viscous,
+                            nskip_tau);
+  });
+}
+
+void HydroFromFile::cache_hydro_event(
+    std::shared_ptr<HydroFromFileEvent> event) {
+  if (n_cached_hydro_events_ < 1)
+    return;
+  for (auto it = cached_events_.begin(); it != cached_events_.end(); ++it) {
+    if ((*it)->file_name == event->file_name) {
+      cached_events_.erase(it);
+      break;
+    }
+  }
+  cached_events_.push_front(event);
+  while (static_cast<int>(cached_events_.size()) > n_cached_hydro_events_) {
+    cached_events_.pop_back();
+  }
+}
+
+void HydroFromFile::EvolveHydro() {
+  if (hydro_status == FINISHED) {
+    clean_hydro_event();
+    hydro_event_idx_ = ini->GetEventId();
+  }
+
+  set_current_event(take_hydro_event(hydro_event_idx_));
+
+  // the initial states from file go through the events one by one
+  if (prefetch_next_hydro_ && flag_read_in_multiple_hydro_ != 0) {
+    prefetch_hydro_event(hydro_event_idx_ + 1);
   }
 }
 
 //! clean up hydro event
 void HydroFromFile::clean_hydro_event() {
   JSINFO << " clean up the loaded hydro event ...";
-  if (hydro_type_ == 1) {
+  if (current_event_) {
+    cache_hydro_event(current_event_);
+    current_event_.reset();
+  }
 #ifdef USE_HDF5
-    hydroinfo_h5_ptr->clean_hydro_event();
+  hydroinfo_h5_ptr = nullptr;
 #endif
-  } else {
-    hydroinfo_MUSIC_ptr->clean_hydro_event();
-  }
+  hydroinfo_MUSIC_ptr = nullptr;
   hydro_status = NOT_START;
 }
 
@@ -221,14 +298,47 @@ void HydroFromFile::GetHydroInfo(
     JSWARN << "Hydro not run yet ...";
     exit(-1);
   }
+  fluid_cell_info_ptr = make_unique<FluidCellInfo>();
+  FillFluidCell(t, x, y, z, *fluid_cell_info_ptr);
+}
 
+void HydroFromFile::GetHydroInfoBatch(int n_points, const Jetscape::real *t,
+                                      const Jetscape::real *x,
+                                      const Jetscape::real *y,
+                                      const Jetscape::real *z,
+                                      unsigned int field_mask,
+                                      Jetscape::real *output) {
+  if (hydro_status != FINISHED) {
+    JSWARN << "Hydro not run yet ...";
+    exit(-1);
+  }
+  EntryName entries[ENTRY_INVALID];
+  int n_entries = 0;
+  for (int i = 0; i < ENTRY_INVALID; i++) {
+    if (field_mask & EntryMask(static_cast<EntryName>(i))) {
+      entries[n_entries++] = static_cast<EntryName>(i);
+    }
+  }
+  FluidCellInfo fluid_cell;
+  for (int i = 0; i < n_points; i++) {
+    FillFluidCell(t[i], x[i], y[i], z[i], fluid_cell);
+    for (int k = 0; k < n_entries; k++) {
+      output[k * n_points + i] = GetEntryValue(fluid_cell, entries[k]);
+    }
+  }
+}
+
+void HydroFromFile::FillFluidCell(Jetscape::real t, Jetscape::real x,
+                                  Jetscape::real y, Jetscape::real z,
+                                  FluidCellInfo &fluid_cell) {
   double t_local = static_cast<double>(t);
   double x_local = static_cast<double>(x);
   double y_local = static_cast<double>(y);
   double z_local = static_cast<double>(z);
 
   // initialize the fluid cell pointer
-  hydrofluidCell *temp_fluid_cell_ptr = new hydrofluidCell;
+  hydrofluidCell temp_fluid_cell = hydrofluidCell();
+  hydrofluidCell *temp_fluid_cell_ptr = &temp_fluid_cell;
   if (hydro_type_ == 1) { // for OSU 2+1d hydro
     double tau_local = sqrt(t * t - z * z);
     double eta_local = 0.5 * log((t + z) / (t - z + 1e-15));
@@ -257,42 +367,36 @@ void HydroFromFile::GetHydroInfo(
 
   // assign all the quantites to JETSCAPE output
   // thermodyanmic quantities
-  fluid_cell_info_ptr = make_unique<FluidCellInfo>();
-  fluid_cell_info_ptr->energy_density =
+  fluid_cell.energy_density =
       (static_cast<Jetscape::real>(temp_fluid_cell_ptr->ed));
-  fluid_cell_info_ptr->entropy_density =
+  fluid_cell.entropy_density =
       (static_cast<Jetscape::real>(temp_fluid_cell_ptr->sd));
-  fluid_cell_info_ptr->temperature =
+  fluid_cell.temperature =
       (static_cast<Jetscape::real>(temp_fluid_cell_ptr->temperature));
-  fluid_cell_info_ptr->pressure =
+  fluid_cell.pressure =
       (static_cast<Jetscape::real>(temp_fluid_cell_ptr->pressure));
   // QGP fraction
   double qgp_fraction_local = 1.0;
   if (temp_fluid_cell_ptr->temperature < T_c_) {
     qgp_fraction_local = 0.0;
   }
-  fluid_cell_info_ptr->qgp_fraction =
-      static_cast<Jetscape::real>(qgp_fraction_local);
+  fluid_cell.qgp_fraction = static_cast<Jetscape::real>(qgp_fraction_local);
   // chemical potentials
-  fluid_cell_info_ptr->mu_B = 0.0;
-  fluid_cell_info_ptr->mu_C = 0.0;
-  fluid_cell_info_ptr->mu_S = 0.0;
+  fluid_cell.mu_B = 0.0;
+  fluid_cell.mu_C = 0.0;
+  fluid_cell.mu_S = 0.0;
   // dynamical quantites
-  fluid_cell_info_ptr->vx =
-      static_cast<Jetscape::real>(temp_fluid_cell_ptr->vx);
-  fluid_cell_info_ptr->vy =
-      static_cast<Jetscape::real>(temp_fluid_cell_ptr->vy);
-  fluid_cell_info_ptr->vz =
-      static_cast<Jetscape::real>(temp_fluid_cell_ptr->vz);
+  fluid_cell.vx = static_cast<Jetscape::real>(temp_fluid_cell_ptr->vx);
+  fluid_cell.vy = static_cast<Jetscape::real>(temp_fluid_cell_ptr->vy);
+  fluid_cell.vz = static_cast<Jetscape::real>(temp_fluid_cell_ptr->vz);
   for (int i = 0; i < 4; i++) {
     for (int j = 0; j < 4; j++) {
-      fluid_cell_info_ptr->pi[i][j] =
+      fluid_cell.pi[i][j] =
           (static_cast<Jetscape::real>(temp_fluid_cell_ptr->pi[i][j]));
     }
   }
-  fluid_cell_info_ptr->bulk_Pi =
+  fluid_cell.bulk_Pi =
       (static_cast<Jetscape::real>(temp_fluid_cell_ptr->bulkPi));
-  delete temp_fluid_cell_ptr;
 }
 
 double HydroFromFile::GetEventPlaneAngle() {
@@ -19,6 +19,9 @@
 #include "FluidDynamics.h"
 #include "Hydroinfo_MUSIC.h"
 
+#include <deque>
+#include <future>
+#include <memory>
 #include <string>
 
 #ifdef USE_HDF5
@@ -27,12 +30,26 @@
 
 using namespace Jetscape;
 
+//! One hydro event read from file, the objects own the evolution data
+struct HydroFromFileEvent {
+  std::string file_name; // evolution file, identifies the event
+#ifdef USE_HDF5
+  std::unique_ptr<HydroinfoH5> h5;
+#endif
+  std::unique_ptr<Hydroinfo_MUSIC> music;
+};
+
 class HydroFromFile : public FluidDynamics {
   // this is wrapper class for MUSIC so that it can be used as a external
   // library for the JETSCAPE integrated framework
+  //
+  // The next hydro event (event-<idx + 1> in the hydro files folder) is
+  // read on a background thread while the current event is in use, if
+  // <prefetch_next_hydro> is set. The last <n_cached_hydro_events> events
+  // are kept in memory, so repeated backgrounds are not read again.
+  // With <mmap_hydro_file> the binary MUSIC evolution files are mapped and
+  // used in place.
 private:
-  tinyxml2::XMLElement *para_;
-
   int flag_read_in_multiple_hydro_;
   int hydro_event_idx_;
 
@@ -42,11 +59,43 @@ private:
   int nskip_tau_;
   double T_c_;
 
+  int prefetch_next_hydro_;
+  int n_cached_hydro_events_;
+  int mmap_hydro_file_;
+
+  // the objects of the current event
 #ifdef USE_HDF5
   HydroinfoH5 *hydroinfo_h5_ptr;
 #endif
   Hydroinfo_MUSIC *hydroinfo_MUSIC_ptr;
 
+  std::shared_ptr<HydroFromFileEvent> current_event_;
+  std::future<std::shared_ptr<HydroFromFileEvent>> prefetched_event_;
+  // recently used events, the most recent first
+  std::deque<std::shared_ptr<HydroFromFileEvent>> cached_events_;
+
+  //! The input and evolution file names of a hydro event
+  void get_hydro_event_files(int event_idx, string &input_file,
+                             string &hydro_file);
+
+  //! Read a hydro event into new objects, can run on any thread
+  std::shared_ptr<HydroFromFileEvent>
+  load_hydro_event(const string &input_file, const string &hydro_file,
+                   int buffer_size, int load_viscous, int nskip_tau) const;
+
+  //! The event from the prefetch or the cache, else read now
+  std::shared_ptr<HydroFromFileEvent> take_hydro_event(int event_idx);
+
+  //! Start reading a hydro event in the background
+  void prefetch_hydro_event(int event_idx);
+
+  void set_current_event(std::shared_ptr<HydroFromFileEvent> event);
+  void cache_hydro_event(std::shared_ptr<HydroFromFileEvent> event);
+
+  //! The fluid cell at a space-time point of the current event
+  void FillFluidCell(Jetscape::real t, Jetscape::real x, Jetscape::real y,
+                     Jetscape::real z, FluidCellInfo &fluid_cell);
+
   // Allows the registration of the module so that it is available to be used by the Jetscape framework.
   static RegisterJetScapeModule<HydroFromFile> reg;
 
@@ -77,6 +126,13 @@ public:
                     Jetscape::real z,
                     std::unique_ptr<FluidCellInfo> &fluid_cell_info_ptr);
 
+  //! The requested fields at many points, without a FluidCellInfo
+  //! allocated per point
+  void GetHydroInfoBatch(int n_points, const Jetscape::real *t,
+                         const Jetscape::real *x, const Jetscape::real *y,
+                         const Jetscape::real *z, unsigned int field_mask,
+                         Jetscape::real *output);
+
   double GetEventPlaneAngle();
   void set_hydro_event_idx(int idx_in) { hydro_event_idx_ = idx_in; };
   int get_hydro_event_idx() { return (hydro_event_idx_); };
@@ -35,6 +35,7 @@ MpiMusic::MpiMusic() {
   freezeout_temperature = 0.0;
   doCooperFrye = 0;
   flag_output_evo_to_file = 0;
+  flag_evolution_storage = 0;
   has_source_terms = false;
   SetId("MUSIC");
   hydro_source_terms_ptr =
@@ -58,6 +59,8 @@ void MpiMusic::InitializeHydro(Parameter parameter_list) {
       GetXMLElementInt({"Hydro", "MUSIC", "output_evolution_to_file"}));
   music_hydro_ptr->set_parameter("output_movie_flag",
                                  static_cast<double>(flag_output_evo_to_file));
+  flag_evolution_storage = (
+      GetXMLElementInt({"Hydro", "MUSIC", "evolution_storage"}, false));
   double tau_hydro = (
           GetXMLElementDouble({"Hydro", "MUSIC", "Initial_time_tau_0"}));
   music_hydro_ptr->set_parameter("Initial_time_tau_0", tau_hydro);
@@ -187,7 +190,8 @@ void MpiMusic::EvolveHydro() {
       // in memory for jet energy loss calculations
       PassHydroEvolutionHistoryToFramework();
       JSINFO << "number of fluid cells received by the JETSCAPE: "
-             << bulk_info.data.size();
+             << bulk_info.get_data_size() << ", memory used: "
+             << bulk_info.GetMemoryFootprint() / 1024 / 1024 << " MB";
     }
     music_hydro_ptr->clear_hydro_info_from_memory();
 
@@ -258,6 +262,20 @@ void MpiMusic::PassHydroEvolutionHistoryToFramework() {
 
   SetHydroGridInfo();
 
+  if (flag_evolution_storage > 0) {
+    // MUSIC does not provide chemical potentials and QGP fraction
+    unsigned int music_fields =
+        (EntryMask(ENTRY_ENERGY_DENSITY) | EntryMask(ENTRY_ENTROPY_DENSITY) |
+         EntryMask(ENTRY_TEMPERATURE) | EntryMask(ENTRY_PRESSURE) |
+         EntryMask(ENTRY_VX) | EntryMask(ENTRY_VY) | EntryMask(ENTRY_VZ) |
+         ENTRY_MASK_SHEAR | EntryMask(ENTRY_BULK_PI));
+    unsigned int half_precision_fields = 0;
+    if (flag_evolution_storage == 2) {
+      half_precision_fields = ENTRY_MASK_SHEAR | EntryMask(ENTRY_BULK_PI);
+    }
+    bulk_info.SetColumnarStorage(music_fields, half_precision_fields);
+  }
+
   fluidCell *fluidCell_ptr = new fluidCell;
   for (int i = 0; i < number_of_cells; i++) {
     std::unique_ptr<FluidCellInfo> fluid_cell_info_ptr(new FluidCellInfo);
@@ -299,6 +317,15 @@ void MpiMusic::GetHydroInfo_JETSCAPE(
   fluid_cell_info_ptr = std::unique_ptr<FluidCellInfo>(new FluidCellInfo(temp));
 }
 
+void MpiMusic::GetHydroInfoBatch(int n_points, const Jetscape::real *t,
+                                 const Jetscape::real *x,
+                                 const Jetscape::real *y,
+                                 const Jetscape::real *z,
+                                 unsigned int field_mask,
+                                 Jetscape::real *output) {
+  bulk_info.get_tz_batch(n_points, t, x, y, z, field_mask, output);
+}
+
 void MpiMusic::GetHydroInfo_MUSIC(
     Jetscape::real t, Jetscape::real x, Jetscape::real y, Jetscape::real z,
     std::unique_ptr<FluidCellInfo> &fluid_cell_info_ptr) {
@@ -74,6 +74,12 @@ public:
 
 //! this is wrapper class for MUSIC so that it can be used as a external
 //! library for the JETSCAPE integrated framework
+//!
+//! MUSIC evolves the whole event in one run_hydro() call and keeps the full
+//! history itself, the time slices are pushed to the framework only after
+//! it. With <Hydro><nEvolutionWindowFrames> > 0 the jets therefore wait for
+//! the whole hydro run instead of overlapping with it, and only the
+//! framework's copy of the history is reduced to the sliding window.
 class MpiMusic : public FluidDynamics {
 private:
   // int mode;            //!< records running mode
@@ -83,6 +89,8 @@ private:
   int doCooperFrye;                     //!< flag to run Cooper-Frye freeze-out
                                         //!< for soft particles
   int flag_output_evo_to_file;
+  int flag_evolution_storage; //!< 0: FluidCellInfo, 1: columnar,
+                              //!< 2: columnar with 16-bit viscous fields
   bool has_source_terms;
   std::shared_ptr<HydroSourceJETSCAPE> hydro_source_terms_ptr;
 
@@ -100,6 +108,10 @@ public:
   void GetHydroInfo(Jetscape::real t, Jetscape::real x, Jetscape::real y,
                     Jetscape::real z,
                     std::unique_ptr<FluidCellInfo> &fluid_cell_info_ptr);
+  void GetHydroInfoBatch(int n_points, const Jetscape::real *t,
+                         const Jetscape::real *x, const Jetscape::real *y,
+                         const Jetscape::real *z, unsigned int field_mask,
+                         Jetscape::real *output);
 
   void
   GetHydroInfo_JETSCAPE(Jetscape::real t, Jetscape::real x, Jetscape::real y,
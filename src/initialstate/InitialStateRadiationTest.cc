@@ -60,12 +60,12 @@ void InitialStateRadiationTest::Exec() {
 
     // create starting and ending node (vertex) for the parton
     // vEnd is one time-step earlier than vStart
-    vEnd = initShower->new_vertex(make_shared<Vertex>(x_init));
-    vStart = initShower->new_vertex(make_shared<Vertex>(x_next));
+    vEnd = initShower->new_vertex(Vertex(x_init));
+    vStart = initShower->new_vertex(Vertex(x_next));
 
     // create a edge that connects the two nodes using the hard parton
     // in the graph structure
-    initShower->new_parton(vStart, vEnd, make_shared<Parton>(p_hard_scat));
+    initShower->new_parton(vStart, vEnd, p_hard_scat);
 
     // push back the edge to the vector of the master graph structure
     pShowerMaster.push_back(initShower);
@@ -148,9 +148,9 @@ void InitialStateRadiationTest::BackwardISR() {
         Parton p_tlike = Parton(0, 21, timeLike_stat, p_new, x_new);
         vEnd = vEndVec[i];
         node vNewChildNode = pShower->new_vertex(
-                              make_shared<Vertex>(0, 0, 0, currentTime + deltaT));
+                              Vertex(0, 0, 0, currentTime + deltaT));
         edgeid = pShower->new_parton(vEnd, vNewChildNode,
-                                     make_shared<Parton>(p_tlike));
+                                     p_tlike);
         JSDEBUG << "time-like vEnd->vNewChildNode:" << vEnd << " " << vNewChildNode
              << " edgeid:" << edgeid;
         n_parton++;
@@ -161,9 +161,9 @@ void InitialStateRadiationTest::BackwardISR() {
         // space-like parton
         Parton p_slike = Parton(0, 21, spaceLike_stat, p_val, x_new);
         vStart = pShower->new_vertex(
-                              make_shared<Vertex>(0, 0, 0, currentTime - deltaT));
+                              Vertex(0, 0, 0, currentTime - deltaT));
         edgeid = pShower->new_parton(vStart, vEnd,
-                                     make_shared<Parton>(p_slike));
+                                     p_slike);
         JSDEBUG << "space-like vStart->vEnd:" << vStart << " " << vEnd
              << " edgeid:" << edgeid;
         pOut.push_back(p_slike);
@@ -292,16 +292,16 @@ void InitialStateRadiationTest::ForwardISR() {
               int edgeid = 0;
               if (pOutModule[k].pstat() == neg_stat) {
                 node vNewRootNode = pShower->new_vertex(
-                                  make_shared<Vertex>(0, 0, 0, currentTime - deltaT));
+                                  Vertex(0, 0, 0, currentTime - deltaT));
                 edgeid = pShower->new_parton(vNewRootNode, vStart,
-                                             make_shared<Parton>(pOutModule[k]));
+                                             pOutModule[k]);
                 JSDEBUG << "negative vNewRootNode->vStart:"
                      << vNewRootNode << " " << vStart << " edgeid:" << edgeid;
               } else {
                 vEnd = pShower->new_vertex(
-                                  make_shared<Vertex>(0, 0, 0, currentTime + deltaT));
+                                  Vertex(0, 0, 0, currentTime + deltaT));
                 edgeid = pShower->new_parton(vStart, vEnd,
-                                             make_shared<Parton>(pOutModule[k]));
+                                             pOutModule[k]);
                 JSDEBUG << "positive vStart->vEnd:"
                      << vStart << " " << vEnd << " edgeid:" << edgeid;
               }
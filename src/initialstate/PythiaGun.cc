@@ -16,6 +16,7 @@
 // Create a pythia collision at a specified point and return the two inital hard partons
 
 #include "PythiaGun.h"
+#include "JetScapeTaskSupport.h"
 #include <sstream>
 
 #define MAGENTA "\033[35m"
@@ -25,7 +26,18 @@ using namespace std;
 // Register the module with the base class
 RegisterJetScapeModule<PythiaGun> PythiaGun::reg("PythiaGun");
 
-PythiaGun::~PythiaGun() { VERBOSE(8); }
+// stream of the counter-based engine giving the seeds of the producer
+static const unsigned int kPythiaSeedStream = 1;
+
+PythiaGun::~PythiaGun() {
+  VERBOSE(8);
+  StopProducer();
+}
+
+void PythiaGun::ReadPythiaSetting(const string &setting) {
+  readString(setting);
+  pythia_settings.push_back(setting);
+}
 
 void PythiaGun::InitTask() {
 
@@ -33,35 +45,35 @@ void PythiaGun::InitTask() {
   VERBOSE(8);
 
   // Show initialization at INFO level
-  readString("Init:showProcesses = off");
-  readString("Init:showChangedSettings = off");
-  readString("Init:showMultipartonInteractions = off");
-  readString("Init:showChangedParticleData = off");
+  ReadPythiaSetting("Init:showProcesses = off");
+  ReadPythiaSetting("Init:showChangedSettings = off");
+  ReadPythiaSetting("Init:showMultipartonInteractions = off");
+  ReadPythiaSetting("Init:showChangedParticleData = off");
   if (JetScapeLogger::Instance()->GetInfo()) {
-    readString("Init:showProcesses = on");
-    readString("Init:showChangedSettings = on");
-    readString("Init:showMultipartonInteractions = on");
-    readString("Init:showChangedParticleData = on");
+    ReadPythiaSetting("Init:showProcesses = on");
+    ReadPythiaSetting("Init:showChangedSettings = on");
+    ReadPythiaSetting("Init:showMultipartonInteractions = on");
+    ReadPythiaSetting("Init:showChangedParticleData = on");
   }
 
   // No event record printout.
-  readString("Next:numberShowInfo = 0");
-  readString("Next:numberShowProcess = 0");
-  readString("Next:numberShowEvent = 0");
+  ReadPythiaSetting("Next:numberShowInfo = 0");
+  ReadPythiaSetting("Next:numberShowProcess = 0");
+  ReadPythiaSetting("Next:numberShowEvent = 0");
 
   // Standard settings
-  readString(
+  ReadPythiaSetting(
       "HardQCD:all = on"); // will repeat this line in the xml for demonstration
   //  readString("HardQCD:gg2ccbar = on"); // switch on heavy quark channel
   //readString("HardQCD:qqbar2ccbar = on");
-  readString("HadronLevel:Decay = off");
-  readString("HadronLevel:all = off");
-  readString("PartonLevel:ISR = on");
-  readString("PartonLevel:MPI = on");
+  ReadPythiaSetting("HadronLevel:Decay = off");
+  ReadPythiaSetting("HadronLevel:all = off");
+  ReadPythiaSetting("PartonLevel:ISR = on");
+  ReadPythiaSetting("PartonLevel:MPI = on");
   //readString("PartonLevel:FSR = on");
-  readString("PromptPhoton:all=on");
-  readString("WeakSingleBoson:all=off");
-  readString("WeakDoubleBoson:all=off");
+  ReadPythiaSetting("PromptPhoton:all=on");
+  ReadPythiaSetting("WeakSingleBoson:all=off");
+  ReadPythiaSetting("WeakDoubleBoson:all=off");
 
   // For parsing text
   stringstream numbf(stringstream::app | stringstream::in | stringstream::out);
@@ -77,14 +89,16 @@ void PythiaGun::InitTask() {
   // SC: read flag for FSR
   FSR_on = GetXMLElementInt({"Hard", "PythiaGun", "FSR_on"});
   if (FSR_on)
-    readString("PartonLevel:FSR = on");
+    ReadPythiaSetting("PartonLevel:FSR = on");
   else
-    readString("PartonLevel:FSR = off");
+    ReadPythiaSetting("PartonLevel:FSR = off");
 
   pTHatMin = GetXMLElementDouble({"Hard", "PythiaGun", "pTHatMin"});
   pTHatMax = GetXMLElementDouble({"Hard", "PythiaGun", "pTHatMax"});
 
   flag_useHybridHad = GetXMLElementInt({"Hard", "PGun", "useHybridHad"});
+  //Reading vir_factor from xml for MATTER
+  vir_factor = GetXMLElementDouble({"Eloss", "Matter", "vir_factor"});
 
   JSINFO << MAGENTA << "Pythia Gun with FSR_on: " << FSR_on;
   JSINFO << MAGENTA << "Pythia Gun with " << pTHatMin << " < pTHat < "
@@ -93,15 +107,15 @@ void PythiaGun::InitTask() {
 
   numbf.str("PhaseSpace:pTHatMin = ");
   numbf << pTHatMin;
-  readString(numbf.str());
+  ReadPythiaSetting(numbf.str());
   numbf.str("PhaseSpace:pTHatMax = ");
   numbf << pTHatMax;
-  readString(numbf.str());
+  ReadPythiaSetting(numbf.str());
 
   // random seed
   // xml limits us to unsigned int :-/ -- but so does 32 bits Mersenne Twist
   tinyxml2::XMLElement *RandomXmlDescription = GetXMLElement({"Random"});
-  readString("Random:setSeed = on");
+  ReadPythiaSetting("Random:setSeed = on");
   numbi.str("Random:seed = ");
   unsigned int seed = 0;
   if (RandomXmlDescription) {
@@ -115,17 +129,17 @@ void PythiaGun::InitTask() {
   }
   VERBOSE(7) << "Seeding pythia to " << seed;
   numbi << seed;
-  readString(numbi.str());
+  ReadPythiaSetting(numbi.str());
 
   // Species
-  readString("Beams:idA = 2212");
-  readString("Beams:idB = 2212");
+  ReadPythiaSetting("Beams:idA = 2212");
+  ReadPythiaSetting("Beams:idB = 2212");
 
   // Energy
   eCM = GetXMLElementDouble({"Hard", "PythiaGun", "eCM"});
   numbf.str("Beams:eCM = ");
   numbf << eCM;
-  readString(numbf.str());
+  ReadPythiaSetting(numbf.str());
 
   std::stringstream lines;
   lines << GetXMLElementText({"Hard", "PythiaGun", "LinesToRead"}, false);
@@ -134,24 +148,37 @@ void PythiaGun::InitTask() {
     if (s.find_first_not_of(" \t\v\f\r") == s.npos)
       continue; // skip empty lines
     VERBOSE(7) << "Also reading in: " << s;
-    readString(s);
+    ReadPythiaSetting(s);
   }
 
-  // And initialize
-  if (!init()) { // Pythia>8.1
-    throw std::runtime_error("Pythia init() failed.");
+  n_pregenerated_events = std::max(
+      0, GetXMLElementInt({"Hard", "PythiaGun", "nPregeneratedEvents"}, false));
+  if (n_pregenerated_events == 0) {
+    // And initialize
+    if (!init()) { // Pythia>8.1
+      throw std::runtime_error("Pythia init() failed.");
+    }
+    return;
   }
 
+  // only the producer's Pythia generates events
+  JSINFO << MAGENTA << "Pythia Gun generates up to " << n_pregenerated_events
+         << " hard scatterings ahead";
+  producer_pythia.reset(new Pythia8::Pythia(xml_dir, false));
+  for (const auto &setting : pythia_settings) {
+    producer_pythia->readString(setting);
+  }
+  if (!producer_pythia->init()) {
+    throw std::runtime_error("Pythia init() failed.");
+  }
+  producer = std::thread(&PythiaGun::ProduceHardScatterings, this,
+                         GetCurrentEvent());
 }
 
-void PythiaGun::Exec() {
-  VERBOSE(1) << "Run Hard Process : " << GetId() << " ...";
-  VERBOSE(8) << "Current Event #" << GetCurrentEvent();
-  //Reading vir_factor from xml for MATTER
-  double vir_factor = GetXMLElementDouble({"Eloss", "Matter", "vir_factor"});
-
+void PythiaGun::GenerateHardScattering(Pythia8::Pythia &generator,
+                                       HardScattering &scattering) {
   bool flag62 = false;
-  vector<Pythia8::Particle> p62;
+  vector<Pythia8::Particle> &p62 = scattering.partons;
 
   // sort by pt
   struct greater_than_pt {
@@ -162,12 +189,13 @@ void PythiaGun::Exec() {
   };
 
   do {
-    next();
+    generator.next();
     p62.clear();
 
     // pTarr[0]=0.0; pTarr[1]=0.0;
     // pindexarr[0]=0; pindexarr[1]=0;
 
+    Pythia8::Event &event = generator.event;
     for (int parid = 0; parid < event.size(); parid++) {
       if (parid < 3)
         continue; // 0, 1, 2: total event and beams
@@ -217,6 +245,80 @@ void PythiaGun::Exec() {
 
   } while (!flag62);
 
+  scattering.sigma_gen = generator.info.sigmaGen();
+  scattering.sigma_err = generator.info.sigmaErr();
+  scattering.weight = generator.info.weight();
+}
+
+void PythiaGun::ProduceHardScatterings(int first_event) {
+  try {
+    for (int event_index = first_event;; event_index++) {
+      HardScattering scattering;
+      scattering.event_index = event_index;
+      // the seed depends on the event only, not on how far ahead we are
+      auto seeder = JetScapeTaskSupport::GetPhiloxEngine(
+          GetMyTaskNumber(), event_index, kPythiaSeedStream);
+      producer_pythia->rndm.init(1 + seeder() % 900000000);
+      GenerateHardScattering(*producer_pythia, scattering);
+
+      std::unique_lock<std::mutex> lock(queue_mutex);
+      queue_changed.wait(lock, [this]() {
+        return (stop_producer || static_cast<int>(hard_scatterings.size()) <
+                                     n_pregenerated_events);
+      });
+      if (stop_producer)
+        return;
+      hard_scatterings.push_back(std::move(scattering));
+      queue_changed.notify_all();
+    }
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    producer_error = std::current_exception();
+    queue_changed.notify_all();
+  }
+}
+
+void PythiaGun::StopProducer() {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    stop_producer = true;
+    queue_changed.notify_all();
+  }
+  if (producer.joinable())
+    producer.join();
+}
+
+const Pythia8::Info &PythiaGun::GetGeneratorInfo() {
+  if (!producer_pythia)
+    return info;
+  StopProducer();
+  return producer_pythia->info;
+}
+
+void PythiaGun::Exec() {
+  VERBOSE(1) << "Run Hard Process : " << GetId() << " ...";
+  VERBOSE(8) << "Current Event #" << GetCurrentEvent();
+  if (n_pregenerated_events > 0) {
+    // take the next hard scattering of the producer thread
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    queue_changed.wait(lock, [this]() {
+      return (!hard_scatterings.empty() || producer_error);
+    });
+    if (hard_scatterings.empty())
+      std::rethrow_exception(producer_error);
+    current_scattering = std::move(hard_scatterings.front());
+    hard_scatterings.pop_front();
+    queue_changed.notify_all();
+    if (current_scattering.event_index != GetCurrentEvent()) {
+      JSWARN << "Pre-generated hard scattering of event "
+             << current_scattering.event_index << " used for event "
+             << GetCurrentEvent();
+    }
+  } else {
+    GenerateHardScattering(*this, current_scattering);
+  }
+  vector<Pythia8::Particle> &p62 = current_scattering.partons;
+
   double p[4], xLoc[4];
 
   // This location should come from an initial state
@@ -22,6 +22,13 @@
 #include "JetScapeLogger.h"
 #include "Pythia8/Pythia.h"
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 using namespace Jetscape;
 
 class PythiaGun : public HardProcess, public Pythia8::Pythia {
@@ -32,6 +39,44 @@ private:
   double eCM;
   bool FSR_on;
   int flag_useHybridHad;
+  double vir_factor;
+
+  // one accepted hard scattering: the partons sorted by pT, and the
+  // cross section information of the generator when it was accepted
+  struct HardScattering {
+    int event_index = 0;
+    vector<Pythia8::Particle> partons;
+    double sigma_gen = 0.0;
+    double sigma_err = 0.0;
+    double weight = 1.0;
+  };
+  HardScattering current_scattering;
+
+  // With <Hard><PythiaGun><nPregeneratedEvents> > 0 the hard scatterings
+  // are generated ahead by a producer thread owning its own Pythia, which
+  // is reseeded from the event index so that the results do not depend on
+  // the timing of the threads.
+  int n_pregenerated_events;
+  string xml_dir;
+  vector<string> pythia_settings; //!< replayed on the producer's Pythia
+  std::unique_ptr<Pythia8::Pythia> producer_pythia;
+  std::thread producer;
+  std::mutex queue_mutex;
+  std::condition_variable queue_changed;
+  std::deque<HardScattering> hard_scatterings;
+  bool stop_producer;
+  std::exception_ptr producer_error;
+
+  // readString() remembering the setting for the producer's Pythia
+  void ReadPythiaSetting(const string &setting);
+
+  // run the generator until at least two partons are accepted
+  void GenerateHardScattering(Pythia8::Pythia &generator,
+                              HardScattering &scattering);
+
+  // body of the producer thread, from event first_event on
+  void ProduceHardScatterings(int first_event);
+  void StopProducer();
 
   // Allows the registration of the module so that it is available to be used by the Jetscape framework.
   static RegisterJetScapeModule<PythiaGun> reg;
@@ -44,6 +89,9 @@ public:
   PythiaGun(string xmlDir = "DONTUSETHIS", bool printBanner = false)
       : Pythia8::Pythia(xmlDir, printBanner), HardProcess() {
     SetId("UninitializedPythiaGun");
+    xml_dir = xmlDir;
+    n_pregenerated_events = 0;
+    stop_producer = false;
   }
 
   ~PythiaGun();
@@ -55,10 +103,18 @@ public:
   double GetpTHatMin() const { return pTHatMin; }
   double GetpTHatMax() const { return pTHatMax; }
 
-  // Cross-section information in mb and event weight.
-  double GetSigmaGen() { return info.sigmaGen(); };
-  double GetSigmaErr() { return info.sigmaErr(); };
-  double GetEventWeight() { return info.weight(); };
+  // Cross-section information in mb and event weight, as given by the
+  // generator of the current hard scattering.
+  double GetSigmaGen() { return current_scattering.sigma_gen; };
+  double GetSigmaErr() { return current_scattering.sigma_err; };
+  double GetEventWeight() { return current_scattering.weight; };
+
+  /** @return Statistics of the generator, like sigmaGen() and nAccepted().
+      With <nPregeneratedEvents> > 0 it is the producer's Pythia, which is
+      stopped first, so call it after the run; its counts include the hard
+      scatterings generated ahead and not used.
+   */
+  const Pythia8::Info &GetGeneratorInfo();
 };
 
 #endif // PYTHIAGUN_H
@@ -57,21 +57,26 @@ double LBT::RHQ11[60][20] = {{0.0}};  //Qq->Qq
 double LBT::RHQ12[60][20] = {{0.0}};  //Qg->Qg
 double LBT::qhatHQ[60][20] = {{0.0}}; //qhat of heavy quark
 
-double LBT::dNg_over_dt_c[t_gn + 2][temp_gn + 1][HQener_gn + 1] = {{{0.0}}};
-double LBT::dNg_over_dt_q[t_gn + 2][temp_gn + 1][HQener_gn + 1] = {{{0.0}}};
-double LBT::dNg_over_dt_g[t_gn + 2][temp_gn + 1][HQener_gn + 1] = {{{0.0}}};
-double LBT::max_dNgfnc_c[t_gn + 2][temp_gn + 1][HQener_gn + 1] = {{{0.0}}};
-double LBT::max_dNgfnc_q[t_gn + 2][temp_gn + 1][HQener_gn + 1] = {{{0.0}}};
-double LBT::max_dNgfnc_g[t_gn + 2][temp_gn + 1][HQener_gn + 1] = {{{0.0}}};
+const double (*LBT::dNg_over_dt_c)[temp_gn + 1][HQener_gn + 1] = nullptr;
+const double (*LBT::dNg_over_dt_q)[temp_gn + 1][HQener_gn + 1] = nullptr;
+const double (*LBT::dNg_over_dt_g)[temp_gn + 1][HQener_gn + 1] = nullptr;
+const double (*LBT::max_dNgfnc_c)[temp_gn + 1][HQener_gn + 1] = nullptr;
+const double (*LBT::max_dNgfnc_q)[temp_gn + 1][HQener_gn + 1] = nullptr;
+const double (*LBT::max_dNgfnc_g)[temp_gn + 1][HQener_gn + 1] = nullptr;
+std::shared_ptr<const CachedTable> LBT::dNgTable_c;
+std::shared_ptr<const CachedTable> LBT::dNgTable_q;
+std::shared_ptr<const CachedTable> LBT::dNgTable_g;
 
 double LBT::initMCX[maxMC] = {0.0};
 double LBT::initMCY[maxMC] = {0.0};
-double LBT::distFncB[N_T][N_p1][N_e2] = {{{0.0}}};
-double LBT::distFncF[N_T][N_p1][N_e2] = {{{0.0}}};
-double LBT::distMaxB[N_T][N_p1][N_e2] = {{{0.0}}};
-double LBT::distMaxF[N_T][N_p1][N_e2] = {{{0.0}}};
-double LBT::distFncBM[N_T][N_p1] = {{0.0}};
-double LBT::distFncFM[N_T][N_p1] = {{0.0}};
+const double (*LBT::distFncB)[N_p1][N_e2] = nullptr;
+const double (*LBT::distFncF)[N_p1][N_e2] = nullptr;
+const double (*LBT::distMaxB)[N_p1][N_e2] = nullptr;
+const double (*LBT::distMaxF)[N_p1][N_e2] = nullptr;
+const double (*LBT::distFncBM)[N_p1] = nullptr;
+const double (*LBT::distFncFM)[N_p1] = nullptr;
+std::shared_ptr<const CachedTable> LBT::distTableB;
+std::shared_ptr<const CachedTable> LBT::distTableF;
 
 LBT::LBT() {
   SetId("LBT");
@@ -1408,6 +1413,67 @@ void LBT::LBT0(int &n, double &ti) {
 //
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+std::shared_ptr<const CachedTable>
+LBT::read_radiation_table(const std::string &file_name) {
+  // dNg_over_dt[t_gn + 2][temp_gn + 1][HQener_gn + 1], then max_dNgfnc.
+  // The first two time steps, the first temperature and the first energy
+  // are left at 0.
+  auto parser = [](std::istream &file, std::vector<double> &values) {
+    const int n_values = (t_gn + 2) * (temp_gn + 1) * (HQener_gn + 1);
+    values.assign(2 * n_values, 0.0);
+    for (int k = 1; k <= t_gn; k++) {
+      std::string dummyString;
+      file >> dummyString >> dummyString >> dummyString >> dummyString;
+      for (int i = 1; i <= temp_gn; i++) {
+        for (int j = 1; j <= HQener_gn; j++) {
+          int index = ((k + 1) * (temp_gn + 1) + i) * (HQener_gn + 1) + j;
+          file >> values[index] >> values[n_values + index];
+        }
+      }
+    }
+    return (!file.fail());
+  };
+  return (CachedTable::Load(file_name, parser));
+}
+
+std::shared_ptr<const CachedTable>
+LBT::read_dist_table(const std::string &name) {
+  // blocks [N_T][N_p1] of the maxima, then [N_T][N_p1][N_e2] of the
+  // distributions and of their maxima
+  auto parser = [this, &name](std::istream &file,
+                              std::vector<double> &values) {
+    values.assign(N_T * N_p1 * (1 + 2 * N_e2), 0.0);
+    double *fncM = &values[0];
+    double *fnc = &values[N_T * N_p1];
+    double *max = &values[N_T * N_p1 * (1 + N_e2)];
+    for (int i = 0; i < N_T; i++) {
+      for (int j = 0; j < N_p1; j++) {
+        double dummy_T, dummy_p1;
+        file >> dummy_T >> dummy_p1;
+        if (fabs(min_T + (0.5 + i) * bin_T - dummy_T) > 1.0e-5 ||
+            fabs(min_p1 + (0.5 + j) * bin_p1 - dummy_p1) > 1.0e-5) {
+          cout << "Erro in reading data file " << name << "!" << endl;
+          exit(EXIT_FAILURE);
+        }
+        file >> fncM[i * N_p1 + j];
+        for (int k = 0; k < N_e2; k++)
+          file >> fnc[(i * N_p1 + j) * N_e2 + k];
+        for (int k = 0; k < N_e2; k++)
+          file >> max[(i * N_p1 + j) * N_e2 + k];
+      }
+    }
+    return (!file.fail());
+  };
+
+  auto table = CachedTable::Load("LBT-tables/" + name, parser);
+  if (!table) {
+    cout << "Erro openning data file " << name << "!" << endl;
+    table = CachedTable::FromValues(
+        std::vector<double>(N_T * N_p1 * (1 + 2 * N_e2), 0.0));
+  }
+  return (table);
+}
+
 void LBT::read_tables() { // intialize various tables for LBT
 
   //     if(bulkFlag==1) { // read in OSU hydro profiles
@@ -1459,98 +1525,45 @@ void LBT::read_tables() { // intialize various tables for LBT
 
   // read radiation table for heavy quark
   if (KINT0 != 0) {
-    ifstream f12("LBT-tables/dNg_over_dt_cD6.dat");
-    ifstream f13("LBT-tables/dNg_over_dt_qD6.dat");
-    ifstream f14("LBT-tables/dNg_over_dt_gD6.dat");
-    if (!f12.is_open() || !f13.is_open() || !f14.is_open()) {
+    dNgTable_c = read_radiation_table("LBT-tables/dNg_over_dt_cD6.dat");
+    dNgTable_q = read_radiation_table("LBT-tables/dNg_over_dt_qD6.dat");
+    dNgTable_g = read_radiation_table("LBT-tables/dNg_over_dt_gD6.dat");
+    if (!dNgTable_c || !dNgTable_q || !dNgTable_g) {
       cout << "Erro openning HQ radiation table file!\n";
-    } else {
-      for (int k = 1; k <= t_gn; k++) {
-        char dummyChar[100];
-        long double dummyD;
-        f12 >> dummyChar >> dummyChar >> dummyChar >> dummyChar;
-        f13 >> dummyChar >> dummyChar >> dummyChar >> dummyChar;
-        f14 >> dummyChar >> dummyChar >> dummyChar >> dummyChar;
-        for (int i = 1; i <= temp_gn; i++) {
-          dNg_over_dt_c[k + 1][i][0] = 0.0;
-          dNg_over_dt_q[k + 1][i][0] = 0.0;
-          dNg_over_dt_g[k + 1][i][0] = 0.0;
-          max_dNgfnc_c[k + 1][i][0] = 0.0;
-          max_dNgfnc_q[k + 1][i][0] = 0.0;
-          max_dNgfnc_g[k + 1][i][0] = 0.0;
-          for (int j = 1; j <= HQener_gn; j++) {
-            f12 >> dNg_over_dt_c[k + 1][i][j] >> max_dNgfnc_c[k + 1][i][j];
-            f13 >> dNg_over_dt_q[k + 1][i][j] >> max_dNgfnc_q[k + 1][i][j];
-            f14 >> dNg_over_dt_g[k + 1][i][j] >> max_dNgfnc_g[k + 1][i][j];
-          }
-        }
-      }
-    }
-    //     cout << dNg_over_dt_c[t_gn+1][temp_gn][HQener_gn] << "    " << max_dNgfnc_c[t_gn+1][temp_gn][HQener_gn] << endl;
-    //     cout << dNg_over_dt_q[t_gn+1][temp_gn][HQener_gn] << "    " << max_dNgfnc_q[t_gn+1][temp_gn][HQener_gn] << endl;
-    //     cout << dNg_over_dt_g[t_gn+1][temp_gn][HQener_gn] << "    " << max_dNgfnc_g[t_gn+1][temp_gn][HQener_gn] << endl;
-    f12.close();
-    f13.close();
-    f14.close();
-
-    for (int i = 1; i <= temp_gn; i++) {
-      for (int j = 1; j <= HQener_gn; j++) {
-        dNg_over_dt_c[1][i][j] = 0.0;
-        dNg_over_dt_q[1][i][j] = 0.0;
-        dNg_over_dt_g[1][i][j] = 0.0;
-        max_dNgfnc_c[1][i][j] = 0.0;
-        max_dNgfnc_q[1][i][j] = 0.0;
-        max_dNgfnc_g[1][i][j] = 0.0;
-      }
+      auto zeros = CachedTable::FromValues(std::vector<double>(
+          2 * (t_gn + 2) * (temp_gn + 1) * (HQener_gn + 1), 0.0));
+      dNgTable_c = dNgTable_c ? dNgTable_c : zeros;
+      dNgTable_q = dNgTable_q ? dNgTable_q : zeros;
+      dNgTable_g = dNgTable_g ? dNgTable_g : zeros;
     }
-  }
 
-  // preparation for HQ 2->2
-  ifstream fileB("LBT-tables/distB.dat");
-  if (!fileB.is_open()) {
-    cout << "Erro openning data file distB.dat!" << endl;
-  } else {
-    for (int i = 0; i < N_T; i++) {
-      for (int j = 0; j < N_p1; j++) {
-        double dummy_T, dummy_p1;
-        fileB >> dummy_T >> dummy_p1;
-        if (fabs(min_T + (0.5 + i) * bin_T - dummy_T) > 1.0e-5 ||
-            fabs(min_p1 + (0.5 + j) * bin_p1 - dummy_p1) > 1.0e-5) {
-          cout << "Erro in reading data file distB.dat!" << endl;
-          exit(EXIT_FAILURE);
-        }
-        fileB >> distFncBM[i][j];
-        for (int k = 0; k < N_e2; k++)
-          fileB >> distFncB[i][j][k];
-        for (int k = 0; k < N_e2; k++)
-          fileB >> distMaxB[i][j][k];
-      }
-    }
+    typedef const double(*RadiationTable)[temp_gn + 1][HQener_gn + 1];
+    const int n_values = (t_gn + 2) * (temp_gn + 1) * (HQener_gn + 1);
+    dNg_over_dt_c = reinterpret_cast<RadiationTable>(dNgTable_c->data());
+    dNg_over_dt_q = reinterpret_cast<RadiationTable>(dNgTable_q->data());
+    dNg_over_dt_g = reinterpret_cast<RadiationTable>(dNgTable_g->data());
+    max_dNgfnc_c =
+        reinterpret_cast<RadiationTable>(dNgTable_c->data() + n_values);
+    max_dNgfnc_q =
+        reinterpret_cast<RadiationTable>(dNgTable_q->data() + n_values);
+    max_dNgfnc_g =
+        reinterpret_cast<RadiationTable>(dNgTable_g->data() + n_values);
   }
-  fileB.close();
 
-  ifstream fileF("LBT-tables/distF.dat");
-  if (!fileF.is_open()) {
-    cout << "Erro openning data file distF.dat!" << endl;
-  } else {
-    for (int i = 0; i < N_T; i++) {
-      for (int j = 0; j < N_p1; j++) {
-        double dummy_T, dummy_p1;
-        fileF >> dummy_T >> dummy_p1;
-        if (fabs(min_T + (0.5 + i) * bin_T - dummy_T) > 1.0e-5 ||
-            fabs(min_p1 + (0.5 + j) * bin_p1 - dummy_p1) > 1.0e-5) {
-          cout << "Erro in reading data file distF.dat!" << endl;
-          exit(EXIT_FAILURE);
-        }
-        fileF >> distFncFM[i][j];
-        for (int k = 0; k < N_e2; k++)
-          fileF >> distFncF[i][j][k];
-        for (int k = 0; k < N_e2; k++)
-          fileF >> distMaxF[i][j][k];
-      }
-    }
-  }
-  fileF.close();
+  // preparation for HQ 2->2
+  distTableB = read_dist_table("distB.dat");
+  distFncBM = reinterpret_cast<const double(*)[N_p1]>(distTableB->data());
+  distFncB = reinterpret_cast<const double(*)[N_p1][N_e2]>(
+      distTableB->data() + N_T * N_p1);
+  distMaxB = reinterpret_cast<const double(*)[N_p1][N_e2]>(
+      distTableB->data() + N_T * N_p1 * (1 + N_e2));
+
+  distTableF = read_dist_table("distF.dat");
+  distFncFM = reinterpret_cast<const double(*)[N_p1]>(distTableF->data());
+  distFncF = reinterpret_cast<const double(*)[N_p1][N_e2]>(
+      distTableF->data() + N_T * N_p1);
+  distMaxF = reinterpret_cast<const double(*)[N_p1][N_e2]>(
+      distTableF->data() + N_T * N_p1 * (1 + N_e2));
 
   cout << "Initialization completed for LBT." << endl;
 }
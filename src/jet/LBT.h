@@ -16,6 +16,7 @@
 #ifndef LBT_H
 #define LBT_H
 
+#include "CachedTable.h"
 #include "JetEnergyLossModule.h"
 #include <iostream>
 #include <string>
@@ -175,12 +176,18 @@ private:
   static const int t_gn = 75;
   static const int temp_gn = 100;
 
-  static double dNg_over_dt_c[t_gn + 2][temp_gn + 1][HQener_gn + 1];
-  static double dNg_over_dt_q[t_gn + 2][temp_gn + 1][HQener_gn + 1];
-  static double dNg_over_dt_g[t_gn + 2][temp_gn + 1][HQener_gn + 1];
-  static double max_dNgfnc_c[t_gn + 2][temp_gn + 1][HQener_gn + 1];
-  static double max_dNgfnc_q[t_gn + 2][temp_gn + 1][HQener_gn + 1];
-  static double max_dNgfnc_g[t_gn + 2][temp_gn + 1][HQener_gn + 1];
+  // [t_gn + 2][temp_gn + 1][HQener_gn + 1], pointing into the tables of
+  // dNg_over_dt_*D6.dat
+  static const double (*dNg_over_dt_c)[temp_gn + 1][HQener_gn + 1];
+  static const double (*dNg_over_dt_q)[temp_gn + 1][HQener_gn + 1];
+  static const double (*dNg_over_dt_g)[temp_gn + 1][HQener_gn + 1];
+  static const double (*max_dNgfnc_c)[temp_gn + 1][HQener_gn + 1];
+  static const double (*max_dNgfnc_q)[temp_gn + 1][HQener_gn + 1];
+  static const double (*max_dNgfnc_g)[temp_gn + 1][HQener_gn + 1];
+  static std::shared_ptr<const CachedTable> dNgTable_c, dNgTable_q,
+      dNgTable_g;
+  std::shared_ptr<const CachedTable>
+  read_radiation_table(const std::string &file_name);
 
   const double HQener_max = 1000.0;
   const double t_max = 15.0;
@@ -299,9 +306,12 @@ private:
   static const int N_p1 = 500;
   static const int N_T = 60;
   static const int N_e2 = 75;
-  static double distFncB[N_T][N_p1][N_e2], distFncF[N_T][N_p1][N_e2],
-      distMaxB[N_T][N_p1][N_e2], distMaxF[N_T][N_p1][N_e2];
-  static double distFncBM[N_T][N_p1], distFncFM[N_T][N_p1];
+  // point into the tables of distB.dat and distF.dat
+  static const double (*distFncB)[N_p1][N_e2], (*distFncF)[N_p1][N_e2],
+      (*distMaxB)[N_p1][N_e2], (*distMaxF)[N_p1][N_e2];
+  static const double (*distFncBM)[N_p1], (*distFncFM)[N_p1];
+  static std::shared_ptr<const CachedTable> distTableB, distTableF;
+  std::shared_ptr<const CachedTable> read_dist_table(const std::string &name);
   double min_p1 = 0.0;
   double max_p1 = 1000.0;
   double bin_p1 = (max_p1 - min_p1) / N_p1;
@@ -38,16 +38,19 @@ using std::ostream;
 using std::ios;
 
 int Martini::pLabelNew = 0;
+std::map<string, std::weak_ptr<const Martini::RateTables>>
+    Martini::loadedTables;
+std::mutex Martini::loadedTablesMutex;
 
 Martini::Martini() {
   SetId("Martini");
   VERBOSE(8);
 
-  //vectors for elastic rates:
-  dGamma_qq = new vector<double>;
-  dGamma_qg = new vector<double>;
-  dGamma_qq_q = new vector<double>;
-  dGamma_qg_q = new vector<double>;
+  //vectors for elastic rates, set in Init():
+  dGamma_qq = nullptr;
+  dGamma_qg = nullptr;
+  dGamma_qq_q = nullptr;
+  dGamma_qg_q = nullptr;
 
   // create and set Martini Mutex
   auto martini_mutex = make_shared<MartiniMutex>();
@@ -92,9 +95,31 @@ void Martini::Init() {
   // Initialize random number distribution
   ZeroOneDistribution = uniform_real_distribution<double>{0.0, 1.0};
 
-  readRadiativeRate(&dat, &Gam);
-  readElasticRateOmega();
-  readElasticRateQ();
+  tables = loadRateTables();
+  dGamma_qq = tables->dGamma_qq.get();
+  dGamma_qg = tables->dGamma_qg.get();
+  dGamma_qq_q = tables->dGamma_qq_q.get();
+  dGamma_qg_q = tables->dGamma_qg_q.get();
+}
+
+std::shared_ptr<const Martini::RateTables> Martini::loadRateTables() {
+  std::lock_guard<std::mutex> lock(loadedTablesMutex);
+  auto loaded = loadedTables[PathToTables].lock();
+  if (loaded) {
+    JSINFO << "Using the Martini rate tables already read from "
+           << PathToTables;
+    return loaded;
+  }
+
+  // about 6 MB, kept on the heap
+  auto newTables = std::make_shared<RateTables>();
+  readRadiativeRate(&newTables->dat, &newTables->Gam);
+  readElasticRateOmega(newTables->dGamma_qq, newTables->dGamma_qg);
+  readElasticRateQ(newTables->dGamma_qq_q, newTables->dGamma_qg_q);
+
+  std::shared_ptr<const RateTables> result = newTables;
+  loadedTables[PathToTables] = result;
+  return result;
 }
 
 void Martini::DoEnergyLoss(double deltaT, double Time, double Q2,
@@ -2771,12 +2796,22 @@ void Martini::readRadiativeRate(Gamma_info *dat, dGammas *Gam) {
   dat->k_max = 2 * dat->dp * (dat->n_k - 1) + dat->k_min;
 }
 
-void Martini::readElasticRateOmega() {
-  ifstream fin;
-  string filename[2];
+// the last column of a table of elastic rates, the others being the grid
+static bool parseElasticRate(std::istream &fin, int n_columns,
+                             std::vector<double> &values) {
+  double column, dGamma;
+  while (!fin.eof()) {
+    for (int i = 0; i < n_columns - 1; i++)
+      fin >> column;
+    fin >> dGamma;
+    values.push_back(dGamma);
+  }
+  return (!values.empty());
+}
 
-  double as, omega;
-  double dGamma;
+void Martini::readElasticRateOmega(std::shared_ptr<const CachedTable> &qq,
+                                   std::shared_ptr<const CachedTable> &qg) {
+  string filename[2];
 
   // open files with data to read in:
   filename[0] = PathToTables + "/logEnDtrqq";
@@ -2786,52 +2821,32 @@ void Martini::readElasticRateOmega() {
   JSINFO << filename[0];
   JSINFO << filename[1] << " ...";
 
-  fin.open(filename[0].c_str(), ios::in);
-  if (!fin) {
+  // columns: alpha_s, omega, dGamma
+  auto parser = [](std::istream &fin, std::vector<double> &values) {
+    return (parseElasticRate(fin, 3, values));
+  };
+
+  qq = CachedTable::Load(filename[0], parser);
+  if (!qq) {
     JSWARN << "[readElasticRateOmega]: ERROR: Unable to open file "
            << filename[0];
     throw std::runtime_error(
         "[readElasticRateQ]: ERROR: Unable to open ElasticRateOmega file");
   }
 
-  int ik = 0;
-  while (!fin.eof()) {
-    fin >> as;
-    fin >> omega;
-    fin >> dGamma;
-    dGamma_qq->push_back(dGamma);
-
-    ik++;
-  }
-  fin.close();
-
-  fin.open(filename[1].c_str(), ios::in);
-  if (!fin) {
+  qg = CachedTable::Load(filename[1], parser);
+  if (!qg) {
     JSWARN << "[readElasticRateOmega]: ERROR: Unable to open file "
            << filename[1];
     throw std::runtime_error(
         "[readElasticRateQ]: ERROR: Unable to open ElasticRateOmega file");
   }
-
-  ik = 0;
-  while (!fin.eof()) {
-    fin >> as;
-    fin >> omega;
-    fin >> dGamma;
-    dGamma_qg->push_back(dGamma);
-
-    ik++;
-  }
-  fin.close();
 }
 
-void Martini::readElasticRateQ() {
-  ifstream fin;
+void Martini::readElasticRateQ(std::shared_ptr<const CachedTable> &qq,
+                               std::shared_ptr<const CachedTable> &qg) {
   string filename[2];
 
-  double as, omega, q;
-  double dGamma;
-
   // open files with data to read in:
   filename[0] = PathToTables + "/logEnDqtrqq";
   filename[1] = PathToTables + "/logEnDqtrqg";
@@ -2840,69 +2855,50 @@ void Martini::readElasticRateQ() {
   JSINFO << filename[0];
   JSINFO << filename[1] << " ...";
 
-  fin.open(filename[0].c_str(), ios::in);
-  if (!fin) {
+  // columns: alpha_s, omega, q, dGamma
+  auto parser = [](std::istream &fin, std::vector<double> &values) {
+    return (parseElasticRate(fin, 4, values));
+  };
+
+  qq = CachedTable::Load(filename[0], parser);
+  if (!qq) {
     JSWARN << "[readElasticRateQ]: ERROR: Unable to open file " << filename[0];
     throw std::runtime_error(
         "[readElasticRateQ]: ERROR: Unable to open ElasticRateQ file");
   }
 
-  int ik = 0;
-  while (!fin.eof()) {
-    fin >> as;
-    fin >> omega;
-    fin >> q;
-    fin >> dGamma;
-    dGamma_qq_q->push_back(dGamma);
-
-    ik++;
-  }
-  fin.close();
-
-  fin.open(filename[1].c_str(), ios::in);
-  if (!fin) {
+  qg = CachedTable::Load(filename[1], parser);
+  if (!qg) {
     JSWARN << "[readElasticRateQ]: ERROR: Unable to open file " << filename[1];
     throw std::runtime_error(
         "[readElasticRateQ]: ERROR: Unable to open ElasticRateQ file");
   }
-
-  ik = 0;
-  while (!fin.eof()) {
-    fin >> as;
-    fin >> omega;
-    fin >> q;
-    fin >> dGamma;
-    dGamma_qg_q->push_back(dGamma);
-
-    ik++;
-  }
-  fin.close();
 }
 
 double Martini::getRate_qqg(double p, double k) {
-  return use_table(p, k, Gam.qqg, 0);
+  return use_table(p, k, tables->Gam.qqg, 0);
 }
 
 double Martini::getRate_gqq(double p, double k) {
   if (k < p / 2.)
-    return use_table(p, k, Gam.gqq, 1);
+    return use_table(p, k, tables->Gam.gqq, 1);
   else
     return 0.;
 }
 
 double Martini::getRate_ggg(double p, double k) {
   if (k < p / 2.)
-    return use_table(p, k, Gam.ggg, 2);
+    return use_table(p, k, tables->Gam.ggg, 2);
   else
     return 0.;
 }
 
 double Martini::getRate_qqgamma(double p, double k) {
-  return use_table(p, k, Gam.qqgamma, 3);
+  return use_table(p, k, tables->Gam.qqgamma, 3);
 }
 
-double Martini::use_table(double p, double k, double dGamma[NP][NK],
-                          int which_kind)
+double Martini::use_table(double p, double k, const double dGamma[NP][NK],
+                                int which_kind)
 /* Uses the lookup table and simple interpolation to get the value
    of dGamma/dkdx at some value of p,k.
    This works by inverting the relations between (p,k) and (n_p,n_k)
@@ -17,7 +17,11 @@
 #define MARTINI_H
 
 #include <fstream>
+#include <map>
 #include <math.h>
+#include <memory>
+#include <mutex>
+#include "CachedTable.h"
 #include "JetEnergyLossModule.h"
 #include "JetScapeConstants.h"
 
@@ -128,13 +132,30 @@ private:
     double tau_qqgamma[NP][NK];
   } dGammas;
 
-  Gamma_info dat;
-  dGammas Gam;
+  // Radiative and elastic rate tables. They are read once per table path,
+  // never modified afterwards and shared by all the (cloned) instances.
+  struct RateTables {
+    Gamma_info dat;
+    dGammas Gam;
 
-  vector<double> *dGamma_qq;
-  vector<double> *dGamma_qg;
-  vector<double> *dGamma_qq_q;
-  vector<double> *dGamma_qg_q;
+    // elastic rates, mapped from their binary cache
+    std::shared_ptr<const CachedTable> dGamma_qq;
+    std::shared_ptr<const CachedTable> dGamma_qg;
+    std::shared_ptr<const CachedTable> dGamma_qq_q;
+    std::shared_ptr<const CachedTable> dGamma_qg_q;
+  };
+
+  std::shared_ptr<const RateTables> tables;
+
+  // elastic rates, pointing into *tables
+  const CachedTable *dGamma_qq;
+  const CachedTable *dGamma_qg;
+  const CachedTable *dGamma_qq_q;
+  const CachedTable *dGamma_qg_q;
+
+  // tables already loaded, by path
+  static std::map<string, std::weak_ptr<const RateTables>> loadedTables;
+  static std::mutex loadedTablesMutex;
 
   static int pLabelNew;
 
@@ -186,15 +207,19 @@ public:
   double getThermal(double k_min, double T, int kind);
 
   //Rate table//
+  std::shared_ptr<const RateTables> loadRateTables();
   void readRadiativeRate(Gamma_info *dat, dGammas *Gam);
-  void readElasticRateOmega();
-  void readElasticRateQ();
+  void readElasticRateOmega(std::shared_ptr<const CachedTable> &qq,
+                            std::shared_ptr<const CachedTable> &qg);
+  void readElasticRateQ(std::shared_ptr<const CachedTable> &qq,
+                        std::shared_ptr<const CachedTable> &qg);
 
   double getRate_qqg(double p, double k);
   double getRate_gqq(double p, double k);
   double getRate_ggg(double p, double k);
   double getRate_qqgamma(double p, double k);
-  double use_table(double p, double k, double dGamma[NP][NK], int which_kind);
+  double use_table(double p, double k, const double dGamma[NP][NK],
+                   int which_kind);
 
   double getElasticRateOmega(double u, double omega, int process);
   double getElasticRateQ(double u, double omega, double q, int process);
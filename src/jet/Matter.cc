@@ -44,12 +44,14 @@ double Matter::RHQ11[60][20] = {{0.0}};  //Qq->Qq
 double Matter::RHQ12[60][20] = {{0.0}};  //Qg->Qg
 double Matter::qhatHQ[60][20] = {{0.0}}; //qhat of heavy quark
 
-double Matter::distFncB[N_T][N_p1][N_e2] = {{{0.0}}};
-double Matter::distFncF[N_T][N_p1][N_e2] = {{{0.0}}};
-double Matter::distMaxB[N_T][N_p1][N_e2] = {{{0.0}}};
-double Matter::distMaxF[N_T][N_p1][N_e2] = {{{0.0}}};
-double Matter::distFncBM[N_T][N_p1] = {{0.0}};
-double Matter::distFncFM[N_T][N_p1] = {{0.0}};
+const double (*Matter::distFncB)[N_p1][N_e2] = nullptr;
+const double (*Matter::distFncF)[N_p1][N_e2] = nullptr;
+const double (*Matter::distMaxB)[N_p1][N_e2] = nullptr;
+const double (*Matter::distMaxF)[N_p1][N_e2] = nullptr;
+const double (*Matter::distFncBM)[N_p1] = nullptr;
+const double (*Matter::distFncFM)[N_p1] = nullptr;
+std::shared_ptr<const CachedTable> Matter::distTableB;
+std::shared_ptr<const CachedTable> Matter::distTableF;
 
 Matter::Matter() {
   SetId("Matter");
@@ -84,7 +86,6 @@ Matter::Matter() {
   Q0 = 0.;
   T0 = 0.;
   iEvent = 0;
-  NUM1 = 0;
 }
 
 Matter::~Matter() { VERBOSE(8); }
@@ -156,16 +157,70 @@ void Matter::Init() {
     flag_init = true;
   }
 
+  // Tabulate the vacuum Sudakov factors, optionally cached in a file
+  if (GetXMLElementInt({"Eloss", "Matter", "sudakov_table"}, false)) {
+    InitSudakovTable(
+        GetXMLElementText({"Eloss", "Matter", "sudakov_table_file"}, false));
+  } else {
+    sudakov_table = nullptr;
+  }
+
   // Initialize random number distribution
   ZeroOneDistribution = uniform_real_distribution<double>{0.0, 1.0};
 
-  //...initialize the random number generator
-  srand((unsigned)time(NULL));
-  NUM1 = -1 * rand();
-  //    NUM1=-33;
   iEvent = 0;
 }
 
+void Matter::InitSudakovTable(const std::string &file_name) {
+  // t0 = QS*QS/2, used for all the light partons, is the middle row
+  const double t0_min = QS * QS / 4.0;
+  const double t0_max = QS * QS;
+  const int n_t0 = 17;
+  const double t_max = 1.0e8;
+  const int n_u = 2000;
+
+  auto table = make_shared<SudakovTable>();
+  if (!file_name.empty() &&
+      table->Read(file_name, n_sudakov_channels, t0_min, t0_max, n_t0, t_max,
+                  n_u)) {
+    JSINFO << MAGENTA << "Sudakov tables read from " << file_name;
+  } else {
+    JSINFO << MAGENTA << "Tabulating the vacuum Sudakov factors ...";
+
+    // Integrate beyond the end of the medium, where only the vacuum part
+    // of the integrands is left. The energy only enters the medium part.
+    double loc = length + 1.0;
+    double E = 1.0;
+    table->Build(
+        n_sudakov_channels,
+        [this, loc, E](int channel, double t0, double t1, double t2) {
+          switch (channel) {
+          case sudakov_gg:
+            return ((Ca / 2.0 / pi) * sud_val_GG(t0, t1, t2, loc, E));
+          case sudakov_qq:
+            return ((Tf / 2.0 / pi) * sud_val_QQ(t0, t1, t2, loc, E));
+          case sudakov_qg:
+            return ((Cf / 2.0 / pi) * sud_val_QG(t0, t1, t2, loc, E));
+          case sudakov_qp:
+            return ((1.0 / 2.0 / pi) * sud_val_QP(t0, t1, t2, loc, E));
+          }
+          return (0.0);
+        },
+        t0_min, t0_max, n_t0, t_max, n_u);
+
+    if (!file_name.empty() && !table->Write(file_name)) {
+      JSWARN << "Could not write the Sudakov tables to " << file_name;
+    }
+  }
+  sudakov_table = table;
+}
+
+bool Matter::UseSudakovTable(double t0, double t, double loc) const {
+  // without medium-induced part, the Sudakov factors only depend on t0, t
+  return (sudakov_table && (in_vac || length - loc < rounding_error) &&
+          sudakov_table->InRange(t0, t));
+}
+
 void Matter::WriteTask(weak_ptr<JetScapeWriter> w) {
   VERBOSE(8);
   auto f = w.lock();
@@ -1921,6 +1976,25 @@ double Matter::generate_vac_t(int p_id, double nu, double t0, double t,
     return (t_mid);
   }
 
+  // In vacuum, solve numer/denom(t_mid) = r directly in the tables
+  if (UseSudakovTable(t0, t, loc_a)) {
+    std::vector<double> weights(n_sudakov_channels, 0.0);
+    if (p_id == gid) {
+      weights[sudakov_gg] = 1.0;
+      weights[sudakov_qq] = nf;
+    } else {
+      double relative_charge = 0.0;
+      if ((std::abs(p_id) > 0) && (std::abs(p_id) < 4))
+        relative_charge = 1.0 / 9.0;
+      if (std::abs(p_id) == 2)
+        relative_charge = relative_charge * 4.0;
+
+      weights[sudakov_qg] = 1.0;
+      weights[sudakov_qp] = relative_charge;
+    }
+    return (sudakov_table->Invert(weights, t0, std::log(r) - std::log(numer)));
+  }
+
   //t_mid = (t_low+t_hi)/2.0 ;
 
   scale = t0;
@@ -2462,6 +2536,9 @@ double Matter::sudakov_Pgg(double g0, double g1, double loc_c, double E) {
 
     return (sud);
   }
+  if (UseSudakovTable(g0, g1, loc_c)) {
+    return (exp(-sudakov_table->Exponent(sudakov_gg, g0, g1)));
+  }
   g = 2.0 * g0;
 
   if (g1 > g) {
@@ -2673,6 +2750,9 @@ double Matter::sudakov_Pqq(double q0, double q1, double loc_c, double E) {
     JSWARN << " in sudakov_Pquark quark, q0, q1 = " << q0 << "  " << q1;
     return (sud);
   }
+  if (UseSudakovTable(q0, q1, loc_c)) {
+    return (exp(-sudakov_table->Exponent(sudakov_qq, q0, q1)));
+  }
   q = 2.0 * q0;
 
   //	g = g0 ;
@@ -2981,6 +3061,9 @@ double Matter::sudakov_Pqp(double g0, double g1, double loc_c, double E) {
     JSWARN << " in sudakov_Pquark Photon, g0, g1 = " << g0 << "  " << g1;
     return (sud);
   }
+  if (UseSudakovTable(g0, g1, loc_c)) {
+    return (exp(-sudakov_table->Exponent(sudakov_qp, g0, g1)));
+  }
   g = 2.0 * g0;
 
   double logsud = sud_val_QP(g0, g, g1, loc_c, E);
@@ -3194,6 +3277,9 @@ double Matter::sudakov_Pqg(double g0, double g1, double loc_c, double E) {
     JSWARN << " in sudakov_Pquark gluon, g0, g1 = " << g0 << "  " << g1;
     return (sud);
   }
+  if (UseSudakovTable(g0, g1, loc_c)) {
+    return (exp(-sudakov_table->Exponent(sudakov_qg, g0, g1)));
+  }
   g = 2.0 * g0;
 
   sud = exp(-1.0 * (Cf / 2.0 / pi) * sud_val_QG(g0, g, g1, loc_c, E));
@@ -3743,7 +3829,12 @@ double Matter::fillQhatTab(double y) {
 
   double tStep = 0.1;
 
-  std::unique_ptr<FluidCellInfo> check_fluid_info_ptr;
+  // space-time points along the parton trajectory, the medium is queried
+  // for all of them at once
+  Jetscape::real tTab[dimQhatTab], xTab[dimQhatTab], yTab[dimQhatTab],
+      zTab[dimQhatTab];
+  int idTab[dimQhatTab];
+  int nQuery = 0;
 
   for (int i = 0; i < dimQhatTab; i++) {
     tLoc = tStep * i;
@@ -3789,15 +3880,34 @@ double Matter::fillQhatTab(double y) {
                                                 //exit(0);
     }
 
-    GetHydroCellSignal(tLoc, xLoc, yLoc, zLoc, check_fluid_info_ptr);
-    VERBOSE(8) << MAGENTA << "Temperature from medium = "
-               << check_fluid_info_ptr->temperature;
+    tTab[nQuery] = tLoc;
+    xTab[nQuery] = xLoc;
+    yTab[nQuery] = yLoc;
+    zTab[nQuery] = zLoc;
+    idTab[nQuery] = i;
+    nQuery++;
+  }
 
-    tempLoc = check_fluid_info_ptr->temperature;
-    sdLoc = check_fluid_info_ptr->entropy_density;
-    vxLoc = check_fluid_info_ptr->vx;
-    vyLoc = check_fluid_info_ptr->vy;
-    vzLoc = check_fluid_info_ptr->vz;
+  // the fields come in the order of EntryName
+  const unsigned int hydroFields =
+      (EntryMask(ENTRY_ENTROPY_DENSITY) | EntryMask(ENTRY_TEMPERATURE) |
+       EntryMask(ENTRY_VX) | EntryMask(ENTRY_VY) | EntryMask(ENTRY_VZ));
+  Jetscape::real hydroTab[5 * dimQhatTab];
+  if (nQuery > 0) {
+    GetHydroInfoBatchSignal(nQuery, tTab, xTab, yTab, zTab, hydroFields,
+                            hydroTab);
+  }
+
+  for (int n = 0; n < nQuery; n++) {
+    int i = idTab[n];
+    tLoc = tStep * i;
+
+    sdLoc = hydroTab[n];
+    tempLoc = hydroTab[nQuery + n];
+    vxLoc = hydroTab[2 * nQuery + n];
+    vyLoc = hydroTab[3 * nQuery + n];
+    vzLoc = hydroTab[4 * nQuery + n];
+    VERBOSE(8) << MAGENTA << "Temperature from medium = " << tempLoc;
 
     hydro_ctl = 0;
 
@@ -3928,7 +4038,7 @@ void Matter::flavor(int &CT, int &KATT0, int &KATT2, int &KATT3,
     double R3 = 6.0 * 6 * 4 / 9; // gq->gq or gqbar->gqbar flavor*DOF_q*factor
     double R0 = R1 + R3;
 
-    double a = ran0(&NUM1);
+    double a = ran0();
 
     if (a <= R1 / R0) { // gg->gg
       CT = 1;
@@ -3945,7 +4055,7 @@ void Matter::flavor(int &CT, int &KATT0, int &KATT2, int &KATT3,
       anti_color3 = max_color;
     } else { // gq->gq
       CT = 3;
-      b = floor(ran0(&NUM1) * 6 + 1);
+      b = floor(ran0() * 6 + 1);
       if (b == 7)
         b = 6;
       KATT3 = vb[b];
@@ -3974,7 +4084,7 @@ void Matter::flavor(int &CT, int &KATT0, int &KATT2, int &KATT3,
     double R2 = 16.0;            // Qg->Qg DOF_ag
     double R00 = R1 + R2;
 
-    double a = ran0(&NUM1);
+    double a = ran0();
 
     if (a <= R2 / R00) { // Qg->Qg
       CT = 12;
@@ -4001,7 +4111,7 @@ void Matter::flavor(int &CT, int &KATT0, int &KATT2, int &KATT3,
       }
     } else { // Qq->Qq
       CT = 11;
-      b = floor(ran0(&NUM1) * 6 + 1);
+      b = floor(ran0() * 6 + 1);
       if (b == 7)
         b = 6;
       KATT3 = vb[b];
@@ -4051,7 +4161,7 @@ void Matter::flavor(int &CT, int &KATT0, int &KATT2, int &KATT3,
     double R8 = 0.0;             // qqbar->gg don't consider in MATTER
     double R00 = R3 + R4 + R5 + R7;
 
-    double a = ran0(&NUM1);
+    double a = ran0();
     if (a <= R3 / R00) { // qg->qg
       CT = 13;
       KATT3 = 21;
@@ -4079,7 +4189,7 @@ void Matter::flavor(int &CT, int &KATT0, int &KATT2, int &KATT3,
     } else if (a <= (R3 + R4) / R00) { // qq'->qq'
       CT = 4;
       do {
-        b = floor(ran0(&NUM1) * 6 + 1);
+        b = floor(ran0() * 6 + 1);
         if (b == 7)
           b = 6;
         KATT3 = vb[b];
@@ -4237,9 +4347,9 @@ void Matter::colljet22(int CT, double temp, double qhat0ud, double v0[4],
 
   do {
     do {
-      xw = 15.0 * ran0(&NUM1);
-      razim = 2.0 * pi * ran0(&NUM1);
-      rcos = 1.0 - 2.0 * ran0(&NUM1);
+      xw = 15.0 * ran0();
+      razim = 2.0 * pi * ran0();
+      rcos = 1.0 - 2.0 * ran0();
       rsin = sqrt(1.0 - rcos * rcos);
       //
       p2[0] = xw * temp;
@@ -4263,7 +4373,7 @@ void Matter::colljet22(int CT, double temp, double qhat0ud, double v0[4],
 
       //    use (s^2+u^2)/(t+qhat0ud)^2 as scattering cross section in the
       //
-      rant = ran0(&NUM1);
+      rant = ran0();
       tt = rant * ss;
 
       //		ic+=1;
@@ -4404,7 +4514,7 @@ void Matter::colljet22(int CT, double temp, double qhat0ud, double v0[4],
             (mmax + 4.0);
     }
 
-    rank = ran0(&NUM1);
+    rank = ran0();
   } while (rank > (msq * ff));
 
   //
@@ -4431,7 +4541,7 @@ void Matter::colljet22(int CT, double temp, double qhat0ud, double v0[4],
   //    sample transverse momentum transfer with respect to jet momentum
   //    in cm frame
   //
-  double ranp = 2.0 * pi * ran0(&NUM1);
+  double ranp = 2.0 * pi * ran0();
   //
   //    transverse momentum transfer
   //
@@ -4593,7 +4703,7 @@ void Matter::collHQ22(int CT, double temp, double qhat0ud, double v0[4],
       flag1 = 1;
       break;
     }
-    xw = max_e2 * ran0(&NUM1);
+    xw = max_e2 * ran0();
     index_e2 = (int)((xw - min_e2) / bin_e2);
     if (index_e2 >= N_e2)
       index_e2 = N_e2 - 1;
@@ -4607,7 +4717,7 @@ void Matter::collHQ22(int CT, double temp, double qhat0ud, double v0[4],
       cout << "Wrong HQ channel ID" << endl;
       exit(EXIT_FAILURE);
     }
-  } while (ran0(&NUM1) > ff);
+  } while (ran0() > ff);
 
   e2 = xw * temp;
   e1 = p0[0];
@@ -4622,9 +4732,9 @@ void Matter::collHQ22(int CT, double temp, double qhat0ud, double v0[4],
       break;
     }
 
-    theta2 = pi * ran0(&NUM1);
-    theta4 = pi * ran0(&NUM1);
-    phi24 = 2.0 * pi * ran0(&NUM1);
+    theta2 = pi * ran0();
+    theta4 = pi * ran0();
+    phi24 = 2.0 * pi * ran0();
 
     cosTheta24 =
         sin(theta2) * sin(theta4) * cos(phi24) + cos(theta2) * cos(theta4);
@@ -4639,7 +4749,7 @@ void Matter::collHQ22(int CT, double temp, double qhat0ud, double v0[4],
 
     // re-sample if the kinematic cuts are not satisfied
     if (ss <= 2.0 * qhat0ud || tt >= -qhat0ud || uu >= -qhat0ud) {
-      rank = ran0(&NUM1);
+      rank = ran0();
       sigFactor = 0.0;
       msq = 0.0;
       continue;
@@ -4659,7 +4769,7 @@ void Matter::collHQ22(int CT, double temp, double qhat0ud, double v0[4],
       msq = Mgc2gc(ss, tt, HQmass) / maxValue;
     }
 
-    rank = ran0(&NUM1);
+    rank = ran0();
 
   } while (rank > (msq * sigFactor));
 
@@ -4680,7 +4790,7 @@ void Matter::collHQ22(int CT, double temp, double qhat0ud, double v0[4],
     p2[0] = e4;
 
     // rotate randomly in xy plane (jet is in z), because p3 is assigned in xz plane with bias
-    double th_rotate = 2.0 * pi * ran0(&NUM1);
+    double th_rotate = 2.0 * pi * ran0();
     double p3x_rotate = p3[1] * cos(th_rotate) - p3[2] * sin(th_rotate);
     double p3y_rotate = p3[1] * sin(th_rotate) + p3[2] * cos(th_rotate);
     double p2x_rotate = p2[1] * cos(th_rotate) - p2[2] * sin(th_rotate);
@@ -4836,64 +4946,10 @@ void Matter::rotate(double px, double py, double pz, double pr[4], int icc) {
   //  pr[0]=sqrt(pr[1]*pr[1]+pr[2]*pr[2]+pr[3]*pr[3]);
 }
 
-float Matter::ran0(long *idum)
-
-{
-  const int IM1 = 2147483563;
-  const int IM2 = 2147483399;
-  const double AM = (1.0 / IM1);
-  const int IMM1 = (IM1 - 1);
-  const int IA1 = 40014;
-  const int IA2 = 40692;
-  const int IQ1 = 53668;
-  const int IQ2 = 52774;
-  const int IR1 = 12211;
-  const int IR2 = 3791;
-  const int NTAB = 32;
-  const int NDIV = (1 + IMM1 / NTAB);
-  const double EPS = 1.2e-7;
-  const double RNMX = (1.0 - EPS);
-
-  int j;
-  long k;
-  static long idum2 = 123456789;
-  static long iy = 0;
-  static long iv[NTAB];
-  float temp;
-
-  if (*idum <= 0) {
-    if (-(*idum) < 1)
-      *idum = 1;
-    else
-      *idum = -(*idum);
-    for (j = NTAB + 7; j >= 0; j--) {
-      k = (*idum) / IQ1;
-      *idum = IA1 * (*idum - k * IQ1) - k * IR1;
-      if (*idum < 0)
-        *idum += IM1;
-      if (j < NTAB)
-        iv[j] = *idum;
-    }
-    iy = iv[0];
-  }
-  k = (*idum) / IQ1;
-  *idum = IA1 * (*idum - k * IQ1) - k * IR1;
-  if (*idum < 0)
-    *idum += IM1;
-  k = idum2 / IQ2;
-  idum2 = IA2 * (idum2 - k * IQ2) - k * IR2;
-  if (idum2 < 0)
-    idum2 += IM2;
-  j = iy / NDIV;
-  iy = iv[j] - idum2;
-  iv[j] = *idum;
-  if (iy < 1)
-    iy += IMM1;
-  if ((temp = AM * iy) > RNMX)
-    return RNMX;
-  else
-    return temp;
-}
+// Uniform in [0,1) from the engine of this task. It used to be a
+// Numerical Recipes generator with static state, which the clones
+// showering on different threads would share.
+double Matter::ran0() { return ZeroOneDistribution(*GetMt19937Generator()); }
 
 //////////////////////////////////////////////////////////////////////////////////////
 
@@ -4958,6 +5014,44 @@ double Matter::fnc0_derivative_alphas(double var_alphas, double var_qhat,
            var_alphas));
 }
 
+std::shared_ptr<const CachedTable>
+Matter::read_dist_table(const std::string &name) {
+  // blocks [N_T][N_p1] of the maxima, then [N_T][N_p1][N_e2] of the
+  // distributions and of their maxima
+  auto parser = [this, &name](std::istream &file,
+                              std::vector<double> &values) {
+    values.assign(N_T * N_p1 * (1 + 2 * N_e2), 0.0);
+    double *fncM = &values[0];
+    double *fnc = &values[N_T * N_p1];
+    double *max = &values[N_T * N_p1 * (1 + N_e2)];
+    for (int i = 0; i < N_T; i++) {
+      for (int j = 0; j < N_p1; j++) {
+        double dummy_T, dummy_p1;
+        file >> dummy_T >> dummy_p1;
+        if (fabs(min_T + (0.5 + i) * bin_T - dummy_T) > 1.0e-5 ||
+            fabs(min_p1 + (0.5 + j) * bin_p1 - dummy_p1) > 1.0e-5) {
+          cout << "Erro in reading data file " << name << "!" << endl;
+          exit(EXIT_FAILURE);
+        }
+        file >> fncM[i * N_p1 + j];
+        for (int k = 0; k < N_e2; k++)
+          file >> fnc[(i * N_p1 + j) * N_e2 + k];
+        for (int k = 0; k < N_e2; k++)
+          file >> max[(i * N_p1 + j) * N_e2 + k];
+      }
+    }
+    return (true);
+  };
+
+  auto table = CachedTable::Load("LBT-tables/" + name, parser);
+  if (!table) {
+    cout << "Erro openning data file " << name << "!" << endl;
+    table = CachedTable::FromValues(
+        std::vector<double>(N_T * N_p1 * (1 + 2 * N_e2), 0.0));
+  }
+  return (table);
+}
+
 void Matter::read_tables() { // intialize various tables for LBT
 
   //...read scattering rate
@@ -4991,49 +5085,17 @@ void Matter::read_tables() { // intialize various tables for LBT
   f11.close();
 
   // preparation for HQ 2->2
-  ifstream fileB("LBT-tables/distB.dat");
-  if (!fileB.is_open()) {
-    cout << "Erro openning data file distB.dat!" << endl;
-  } else {
-    for (int i = 0; i < N_T; i++) {
-      for (int j = 0; j < N_p1; j++) {
-        double dummy_T, dummy_p1;
-        fileB >> dummy_T >> dummy_p1;
-        if (fabs(min_T + (0.5 + i) * bin_T - dummy_T) > 1.0e-5 ||
-            fabs(min_p1 + (0.5 + j) * bin_p1 - dummy_p1) > 1.0e-5) {
-          cout << "Erro in reading data file distB.dat!" << endl;
-          exit(EXIT_FAILURE);
-        }
-        fileB >> distFncBM[i][j];
-        for (int k = 0; k < N_e2; k++)
-          fileB >> distFncB[i][j][k];
-        for (int k = 0; k < N_e2; k++)
-          fileB >> distMaxB[i][j][k];
-      }
-    }
-  }
-  fileB.close();
-
-  ifstream fileF("LBT-tables/distF.dat");
-  if (!fileF.is_open()) {
-    cout << "Erro openning data file distF.dat!" << endl;
-  } else {
-    for (int i = 0; i < N_T; i++) {
-      for (int j = 0; j < N_p1; j++) {
-        double dummy_T, dummy_p1;
-        fileF >> dummy_T >> dummy_p1;
-        if (fabs(min_T + (0.5 + i) * bin_T - dummy_T) > 1.0e-5 ||
-            fabs(min_p1 + (0.5 + j) * bin_p1 - dummy_p1) > 1.0e-5) {
-          cout << "Erro in reading data file distF.dat!" << endl;
-          exit(EXIT_FAILURE);
-        }
-        fileF >> distFncFM[i][j];
-        for (int k = 0; k < N_e2; k++)
-          fileF >> distFncF[i][j][k];
-        for (int k = 0; k < N_e2; k++)
-          fileF >> distMaxF[i][j][k];
-      }
-    }
-  }
-  fileF.close();
+  distTableB = read_dist_table("distB.dat");
+  distFncBM = reinterpret_cast<const double(*)[N_p1]>(distTableB->data());
+  distFncB = reinterpret_cast<const double(*)[N_p1][N_e2]>(
+      distTableB->data() + N_T * N_p1);
+  distMaxB = reinterpret_cast<const double(*)[N_p1][N_e2]>(
+      distTableB->data() + N_T * N_p1 * (1 + N_e2));
+
+  distTableF = read_dist_table("distF.dat");
+  distFncFM = reinterpret_cast<const double(*)[N_p1]>(distTableF->data());
+  distFncF = reinterpret_cast<const double(*)[N_p1][N_e2]>(
+      distTableF->data() + N_T * N_p1);
+  distMaxF = reinterpret_cast<const double(*)[N_p1][N_e2]>(
+      distTableF->data() + N_T * N_p1 * (1 + N_e2));
 }
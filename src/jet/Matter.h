@@ -16,7 +16,9 @@
 #ifndef MATTER_H
 #define MATTER_H
 
+#include "CachedTable.h"
 #include "JetEnergyLossModule.h"
+#include "SudakovTable.h"
 #include "Pythia8/Pythia.h"
 
 using namespace Jetscape;
@@ -33,6 +35,10 @@ public:
   //void DoEnergyLoss(double deltaT, double Q2, const vector<Parton>& pIn, vector<Parton>& pOut);
   void DoEnergyLoss(double deltaT, double time, double Q2, vector<Parton> &pIn,
                     vector<Parton> &pOut);
+  // the clones of Matter share only the tables filled in Init() and draw
+  // their random numbers from their own task engine, so the showers of
+  // different hard partons can run on different threads
+  bool IsThreadSafe() const { return (true); }
   void WriteTask(weak_ptr<JetScapeWriter> w);
   void Dump_pIn_info(int i, vector<Parton> &pIn);
 
@@ -76,6 +82,14 @@ public:
   double P_z_qq_int_w_M_vac_only(double M, double cg, double cg1, double loc_e,
                                  double cg3, double l_fac, double E2);
 
+  // Tabulated vacuum Sudakov exponents, filled in Init() and shared by the
+  // clones. They replace the integrals above whenever the medium-induced
+  // part vanishes.
+  enum { sudakov_gg, sudakov_qq, sudakov_qg, sudakov_qp, n_sudakov_channels };
+  std::shared_ptr<const SudakovTable> sudakov_table;
+  void InitSudakovTable(const std::string &file_name);
+  bool UseSudakovTable(double t0, double t, double loc) const;
+
   //  void shower_vac( int line, int pid, double nu_in, double t0_in, double t_in, double kx, double ky, double loc, bool is_lead);
   double generate_vac_t(int p_id, double nu, double t0, double t, double loc_a,
                         int isp);
@@ -118,15 +132,17 @@ public:
   double tStart = 0.6;
   int iEvent;
   bool debug_flag = 0;
-  long NUM1;
 
   // Variables for HQ 2->2
   static const int N_p1 = 500;
   static const int N_T = 60;
   static const int N_e2 = 75;
-  static double distFncB[N_T][N_p1][N_e2], distFncF[N_T][N_p1][N_e2],
-      distMaxB[N_T][N_p1][N_e2], distMaxF[N_T][N_p1][N_e2];
-  static double distFncBM[N_T][N_p1], distFncFM[N_T][N_p1];
+  // point into the tables of distB.dat and distF.dat
+  static const double (*distFncB)[N_p1][N_e2], (*distFncF)[N_p1][N_e2],
+      (*distMaxB)[N_p1][N_e2], (*distMaxF)[N_p1][N_e2];
+  static const double (*distFncBM)[N_p1], (*distFncFM)[N_p1];
+  static std::shared_ptr<const CachedTable> distTableB, distTableF;
+  std::shared_ptr<const CachedTable> read_dist_table(const std::string &name);
   double min_p1 = 0.0;
   double max_p1 = 1000.0;
   double bin_p1 = (max_p1 - min_p1) / N_p1;
@@ -157,7 +173,7 @@ public:
   void trans(double v[4], double p[4]);
   void transback(double v[4], double p[4]);
   void rotate(double px, double py, double pz, double pr[4], int icc);
-  float ran0(long *idum);
+  double ran0();
   double solve_alphas(double var_qhat, double var_ener, double var_temp);
   double fnc0_alphas(double var_alphas, double var_qhat, double var_ener,
                      double var_temp);
@@ -0,0 +1,241 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "SudakovTable.h"
+#include "JetScapeLogger.h"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace Jetscape {
+
+namespace {
+const char sudakov_file_tag[8] = {'J', 'S', 'S', 'U', 'D', 'A', 'K', '1'};
+}
+
+SudakovTable::SudakovTable()
+    : n_channels(0), n_t0(0), n_u(0), t0_min(0.), t0_max(0.), t_max(0.),
+      log_t0_min(0.), d_log_t0(0.), du(0.) {}
+
+void SudakovTable::Build(int n_channels_in, const Integral &integral,
+                         double t0_min_in, double t0_max_in, int n_t0_in,
+                         double t_max_in, int n_u_in) {
+  if (n_channels_in < 1 || n_t0_in < 1 || n_u_in < 2 || t0_min_in <= 0. ||
+      t0_max_in < t0_min_in || t_max_in <= 2. * t0_min_in) {
+    throw std::runtime_error("SudakovTable::Build: invalid grid");
+  }
+  n_channels = n_channels_in;
+  n_t0 = n_t0_in;
+  n_u = n_u_in;
+  t0_min = t0_min_in;
+  t0_max = t0_max_in;
+  t_max = t_max_in;
+  log_t0_min = std::log(t0_min);
+  d_log_t0 = (n_t0 > 1) ? std::log(t0_max / t0_min) / (n_t0 - 1) : 0.;
+  du = std::log(t_max / (2. * t0_min)) / (n_u - 1);
+
+  values.assign(n_channels * n_t0 * n_u, 0.);
+  for (int channel = 0; channel < n_channels; channel++) {
+    for (int row = 0; row < n_t0; row++) {
+      double t0 = std::exp(log_t0_min + row * d_log_t0);
+      double *exponent = &values[(channel * n_t0 + row) * n_u];
+      // the exponents are accumulated between neighbouring grid points
+      double t1 = 2. * t0;
+      for (int j = 1; j < n_u; j++) {
+        double t2 = 2. * t0 * std::exp(j * du);
+        exponent[j] = exponent[j - 1] + integral(channel, t0, t1, t2);
+        t1 = t2;
+      }
+    }
+  }
+}
+
+bool SudakovTable::Write(const std::string &file_name) const {
+  std::ofstream out(file_name.c_str(), std::ios::out | std::ios::binary);
+  if (!out) {
+    return (false);
+  }
+  out.write(sudakov_file_tag, sizeof(sudakov_file_tag));
+  int sizes[3] = {n_channels, n_t0, n_u};
+  double grid[3] = {t0_min, t0_max, t_max};
+  out.write(reinterpret_cast<const char *>(sizes), sizeof(sizes));
+  out.write(reinterpret_cast<const char *>(grid), sizeof(grid));
+  out.write(reinterpret_cast<const char *>(values.data()),
+            values.size() * sizeof(double));
+  return (out.good());
+}
+
+bool SudakovTable::Read(const std::string &file_name, int n_channels_in,
+                        double t0_min_in, double t0_max_in, int n_t0_in,
+                        double t_max_in, int n_u_in) {
+  std::ifstream in(file_name.c_str(), std::ios::in | std::ios::binary);
+  if (!in) {
+    return (false);
+  }
+  char tag[sizeof(sudakov_file_tag)];
+  int sizes[3];
+  double grid[3];
+  in.read(tag, sizeof(tag));
+  in.read(reinterpret_cast<char *>(sizes), sizeof(sizes));
+  in.read(reinterpret_cast<char *>(grid), sizeof(grid));
+  if (!in || std::memcmp(tag, sudakov_file_tag, sizeof(tag)) != 0) {
+    JSWARN << "SudakovTable: " << file_name << " is not a Sudakov table";
+    return (false);
+  }
+  if (sizes[0] != n_channels_in || sizes[1] != n_t0_in ||
+      sizes[2] != n_u_in || grid[0] != t0_min_in || grid[1] != t0_max_in ||
+      grid[2] != t_max_in) {
+    JSINFO << "SudakovTable: " << file_name << " holds another grid";
+    return (false);
+  }
+
+  std::vector<double> read_values(sizes[0] * sizes[1] * sizes[2]);
+  in.read(reinterpret_cast<char *>(read_values.data()),
+          read_values.size() * sizeof(double));
+  if (!in) {
+    JSWARN << "SudakovTable: " << file_name << " is truncated";
+    return (false);
+  }
+
+  n_channels = n_channels_in;
+  n_t0 = n_t0_in;
+  n_u = n_u_in;
+  t0_min = t0_min_in;
+  t0_max = t0_max_in;
+  t_max = t_max_in;
+  log_t0_min = std::log(t0_min);
+  d_log_t0 = (n_t0 > 1) ? std::log(t0_max / t0_min) / (n_t0 - 1) : 0.;
+  du = std::log(t_max / (2. * t0_min)) / (n_u - 1);
+  values.swap(read_values);
+  return (true);
+}
+
+bool SudakovTable::InRange(double t0, double t) const {
+  if (!IsFilled() || t0 < t0_min || t0 > t0_max || t < 2. * t0) {
+    return (false);
+  }
+  return (std::log(t / (2. * t0)) <= du * (n_u - 1));
+}
+
+void SudakovTable::Locate(double t0, int &row, double &a) const {
+  row = 0;
+  a = 0.;
+  if (n_t0 == 1) {
+    return;
+  }
+  double x = (std::log(t0) - log_t0_min) / d_log_t0;
+  row = static_cast<int>(x);
+  if (row < 0) {
+    row = 0;
+  }
+  if (row > n_t0 - 2) {
+    row = n_t0 - 2;
+  }
+  a = x - row;
+}
+
+double SudakovTable::Interpolated(int channel, int row, double a,
+                                  int j) const {
+  double value = Value(channel, row, j);
+  if (a > 0.) {
+    value += a * (Value(channel, row + 1, j) - value);
+  }
+  return (value);
+}
+
+double SudakovTable::Combined(const std::vector<double> &weights, int row,
+                              double a, int j) const {
+  double result = 0.;
+  for (int channel = 0; channel < n_channels; channel++) {
+    if (weights[channel] != 0.) {
+      result += weights[channel] * Interpolated(channel, row, a, j);
+    }
+  }
+  return (result);
+}
+
+double SudakovTable::Exponent(int channel, double t0, double t) const {
+  int row;
+  double a;
+  Locate(t0, row, a);
+
+  double x = std::log(t / (2. * t0)) / du;
+  int j = static_cast<int>(x);
+  if (j < 0) {
+    return (0.);
+  }
+  if (j >= n_u - 1) {
+    return (Interpolated(channel, row, a, n_u - 1));
+  }
+  double low = Interpolated(channel, row, a, j);
+  double high = Interpolated(channel, row, a, j + 1);
+  return (low + (x - j) * (high - low));
+}
+
+double SudakovTable::Exponent(const std::vector<double> &weights, double t0,
+                              double t) const {
+  int row;
+  double a;
+  Locate(t0, row, a);
+
+  double x = std::log(t / (2. * t0)) / du;
+  int j = static_cast<int>(x);
+  if (j < 0) {
+    return (0.);
+  }
+  if (j >= n_u - 1) {
+    return (Combined(weights, row, a, n_u - 1));
+  }
+  double low = Combined(weights, row, a, j);
+  double high = Combined(weights, row, a, j + 1);
+  return (low + (x - j) * (high - low));
+}
+
+double SudakovTable::Invert(const std::vector<double> &weights, double t0,
+                            double exponent) const {
+  if (exponent <= 0.) {
+    return (2. * t0);
+  }
+  int row;
+  double a;
+  Locate(t0, row, a);
+
+  // bisection over the grid points, the exponent grows with u
+  int low = 0;
+  int high = n_u - 1;
+  double high_value = Combined(weights, row, a, high);
+  if (exponent >= high_value) {
+    return (2. * t0 * std::exp(high * du));
+  }
+  while (high - low > 1) {
+    int mid = (low + high) / 2;
+    if (Combined(weights, row, a, mid) <= exponent) {
+      low = mid;
+    } else {
+      high = mid;
+    }
+  }
+  double low_value = Combined(weights, row, a, low);
+  high_value = Combined(weights, row, a, high);
+  double x = low;
+  if (high_value > low_value) {
+    x += (exponent - low_value) / (high_value - low_value);
+  }
+  return (2. * t0 * std::exp(x * du));
+}
+
+} // end namespace Jetscape
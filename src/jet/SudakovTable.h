@@ -0,0 +1,117 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#ifndef SUDAKOVTABLE_H
+#define SUDAKOVTABLE_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Jetscape {
+
+/** @class SudakovTable
+ * Sudakov exponents L(t0, t) = -log(Delta(t0, t)) of several splitting
+ * channels, tabulated on a common grid in log(t0) and u = log(t / (2 t0))
+ * and interpolated linearly in both variables. L(t0, t) = 0 for t = 2 t0
+ * and grows with t, so that a product of Sudakov factors can be inverted
+ * without any new integration. The table is not modified once filled,
+ * so it can be shared by concurrent readers.
+ */
+class SudakovTable {
+public:
+  /** Exponent of a channel between the virtualities t1 and t2 > t1, for
+      the lower cutoff t0.
+   */
+  typedef std::function<double(int channel, double t0, double t1, double t2)>
+      Integral;
+
+  SudakovTable();
+
+  /** Fill the table by integrating each channel between the grid points.
+      @param n_channels Number of splitting channels.
+      @param integral Exponent of a channel between two virtualities.
+      @param t0_min Smallest lower cutoff, in GeV^2.
+      @param t0_max Largest lower cutoff, in GeV^2.
+      @param n_t0 Number of points in log(t0).
+      @param t_max Largest virtuality for t0 = t0_min, in GeV^2.
+      @param n_u Number of points in log(t / (2 t0)).
+   */
+  void Build(int n_channels, const Integral &integral, double t0_min,
+             double t0_max, int n_t0, double t_max, int n_u);
+
+  /** Write the table to a binary file.
+      @return False if the file could not be written.
+   */
+  bool Write(const std::string &file_name) const;
+
+  /** Read a table written by Write(). The parameters are those of Build().
+      @return False if the file cannot be read or holds another grid.
+   */
+  bool Read(const std::string &file_name, int n_channels, double t0_min,
+            double t0_max, int n_t0, double t_max, int n_u);
+
+  bool IsFilled() const { return (!values.empty()); }
+  int GetNumberOfChannels() const { return (n_channels); }
+
+  /** @return True if t0 and 2 t0 <= t are covered by the table. */
+  bool InRange(double t0, double t) const;
+
+  /** @return Exponent of one channel, for a point InRange(). */
+  double Exponent(int channel, double t0, double t) const;
+
+  /** @return Sum of the exponents of all channels with the given weights,
+      for a point InRange().
+   */
+  double Exponent(const std::vector<double> &weights, double t0,
+                  double t) const;
+
+  /** Inverse of Exponent(weights, t0, t) in t.
+      @return Virtuality t at which the weighted exponent reaches the
+      given value, 2 t0 if it is not positive and the end of the table if
+      it is beyond the table.
+   */
+  double Invert(const std::vector<double> &weights, double t0,
+                double exponent) const;
+
+private:
+  // row below t0 and weight of the row above
+  void Locate(double t0, int &row, double &a) const;
+  // exponent of a channel at the grid point j in u, interpolated in t0
+  double Interpolated(int channel, int row, double a, int j) const;
+  // weighted exponent at the grid point j in u, interpolated in t0
+  double Combined(const std::vector<double> &weights, int row, double a,
+                  int j) const;
+  double Value(int channel, int row, int j) const {
+    return (values[(channel * n_t0 + row) * n_u + j]);
+  }
+
+  int n_channels;
+  int n_t0;
+  int n_u;
+  double t0_min;
+  double t0_max;
+  double t_max;
+  double log_t0_min;
+  double d_log_t0;
+  double du;
+
+  // values[(channel * n_t0 + row) * n_u + j]
+  std::vector<double> values;
+};
+
+} // end namespace Jetscape
+
+#endif // SUDAKOVTABLE_H
@@ -20,8 +20,58 @@
 #include "JetScapeLogger.h"
 #include "JetScapeXML.h"
 #include <cfloat>
+#include <limits>
+#include <vector>
 
 namespace Jetscape {
+
+namespace {
+
+// exp(-x) I1(x)/x and exp(-x) I2(x)/x^2 on 0 <= x <= x_max, used for the
+// smooth part of the kernel instead of the Bessel functions. Both are smooth
+// and bounded (1/2 and 1/8 at x=0), linear interpolation is good to ~1e-7.
+class ScaledBesselTable {
+ public:
+    static constexpr double x_max = 64.0;
+    static constexpr double dx = 1.0/512.0;
+
+    ScaledBesselTable(){
+        int n = int(x_max/dx) + 1;
+        i1.resize(n);
+        i2.resize(n);
+        i1[0] = 0.5;
+        i2[0] = 0.125;
+        for(int i=1; i<n; i++){
+            double x = i*dx;
+            i1[i] = gsl_sf_bessel_I1_scaled(x)/x;
+            i2[i] = gsl_sf_bessel_In_scaled(2,x)/x/x;
+        }
+    }
+
+    void get(double x, double &v1, double &v2) const {
+        double s = x/dx;
+        int i = int(s);
+        double w = s - i;
+        v1 = (1.0-w)*i1[i] + w*i1[i+1];
+        v2 = (1.0-w)*i2[i] + w*i2[i+1];
+    }
+
+ private:
+    std::vector<double> i1, i2;
+};
+
+}
+
+void CausalLiquefier::scaled_bessel(double x, double &i1, double &i2){
+    // built once, on first use
+    static const ScaledBesselTable table;
+    if( x < ScaledBesselTable::x_max - ScaledBesselTable::dx ){
+        table.get(x, i1, i2);
+    }else{
+        i1 = gsl_sf_bessel_I1_scaled(x)/x;
+        i2 = gsl_sf_bessel_In_scaled(2,x)/x/x;
+    }
+}
     
     
 CausalLiquefier::CausalLiquefier(){
@@ -40,6 +90,7 @@ CausalLiquefier::CausalLiquefier(){
     if( c_diff > 1.0 ){
         JSWARN << "Bad Signal Velocity in CausalLiquefier";
     }
+    set_droplet_cell_size(dtau, 1.0, 0.5);
 //    else{
 //        //for debug
 //        JSINFO << "c_diff = " << c_diff;
@@ -61,6 +112,7 @@ CausalLiquefier::CausalLiquefier(double dtau_in, double dx_in, double dy_in, dou
     
     c_diff = sqrt(d_diff/time_relax);
     gamma_relax = 0.5/time_relax;
+    set_droplet_cell_size(dtau, 1.0, 0.5);
 
     JSINFO
     << "<CausalLiquefier> Fluid Time Step and Cell Size: dtau="
@@ -133,12 +185,14 @@ void CausalLiquefier::smearing_kernel(
         double delta_r = sqrt((x-x_drop[1])*(x-x_drop[1])+(y-x_drop[2])*(y-x_drop[2])+(z-x_drop[3])*(z-x_drop[3]));
 
         // get solutions of the diffusion equation in the Cartesian coordinates
-        double jt = kernel_rho( delta_t, delta_r )/dtau;
+        double rho, j;
+        kernel( delta_t, delta_r, rho, j );
+        double jt = rho/dtau;
         double jz;
         if( delta_r <= DBL_MIN ){
             jz = 0.0;
         }else{
-            jz = ((z-x_drop[3])/delta_r)*kernel_j( delta_t, delta_r )/dtau;
+            jz = ((z-x_drop[3])/delta_r)*j/dtau;
         }
         // get flux for the constant-tau surface
         double jtau = get_ptau(jt, jz, eta);
@@ -153,15 +207,47 @@ void CausalLiquefier::smearing_kernel(
     
 }
 
-    
+
+//Droplets deposited at tau_drop reach the fluid at tau_drop + tau_delay
+void CausalLiquefier::get_droplet_window(Jetscape::real tau,
+                                         double &tau_drop_min,
+                                         double &tau_drop_max) const {
+    // same condition as in smearing_kernel, with some room for rounding
+    double margin = 1.e-5*(1.0 + std::abs(tau));
+    tau_drop_min = tau - 0.5*dtau - tau_delay - margin;
+    tau_drop_max = tau + 0.5*dtau - tau_delay + margin;
+}
+
 //Charge density rho in causal diffusion
 double CausalLiquefier::kernel_rho(double t, double r) const {
-    return dumping(t)*(rho_smooth(t, r)+rho_delta(t, r));
+    double rho, j;
+    kernel(t, r, rho, j);
+    return rho;
 }
 
 //Radial component of current j in causal diffusion
 double CausalLiquefier::kernel_j(double t, double r) const {
-    return dumping(t)*(j_smooth(t, r)+j_delta(t, r));
+    double rho, j;
+    kernel(t, r, rho, j);
+    return j;
+}
+
+//rho and j, the smooth components from the scaled Bessel functions
+//with their exp(x) taken into the dumping factor
+void CausalLiquefier::kernel(double t, double r, double &rho, double &j) const {
+    rho = dumping(t)*rho_delta(t, r);
+    j = c_diff*rho;
+    if( r < c_diff*t ){
+        double u = sqrt( c_diff*c_diff*t*t - r*r );
+        double x = gamma_relax*u/c_diff; // unitless
+        double i1, i2;
+        scaled_bessel(x, i1, i2);
+
+        double g = gamma_relax/c_diff;
+        double f = exp(x - gamma_relax*t)/(4.0*M_PI)*gamma_relax*gamma_relax/c_diff*g;
+        rho += f*(i1/c_diff + g*t*i2);
+        j += f*g*r*i2;
+    }
 }
 
 //Dumping factor in solutions of rho and j
@@ -174,12 +260,14 @@ double CausalLiquefier::rho_smooth(double t, double r) const {
     if( r < c_diff*t ){
         double u = sqrt( c_diff*c_diff*t*t - r*r );
         double x = gamma_relax*u/c_diff; // unitless
+        double i1, i2;
+        scaled_bessel(x, i1, i2);
 
-        double i1 = gsl_sf_bessel_I1(x)/(c_diff*u);
-        double i2 = gsl_sf_bessel_In(2,x)*t/u/u;
+        // I1(x)/u = exp(x) i1 x/u and I2(x)/u^2 = exp(x) i2 (x/u)^2
+        double g = gamma_relax/c_diff;
         double f = gamma_relax*gamma_relax/c_diff;
 
-        return f * (i1+i2);
+        return f * exp(x) * (i1*g/c_diff + i2*g*g*t);
     }else{
         return 0.0;
     }
@@ -190,11 +278,13 @@ double CausalLiquefier::j_smooth(double t, double r) const {
     if( r < c_diff*t ){
         double u = sqrt( c_diff*c_diff*t*t - r*r );
         double x = gamma_relax*u/c_diff; // unitless
+        double i1, i2;
+        scaled_bessel(x, i1, i2);
 
-        double i2 = gsl_sf_bessel_In(2,x)*r/u/u;
+        double g = gamma_relax/c_diff;
         double f = gamma_relax*gamma_relax/c_diff;
 
-        return f * i2;
+        return f * exp(x) * i2*g*g*r;
 
     }else{
         return 0.0;
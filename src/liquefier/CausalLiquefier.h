@@ -31,6 +31,8 @@ namespace Jetscape {
 class CausalLiquefier: public Jetscape::LiquefierBase {
  private:
 
+    // exp(-x) I1(x)/x and exp(-x) I2(x)/x^2, tabulated
+    static void scaled_bessel(double x, double &i1, double &i2);
     
  public:
     
@@ -57,9 +59,16 @@ class CausalLiquefier: public Jetscape::LiquefierBase {
                          Jetscape::real y, Jetscape::real eta,
                          const Droplet drop_i,
                          std::array<Jetscape::real, 4> &jmu) const;
-    
+
+    // droplets contribute only at tau_drop + tau_delay, within dtau
+    void get_droplet_window(Jetscape::real tau, double &tau_drop_min,
+                            double &tau_drop_max) const;
+
     double dumping(double t) const;
 
+    // rho and j together, as in kernel_rho and kernel_j
+    void kernel(double t, double r, double &rho, double &j) const;
+
     double kernel_rho(double t, double r) const;
     double rho_smooth(double t, double r) const;
     double rho_delta(double t, double r) const;
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "JetScapeBinaryReader.h"
+
+namespace Jetscape {
+
+void JetScapeBinaryReader::Init() {
+  JSINFO << "Open Input File = " << file_name_in;
+
+  inFile.open(file_name_in.c_str(), std::ios::in | std::ios::binary);
+
+  if (!JetScapeBinary::ReadFileTag(inFile)) {
+    JSWARN << "Corrupt input file!";
+    exit(-1);
+  } else
+    JSINFO << "File opened";
+}
+
+void JetScapeBinaryReader::Clear() {
+  event.Clear();
+  pShowers.clear();
+  hadrons.clear();
+}
+
+bool JetScapeBinaryReader::Finished() {
+  return inFile.peek() == std::char_traits<char>::eof();
+}
+
+void JetScapeBinaryReader::Next() {
+  Clear();
+  if (!JetScapeBinary::ReadBlock(inFile, payload) || !event.Decode(payload)) {
+    JSWARN << "Could not read an event from " << file_name_in;
+    event.Clear();
+    inFile.setstate(std::ios::eofbit);
+    return;
+  }
+  VERBOSE(3) << "Current Event = " << event.event_number;
+}
+
+vector<shared_ptr<PartonShower>> JetScapeBinaryReader::GetPartonShowers() {
+  if (pShowers.size() == event.shower_vertices.size())
+    return pShowers;
+
+  const VertexColumns &v = event.shower_vertex_columns;
+  const ParticleColumns &p = event.shower_parton_columns;
+  int first_vertex = 0;
+  int first_parton = 0;
+  vector<node> nodes;
+  for (unsigned int s = 0; s < event.shower_vertices.size(); s++) {
+    auto pShower = make_shared<PartonShower>();
+    nodes.clear();
+    int end_vertex = first_vertex + event.shower_vertices[s];
+    for (int i = first_vertex; i < end_vertex; i++) {
+      nodes.push_back(pShower->new_vertex(Vertex(v.x[i], v.y[i], v.z[i], v.t[i])));
+    }
+    int end_parton = first_parton + event.shower_partons[s];
+    for (int i = first_parton; i < end_parton; i++) {
+      pShower->new_parton(
+          nodes.at(event.edge_source[i]), nodes.at(event.edge_target[i]),
+          Parton(p.label[i], p.pid[i], p.stat[i],
+                 FourVector(p.px[i], p.py[i], p.pz[i], p.e[i]),
+                 FourVector(p.x[i], p.y[i], p.z[i], p.t[i])));
+    }
+    pShowers.push_back(pShower);
+    first_vertex = end_vertex;
+    first_parton = end_parton;
+  }
+  return pShowers;
+}
+
+vector<shared_ptr<Hadron>> JetScapeBinaryReader::GetHadrons() {
+  const ParticleColumns &h = event.hadrons;
+  if (hadrons.size() == h.size())
+    return hadrons;
+
+  hadrons.reserve(h.size());
+  for (unsigned int i = 0; i < h.size(); i++) {
+    hadrons.push_back(make_shared<Hadron>(
+        h.label[i], h.pid[i], h.stat[i],
+        FourVector(h.px[i], h.py[i], h.pz[i], h.e[i]),
+        FourVector(h.x[i], h.y[i], h.z[i], h.t[i])));
+  }
+  return hadrons;
+}
+
+vector<fjcore::PseudoJet> JetScapeBinaryReader::GetHadronsForFastJet() {
+  const ParticleColumns &h = event.hadrons;
+  vector<fjcore::PseudoJet> forFJ;
+  forFJ.reserve(h.size());
+
+  for (unsigned int i = 0; i < h.size(); i++) {
+    forFJ.push_back(fjcore::PseudoJet(h.px[i], h.py[i], h.pz[i], h.e[i]));
+  }
+
+  return forFJ;
+}
+
+} // end namespace Jetscape
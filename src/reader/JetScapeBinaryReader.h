@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#ifndef JETSCAPEBINARYREADER_H
+#define JETSCAPEBINARYREADER_H
+
+#include "JetClass.h"
+#include "JetScapeParticles.h"
+#include "JetScapeLogger.h"
+#include "JetScapeBinaryFormat.h"
+#include "PartonShower.h"
+#include <fstream>
+
+using std::ifstream;
+
+namespace Jetscape {
+
+/** @class JetScapeBinaryReader
+ * Reads the files of JetScapeWriterBinary event by event, with the same
+ * interface as JetScapeReader. The columns of the event can be used
+ * directly with GetEvent(); the showers and hadrons are only turned into
+ * objects when they are asked for.
+ */
+class JetScapeBinaryReader {
+
+public:
+  JetScapeBinaryReader(string m_file_name_in) {
+    file_name_in = m_file_name_in;
+    Init();
+  }
+  virtual ~JetScapeBinaryReader() { VERBOSE(8); }
+
+  void Close() { inFile.close(); }
+  void Clear();
+
+  void Next();
+  bool Finished();
+
+  int GetCurrentEvent() const { return event.event_number; }
+  int GetCurrentNumberOfPartonShowers() const {
+    return event.shower_vertices.size();
+  }
+
+  const JetScapeBinaryEvent &GetEvent() const { return event; }
+
+  vector<shared_ptr<PartonShower>> GetPartonShowers();
+  vector<shared_ptr<Hadron>> GetHadrons();
+  vector<fjcore::PseudoJet> GetHadronsForFastJet();
+  double GetEventPlaneAngle() const { return event.event_plane_angle; }
+
+private:
+  void Init();
+
+  string file_name_in;
+  ifstream inFile;
+
+  JetScapeBinaryEvent event;
+  std::string payload;
+
+  vector<shared_ptr<PartonShower>> pShowers;
+  vector<shared_ptr<Hadron>> hadrons;
+};
+
+} // end namespace Jetscape
+
+#endif // JETSCAPEBINARYREADER_H
@@ -15,10 +15,122 @@
 
 #include "JetScapeReader.h"
 #include <sstream>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 
 namespace Jetscape {
 
-template <class T> JetScapeReader<T>::JetScapeReader() {
+namespace {
+
+// Number parsing in place for the fast path. Lines are terminated by '\0'.
+
+inline const char *SkipBlanks(const char *p) {
+  while (*p == ' ' || *p == '\t' || *p == '\r')
+    p++;
+  return p;
+}
+
+inline bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+int ParseInt(const char *&p) {
+  p = SkipBlanks(p);
+  bool negative = (*p == '-');
+  if (*p == '-' || *p == '+')
+    p++;
+  int value = 0;
+  while (IsDigit(*p))
+    value = 10 * value + (*p++ - '0');
+  return negative ? -value : value;
+}
+
+// Plain decimal numbers with a mantissa below 2^53 and a power of ten up
+// to 10^22 are converted exactly: both are exact doubles and a single
+// multiplication or division rounds correctly. Anything else goes to
+// strtod.
+double ParseDouble(const char *&p) {
+  static const double powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                  1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                  1e18, 1e19, 1e20, 1e21, 1e22};
+  p = SkipBlanks(p);
+  const char *start = p;
+  bool negative = (*p == '-');
+  if (*p == '-' || *p == '+')
+    p++;
+
+  std::uint64_t mantissa = 0;
+  int n_digits = 0;
+  int exponent = 0;
+  bool exact = true;
+  bool any_digit = false;
+  for (; IsDigit(*p); p++) {
+    any_digit = true;
+    if (n_digits < 18) {
+      mantissa = 10 * mantissa + (*p - '0');
+      n_digits += (mantissa > 0);
+    } else {
+      exponent++;
+      exact = false;
+    }
+  }
+  if (*p == '.') {
+    for (p++; IsDigit(*p); p++) {
+      any_digit = true;
+      if (n_digits < 18) {
+        mantissa = 10 * mantissa + (*p - '0');
+        n_digits += (mantissa > 0);
+        exponent--;
+      } else {
+        exact = false;
+      }
+    }
+  }
+  if (any_digit && (*p == 'e' || *p == 'E')) {
+    const char *q = p + 1;
+    bool negative_exponent = (*q == '-');
+    if (*q == '-' || *q == '+')
+      q++;
+    if (IsDigit(*q)) {
+      int e = 0;
+      while (IsDigit(*q) && e < 10000)
+        e = 10 * e + (*q++ - '0');
+      exponent += negative_exponent ? -e : e;
+      p = q;
+    }
+  }
+
+  if (!any_digit || !exact || mantissa > (std::uint64_t(1) << 53) ||
+      exponent < -22 || exponent > 22 ||
+      std::isalpha(static_cast<unsigned char>(*p))) {
+    char *end;
+    double value = std::strtod(start, &end);
+    p = end;
+    return value;
+  }
+  double value = static_cast<double>(mantissa);
+  if (exponent < 0)
+    value /= powers[-exponent];
+  else
+    value *= powers[exponent];
+  return negative ? -value : value;
+}
+
+// pattern in the first n characters of line
+bool StartsWithin(const char *line, const char *end, const char *pattern,
+                  size_t n) {
+  size_t length = strlen(pattern);
+  const char *last = std::min(end, line + n + length);
+  return std::search(line, last, pattern, pattern + length) != last;
+}
+
+} // end namespace
+
+template <class T>
+JetScapeReader<T>::JetScapeReader()
+    : fastParsing(false), readShowers(true), chunkBegin(0), chunkEnd(0) {
   VERBOSE(8);
   currentEvent = -1;
   EventPlaneAngle = 0.0;
@@ -48,7 +160,7 @@ template <class T> void JetScapeReader<T>::AddNode(string s) {
   }
 
   nodeVec.push_back(pShower->new_vertex(
-      make_shared<Vertex>(stod(vS[1]), stod(vS[2]), stod(vS[3]), stod(vS[4]))));
+      Vertex(stod(vS[1]), stod(vS[2]), stod(vS[3]), stod(vS[4]))));
 }
 
 template <class T> void JetScapeReader<T>::AddEdge(string s) {
@@ -67,7 +179,7 @@ template <class T> void JetScapeReader<T>::AddEdge(string s) {
 
     pShower->new_parton(
         nodeVec[stoi(vS[0])], nodeVec[stoi(vS[1])],
-        make_shared<Parton>(
+        Parton(
             stoi(vS[2]), stoi(vS[3]), stoi(vS[4]), stod(vS[5]), stod(vS[6]),
             stod(vS[7]),
             stod(
@@ -94,6 +206,11 @@ template <class T> void JetScapeReader<T>::AddHadron(string s) {
 }
 
 template <class T> void JetScapeReader<T>::Next() {
+  if (fastParsing) {
+    NextFast();
+    return;
+  }
+
   if (currentEvent > 0)
     Clear();
 
@@ -170,6 +287,173 @@ template <class T> void JetScapeReader<T>::Next() {
     currentEvent++;
 }
 
+// Same logic as Next(), on lines taken from a large buffer
+template <class T> void JetScapeReader<T>::NextFast() {
+  if (currentEvent > 0)
+    Clear();
+
+  JSINFO << "Current Event = " << currentEvent;
+
+  if (readShowers) {
+    pShowers.push_back(make_shared<PartonShower>());
+    pShower = pShowers[0];
+  }
+  currentShower = 1;
+
+  int nodeZeroCounter = 0;
+  char *line;
+  char *end;
+  while (GetLine(line, end)) {
+    if (*line == '#') {
+      const char *angle = strstr(line, "EventPlaneAngle");
+      if (angle) {
+        const char *p = angle + strlen("EventPlaneAngle");
+        EventPlaneAngle = ParseDouble(p);
+        JSINFO << " EventPlaneAngle=" << EventPlaneAngle;
+      }
+      continue;
+    }
+
+    if (StartsWithin(line, end, "Event", 100)) {
+      const char *p = line;
+      while (*p == '[' || *p == ' ' || *p == '\t')
+        p++;
+      int newEvent = ParseInt(p);
+      if (currentEvent != newEvent && currentEvent > -1) {
+        currentEvent++;
+        break;
+      }
+      currentEvent = newEvent;
+      continue;
+    }
+
+    // not a graph or hadron entry
+    if (*line != '[')
+      continue;
+
+    const char *p = line + 1;
+    int first = ParseInt(p);
+    if (*p == ']')
+      p++;
+
+    // edge: [s]=>[t] P ...
+    if (p[0] == '=' && p[1] == '>' && p[2] == '[') {
+      if (!readShowers)
+        continue;
+      p += 3;
+      int second = ParseInt(p);
+      if (*p == ']')
+        p++;
+      p = SkipBlanks(p);
+      if (*p == 'P')
+        p++;
+      AddEdgeFast(first, second, p);
+      continue;
+    }
+
+    p = SkipBlanks(p);
+    // node: [n] V ...
+    if (p[0] == 'V' && (p[1] == ' ' || p[1] == '\t')) {
+      if (!readShowers)
+        continue;
+      if (first == 0 && line[1] == '0') {
+        nodeZeroCounter++;
+        if (nodeZeroCounter > currentShower) {
+          nodeVec.clear();
+          edgeVec.clear();
+          pShowers.push_back(make_shared<PartonShower>());
+          pShower = pShowers.back();
+          currentShower++;
+        }
+      }
+      AddNodeFast(p + 1);
+      continue;
+    }
+
+    // rest is a hadron: [i] H ...
+    while (std::isalpha(static_cast<unsigned char>(*p)))
+      p++;
+    AddHadronFast(p);
+  }
+
+  if (Finished())
+    currentEvent++;
+}
+
+template <class T> bool JetScapeReader<T>::GetLine(char *&line, char *&end) {
+  const size_t chunkSize = 1 << 22;
+  while (true) {
+    char *first = chunk.data() + chunkBegin;
+    char *last = chunk.data() + chunkEnd;
+    char *newline = static_cast<char *>(memchr(first, '\n', last - first));
+    if (newline) {
+      *newline = '\0';
+      line = first;
+      end = newline;
+      chunkBegin = newline + 1 - chunk.data();
+      return true;
+    }
+    if (!inFile.good()) {
+      // last line without a newline
+      if (first == last)
+        return false;
+      line = first;
+      end = last;
+      chunkBegin = chunkEnd;
+      return true;
+    }
+
+    // keep the beginning of the line and read the next chunk after it
+    size_t rest = last - first;
+    if (rest > 0)
+      memmove(chunk.data(), first, rest);
+    chunkBegin = 0;
+    chunkEnd = rest;
+    if (chunk.size() < rest + chunkSize + 1)
+      chunk.resize(rest + chunkSize + 1);
+    inFile.read(chunk.data() + rest, chunkSize);
+    chunkEnd += inFile.gcount();
+    chunk[chunkEnd] = '\0';
+  }
+}
+
+template <class T> void JetScapeReader<T>::AddNodeFast(const char *p) {
+  double x = ParseDouble(p);
+  double y = ParseDouble(p);
+  double z = ParseDouble(p);
+  double t = ParseDouble(p);
+  nodeVec.push_back(pShower->new_vertex(Vertex(x, y, z, t)));
+}
+
+template <class T>
+void JetScapeReader<T>::AddEdgeFast(int source, int target, const char *p) {
+  if (nodeVec.size() > 1) {
+    int label = ParseInt(p);
+    int id = ParseInt(p);
+    int stat = ParseInt(p);
+    double pt = ParseDouble(p);
+    double eta = ParseDouble(p);
+    double phi = ParseDouble(p);
+    double e = ParseDouble(p);
+    pShower->new_parton(nodeVec[source], nodeVec[target],
+                        Parton(label, id, stat, pt, eta, phi, e));
+  } else
+    JSWARN << "Node vector not filled, can not add edges/partons!";
+}
+
+template <class T> void JetScapeReader<T>::AddHadronFast(const char *p) {
+  double x[4];
+  x[0] = x[1] = x[2] = x[3] = 0.0;
+  int label = ParseInt(p);
+  int id = ParseInt(p);
+  int stat = ParseInt(p);
+  double pt = ParseDouble(p);
+  double eta = ParseDouble(p);
+  double phi = ParseDouble(p);
+  double e = ParseDouble(p);
+  hadrons.push_back(make_shared<Hadron>(label, id, stat, pt, eta, phi, e, x));
+}
+
 template <class T>
 vector<fjcore::PseudoJet> JetScapeReader<T>::GetHadronsForFastJet() {
   vector<fjcore::PseudoJet> forFJ;
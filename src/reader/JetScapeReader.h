@@ -40,7 +40,9 @@ template <class T> class JetScapeReader {
 
 public:
   JetScapeReader();
-  JetScapeReader(string m_file_name_in) {
+  JetScapeReader(string m_file_name_in)
+      : fastParsing(false), readShowers(true), chunkBegin(0), chunkEnd(0),
+        EventPlaneAngle(0.0) {
     file_name_in = m_file_name_in;
     Init();
   }
@@ -50,7 +52,21 @@ public:
   void Clear();
 
   void Next();
-  bool Finished() { return inFile.eof(); }
+  bool Finished() {
+    return inFile.eof() && (!fastParsing || chunkBegin == chunkEnd);
+  }
+
+  /** Read the file in large chunks and convert the numbers in place,
+      instead of tokenizing every line. Call before the first Next().
+   */
+  void SetFastParsing(bool m_fastParsing) { fastParsing = m_fastParsing; }
+  bool GetFastParsing() const { return fastParsing; }
+
+  /** With fast parsing, skip the vertices and partons of the showers when
+      only the hadrons are needed. GetPartonShowers() is then empty.
+   */
+  void SetReadShowers(bool m_readShowers) { readShowers = m_readShowers; }
+  bool GetReadShowers() const { return readShowers; }
 
   int GetCurrentEvent() { return currentEvent - 1; }
   int GetCurrentNumberOfPartonShowers() { return pShowers.size(); }
@@ -70,9 +86,22 @@ private:
   void AddEdge(string s);
   //void MakeGraph();
   void AddHadron(string s);
+
+  void NextFast();
+  bool GetLine(char *&line, char *&end);
+  void AddNodeFast(const char *p);
+  void AddEdgeFast(int source, int target, const char *p);
+  void AddHadronFast(const char *p);
+
   string file_name_in;
   T inFile;
 
+  bool fastParsing;
+  bool readShowers;
+  vector<char> chunk; // lines not parsed yet in fast parsing
+  size_t chunkBegin;
+  size_t chunkEnd;
+
   int currentEvent;
   int currentShower;
 